@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <string>
+#include <vector>
+
+/** @class FakeDBusHandler
+ *
+ *  D-Bus handler answering from memory, so that the benchmarks measure the
+ *  code of pldmd and not a D-Bus round trip. Unlike the gmock based
+ *  MockdBusHandler of the tests it has no expectations to match on every
+ *  call.
+ */
+class FakeDBusHandler : public pldm::utils::DBusHandler
+{
+  public:
+    std::string getService(const char* /*path*/,
+                           const char* /*interface*/) const override
+    {
+        return "xyz.openbmc_project.Benchmark";
+    }
+
+    void setDbusProperty(const pldm::utils::DBusMapping& /*dBusMap*/,
+                         const pldm::utils::PropertyValue& value) const override
+    {
+        lastSetValue = value;
+    }
+
+    pldm::utils::PropertyValue getDbusPropertyVariant(
+        const char* /*objPath*/, const char* /*dbusProp*/,
+        const char* /*dbusInterface*/) const override
+    {
+        return propertyValue;
+    }
+
+    pldm::utils::GetSubTreeResponse getSubtree(
+        const std::string& /*path*/, int /*depth*/,
+        const std::vector<std::string>& /*ifaceList*/) const override
+    {
+        return {};
+    }
+
+    pldm::utils::GetSubTreePathsResponse getSubTreePaths(
+        const std::string& /*objectPath*/, int /*depth*/,
+        const std::vector<std::string>& /*ifaceList*/) const override
+    {
+        return {};
+    }
+
+    /** @brief Value returned by getDbusPropertyVariant */
+    pldm::utils::PropertyValue propertyValue{};
+
+    /** @brief Last value written by setDbusProperty */
+    mutable pldm::utils::PropertyValue lastSetValue{};
+};
@@ -0,0 +1,81 @@
+#include "common/types.hpp"
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/base.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+/* Benchmark of the bookkeeping of the requester: registering requests and
+ * handling their responses, for batches of requests in flight to distinct
+ * endpoints. Sending is a no-op, so only the handler is measured.
+ */
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+/** @class NullRequest
+ *
+ *  A request whose sending always succeeds without sending anything
+ */
+class NullRequest : public RequestRetryTimer
+{
+  public:
+    NullRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+                TimingWheel& wheel, pldm::Request&& /*requestMsg*/,
+                uint8_t numRetries, milliseconds responseTimeOut,
+                bool /*verbose*/) :
+        RequestRetryTimer(wheel, numRetries, responseTimeOut)
+    {}
+
+    int send() const override
+    {
+        return PLDM_SUCCESS;
+    }
+};
+
+static void registerRequestHandleResponse(benchmark::State& state)
+{
+    auto event = sdeventplus::Event::get_default();
+    TestInstanceIdDb instanceIdDb;
+    Handler<NullRequest> reqHandler(nullptr, event, instanceIdDb, false,
+                                    seconds(5), 2, milliseconds(100));
+    auto batch = static_cast<size_t>(state.range(0));
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    std::vector<std::pair<mctp_eid_t, uint8_t>> inFlight(batch);
+    size_t responses = 0;
+    auto responseHandler = [&responses](mctp_eid_t, const pldm_msg*,
+                                        size_t) { responses++; };
+
+    for (auto _ : state)
+    {
+        for (size_t idx = 0; idx < batch; ++idx)
+        {
+            auto eid = static_cast<mctp_eid_t>(idx + 8);
+            auto instanceId = instanceIdDb.next(eid);
+            inFlight[idx] = {eid, instanceId};
+            reqHandler.registerRequest(eid, instanceId, PLDM_BASE, PLDM_GET_TID,
+                                       pldm::Request{}, responseHandler);
+        }
+        for (const auto& [eid, instanceId] : inFlight)
+        {
+            reqHandler.handleResponse(eid, instanceId, PLDM_BASE, PLDM_GET_TID,
+                                      responsePtr, response.size());
+        }
+    }
+
+    if (responses != state.iterations() * batch)
+    {
+        state.SkipWithError("Requests not answered");
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(registerRequestHandleResponse)->RangeMultiplier(4)->Range(1, 64);
@@ -0,0 +1,138 @@
+#include "common/bios_utils.hpp"
+#include "libpldmresponder/bios_config.hpp"
+#include "libpldmresponder/bios_table.hpp"
+#include "mocked_utils.hpp"
+
+#include <libpldm/bios.h>
+#include <libpldm/bios_table.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+/* Benchmarks of the BIOS tables served by the BIOS responder, built from the
+ * test BIOS JSONs of libpldmresponder. The D-Bus side of the attributes is
+ * left out: the D-Bus handler answers from memory and setAttrValue does not
+ * update the D-Bus properties.
+ */
+
+using namespace pldm::bios::utils;
+using namespace pldm::responder::bios;
+
+/** @class BIOSFixture
+ *
+ *  A BIOSConfig with its tables built in a temporary directory
+ */
+class BIOSFixture
+{
+  public:
+    BIOSFixture()
+    {
+        char tmpdir[] = "/tmp/BIOSTables.XXXXXX";
+        if (!mkdtemp(tmpdir))
+        {
+            throw std::runtime_error("Failed to create the BIOS table dir");
+        }
+        tableDir = tmpdir;
+        biosConfig = std::make_unique<BIOSConfig>(
+            "./bios_jsons", tableDir.c_str(), &dBusHandler, 0, 0, nullptr,
+            nullptr, nullptr, []() {});
+    }
+
+    ~BIOSFixture()
+    {
+        biosConfig.reset();
+        fs::remove_all(tableDir);
+    }
+
+    /** @brief Find the handle of an attribute by its name */
+    std::optional<uint16_t> findAttrHandle(const std::string& name)
+    {
+        auto stringTable = biosConfig->getBIOSTable(PLDM_BIOS_STRING_TABLE);
+        auto attrTable = biosConfig->getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+        if (!stringTable || !attrTable)
+        {
+            return std::nullopt;
+        }
+
+        auto stringHandle = BIOSStringTable(*stringTable).findHandle(name);
+        for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+                 attrTable->data(), attrTable->size()))
+        {
+            auto header = table::attribute::decodeHeader(entry);
+            if (header.stringHandle == stringHandle)
+            {
+                return header.attrHandle;
+            }
+        }
+        return std::nullopt;
+    }
+
+    FakeDBusHandler dBusHandler;
+    fs::path tableDir;
+    std::unique_ptr<BIOSConfig> biosConfig;
+};
+
+static void getBIOSTable(benchmark::State& state)
+{
+    BIOSFixture fixture;
+    auto tableType = static_cast<pldm_bios_table_types>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto table = fixture.biosConfig->getBIOSTable(tableType);
+        if (!table)
+        {
+            state.SkipWithError("BIOS table unavailable");
+            break;
+        }
+        benchmark::DoNotOptimize(table->data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getBIOSTable)
+    ->Arg(PLDM_BIOS_STRING_TABLE)
+    ->Arg(PLDM_BIOS_ATTR_TABLE)
+    ->Arg(PLDM_BIOS_ATTR_VAL_TABLE);
+
+static void setAttrValue(benchmark::State& state)
+{
+    BIOSFixture fixture;
+    auto attrHandle = fixture.findAttrHandle("str_example1");
+    if (!attrHandle)
+    {
+        state.SkipWithError("Attribute str_example1 not found");
+        return;
+    }
+
+    // Alternate between two values, so that every set updates the table
+    std::vector<uint8_t> attrValueEntries[] = {
+        {0, 0, PLDM_BIOS_STRING, 4, 0, 'a', 'b', 'c', 'd'},
+        {0, 0, PLDM_BIOS_STRING, 4, 0, 'e', 'f', 'g', 'h'}};
+    for (auto& entry : attrValueEntries)
+    {
+        entry[0] = *attrHandle & 0xff;
+        entry[1] = (*attrHandle >> 8) & 0xff;
+    }
+
+    size_t idx = 0;
+    for (auto _ : state)
+    {
+        const auto& entry = attrValueEntries[idx++ % 2];
+        auto rc = fixture.biosConfig->setAttrValue(entry.data(), entry.size(),
+                                                   false, false, false);
+        if (rc != PLDM_SUCCESS)
+        {
+            state.SkipWithError("setAttrValue failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(setAttrValue);
@@ -0,0 +1,118 @@
+#include "common/types.hpp"
+#include "libpldmresponder/fru.hpp"
+
+#include <libpldm/fru.h>
+#include <libpldm/pdr.h>
+
+#include <sdbusplus/message.hpp>
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+/* Benchmarks of the FRU record table served by the FRU responder. The table
+ * is built from the test FRU JSONs of libpldmresponder and an inventory of
+ * CPUs under a motherboard, given to the FRU table instead of fetching it
+ * from the inventory manager.
+ */
+
+using namespace pldm::responder;
+
+constexpr auto inventoryRoot = "/xyz/openbmc_project/inventory/system";
+
+/** @class FruFixture
+ *
+ *  A FRU table holding a record set per CPU of the inventory
+ */
+class FruFixture
+{
+  public:
+    explicit FruFixture(size_t cpus) :
+        pdrRepo(pldm_pdr_init(), pldm_pdr_destroy),
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy),
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy),
+        impl("./fru_jsons/good", "./fru_jsons/fru_master/fru_master.json",
+             pdrRepo.get(), entityTree.get(), bmcEntityTree.get())
+    {
+        std::string chassis = std::string(inventoryRoot) + "/chassis";
+        std::string motherboard = chassis + "/motherboard";
+        dbus::ObjectValueTree inventory{
+            {sdbusplus::message::object_path(inventoryRoot),
+             {{"xyz.openbmc_project.Inventory.Item.System", {}}}},
+            {sdbusplus::message::object_path(chassis),
+             {{"xyz.openbmc_project.Inventory.Item.Chassis", {}}}},
+            {sdbusplus::message::object_path(motherboard),
+             {{"xyz.openbmc_project.Inventory.Item.Board.Motherboard", {}}}}};
+
+        for (size_t idx = 0; idx < cpus; ++idx)
+        {
+            auto index = std::to_string(idx);
+            inventory.emplace(
+                sdbusplus::message::object_path(motherboard + "/cpu" + index),
+                dbus::InterfaceMap{
+                    {"xyz.openbmc_project.Inventory.Item.Cpu", {}},
+                    {"xyz.openbmc_project.Inventory.Decorator.Asset",
+                     {{"PartNumber", std::string("PN-CPU-") + index},
+                      {"SerialNumber", std::string("SN-CPU-") + index}}}});
+        }
+
+        impl.buildFRUTable(inventory, [](const std::string&) { return true; });
+    }
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree;
+    FruImpl impl;
+};
+
+static void getFRUTable(benchmark::State& state)
+{
+    FruFixture fixture(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        pldm::Response response(sizeof(pldm_msg_hdr) +
+                                PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
+        fixture.impl.getFRUTable(response);
+        benchmark::DoNotOptimize(response.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["tableBytes"] = fixture.impl.size();
+}
+BENCHMARK(getFRUTable)->RangeMultiplier(4)->Range(4, 1024);
+
+/* GetFRURecordByOption of the general record of each record set in turn */
+static void getFRURecordByOption(benchmark::State& state)
+{
+    FruFixture fixture(static_cast<size_t>(state.range(0)));
+    auto recordSets = fixture.impl.numRSI();
+    if (!recordSets)
+    {
+        state.SkipWithError("No FRU record sets");
+        return;
+    }
+
+    uint16_t recordSetIdentifier = 0;
+    for (auto _ : state)
+    {
+        pldm::Response response;
+        recordSetIdentifier = recordSetIdentifier % recordSets + 1;
+        auto rc = fixture.impl.getFRURecordByOption(
+            response, 0, recordSetIdentifier, PLDM_FRU_RECORD_TYPE_GENERAL, 0);
+        if (rc != PLDM_SUCCESS)
+        {
+            state.SkipWithError("getFRURecordByOption failed");
+            break;
+        }
+        benchmark::DoNotOptimize(response.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getFRURecordByOption)->RangeMultiplier(4)->Range(4, 1024);
@@ -0,0 +1,199 @@
+#include "host-bmc/dbus_to_event_handler.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+#include "libpldmresponder/platform.hpp"
+#include "libpldmresponder/platform_numeric_effecter.hpp"
+#include "libpldmresponder/platform_state_sensor.hpp"
+#include "mocked_utils.hpp"
+
+#include <endian.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+/* Benchmarks of the platform responder commands over PDR repositories of
+ * increasing size. The repositories hold the PDRs generated from the test
+ * JSONs of libpldmresponder, then filler state sensor and numeric effecter
+ * PDRs, so that the lookups of the commands walk realistic repositories.
+ */
+
+using namespace pldm::responder;
+using namespace pldm::responder::platform;
+
+constexpr uint16_t fillerIdBase = 0x1000;
+
+/** @class PlatformFixture
+ *
+ *  A platform handler over a PDR repository generated from a JSON directory
+ *  and grown to the requested number of records
+ */
+class PlatformFixture
+{
+  public:
+    PlatformFixture(const char* pdrJsonDir, size_t records) :
+        repo(pldm_pdr_init(), pldm_pdr_destroy),
+        event(sdeventplus::Event::get_default()),
+        handler(&dBusHandler, 0, nullptr, pdrJsonDir, repo.get(), nullptr,
+                nullptr, nullptr, nullptr, nullptr, event)
+    {
+        for (auto idx = pldm_pdr_get_record_count(repo.get()); idx < records;
+             ++idx)
+        {
+            auto id = static_cast<uint16_t>(fillerIdBase + idx);
+            if (idx % 2)
+            {
+                addStateSensorPdr(id);
+                lastStateSensorId = id;
+            }
+            else
+            {
+                addNumericEffecterPdr(id);
+            }
+        }
+    }
+
+    FakeDBusHandler dBusHandler;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> repo;
+    sdeventplus::Event event;
+    Handler handler;
+
+    /** @brief The filler state sensor found last by a lookup walking the
+     *         repository, 0 if there is none
+     */
+    uint16_t lastStateSensorId = 0;
+
+  private:
+    void addRecord(std::vector<uint8_t>& pdr)
+    {
+        uint32_t handle = 0;
+        if (pldm_pdr_add(repo.get(), pdr.data(), pdr.size(), false,
+                         TERMINUS_HANDLE, &handle))
+        {
+            throw std::runtime_error("Failed to add PDR");
+        }
+    }
+
+    void addStateSensorPdr(uint16_t sensorId)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_state_sensor_pdr) -
+                                 sizeof(uint8_t) +
+                                 sizeof(state_sensor_possible_states));
+        auto rec = reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data());
+        rec->hdr.version = 1;
+        rec->hdr.type = PLDM_STATE_SENSOR_PDR;
+        rec->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        rec->sensor_id = sensorId;
+        rec->composite_sensor_count = 1;
+        addRecord(pdr);
+    }
+
+    void addNumericEffecterPdr(uint16_t effecterId)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_numeric_effecter_value_pdr));
+        auto rec =
+            reinterpret_cast<pldm_numeric_effecter_value_pdr*>(pdr.data());
+        rec->hdr.version = 1;
+        rec->hdr.type = PLDM_NUMERIC_EFFECTER_PDR;
+        rec->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        rec->effecter_id = effecterId;
+        rec->effecter_data_size = PLDM_EFFECTER_DATA_SIZE_UINT32;
+        addRecord(pdr);
+    }
+};
+
+/* GetPDR of every record of the repository in turn, as a PDR repository
+ * consumer walking the repository would */
+static void getPDR(benchmark::State& state)
+{
+    PlatformFixture fixture("./pdr_jsons/state_sensor/good",
+                            static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) +
+                                 PLDM_GET_PDR_REQ_BYTES);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+
+    uint32_t recordHandle = 0;
+    for (auto _ : state)
+    {
+        encode_get_pdr_req(0, recordHandle, 0, PLDM_GET_FIRSTPART, UINT16_MAX,
+                           0, requestPtr, PLDM_GET_PDR_REQ_BYTES);
+        auto response =
+            fixture.handler.getPDR(requestPtr, PLDM_GET_PDR_REQ_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        recordHandle = le32toh(reinterpret_cast<pldm_get_pdr_resp*>(
+                                   responsePtr->payload)
+                                   ->next_record_handle);
+        benchmark::DoNotOptimize(response.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getPDR)->RangeMultiplier(4)->Range(64, 16384);
+
+static void getStateSensorReadings(benchmark::State& state)
+{
+    PlatformFixture fixture("./pdr_jsons/state_sensor/good",
+                            static_cast<size_t>(state.range(0)));
+    fixture.dBusHandler.propertyValue =
+        std::string("xyz.openbmc_project.Foo.Bar.V0");
+
+    // Read the last filler sensor, behind all the other state sensor PDRs,
+    // through the D-Bus mapping of the sensor of the JSONs
+    auto sensorId = fixture.lastStateSensorId;
+    if (!sensorId)
+    {
+        state.SkipWithError("No filler state sensor");
+        return;
+    }
+    fixture.handler.addDbusObjMaps(
+        sensorId,
+        fixture.handler.getDbusObjMaps(1, pdr_utils::TypeId::PLDM_SENSOR_ID),
+        pdr_utils::TypeId::PLDM_SENSOR_ID);
+    pldm::stateSensorCacheMaps sensorCache;
+    sensorCache.emplace(sensorId, pdr_utils::EventStates{PLDM_SENSOR_NORMAL});
+
+    std::vector<get_sensor_state_field> stateField;
+    for (auto _ : state)
+    {
+        uint8_t compSensorCnt{};
+        auto rc = platform_state_sensor::getStateSensorReadingsHandler<
+            FakeDBusHandler, Handler>(fixture.dBusHandler, fixture.handler,
+                                      sensorId, 1, compSensorCnt, stateField,
+                                      sensorCache);
+        if (rc != PLDM_SUCCESS)
+        {
+            state.SkipWithError("GetStateSensorReadings failed");
+            break;
+        }
+        benchmark::DoNotOptimize(stateField.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(getStateSensorReadings)->RangeMultiplier(4)->Range(64, 16384);
+
+static void setNumericEffecterValue(benchmark::State& state)
+{
+    PlatformFixture fixture("./pdr_jsons/state_effecter/good",
+                            static_cast<size_t>(state.range(0)));
+
+    uint32_t effecterValue = 2100000000;
+    for (auto _ : state)
+    {
+        auto rc = platform_numeric_effecter::setNumericEffecterValueHandler<
+            FakeDBusHandler, Handler>(
+            fixture.dBusHandler, fixture.handler, 3,
+            PLDM_EFFECTER_DATA_SIZE_UINT32,
+            reinterpret_cast<uint8_t*>(&effecterValue), sizeof(effecterValue));
+        if (rc != PLDM_SUCCESS)
+        {
+            state.SkipWithError("SetNumericEffecterValue failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(setNumericEffecterValue)->RangeMultiplier(4)->Range(64, 16384);
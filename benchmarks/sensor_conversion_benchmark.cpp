@@ -0,0 +1,165 @@
+#include "platform-mc/sensor_conversion.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+/* Benchmark of the per-reading cost of the numeric sensors: converting a raw
+ * reading and checking it against the warning and critical thresholds. The
+ * conversion of every reading with std::pow and the threshold checks in the
+ * unit of the sensor are compared with the precomputed conversion and the
+ * thresholds translated into the raw domain, reading by reading and for a
+ * whole terminus at once.
+ */
+
+using namespace pldm::platform_mc;
+
+namespace
+{
+
+constexpr double resolution = 1.25;
+constexpr double offset = -400;
+constexpr int8_t unitModifier = -1;
+constexpr double hysteresis = 2;
+constexpr std::array<double, 4> thresholds{85, 0, 100, -10};
+
+/** @brief Raw readings sweeping across the thresholds */
+std::vector<int64_t> makeReadings(size_t count)
+{
+    std::vector<int64_t> readings(count);
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        readings[idx] = static_cast<int64_t>((idx * 37) % 1400);
+    }
+    return readings;
+}
+
+/* The threshold check of NumericSensor, in the unit of the sensor */
+bool checkThreshold(bool alarm, bool direction, double value, double threshold,
+                    double hyst)
+{
+    if (direction)
+    {
+        if (value >= threshold)
+        {
+            return true;
+        }
+        if (value < (threshold - hyst))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if (value <= threshold)
+        {
+            return true;
+        }
+        if (value > (threshold + hyst))
+        {
+            return false;
+        }
+    }
+    return alarm;
+}
+
+} // namespace
+
+static void convertedThresholds(benchmark::State& state)
+{
+    auto readings = makeReadings(static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> alarms(readings.size());
+    std::vector<double> values(readings.size());
+    /* Read from the PDR, not a constant */
+    int8_t modifier = unitModifier;
+    benchmark::DoNotOptimize(modifier);
+
+    for (auto _ : state)
+    {
+        for (size_t idx = 0; idx < readings.size(); ++idx)
+        {
+            /* The conversion formula then the unit modifier */
+            double value = readings[idx] * resolution + offset;
+            value *= std::pow(10, modifier);
+            values[idx] = value;
+
+            uint8_t current = alarms[idx];
+            for (size_t th = 0; th < thresholds.size(); ++th)
+            {
+                auto alarm = RawThresholds::alarms[th];
+                bool high =
+                    alarm == warningHighAlarm || alarm == criticalHighAlarm;
+                if (checkThreshold(current & alarm, high, value,
+                                   thresholds[th], hysteresis))
+                {
+                    current |= alarm;
+                }
+                else
+                {
+                    current &= ~alarm;
+                }
+            }
+            alarms[idx] = current;
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::DoNotOptimize(alarms.data());
+    }
+    state.SetItemsProcessed(state.iterations() * readings.size());
+}
+BENCHMARK(convertedThresholds)->Arg(1)->Arg(256);
+
+static void rawThresholds(benchmark::State& state)
+{
+    auto readings = makeReadings(static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> alarms(readings.size());
+    std::vector<double> values(readings.size());
+    SensorConversion conversion(resolution, offset, unitModifier);
+    auto raw = RawThresholds::fromThresholds(conversion, thresholds,
+                                             hysteresis);
+    if (!raw)
+    {
+        state.SkipWithError("Thresholds not translated");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t idx = 0; idx < readings.size(); ++idx)
+        {
+            alarms[idx] = raw->check(readings[idx], alarms[idx]);
+            values[idx] = conversion.convert(readings[idx]);
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::DoNotOptimize(alarms.data());
+    }
+    state.SetItemsProcessed(state.iterations() * readings.size());
+}
+BENCHMARK(rawThresholds)->Arg(1)->Arg(256);
+
+static void rawThresholdsBatch(benchmark::State& state)
+{
+    auto readings = makeReadings(static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> alarms(readings.size());
+    SensorConversion conversion(resolution, offset, unitModifier);
+    auto raw = RawThresholds::fromThresholds(conversion, thresholds,
+                                             hysteresis);
+    if (!raw)
+    {
+        state.SkipWithError("Thresholds not translated");
+        return;
+    }
+    std::vector<RawThresholds> terminus(readings.size(), *raw);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            checkRawThresholds(terminus, readings, alarms));
+        benchmark::DoNotOptimize(alarms.data());
+    }
+    state.SetItemsProcessed(state.iterations() * readings.size());
+}
+BENCHMARK(rawThresholdsBatch)->Arg(256);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "utils.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/async.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <coroutine>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class AsyncMethodCall
+ *
+ *  Awaitable D-Bus method call. The call is sent without waiting for the
+ *  reply, the awaiting coroutine is resumed on the event loop once the reply
+ *  is dispatched, so the event loop keeps serving other messages meanwhile.
+ *  The bus must be attached to the event loop.
+ */
+class AsyncMethodCall
+{
+  public:
+    AsyncMethodCall() = delete;
+    AsyncMethodCall(const AsyncMethodCall&) = delete;
+    AsyncMethodCall(AsyncMethodCall&&) = delete;
+    AsyncMethodCall& operator=(const AsyncMethodCall&) = delete;
+    AsyncMethodCall& operator=(AsyncMethodCall&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] bus - the bus connection
+     *  @param[in] method - the method call
+     *  @param[in] timeout - timeout of the call in microseconds
+     */
+    AsyncMethodCall(sdbusplus::bus_t& bus, sdbusplus::message_t&& method,
+                    uint64_t timeout = dbusTimeout) :
+        bus(bus), method(std::move(method)), timeout(timeout)
+    {}
+
+    ~AsyncMethodCall()
+    {
+        sd_bus_slot_unref(slot);
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        awaiting = handle;
+        auto rc = sd_bus_call_async(bus.get(), &slot, method.get(), onReply,
+                                    this, timeout);
+        if (rc < 0)
+        {
+            throw sdbusplus::exception::SdBusError(-rc, "sd_bus_call_async");
+        }
+    }
+
+    /** @brief Get the reply of the call
+     *
+     *  @return the method return message
+     *  @throw sdbusplus::exception_t if the call failed or timed out
+     */
+    sdbusplus::message_t await_resume()
+    {
+        if (reply->is_method_error())
+        {
+            throw sdbusplus::exception::SdBusError(reply->get_errno(),
+                                                   "D-Bus method call");
+        }
+        return std::move(*reply);
+    }
+
+  private:
+    static int onReply(sd_bus_message* msg, void* userdata, sd_bus_error*)
+    {
+        auto self = static_cast<AsyncMethodCall*>(userdata);
+        self->reply.emplace(msg);
+        self->awaiting.resume();
+        return 0;
+    }
+
+    sdbusplus::bus_t& bus;
+    sdbusplus::message_t method;
+    uint64_t timeout;
+    sd_bus_slot* slot = nullptr;
+    std::coroutine_handle<> awaiting;
+    std::optional<sdbusplus::message_t> reply;
+};
+
+/** @brief Get the D-Bus service of an object without blocking the event loop
+ *
+ *  @param[in] path - D-Bus object path
+ *  @param[in] interface - D-Bus interface
+ *
+ *  @return the D-Bus service name
+ *  @throw sdbusplus::exception_t when it fails
+ */
+inline exec::task<std::string> getServiceAsync(std::string path,
+                                               std::string interface)
+{
+    auto& bus = DBusHandler::getBus();
+    auto mapper = bus.new_method_call(ObjectMapper::default_service,
+                                      ObjectMapper::instance_path,
+                                      ObjectMapper::interface, "GetObject");
+    mapper.append(path, std::vector<std::string>({interface}));
+
+    auto response = co_await AsyncMethodCall(bus, std::move(mapper));
+    std::map<std::string, std::vector<std::string>> mapperResponse;
+    response.read(mapperResponse);
+    co_return mapperResponse.begin()->first;
+}
+
+/** @brief Set a D-Bus property without blocking the event loop, the
+ *         counterpart of DBusHandler::setDbusProperty
+ *
+ *  @param[in] dBusMap - Object path, property name, interface and property
+ *                       type for the D-Bus object
+ *  @param[in] value - The value to be set
+ *
+ *  @throw sdbusplus::exception_t when it fails, std::invalid_argument for an
+ *         unsupported property type
+ */
+inline exec::task<void> setDbusPropertyAsync(DBusMapping dBusMap,
+                                             PropertyValue value)
+{
+    auto& bus = DBusHandler::getBus();
+    auto service = co_await getServiceAsync(dBusMap.objectPath,
+                                            dBusMap.interface);
+    co_await AsyncMethodCall(bus,
+                             newSetPropertyCall(bus, service, dBusMap, value));
+}
+
+} // namespace utils
+} // namespace pldm
@@ -1,12 +1,19 @@
 #pragma once
 
-#include <common/utils.hpp>
+#include "common/flight_recorder_format.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <iomanip>
-#include <iostream>
-#include <vector>
+#include <span>
+#include <string>
 
 PHOSPHOR_LOG2_USING;
 
@@ -15,111 +22,145 @@ namespace pldm
 namespace flightrecorder
 {
 using ReqOrResponse = bool;
-using FlightRecorderData = std::vector<uint8_t>;
-using FlightRecorderTimeStamp = std::string;
-using FlightRecorderRecord =
-    std::tuple<FlightRecorderTimeStamp, ReqOrResponse, FlightRecorderData>;
-using FlightRecorderCassette = std::vector<FlightRecorderRecord>;
 static constexpr auto flightRecorderDumpPath = "/tmp/pldm_flight_recorder";
 
 /** @class FlightRecorder
  *
- *  The class for implementing the PLDM flight recorder logic. This class
- *  handles the insertion of the data into the recorder and also provides
- *  API's to dump the flight recorder into a file.
+ *  The class for implementing the PLDM flight recorder logic. The messages are
+ *  recorded in binary into a ring of fixed size slots preallocated at start,
+ *  so recording a message takes a timestamp and a copy of its first bytes and
+ *  never allocates memory. The ring is optionally an mmap'ed file, so that the
+ *  records of a crashed daemon can still be decoded, `pldmtool flightrecorder`
+ *  decodes the file or a dump of the recorder.
  */
 
 class FlightRecorder
 {
-  private:
-    FlightRecorder() : index(0)
-    {
-        flightRecorderPolicy = FLIGHT_RECORDER_MAX_ENTRIES ? true : false;
-        if (flightRecorderPolicy)
-        {
-            tapeRecorder = FlightRecorderCassette(FLIGHT_RECORDER_MAX_ENTRIES);
-        }
-    }
-
-  protected:
-    int index;
-    FlightRecorderCassette tapeRecorder;
-    bool flightRecorderPolicy;
-
   public:
+    FlightRecorder() = delete;
     FlightRecorder(const FlightRecorder&) = delete;
     FlightRecorder(FlightRecorder&&) = delete;
     FlightRecorder& operator=(const FlightRecorder&) = delete;
     FlightRecorder& operator=(FlightRecorder&&) = delete;
-    ~FlightRecorder() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] slotCount - number of records kept, 0 disables the recorder
+     *  @param[in] path - file backing the recorder, an existing file is kept
+     *                    with a .prev suffix, empty to record into memory only
+     */
+    explicit FlightRecorder(size_t slotCount, const std::string& path = {}) :
+        ring(recorderMagic, recorderVersion, slotCount,
+             openFile(slotCount, path))
+    {}
 
     static FlightRecorder& GetInstance()
     {
-        static FlightRecorder flightRecorder;
+        static FlightRecorder flightRecorder(FLIGHT_RECORDER_MAX_ENTRIES,
+                                             FLIGHT_RECORDER_FILE);
         return flightRecorder;
     }
 
     /** @brief Add records to the flightRecorder
      *
      *  @param[in] buffer  - The request/response byte buffer
-     *  @param[in] isRequest - bool that captures if it is a request message or
-     *                         a response message
+     *  @param[in] isRequest - true if the message is transmitted, false if it
+     *                         is received
+     *  @param[in] tid - TID of the terminus the message is exchanged with
      *
      *  @return void
      */
-    void saveRecord(const FlightRecorderData& buffer, ReqOrResponse isRequest)
+    void saveRecord(std::span<const uint8_t> buffer, ReqOrResponse isRequest,
+                    uint8_t tid)
     {
         // if the flight recorder policy is enabled, then only insert the
         // messages into the flight recorder, if not this function will be just
         // a no-op
-        if (flightRecorderPolicy)
-        {
-            int currentIndex = index++;
-            tapeRecorder[currentIndex] = std::make_tuple(
-                pldm::utils::getCurrentSystemTime(), isRequest, buffer);
-            index =
-                (currentIndex == FLIGHT_RECORDER_MAX_ENTRIES - 1) ? 0 : index;
-        }
+        ring.push([&](RecordSlot& slot) {
+            slot.header.timestampNs =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+            slot.header.length = static_cast<uint16_t>(
+                std::min<size_t>(buffer.size(), UINT16_MAX));
+            slot.header.flags = isRequest ? recordFlagTx : 0;
+            slot.header.tid = tid;
+            std::memcpy(slot.data.data(), buffer.data(),
+                        std::min(buffer.size(), slot.data.size()));
+        });
     }
 
     /** @brief play flight recorder
+     *
+     *  Writes the binary contents of the recorder to flightRecorderDumpPath
      *
      *  @return void
      */
 
     void playRecorder()
     {
-        if (flightRecorderPolicy)
+        if (!ring.enabled())
         {
-            std::ofstream recorderOutputFile(flightRecorderDumpPath);
-            info("Dumping the flight recorder into : {DUMP_PATH}", "DUMP_PATH",
-                 flightRecorderDumpPath);
-            for (const auto& message : tapeRecorder)
-            {
-                recorderOutputFile
-                    << std::get<FlightRecorderTimeStamp>(message) << " : ";
-                if (std::get<ReqOrResponse>(message))
-                {
-                    recorderOutputFile << "Tx : \n";
-                }
-                else
-                {
-                    recorderOutputFile << "Rx : \n";
-                }
-                for (const auto& word : std::get<FlightRecorderData>(message))
-                {
-                    recorderOutputFile << std::setfill('0') << std::setw(2)
-                                       << std::hex << (unsigned)word << " ";
-                }
-                recorderOutputFile << std::endl;
-            }
-            recorderOutputFile.close();
+            error("Fight recorder policy is disabled");
+            return;
+        }
+
+        info(
+            "Dumping the flight recorder into : {DUMP_PATH}, decode it with 'pldmtool flightrecorder'",
+            "DUMP_PATH", flightRecorderDumpPath);
+        std::ofstream recorderOutputFile(flightRecorderDumpPath,
+                                         std::ios::binary | std::ios::trunc);
+        auto mapping = ring.getMapping();
+        recorderOutputFile.write(reinterpret_cast<const char*>(mapping.data()),
+                                 mapping.size());
+        if (!recorderOutputFile)
+        {
+            error("Failed to dump the flight recorder into {DUMP_PATH}",
+                  "DUMP_PATH", flightRecorderDumpPath);
         }
-        else
+    }
+
+  private:
+    /** @brief Create the file backing the recorder
+     *
+     *  @param[in] slotCount - number of records kept
+     *  @param[in] path - path of the file
+     *
+     *  @return the file descriptor, -1 to record into memory only
+     */
+    static int openFile(size_t slotCount, const std::string& path)
+    {
+        if (!slotCount || path.empty())
         {
-            error("Fight recorder policy is disabled");
+            return -1;
         }
+
+        // Keep the records of the previous run, which may have crashed
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec))
+        {
+            std::filesystem::rename(path, path + ".prev", ec);
+        }
+
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                      0600);
+        if (fd < 0 ||
+            ftruncate(fd, SeqlockRing<RecordSlot>::mapSize(slotCount)) < 0)
+        {
+            error(
+                "Failed to create flight recorder file {PATH}, recording into memory, error - {ERROR}",
+                "PATH", path, "ERROR", errno);
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return -1;
+        }
+        return fd;
     }
+
+    /** @brief The ring of record slots, disabled with the recorder */
+    SeqlockRing<RecordSlot> ring;
 };
 
 } // namespace flightrecorder
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "common/seqlock_ring.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+namespace flightrecorder
+{
+
+/** @brief Magic number at the start of a flight recorder file */
+constexpr std::array<char, 8> recorderMagic = {'P', 'L', 'D', 'M',
+                                               'F', 'R', 'E', 'C'};
+
+/** @brief Version of the flight recorder file layout */
+constexpr uint32_t recorderVersion = 1;
+
+/** @brief Size of a record slot, including its header */
+constexpr size_t recordSlotSize = 128;
+
+/** @brief Record flag set for a transmitted message, clear for a received one
+ */
+constexpr uint8_t recordFlagTx = 0x01;
+
+/** @brief Header of a flight recorder file, the header of its seqlock ring */
+using RecorderHeader = RingHeader;
+
+/** @struct RecordHeader
+ *
+ *  Header of a record slot, followed by the first bytes of the message
+ */
+struct RecordHeader
+{
+    uint64_t sequence;    //!< 1 based sequence number, 0 if the slot is empty
+                          //!< or being written
+    uint64_t timestampNs; //!< CLOCK_MONOTONIC time of the message, in ns
+    uint16_t length;      //!< length of the message, may exceed the data
+    uint8_t flags;        //!< recordFlagTx
+    uint8_t tid;          //!< TID of the terminus the message was exchanged
+                          //!< with, pldmd uses its MCTP EID
+    std::array<uint8_t, 4> reserved;
+};
+
+/** @brief Number of message bytes kept per record */
+constexpr size_t recordDataSize = recordSlotSize - sizeof(RecordHeader);
+
+/** @struct RecordSlot
+ *
+ *  A record slot of the flight recorder ring
+ */
+struct RecordSlot
+{
+    RecordHeader header;
+    std::array<uint8_t, recordDataSize> data;
+};
+
+static_assert(sizeof(RecordHeader) == 24);
+static_assert(sizeof(RecordSlot) == recordSlotSize);
+static_assert(offsetof(RecordSlot, header.sequence) == 0);
+
+/** @brief Offset of the first record slot in a flight recorder file */
+constexpr size_t recordSlotsOffset = ringRecordsOffset;
+
+/** @struct Recording
+ *
+ *  The contents of a flight recorder file
+ */
+struct Recording
+{
+    RecorderHeader header;
+    std::vector<RecordSlot> records; //!< in the order they were recorded
+};
+
+/** @brief Parse the contents of a flight recorder file
+ *
+ *  @param[in] file - the contents of the file
+ *
+ *  @return the recording, std::nullopt if the file is not a flight recorder
+ *          file of a known layout
+ */
+inline std::optional<Recording> parseRecording(std::span<const uint8_t> file)
+{
+    Recording recording{};
+    if (file.size() < recordSlotsOffset)
+    {
+        return std::nullopt;
+    }
+    std::memcpy(&recording.header, file.data(), sizeof(recording.header));
+
+    const auto& header = recording.header;
+    if (header.magic != recorderMagic || header.version != recorderVersion ||
+        header.recordSize != recordSlotSize ||
+        file.size() < recordSlotsOffset + header.recordCount * recordSlotSize)
+    {
+        return std::nullopt;
+    }
+
+    for (size_t i = 0; i < header.recordCount; ++i)
+    {
+        RecordSlot slot;
+        std::memcpy(&slot, file.data() + recordSlotsOffset + i * recordSlotSize,
+                    sizeof(slot));
+        if (slot.header.sequence)
+        {
+            recording.records.emplace_back(slot);
+        }
+    }
+    std::ranges::sort(recording.records, {},
+                      [](const auto& slot) { return slot.header.sequence; });
+    return recording;
+}
+
+} // namespace flightrecorder
+} // namespace pldm
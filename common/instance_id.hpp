@@ -2,11 +2,15 @@
 
 #include <libpldm/instance-id.h>
 
+#include <algorithm>
+#include <bitset>
 #include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <string>
 #include <system_error>
+#include <unordered_map>
 
 namespace pldm
 {
@@ -41,6 +45,8 @@ class InstanceIdDb
 
     ~InstanceIdDb()
     {
+        releaseLeases();
+
         /*
          * Abandon error-reporting. We shouldn't throw an exception from the
          * destructor, and the class has multiple consumers using incompatible
@@ -51,12 +57,152 @@ class InstanceIdDb
         pldm_instance_db_destroy(pldmInstanceIdDb);
     }
 
+    /** @brief Number of instance IDs per terminus */
+    static constexpr size_t maxInstanceIds = 32;
+
+    /** @brief Default number of instance IDs reserved per lease */
+    static constexpr uint8_t defaultLeaseBlockSize = 8;
+
+    /** @brief Default time after which an idle lease is returned */
+    static constexpr std::chrono::seconds defaultLeaseIdleTimeout{10};
+
+    /** @brief Hand instance IDs out from in-process leases
+     *
+     *  Instead of going to the shared database for every allocation, a block
+     *  of instance IDs is reserved per terminus and handed out from memory.
+     *  The reserved IDs stay allocated in the database, so other processes
+     *  sharing it never get an ID that is in use here. A lease is returned to
+     *  the database once it has been idle for the timeout, see
+     *  releaseExpiredLeases(), and on destruction.
+     *
+     *  @param[in] blockSize - number of instance IDs reserved at once
+     *  @param[in] idleTimeout - time after which an idle lease is returned
+     */
+    void enableLeases(
+        uint8_t blockSize = defaultLeaseBlockSize,
+        std::chrono::milliseconds idleTimeout = defaultLeaseIdleTimeout)
+    {
+        leaseBlockSize = std::clamp<uint8_t>(blockSize, 1, maxInstanceIds);
+        leaseIdleTimeout = idleTimeout;
+    }
+
     /** @brief Allocate an instance ID for the given terminus
      *  @param[in] tid - the terminus ID the instance ID is associated with
      *  @return - PLDM instance id or -EAGAIN if there are no available instance
      *            IDs
      */
     uint8_t next(uint8_t tid)
+    {
+        if (!leaseBlockSize)
+        {
+            return alloc(tid);
+        }
+
+        auto& lease = leases[tid];
+        lease.lastUsed = std::chrono::steady_clock::now();
+        auto available = lease.reserved & ~lease.inUse;
+        if (available.none())
+        {
+            available = reserve(tid, lease);
+        }
+
+        // Hand the IDs out round robin, as the database does, so that an ID
+        // is not reused right after it was freed
+        for (size_t i = 1; i <= maxInstanceIds; ++i)
+        {
+            auto id = (lease.last + i) % maxInstanceIds;
+            if (available.test(id))
+            {
+                lease.inUse.set(id);
+                lease.last = id;
+                return id;
+            }
+        }
+        throw std::runtime_error("No free instance ids");
+    }
+
+    /** @brief Mark an instance id as unused
+     *  @param[in] tid - the terminus ID the instance ID is associated with
+     *  @param[in] instanceId - PLDM instance id to be freed
+     */
+    void free(uint8_t tid, uint8_t instanceId)
+    {
+        auto it = leases.find(tid);
+        if (it != leases.end() && instanceId < maxInstanceIds &&
+            it->second.reserved.test(instanceId))
+        {
+            auto& lease = it->second;
+            if (!lease.inUse.test(instanceId))
+            {
+                throw std::runtime_error(
+                    "Instance ID " + std::to_string(instanceId) + " for TID " +
+                    std::to_string(tid) + " was not previously allocated");
+            }
+            lease.inUse.reset(instanceId);
+            lease.lastUsed = std::chrono::steady_clock::now();
+            return;
+        }
+
+        release(tid, instanceId);
+    }
+
+    /** @brief Return the unused instance IDs of the leases which have been
+     *         idle for longer than the lease timeout to the database
+     *
+     *  A lease in use keeps at most one block of unused instance IDs, so a
+     *  lease which has grown during a burst shrinks back even if the terminus
+     *  is polled steadily and the lease never becomes idle.
+     */
+    void releaseExpiredLeases()
+    {
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = leases.begin(); it != leases.end();)
+        {
+            auto& [tid, lease] = *it;
+            releaseUnused(tid, lease,
+                          now - lease.lastUsed >= leaseIdleTimeout
+                              ? 0
+                              : leaseBlockSize);
+            it = lease.reserved.none() ? leases.erase(it) : std::next(it);
+        }
+    }
+
+    /** @brief Return the unused instance IDs of all leases to the database */
+    void releaseLeases()
+    {
+        for (auto& [tid, lease] : leases)
+        {
+            releaseUnused(tid, lease);
+        }
+        std::erase_if(leases, [](const auto& entry) {
+            return entry.second.reserved.none();
+        });
+    }
+
+    /** @brief Get the number of instance IDs reserved for a terminus
+     *  @param[in] tid - the terminus ID
+     */
+    size_t getLeasedCount(uint8_t tid) const
+    {
+        auto it = leases.find(tid);
+        return it != leases.end() ? it->second.reserved.count() : 0;
+    }
+
+  private:
+    /** @struct Lease
+     *
+     *  The instance IDs of a terminus reserved in the database
+     */
+    struct Lease
+    {
+        std::bitset<maxInstanceIds> reserved; //!< allocated in the database
+        std::bitset<maxInstanceIds> inUse;    //!< handed out
+        uint8_t last = maxInstanceIds - 1;    //!< last ID handed out
+        std::chrono::steady_clock::time_point lastUsed; //!< last activity
+    };
+
+    /** @brief Allocate an instance ID from the database */
+    uint8_t alloc(uint8_t tid)
     {
         uint8_t id;
         int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
@@ -74,11 +220,8 @@ class InstanceIdDb
         return id;
     }
 
-    /** @brief Mark an instance id as unused
-     *  @param[in] tid - the terminus ID the instance ID is associated with
-     *  @param[in] instanceId - PLDM instance id to be freed
-     */
-    void free(uint8_t tid, uint8_t instanceId)
+    /** @brief Free an instance ID in the database */
+    void release(uint8_t tid, uint8_t instanceId)
     {
         int rc = pldm_instance_id_free(pldmInstanceIdDb, tid, instanceId);
         if (rc == -EINVAL)
@@ -93,8 +236,70 @@ class InstanceIdDb
         }
     }
 
-  private:
+    /** @brief Reserve a block of instance IDs for a lease
+     *
+     *  Fewer IDs than the block size are reserved if the database runs out,
+     *  the lease grows by another block when it is exhausted again.
+     *
+     *  @return the newly reserved instance IDs
+     */
+    std::bitset<maxInstanceIds> reserve(uint8_t tid, Lease& lease)
+    {
+        std::bitset<maxInstanceIds> reserved;
+        for (size_t i = 0; i < leaseBlockSize; ++i)
+        {
+            uint8_t id;
+            int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
+            if (rc == -EAGAIN)
+            {
+                break;
+            }
+            if (rc)
+            {
+                throw std::system_category().default_error_condition(rc);
+            }
+            reserved.set(id);
+        }
+        lease.reserved |= reserved;
+        return reserved;
+    }
+
+    /** @brief Return the instance IDs of a lease which are not in use
+     *
+     *  @param[in] keep - number of unused instance IDs kept in the lease, the
+     *                    ones handed out next
+     */
+    void releaseUnused(uint8_t tid, Lease& lease, size_t keep = 0)
+    {
+        auto unused = lease.reserved & ~lease.inUse;
+        for (size_t i = 1; i <= maxInstanceIds; ++i)
+        {
+            auto id = (lease.last + i) % maxInstanceIds;
+            if (!unused.test(id))
+            {
+                continue;
+            }
+            if (keep)
+            {
+                keep--;
+                continue;
+            }
+            // Abandon error-reporting, the ID is ours in the database
+            pldm_instance_id_free(pldmInstanceIdDb, tid, id);
+            lease.reserved.reset(id);
+        }
+    }
+
     pldm_instance_db* pldmInstanceIdDb = nullptr;
+
+    /** @brief Instance IDs reserved per lease, 0 if leases are disabled */
+    uint8_t leaseBlockSize = 0;
+
+    /** @brief Time after which an idle lease is returned */
+    std::chrono::milliseconds leaseIdleTimeout = defaultLeaseIdleTimeout;
+
+    /** @brief Leases by terminus ID */
+    std::unordered_map<uint8_t, Lease> leases;
 };
 
 } // namespace pldm
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace pldm
+{
+
+/** @class LatencyHistogram
+ *
+ *  A log-linear histogram of latencies in microseconds, in the style of an
+ *  HDR histogram. Every power of two range is split into 16 linear buckets,
+ *  so a value is recorded with a relative error below 6.25% in a fixed array
+ *  of counters. Recording a value is a few bit operations and an increment.
+ */
+class LatencyHistogram
+{
+  public:
+    /** @brief Number of bits of the value kept in the bucket index */
+    static constexpr unsigned subBucketBits = 4;
+
+    /** @brief Number of linear buckets per power of two */
+    static constexpr uint64_t subBucketCount = 1 << subBucketBits;
+
+    /** @brief Values above this limit, in microseconds, are counted in the
+     *         last bucket
+     */
+    static constexpr uint64_t maxTrackable = (uint64_t(1) << 26) - 1;
+
+    /** @brief Number of buckets */
+    static constexpr size_t numBuckets =
+        (std::bit_width(maxTrackable) - subBucketBits + 1) * subBucketCount;
+
+    /** @brief Record a latency
+     *
+     *  @param[in] latency - the latency
+     */
+    void record(std::chrono::microseconds latency)
+    {
+        auto value = static_cast<uint64_t>(
+            std::clamp<int64_t>(latency.count(), 0, maxTrackable));
+        buckets[bucketIndex(value)]++;
+        count++;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    /** @brief Get the value at a percentile of the recorded latencies
+     *
+     *  @param[in] percentile - the percentile, from 0 to 100
+     *
+     *  @return the highest value of the bucket the percentile falls in, 0 if
+     *          nothing was recorded
+     */
+    std::chrono::microseconds getPercentile(double percentile) const
+    {
+        if (!count)
+        {
+            return std::chrono::microseconds(0);
+        }
+
+        auto rank = static_cast<uint64_t>(
+            std::clamp(percentile, 0.0, 100.0) / 100.0 * count + 0.5);
+        rank = std::clamp<uint64_t>(rank, 1, count);
+        uint64_t seen = 0;
+        for (size_t idx = 0; idx < numBuckets; ++idx)
+        {
+            seen += buckets[idx];
+            if (seen >= rank)
+            {
+                return std::chrono::microseconds(
+                    std::clamp(bucketUpperBound(idx), min, max));
+            }
+        }
+        return std::chrono::microseconds(max);
+    }
+
+    /** @brief Invoke a function with the bounds and the count of every
+     *         bucket which has recorded a latency
+     *
+     *  @param[in] func - invoked with the lowest and the highest value of the
+     *                    bucket, in microseconds, and its count
+     */
+    void forEachBucket(
+        const std::function<void(uint64_t, uint64_t, uint64_t)>& func) const
+    {
+        for (size_t idx = 0; idx < numBuckets; ++idx)
+        {
+            if (buckets[idx])
+            {
+                func(bucketLowerBound(idx), bucketUpperBound(idx),
+                     buckets[idx]);
+            }
+        }
+    }
+
+    /** @brief Get the index of the bucket of a value
+     *
+     *  @param[in] value - the value, at most maxTrackable
+     */
+    static constexpr size_t bucketIndex(uint64_t value)
+    {
+        // Values below 2 * subBucketCount have a bucket each, above that
+        // every power of two is split into subBucketCount buckets
+        auto group = static_cast<unsigned>(std::bit_width(value));
+        if (group <= subBucketBits + 1)
+        {
+            return value;
+        }
+        auto shift = group - subBucketBits - 1;
+        return shift * subBucketCount + (value >> shift);
+    }
+
+    /** @brief Get the lowest value of a bucket */
+    static constexpr uint64_t bucketLowerBound(size_t idx)
+    {
+        if (idx < 2 * subBucketCount)
+        {
+            return idx;
+        }
+        auto shift = idx / subBucketCount - 1;
+        return (idx - shift * subBucketCount) << shift;
+    }
+
+    /** @brief Get the highest value of a bucket */
+    static constexpr uint64_t bucketUpperBound(size_t idx)
+    {
+        return idx + 1 < numBuckets ? bucketLowerBound(idx + 1) - 1
+                                    : std::numeric_limits<uint64_t>::max();
+    }
+
+    uint64_t count = 0; //!< Number of recorded latencies
+    uint64_t sum = 0;   //!< Sum of the recorded latencies, in microseconds
+    uint64_t min = std::numeric_limits<uint64_t>::max(); //!< Lowest latency
+    uint64_t max = 0;                                    //!< Highest latency
+
+  private:
+    std::array<uint64_t, numBuckets> buckets{};
+};
+
+static_assert(LatencyHistogram::bucketIndex(LatencyHistogram::maxTrackable) ==
+              LatencyHistogram::numBuckets - 1);
+
+} // namespace pldm
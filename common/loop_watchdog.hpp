@@ -0,0 +1,376 @@
+#pragma once
+
+#include "common/latency_histogram.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace watchdog
+{
+
+/** @brief Kinds of callbacks dispatched by the event loop */
+enum class SourceKind : uint8_t
+{
+    Command,  //!< responder command handler, by TID, PLDM type and command
+    Response, //!< requester response handler, by EID, PLDM type and command
+    Match,    //!< D-Bus match callback, by name
+    Timer,    //!< timer callback, by name
+    IO,       //!< IO callback, by name
+};
+
+/** @brief Get the name of a kind of callback */
+constexpr std::string_view toString(SourceKind kind)
+{
+    switch (kind)
+    {
+        case SourceKind::Command:
+            return "Command";
+        case SourceKind::Response:
+            return "Response";
+        case SourceKind::Match:
+            return "Match";
+        case SourceKind::Timer:
+            return "Timer";
+        case SourceKind::IO:
+            return "IO";
+    }
+    return "Unknown";
+}
+
+/** @struct Source
+ *
+ *  Identifies a callback of the event loop. PLDM message handlers are
+ *  identified by their endpoint, PLDM type and command, the other callbacks
+ *  by a name, which must be a string literal.
+ */
+struct Source
+{
+    SourceKind kind = SourceKind::IO;
+    uint8_t eid = 0;
+    uint8_t type = 0;
+    uint8_t command = 0;
+    std::string_view name{};
+
+    bool operator==(const Source&) const = default;
+};
+
+/** @struct SourceHasher */
+struct SourceHasher
+{
+    std::size_t operator()(const Source& source) const
+    {
+        return std::hash<std::string_view>{}(source.name) ^
+               (static_cast<std::size_t>(source.kind) << 24 |
+                source.eid << 16 | source.type << 8 | source.command);
+    }
+};
+
+/** @struct StallStats
+ *
+ *  The stalls of the event loop attributed to one callback
+ */
+struct StallStats
+{
+    uint64_t stalls = 0;  //!< Dispatches held longer than the threshold
+    uint64_t totalUs = 0; //!< Time the loop was held by those dispatches
+    uint64_t maxUs = 0;   //!< Longest of those dispatches
+};
+
+/** @class LoopWatchdog
+ *
+ *  Measures how long the callbacks dispatched by the sd-event loop hold it.
+ *  The callbacks are measured with a Scope, the time of every dispatch is
+ *  recorded into a histogram and a dispatch holding the loop longer than the
+ *  threshold is a stall. A stall is attributed to the callback of the
+ *  dispatch which ran the longest by itself, excluding the nested callbacks,
+ *  e.g. to the response handler invoked by the receive callback rather than
+ *  to the receive callback.
+ *
+ *  The watchdog is disabled with a zero threshold, a Scope then costs a
+ *  branch. It is only used from the event loop thread.
+ */
+class LoopWatchdog
+{
+  public:
+    class Scope;
+
+    /** @brief The watchdog of the process */
+    static LoopWatchdog& getInstance()
+    {
+        static LoopWatchdog watchdog;
+        return watchdog;
+    }
+
+    /** @brief Set the time beyond which a dispatch is a stall, zero disables
+     *         the watchdog
+     */
+    void setThreshold(std::chrono::microseconds threshold)
+    {
+        this->threshold = std::max(threshold, std::chrono::microseconds(0));
+    }
+
+    /** @brief Get the time beyond which a dispatch is a stall */
+    std::chrono::microseconds getThreshold() const
+    {
+        return threshold;
+    }
+
+    /** @brief Check whether the callbacks are measured */
+    bool isEnabled() const
+    {
+        return threshold.count() > 0;
+    }
+
+    /** @brief Record how late a timer of the loop was dispatched
+     *
+     *  @param[in] lag - time from the expiry of the timer to its dispatch
+     */
+    void recordLag(std::chrono::microseconds lag)
+    {
+        lagHistogram.record(lag);
+    }
+
+    /** @brief Get the histogram of the time held by each dispatch */
+    const LatencyHistogram& getHoldTimes() const
+    {
+        return holdHistogram;
+    }
+
+    /** @brief Get the histogram of the lag of the loop */
+    const LatencyHistogram& getLag() const
+    {
+        return lagHistogram;
+    }
+
+    /** @brief Get the callbacks which stalled the loop the most
+     *
+     *  @param[in] count - maximum number of callbacks returned
+     *
+     *  @return the callbacks, by decreasing time they stalled the loop for
+     */
+    std::vector<std::pair<Source, StallStats>> getTopStalls(size_t count) const
+    {
+        std::vector<std::pair<Source, StallStats>> top(stalls.begin(),
+                                                       stalls.end());
+        auto middle = top.begin() + std::min(count, top.size());
+        std::partial_sort(top.begin(), middle, top.end(),
+                          [](const auto& lhs, const auto& rhs) {
+                              return lhs.second.totalUs > rhs.second.totalUs;
+                          });
+        top.erase(middle, top.end());
+        return top;
+    }
+
+    /** @brief Clear the histograms and the stalls */
+    void reset()
+    {
+        holdHistogram = LatencyHistogram{};
+        lagHistogram = LatencyHistogram{};
+        stalls.clear();
+    }
+
+    /** @brief Wrap a callback so that its dispatches are measured
+     *
+     *  @param[in] source - identity of the callback
+     *  @param[in] func - the callback
+     *
+     *  @return a callback invoking func within a Scope
+     */
+    template <typename Func>
+    static auto wrap(Source source, Func&& func)
+    {
+        return [source, func = std::forward<Func>(func)](
+                   auto&&... args) mutable -> decltype(auto) {
+            Scope scope(source);
+            return func(std::forward<decltype(args)>(args)...);
+        };
+    }
+
+  private:
+    /** @brief Record a dispatch of the loop
+     *
+     *  @param[in] held - time the dispatch held the loop
+     *  @param[in] offender - the callback of the dispatch which ran the
+     *                        longest by itself
+     */
+    void record(std::chrono::nanoseconds held, const Source& offender)
+    {
+        auto heldUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            held);
+        holdHistogram.record(heldUs);
+        if (heldUs <= threshold)
+        {
+            return;
+        }
+
+        auto& entry = stalls[offender];
+        entry.stalls++;
+        entry.totalUs += heldUs.count();
+        if (static_cast<uint64_t>(heldUs.count()) > entry.maxUs)
+        {
+            entry.maxUs = heldUs.count();
+            if (offender.name.empty())
+            {
+                lg2::warning(
+                    "{KIND} handler of EID {EID} PLDM type {TYPE} command {COMMAND} held the event loop for {DURATION_US} us",
+                    "KIND", toString(offender.kind), "EID", offender.eid,
+                    "TYPE", offender.type, "COMMAND", offender.command,
+                    "DURATION_US", heldUs.count());
+            }
+            else
+            {
+                lg2::warning(
+                    "{KIND} callback {NAME} held the event loop for {DURATION_US} us",
+                    "KIND", toString(offender.kind), "NAME", offender.name,
+                    "DURATION_US", heldUs.count());
+            }
+        }
+    }
+
+    std::chrono::microseconds threshold{0};
+
+    /** @brief The innermost Scope being dispatched */
+    Scope* current = nullptr;
+
+    LatencyHistogram holdHistogram;
+    LatencyHistogram lagHistogram;
+    std::unordered_map<Source, StallStats, SourceHasher> stalls;
+};
+
+/** @class LoopWatchdog::Scope
+ *
+ *  Measures a callback from its construction to its destruction. Scopes
+ *  nest, the outermost scope is the dispatch of the loop.
+ */
+class LoopWatchdog::Scope
+{
+  public:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(Scope&&) = delete;
+
+    /** @brief Start measuring a callback
+     *
+     *  @param[in] source - identity of the callback
+     *  @param[in] watchdog - the watchdog recording the callback
+     */
+    explicit Scope(const Source& source,
+                   LoopWatchdog& watchdog = LoopWatchdog::getInstance())
+    {
+        if (!watchdog.isEnabled()) [[likely]]
+        {
+            return;
+        }
+        this->watchdog = &watchdog;
+        this->source = source;
+        offender = source;
+        parent = std::exchange(watchdog.current, this);
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~Scope()
+    {
+        if (!watchdog) [[likely]]
+        {
+            return;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto self = elapsed - nestedTime;
+        if (self >= offenderTime)
+        {
+            offender = source;
+            offenderTime = self;
+        }
+
+        watchdog->current = parent;
+        if (!parent)
+        {
+            watchdog->record(elapsed, offender);
+            return;
+        }
+        parent->nestedTime += elapsed;
+        if (offenderTime > parent->offenderTime)
+        {
+            parent->offender = offender;
+            parent->offenderTime = offenderTime;
+        }
+    }
+
+  private:
+    LoopWatchdog* watchdog = nullptr;
+    Scope* parent = nullptr;
+    Source source;
+    std::chrono::steady_clock::time_point start;
+
+    /** @brief Time spent in the nested scopes */
+    std::chrono::steady_clock::duration nestedTime{0};
+
+    /** @brief The callback of this scope or of a nested scope which ran the
+     *         longest by itself, and for how long
+     */
+    Source offender;
+    std::chrono::steady_clock::duration offenderTime{0};
+};
+
+/** @class LagProbe
+ *
+ *  A periodic timer recording how late the loop dispatches it, which catches
+ *  the stalls of the callbacks not measured by a Scope as well.
+ */
+class LagProbe
+{
+  public:
+    LagProbe() = delete;
+    LagProbe(const LagProbe&) = delete;
+    LagProbe& operator=(const LagProbe&) = delete;
+    LagProbe(LagProbe&&) = delete;
+    LagProbe& operator=(LagProbe&&) = delete;
+    ~LagProbe() = default;
+
+    /** @brief Start probing the loop
+     *
+     *  @param[in] event - the event loop
+     *  @param[in] interval - period of the probe
+     *  @param[in] watchdog - the watchdog recording the lag
+     */
+    LagProbe(sdeventplus::Event& event, std::chrono::microseconds interval,
+             LoopWatchdog& watchdog = LoopWatchdog::getInstance()) :
+        watchdog(watchdog), interval(interval),
+        timer(event.get(), std::bind_front(&LagProbe::probe, this))
+    {
+        expiry = std::chrono::steady_clock::now() + interval;
+        timer.start(interval, true);
+    }
+
+  private:
+    void probe()
+    {
+        auto now = std::chrono::steady_clock::now();
+        watchdog.recordLag(std::max(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - expiry),
+            std::chrono::microseconds(0)));
+        expiry = now + interval;
+    }
+
+    LoopWatchdog& watchdog;
+    std::chrono::microseconds interval;
+    std::chrono::steady_clock::time_point expiry;
+    sdbusplus::Timer timer;
+};
+
+} // namespace watchdog
+} // namespace pldm
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace loopback
+{
+
+/** @brief Largest PLDM message carried by the loopback transport */
+constexpr size_t maxMessageSize = 64 * 1024;
+
+/** The loopback transport carries PLDM messages in AF_UNIX datagrams instead
+ *  of MCTP. Every datagram starts with the EID of the terminus on the far side
+ *  of pldmd, the destination of a message sent by pldmd or the source of a
+ *  message received by it, followed by the PLDM message.
+ *
+ *  pldmd binds the base socket path. A simulated terminus binds the base path
+ *  with its EID as suffix, e.g. /tmp/pldm-loopback.9, sends its requests to
+ *  the base path and its responses to the sender of the request. An in-process
+ *  terminus rather uses one end of a socketpair().
+ */
+
+/** @struct Address
+ *
+ *  Socket address of a loopback endpoint. The length is part of the address,
+ *  as an autobound abstract address is not NUL terminated.
+ */
+struct Address
+{
+    sockaddr_un addr{}; //!< the address
+    socklen_t len = 0;  //!< its length, 0 for no address
+
+    explicit operator bool() const
+    {
+        return len != 0;
+    }
+
+    const sockaddr* get() const
+    {
+        return reinterpret_cast<const sockaddr*>(&addr);
+    }
+};
+
+/** @brief Get the socket address of a loopback endpoint
+ *
+ *  @param[in] basePath - socket path of pldmd
+ *  @param[in] eid - EID of a simulated terminus, std::nullopt for pldmd
+ *
+ *  @return the address, empty if the path does not fit into one
+ */
+inline Address endpointAddress(const std::string& basePath,
+                               std::optional<uint8_t> eid = std::nullopt)
+{
+    auto path = basePath;
+    if (eid)
+    {
+        path += "." + std::to_string(*eid);
+    }
+
+    Address address;
+    address.addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.addr.sun_path))
+    {
+        return {};
+    }
+    std::memcpy(address.addr.sun_path, path.c_str(), path.size() + 1);
+    address.len = offsetof(sockaddr_un, sun_path) + path.size() + 1;
+    return address;
+}
+
+/** @brief Create a loopback socket bound to an address
+ *
+ *  A stale socket left behind by a process which is gone is replaced. An
+ *  address used by a live process is left alone.
+ *
+ *  @param[in] address - the address, empty to autobind to an unnamed
+ *                       abstract address peers can still reply to
+ *
+ *  @return the socket, or a negative errno
+ */
+inline int bindSocket(const Address& address)
+{
+    int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        return -errno;
+    }
+
+    int rc = 0;
+    if (!address)
+    {
+        sa_family_t family = AF_UNIX;
+        rc = bind(fd, reinterpret_cast<const sockaddr*>(&family),
+                  sizeof(family));
+    }
+    else
+    {
+        rc = bind(fd, address.get(), address.len);
+        if (rc < 0 && errno == EADDRINUSE)
+        {
+            // The address is free if nobody receives on it
+            int probe = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            bool live = probe >= 0 &&
+                        connect(probe, address.get(), address.len) == 0;
+            if (probe >= 0)
+            {
+                close(probe);
+            }
+            if (!live)
+            {
+                unlink(address.addr.sun_path);
+                rc = bind(fd, address.get(), address.len);
+            }
+            else
+            {
+                errno = EADDRINUSE;
+            }
+        }
+    }
+
+    if (rc < 0)
+    {
+        rc = -errno;
+        close(fd);
+        return rc;
+    }
+    return fd;
+}
+
+/** @brief Send a PLDM message over a loopback socket
+ *
+ *  @param[in] fd - the socket
+ *  @param[in] dest - destination address, empty if the socket is connected
+ *  @param[in] eid - EID of the terminus
+ *  @param[in] msg - the PLDM message
+ *  @param[in] len - length of the message
+ *
+ *  @return PLDM_REQUESTER_SUCCESS, or PLDM_REQUESTER_SEND_FAIL
+ */
+inline pldm_requester_rc_t sendMessage(int fd, const Address& dest,
+                                       uint8_t eid, const void* msg,
+                                       size_t len)
+{
+    if (!msg || len < sizeof(pldm_msg_hdr) || len > maxMessageSize)
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+
+    iovec iov[2] = {{&eid, sizeof(eid)}, {const_cast<void*>(msg), len}};
+    msghdr hdr{};
+    if (dest)
+    {
+        hdr.msg_name = const_cast<sockaddr_un*>(&dest.addr);
+        hdr.msg_namelen = dest.len;
+    }
+    hdr.msg_iov = iov;
+    hdr.msg_iovlen = 2;
+
+    auto rc = sendmsg(fd, &hdr, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (rc != static_cast<ssize_t>(sizeof(eid) + len))
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+/** @brief Map the error of a receive on a loopback socket to a return code
+ *
+ *  @param[in] err - the errno of the receive
+ *
+ *  @return PLDM_REQUESTER_TRANSPORT_BUSY if the error is not fatal to the
+ *          socket, otherwise PLDM_REQUESTER_RECV_FAIL
+ */
+inline pldm_requester_rc_t recvError(int err)
+{
+    switch (err)
+    {
+        case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EINTR:
+        // The error of an earlier datagram to a peer which is gone, it is
+        // reported once and the socket remains usable
+        case ECONNREFUSED:
+        case ECONNRESET:
+            return PLDM_REQUESTER_TRANSPORT_BUSY;
+        default:
+            return PLDM_REQUESTER_RECV_FAIL;
+    }
+}
+
+/** @brief Receive a PLDM message from a loopback socket
+ *
+ *  @param[in] fd - the socket
+ *  @param[out] eid - EID of the terminus
+ *  @param[out] msg - the PLDM message
+ *  @param[out] src - address of the sender to reply to, empty for the peer
+ *                    of a connected socket
+ *
+ *  @return PLDM_REQUESTER_SUCCESS, PLDM_REQUESTER_TRANSPORT_BUSY if no
+ *          message was received but the socket remains usable, e.g. when no
+ *          message is pending or a peer is gone,
+ *          PLDM_REQUESTER_INVALID_RECV_LEN if the datagram is too short to
+ *          hold a PLDM message, or PLDM_REQUESTER_RECV_FAIL if the socket
+ *          failed
+ */
+inline pldm_requester_rc_t recvMessage(int fd, uint8_t& eid,
+                                       std::vector<uint8_t>& msg,
+                                       Address* src = nullptr)
+{
+    // Size the buffer to the pending datagram, rather than clearing one of
+    // the maximum message size for every message
+    auto size = recv(fd, nullptr, 0, MSG_DONTWAIT | MSG_PEEK | MSG_TRUNC);
+    if (size < 0)
+    {
+        msg.clear();
+        return recvError(errno);
+    }
+    msg.resize(std::max<size_t>(size, sizeof(eid)) - sizeof(eid));
+
+    iovec iov[2] = {{&eid, sizeof(eid)}, {msg.data(), msg.size()}};
+    Address from;
+    msghdr hdr{};
+    hdr.msg_name = &from.addr;
+    hdr.msg_namelen = sizeof(from.addr);
+    hdr.msg_iov = iov;
+    hdr.msg_iovlen = 2;
+
+    auto rc = recvmsg(fd, &hdr, MSG_DONTWAIT);
+    if (rc < 0)
+    {
+        msg.clear();
+        return recvError(errno);
+    }
+    if (static_cast<size_t>(rc) < sizeof(eid) + sizeof(pldm_msg_hdr))
+    {
+        msg.clear();
+        return PLDM_REQUESTER_INVALID_RECV_LEN;
+    }
+
+    if (src)
+    {
+        // An unnamed sender, such as the peer of a socketpair, has only the
+        // address family
+        from.len = hdr.msg_namelen > sizeof(sa_family_t) ? hdr.msg_namelen
+                                                         : 0;
+        *src = from;
+    }
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+} // namespace loopback
+} // namespace pldm
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pldm
+{
+
+/** @struct RingHeader
+ *
+ *  Header of a seqlock ring, followed by recordCount records from
+ *  ringRecordsOffset. The layout is native endian, a ring is decoded on the
+ *  machine, or the architecture, it was written on.
+ */
+struct RingHeader
+{
+    std::array<char, 8> magic; //!< identifies the records of the ring
+    uint32_t version;          //!< version of the layout of the records
+    uint32_t recordSize;       //!< size of a record
+    uint32_t recordCount;      //!< number of records
+    uint32_t reserved;
+    int64_t realtimeOffsetNs;  //!< CLOCK_REALTIME - CLOCK_MONOTONIC, in ns
+    uint64_t nextSequence;     //!< sequence number of the next record
+};
+
+static_assert(sizeof(RingHeader) == 40);
+
+/** @brief Offset of the first record in a seqlock ring */
+constexpr size_t ringRecordsOffset = 64;
+
+static_assert(sizeof(RingHeader) <= ringRecordsOffset);
+
+/** @brief Get the sequence number of a record of a seqlock ring
+ *
+ *  The records start with their uint64_t sequence number: 1 based, 0 while
+ *  the record is empty or being written. The readers may map the ring
+ *  read-only, they only load the sequence number.
+ *
+ *  @param[in] record - the record
+ *
+ *  @return an atomic reference to the sequence number of the record
+ */
+template <typename Record>
+std::atomic_ref<uint64_t> recordSequence(const Record& record)
+{
+    static_assert(std::is_standard_layout_v<Record> &&
+                  std::is_trivially_copyable_v<Record>);
+    return std::atomic_ref(
+        *reinterpret_cast<uint64_t*>(const_cast<Record*>(&record)));
+}
+
+/** @brief Read the records of a seqlock ring written since a sequence number
+ *
+ *  The ring is read without locking while it is written: a record
+ *  overwritten during the copy is skipped, so are the records already
+ *  overwritten when the reader fell more than a ring behind. The read stops
+ *  at a record still being written, it is read by the next call.
+ *
+ *  @param[in] ring - the mapped ring
+ *  @param[in] magic - magic number of the ring
+ *  @param[in] version - version of the layout of the records
+ *  @param[in,out] next - sequence number of the first record to read,
+ *                        updated to the first record not read yet
+ *
+ *  @return the complete records in the order they were written, empty if
+ *          the mapping is not a ring of this magic number and layout
+ */
+template <typename Record>
+std::vector<Record> readRingRecords(std::span<const uint8_t> ring,
+                                    const std::array<char, 8>& magic,
+                                    uint32_t version, uint64_t& next)
+{
+    std::vector<Record> records;
+    if (ring.size() < ringRecordsOffset)
+    {
+        return records;
+    }
+    auto header = reinterpret_cast<const RingHeader*>(ring.data());
+    if (header->magic != magic || header->version != version ||
+        header->recordSize != sizeof(Record) || !header->recordCount ||
+        ring.size() <
+            ringRecordsOffset + header->recordCount * sizeof(Record))
+    {
+        return records;
+    }
+    auto slots = std::span(
+        reinterpret_cast<const Record*>(ring.data() + ringRecordsOffset),
+        header->recordCount);
+
+    // std::atomic_ref of a const object is C++26, loading does not write
+    auto head = std::atomic_ref(const_cast<uint64_t&>(header->nextSequence))
+                    .load(std::memory_order_acquire);
+    auto sequence = std::max(next, head > slots.size() ? head - slots.size()
+                                                       : 0);
+    for (; sequence < head; ++sequence)
+    {
+        auto& slot = slots[sequence % slots.size()];
+        auto slotSequence = recordSequence(slot);
+        auto written = slotSequence.load(std::memory_order_acquire);
+        if (written < sequence + 1)
+        {
+            // Not written yet, the writer took the sequence number only
+            break;
+        }
+        if (written > sequence + 1)
+        {
+            continue;
+        }
+        Record record;
+        std::memcpy(&record, &slot, sizeof(record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slotSequence.load(std::memory_order_relaxed) == sequence + 1)
+        {
+            records.push_back(record);
+        }
+    }
+    next = sequence;
+    return records;
+}
+
+/** @class SeqlockRing
+ *
+ *  A ring of fixed size records preallocated in a mapping, written without
+ *  locking and without allocating memory, and read by other threads or
+ *  processes with readRingRecords(). The mapping starts with a RingHeader.
+ *  Each record is a seqlock: its sequence number is cleared while it is
+ *  written, so that the readers skip a partial record.
+ */
+template <typename Record>
+class SeqlockRing
+{
+  public:
+    SeqlockRing() = delete;
+    SeqlockRing(const SeqlockRing&) = delete;
+    SeqlockRing(SeqlockRing&&) = delete;
+    SeqlockRing& operator=(const SeqlockRing&) = delete;
+    SeqlockRing& operator=(SeqlockRing&&) = delete;
+
+    /** @brief Size of the mapping of a ring
+     *
+     *  @param[in] recordCount - number of records
+     *
+     *  @return the size in bytes
+     */
+    static constexpr size_t mapSize(size_t recordCount)
+    {
+        return ringRecordsOffset + recordCount * sizeof(Record);
+    }
+
+    /** @brief Constructor
+     *
+     *  @param[in] magic - magic number of the ring
+     *  @param[in] version - version of the layout of the records
+     *  @param[in] recordCount - number of records, 0 disables the ring
+     *  @param[in] fd - file of mapSize(recordCount) bytes shared with the
+     *                  readers, closed by the constructor, -1 to map private
+     *                  memory
+     */
+    SeqlockRing(const std::array<char, 8>& magic, uint32_t version,
+                size_t recordCount, int fd = -1)
+    {
+        if (!recordCount)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return;
+        }
+
+        size = mapSize(recordCount);
+        auto flags = fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS;
+        auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+        auto mapError = errno;
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        if (addr == MAP_FAILED)
+        {
+            lg2::error("Failed to map the {MAGIC} ring, error - {ERROR}",
+                       "MAGIC", std::string_view(magic.data(), magic.size()),
+                       "ERROR", mapError);
+            return;
+        }
+
+        base = static_cast<uint8_t*>(addr);
+        auto realtimeOffset =
+            std::chrono::system_clock::now().time_since_epoch() -
+            std::chrono::steady_clock::now().time_since_epoch();
+        header = new (base) RingHeader{
+            magic,
+            version,
+            sizeof(Record),
+            static_cast<uint32_t>(recordCount),
+            0,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                realtimeOffset)
+                .count(),
+            0};
+        records = std::span(
+            reinterpret_cast<Record*>(base + ringRecordsOffset), recordCount);
+    }
+
+    ~SeqlockRing()
+    {
+        if (base)
+        {
+            munmap(base, size);
+        }
+    }
+
+    /** @brief Check whether the ring is mapped */
+    bool enabled() const
+    {
+        return !records.empty();
+    }
+
+    /** @brief Get the mapped ring, empty if the ring is disabled */
+    std::span<const uint8_t> getMapping() const
+    {
+        return {base, base ? size : 0};
+    }
+
+    /** @brief Append a record to the ring
+     *
+     *  Concurrent writers take distinct sequence numbers. The sequence number
+     *  is taken before the record is written, the readers stop at a record
+     *  not written yet.
+     *
+     *  @param[in] fill - writes the record but its sequence number
+     */
+    template <typename Fill>
+    void push(Fill&& fill)
+    {
+        if (records.empty())
+        {
+            return;
+        }
+
+        auto sequence = std::atomic_ref(header->nextSequence)
+                            .fetch_add(1, std::memory_order_relaxed);
+        auto& record = records[sequence % records.size()];
+        auto slotSequence = recordSequence(record);
+
+        // Mark the record as being written, the readers skip it
+        slotSequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(record);
+        slotSequence.store(sequence + 1, std::memory_order_release);
+    }
+
+  private:
+    /** @brief Start of the mapped ring, the header */
+    uint8_t* base = nullptr;
+
+    /** @brief Size of the mapped ring */
+    size_t size = 0;
+
+    /** @brief Header of the ring */
+    RingHeader* header = nullptr;
+
+    /** @brief The records, empty if the ring is disabled */
+    std::span<Record> records;
+};
+
+} // namespace pldm
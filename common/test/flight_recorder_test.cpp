@@ -0,0 +1,120 @@
+#include "common/flight_recorder.hpp"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::flightrecorder;
+
+static std::vector<uint8_t> readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+class FlightRecorderTest : public ::testing::Test
+{
+  protected:
+    FlightRecorderTest()
+    {
+        static const char fileTmpl[] = "/tmp/flight_recorder.XXXXXX";
+        char fileName[sizeof(fileTmpl)] = {};
+
+        ::strncpy(fileName, fileTmpl, sizeof(fileName));
+        ::close(::mkstemp(fileName));
+        path = fileName;
+        std::filesystem::remove(path);
+    }
+
+    ~FlightRecorderTest()
+    {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + ".prev");
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_F(FlightRecorderTest, recordsWrapAround)
+{
+    {
+        FlightRecorder recorder(4, path);
+        for (uint8_t i = 0; i < 6; ++i)
+        {
+            std::vector<uint8_t> msg{0x80, 0x02, 0x11, i};
+            recorder.saveRecord(msg, i % 2, i + 8);
+        }
+    }
+
+    auto contents = readFile(path);
+    auto recording = parseRecording(contents);
+    ASSERT_TRUE(recording.has_value());
+    EXPECT_EQ(recording->header.recordCount, 4);
+    EXPECT_EQ(recording->header.nextSequence, 6);
+
+    // The oldest two records are overwritten, the rest are in order
+    ASSERT_EQ(recording->records.size(), 4);
+    uint64_t timestamp = 0;
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        const auto& [header, data] = recording->records[i];
+        uint8_t index = i + 2;
+        EXPECT_EQ(header.sequence, index + 1);
+        EXPECT_EQ(header.length, 4);
+        EXPECT_EQ(header.flags, index % 2 ? recordFlagTx : 0);
+        EXPECT_EQ(header.tid, index + 8);
+        EXPECT_EQ(data[3], index);
+        EXPECT_GE(header.timestampNs, timestamp);
+        timestamp = header.timestampNs;
+    }
+}
+
+TEST_F(FlightRecorderTest, longMessagesAreTruncated)
+{
+    {
+        FlightRecorder recorder(2, path);
+        std::vector<uint8_t> msg(recordDataSize + 100, 0x5a);
+        recorder.saveRecord(msg, true, 9);
+    }
+
+    auto contents = readFile(path);
+    auto recording = parseRecording(contents);
+    ASSERT_TRUE(recording.has_value());
+    ASSERT_EQ(recording->records.size(), 1);
+    EXPECT_EQ(recording->records[0].header.length, recordDataSize + 100);
+    EXPECT_EQ(recording->records[0].data.back(), 0x5a);
+}
+
+TEST_F(FlightRecorderTest, previousFileIsKept)
+{
+    {
+        FlightRecorder recorder(2, path);
+        std::vector<uint8_t> msg{0x80, 0x02, 0x11};
+        recorder.saveRecord(msg, true, 9);
+    }
+    FlightRecorder recorder(2, path);
+
+    auto previous = readFile(path.string() + ".prev");
+    auto recording = parseRecording(previous);
+    ASSERT_TRUE(recording.has_value());
+    EXPECT_EQ(recording->records.size(), 1);
+
+    auto current = readFile(path);
+    recording = parseRecording(current);
+    ASSERT_TRUE(recording.has_value());
+    EXPECT_TRUE(recording->records.empty());
+}
+
+TEST(FlightRecorder, invalidFileIsRejected)
+{
+    std::vector<uint8_t> contents(recordSlotsOffset + recordSlotSize);
+    EXPECT_FALSE(parseRecording(contents).has_value());
+    EXPECT_FALSE(parseRecording({}).has_value());
+}
@@ -0,0 +1,156 @@
+#include "common/instance_id.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+constexpr uint8_t tid = 9;
+
+class InstanceIdLeaseTest : public ::testing::Test
+{
+  protected:
+    InstanceIdLeaseTest() : dbPath(createDb()), leased(dbPath), other(dbPath)
+    {}
+
+    ~InstanceIdLeaseTest()
+    {
+        std::filesystem::remove(dbPath);
+    }
+
+    static std::filesystem::path createDb()
+    {
+        static const char dbTmpl[] = "/tmp/db.XXXXXX";
+        char dbName[sizeof(dbTmpl)] = {};
+
+        ::strncpy(dbName, dbTmpl, sizeof(dbName));
+        ::close(::mkstemp(dbName));
+
+        std::filesystem::path path(dbName);
+        std::filesystem::resize_file(
+            path, static_cast<uintmax_t>(PLDM_MAX_TIDS) *
+                      InstanceIdDb::maxInstanceIds);
+        return path;
+    }
+
+    /** @brief Allocate instance IDs from the other database until it runs
+     *         out, the IDs stay allocated
+     */
+    std::set<uint8_t> exhaustOther()
+    {
+        std::set<uint8_t> ids;
+        try
+        {
+            while (true)
+            {
+                ids.emplace(other.next(tid));
+            }
+        }
+        catch (const std::runtime_error&)
+        {}
+        return ids;
+    }
+
+    std::filesystem::path dbPath;
+    InstanceIdDb leased;
+    InstanceIdDb other;
+};
+
+TEST_F(InstanceIdLeaseTest, leasedIdsAreReservedInDb)
+{
+    leased.enableLeases(4);
+    auto id = leased.next(tid);
+    EXPECT_EQ(leased.getLeasedCount(tid), 4);
+
+    // Another user of the database never gets a leased ID
+    auto otherIds = exhaustOther();
+    EXPECT_EQ(otherIds.size(), InstanceIdDb::maxInstanceIds - 4);
+    EXPECT_FALSE(otherIds.contains(id));
+
+    // The rest of the lease is handed out from memory
+    std::set<uint8_t> leasedIds{id};
+    for (int i = 0; i < 3; ++i)
+    {
+        leasedIds.emplace(leased.next(tid));
+    }
+    EXPECT_EQ(leasedIds.size(), 4);
+    for (auto leasedId : leasedIds)
+    {
+        EXPECT_FALSE(otherIds.contains(leasedId));
+    }
+    EXPECT_THROW(leased.next(tid), std::runtime_error);
+}
+
+TEST_F(InstanceIdLeaseTest, freedIdsStayLeased)
+{
+    leased.enableLeases(4);
+    auto first = leased.next(tid);
+    leased.free(tid, first);
+    EXPECT_EQ(leased.getLeasedCount(tid), 4);
+
+    // Freed IDs are not reused right away
+    EXPECT_NE(leased.next(tid), first);
+
+    // Freeing an ID which is not handed out is still an error
+    EXPECT_THROW(leased.free(tid, first), std::runtime_error);
+}
+
+TEST_F(InstanceIdLeaseTest, idleLeasesAreReleased)
+{
+    leased.enableLeases(4, 0ms);
+    auto id = leased.next(tid);
+    leased.next(tid);
+
+    // IDs in use survive the expiry of the lease
+    leased.releaseExpiredLeases();
+    EXPECT_EQ(leased.getLeasedCount(tid), 2);
+
+    leased.free(tid, id);
+    leased.releaseExpiredLeases();
+    EXPECT_EQ(leased.getLeasedCount(tid), 1);
+    EXPECT_EQ(exhaustOther().size(), InstanceIdDb::maxInstanceIds - 1);
+}
+
+TEST_F(InstanceIdLeaseTest, grownLeasesAreTrimmed)
+{
+    leased.enableLeases(4, 1h);
+    std::vector<uint8_t> ids;
+    for (int i = 0; i < 10; ++i)
+    {
+        ids.emplace_back(leased.next(tid));
+    }
+    EXPECT_EQ(leased.getLeasedCount(tid), 12);
+    for (size_t i = 0; i < ids.size() - 1; ++i)
+    {
+        leased.free(tid, ids[i]);
+    }
+
+    // The lease is not idle, it keeps one block besides the ID in use
+    leased.releaseExpiredLeases();
+    EXPECT_EQ(leased.getLeasedCount(tid), 5);
+    EXPECT_EQ(exhaustOther().size(), InstanceIdDb::maxInstanceIds - 5);
+
+    // The IDs kept are handed out from memory
+    for (int i = 0; i < 4; ++i)
+    {
+        leased.next(tid);
+    }
+    EXPECT_EQ(leased.getLeasedCount(tid), 5);
+}
+
+TEST_F(InstanceIdLeaseTest, leasesAreDisabledByDefault)
+{
+    auto id = leased.next(tid);
+    EXPECT_EQ(leased.getLeasedCount(tid), 0);
+    EXPECT_EQ(exhaustOther().size(), InstanceIdDb::maxInstanceIds - 1);
+    leased.free(tid, id);
+}
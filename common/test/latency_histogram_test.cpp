@@ -0,0 +1,60 @@
+#include "common/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono;
+
+TEST(LatencyHistogram, bucketBounds)
+{
+    // Every value falls into the bucket whose bounds enclose it
+    for (uint64_t value : std::initializer_list<uint64_t>{
+             0, 1, 31, 32, 33, 63, 64, 100, 1000, 123456,
+             LatencyHistogram::maxTrackable})
+    {
+        auto idx = LatencyHistogram::bucketIndex(value);
+        EXPECT_LT(idx, LatencyHistogram::numBuckets);
+        EXPECT_LE(LatencyHistogram::bucketLowerBound(idx), value);
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(idx), value);
+    }
+
+    // Buckets are contiguous and at most 1/16th of their lower bound wide
+    for (size_t idx = 1; idx < LatencyHistogram::numBuckets; ++idx)
+    {
+        auto lower = LatencyHistogram::bucketLowerBound(idx);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(idx - 1) + 1, lower);
+        EXPECT_EQ(LatencyHistogram::bucketIndex(lower), idx);
+        if (idx + 1 < LatencyHistogram::numBuckets)
+        {
+            EXPECT_LE(LatencyHistogram::bucketUpperBound(idx) - lower,
+                      lower / LatencyHistogram::subBucketCount);
+        }
+    }
+}
+
+TEST(LatencyHistogram, percentiles)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getPercentile(50), microseconds(0));
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        histogram.record(microseconds(i));
+    }
+    histogram.record(seconds(100));
+
+    EXPECT_EQ(histogram.count, 1001);
+    EXPECT_EQ(histogram.min, 1);
+    EXPECT_EQ(histogram.max, LatencyHistogram::maxTrackable);
+    EXPECT_EQ(histogram.getPercentile(0), microseconds(1));
+    EXPECT_EQ(histogram.getPercentile(100),
+              microseconds(LatencyHistogram::maxTrackable));
+
+    // Percentiles are within the precision of the buckets
+    auto p50 = histogram.getPercentile(50).count();
+    EXPECT_GE(p50, 500);
+    EXPECT_LE(p50, 500 + 500 / 16);
+    auto p99 = histogram.getPercentile(99).count();
+    EXPECT_GE(p99, 990);
+    EXPECT_LE(p99, 990 + 990 / 16);
+}
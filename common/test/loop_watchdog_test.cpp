@@ -0,0 +1,105 @@
+#include "common/loop_watchdog.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::watchdog;
+using namespace std::chrono_literals;
+
+TEST(LoopWatchdog, disabledRecordsNothing)
+{
+    LoopWatchdog watchdog;
+    EXPECT_FALSE(watchdog.isEnabled());
+    {
+        LoopWatchdog::Scope scope(
+            {.kind = SourceKind::Timer, .name = "Test"}, watchdog);
+        std::this_thread::sleep_for(2ms);
+    }
+    EXPECT_EQ(watchdog.getHoldTimes().count, 0);
+    EXPECT_TRUE(watchdog.getTopStalls(10).empty());
+}
+
+TEST(LoopWatchdog, stallAttributedToNestedCallback)
+{
+    LoopWatchdog watchdog;
+    watchdog.setThreshold(1ms);
+
+    Source receive{.kind = SourceKind::IO, .name = "Receive"};
+    Source fast{SourceKind::Command, 9, PLDM_BASE, PLDM_GET_TID};
+    Source slow{SourceKind::Response, 9, PLDM_PLATFORM, PLDM_GET_PDR};
+    {
+        LoopWatchdog::Scope outer(receive, watchdog);
+        {
+            LoopWatchdog::Scope inner(fast, watchdog);
+        }
+        {
+            LoopWatchdog::Scope inner(slow, watchdog);
+            std::this_thread::sleep_for(5ms);
+        }
+    }
+    {
+        // A dispatch within the threshold is not a stall
+        LoopWatchdog::Scope outer(receive, watchdog);
+    }
+
+    EXPECT_EQ(watchdog.getHoldTimes().count, 2);
+    auto top = watchdog.getTopStalls(10);
+    ASSERT_EQ(top.size(), 1);
+    EXPECT_EQ(top[0].first, slow);
+    EXPECT_EQ(top[0].second.stalls, 1);
+    EXPECT_GE(top[0].second.maxUs, 5000);
+    EXPECT_EQ(top[0].second.totalUs, top[0].second.maxUs);
+}
+
+TEST(LoopWatchdog, topStallsSortedByTotalTime)
+{
+    LoopWatchdog watchdog;
+    watchdog.setThreshold(1ms);
+
+    Source once{.kind = SourceKind::Timer, .name = "Once"};
+    Source twice{.kind = SourceKind::Match, .name = "Twice"};
+    Source never{.kind = SourceKind::Match, .name = "Never"};
+    for (const auto& source : {once, twice, twice})
+    {
+        LoopWatchdog::Scope scope(source, watchdog);
+        std::this_thread::sleep_for(3ms);
+    }
+    {
+        LoopWatchdog::Scope scope(never, watchdog);
+    }
+
+    auto top = watchdog.getTopStalls(1);
+    ASSERT_EQ(top.size(), 1);
+    EXPECT_EQ(top[0].first, twice);
+    EXPECT_EQ(top[0].second.stalls, 2);
+    EXPECT_EQ(watchdog.getTopStalls(10).size(), 2);
+
+    watchdog.reset();
+    EXPECT_EQ(watchdog.getHoldTimes().count, 0);
+    EXPECT_TRUE(watchdog.getTopStalls(10).empty());
+}
+
+TEST(LoopWatchdog, wrappedCallback)
+{
+    auto& watchdog = LoopWatchdog::getInstance();
+    watchdog.setThreshold(1ms);
+
+    auto callback = LoopWatchdog::wrap(
+        {.kind = SourceKind::Match, .name = "Wrapped"}, [](int value) {
+            std::this_thread::sleep_for(2ms);
+            return value + 1;
+        });
+    EXPECT_EQ(callback(41), 42);
+
+    auto top = watchdog.getTopStalls(10);
+    ASSERT_EQ(top.size(), 1);
+    EXPECT_EQ(top[0].first.name, "Wrapped");
+
+    watchdog.setThreshold(0ms);
+    watchdog.reset();
+}
@@ -0,0 +1,177 @@
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+
+#include <libpldm/base.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+constexpr uint8_t terminusEid = 9;
+
+static std::vector<uint8_t> makeMsg(uint8_t instanceId, MessageType msgType,
+                                    uint8_t command, uint8_t payload)
+{
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + 1);
+    pldm_header_info header{};
+    header.msg_type = msgType;
+    header.instance = instanceId;
+    header.pldm_type = PLDM_BASE;
+    header.command = command;
+    pack_pldm_header(&header, reinterpret_cast<pldm_msg_hdr*>(msg.data()));
+    msg.back() = payload;
+    return msg;
+}
+
+class LoopbackTransportTest : public ::testing::Test
+{
+  protected:
+    LoopbackTransportTest() : transport(createPair())
+    {}
+
+    ~LoopbackTransportTest()
+    {
+        close(terminusFd);
+    }
+
+    int createPair()
+    {
+        int fds[2] = {-1, -1};
+        socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, fds);
+        terminusFd = fds[1];
+        return fds[0];
+    }
+
+    int terminusFd = -1;
+    PldmTransport transport;
+};
+
+TEST_F(LoopbackTransportTest, exchangeMessages)
+{
+    auto request = makeMsg(1, PLDM_REQUEST, PLDM_GET_TID, 0);
+    EXPECT_FALSE(transport.hasPendingMsg());
+    ASSERT_EQ(transport.sendMsg(terminusEid, request.data(), request.size()),
+              PLDM_REQUESTER_SUCCESS);
+
+    uint8_t eid = 0;
+    std::vector<uint8_t> received;
+    ASSERT_EQ(loopback::recvMessage(terminusFd, eid, received),
+              PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(eid, terminusEid);
+    EXPECT_EQ(received, request);
+
+    auto response = makeMsg(1, PLDM_RESPONSE, PLDM_GET_TID, PLDM_SUCCESS);
+    ASSERT_EQ(loopback::sendMessage(terminusFd, {}, terminusEid,
+                                    response.data(), response.size()),
+              PLDM_REQUESTER_SUCCESS);
+    EXPECT_TRUE(transport.hasPendingMsg());
+
+    pldm_tid_t tid = 0;
+    void* rx = nullptr;
+    size_t rxLen = 0;
+    ASSERT_EQ(transport.recvMsg(tid, rx, rxLen), PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(tid, terminusEid);
+    EXPECT_EQ(std::vector<uint8_t>(static_cast<uint8_t*>(rx),
+                                   static_cast<uint8_t*>(rx) + rxLen),
+              response);
+    free(rx);
+    EXPECT_FALSE(transport.hasPendingMsg());
+}
+
+TEST_F(LoopbackTransportTest, nothingPendingIsNotFatal)
+{
+    // A wakeup without a message does not fail the transport
+    pldm_tid_t tid = 0;
+    void* rx = nullptr;
+    size_t rxLen = 0;
+    EXPECT_EQ(transport.recvMsg(tid, rx, rxLen),
+              PLDM_REQUESTER_TRANSPORT_BUSY);
+
+    uint8_t eid = 0;
+    std::vector<uint8_t> received;
+    EXPECT_EQ(loopback::recvMessage(terminusFd, eid, received),
+              PLDM_REQUESTER_TRANSPORT_BUSY);
+
+    // Nor does the error of a datagram to a peer which is gone
+    EXPECT_EQ(loopback::recvError(ECONNREFUSED),
+              PLDM_REQUESTER_TRANSPORT_BUSY);
+    EXPECT_EQ(loopback::recvError(EBADF), PLDM_REQUESTER_RECV_FAIL);
+    EXPECT_EQ(loopback::recvMessage(-1, eid, received),
+              PLDM_REQUESTER_RECV_FAIL);
+}
+
+TEST_F(LoopbackTransportTest, sendRecvSkipsOtherMessages)
+{
+    // A request of the terminus and a response to another request are
+    // pending before the response to the exchange
+    auto other = makeMsg(2, PLDM_REQUEST, PLDM_GET_TID, 0);
+    auto stale = makeMsg(0, PLDM_RESPONSE, PLDM_GET_TID, PLDM_SUCCESS);
+    auto response = makeMsg(1, PLDM_RESPONSE, PLDM_GET_TID, PLDM_SUCCESS);
+    for (const auto& msg : {other, stale, response})
+    {
+        ASSERT_EQ(loopback::sendMessage(terminusFd, {}, terminusEid,
+                                        msg.data(), msg.size()),
+                  PLDM_REQUESTER_SUCCESS);
+    }
+
+    auto request = makeMsg(1, PLDM_REQUEST, PLDM_GET_TID, 0);
+    void* rx = nullptr;
+    size_t rxLen = 0;
+    ASSERT_EQ(transport.sendRecvMsg(terminusEid, request.data(),
+                                    request.size(), rx, rxLen),
+              PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(std::vector<uint8_t>(static_cast<uint8_t*>(rx),
+                                   static_cast<uint8_t*>(rx) + rxLen),
+              response);
+    free(rx);
+}
+
+TEST(LoopbackSocket, staleSocketIsReplaced)
+{
+    auto path = std::filesystem::temp_directory_path() /
+                ("pldm-loopback-test." + std::to_string(getpid()));
+    auto address = loopback::endpointAddress(path, terminusEid);
+    ASSERT_TRUE(address);
+
+    int live = loopback::bindSocket(address);
+    ASSERT_GE(live, 0);
+    EXPECT_EQ(loopback::bindSocket(address), -EADDRINUSE);
+
+    // The socket file outlives its process
+    close(live);
+    int fd = loopback::bindSocket(address);
+    EXPECT_GE(fd, 0);
+
+    // Messages to the path reach the socket
+    auto msg = makeMsg(3, PLDM_REQUEST, PLDM_GET_TID, 0);
+    int sender = loopback::bindSocket({});
+    ASSERT_GE(sender, 0);
+    EXPECT_EQ(
+        loopback::sendMessage(sender, address, 8, msg.data(), msg.size()),
+        PLDM_REQUESTER_SUCCESS);
+
+    uint8_t eid = 0;
+    std::vector<uint8_t> received;
+    loopback::Address src;
+    EXPECT_EQ(loopback::recvMessage(fd, eid, received, &src),
+              PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(eid, 8);
+    EXPECT_EQ(received, msg);
+
+    // The unnamed sender can be replied to
+    EXPECT_TRUE(src);
+    EXPECT_EQ(loopback::sendMessage(fd, src, 8, msg.data(), msg.size()),
+              PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(loopback::recvMessage(sender, eid, received),
+              PLDM_REQUESTER_SUCCESS);
+
+    close(sender);
+    close(fd);
+    unlink(address.addr.sun_path);
+}
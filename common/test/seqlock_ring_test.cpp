@@ -0,0 +1,76 @@
+#include "common/seqlock_ring.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+namespace
+{
+
+struct TestRecord
+{
+    uint64_t sequence;
+    uint64_t value;
+};
+
+constexpr std::array<char, 8> testMagic = {'P', 'L', 'D', 'M',
+                                           'T', 'E', 'S', 'T'};
+
+} // namespace
+
+TEST(SeqlockRing, header)
+{
+    SeqlockRing<TestRecord> ring(testMagic, 3, 4);
+    ASSERT_TRUE(ring.enabled());
+
+    auto mapping = ring.getMapping();
+    ASSERT_EQ(mapping.size(), SeqlockRing<TestRecord>::mapSize(4));
+    auto header = reinterpret_cast<const RingHeader*>(mapping.data());
+    EXPECT_EQ(header->magic, testMagic);
+    EXPECT_EQ(header->version, 3);
+    EXPECT_EQ(header->recordSize, sizeof(TestRecord));
+    EXPECT_EQ(header->recordCount, 4);
+    EXPECT_EQ(header->nextSequence, 0);
+
+    uint64_t next = 0;
+    EXPECT_TRUE(readRingRecords<TestRecord>(mapping, testMagic, 2, next)
+                    .empty());
+}
+
+TEST(SeqlockRing, disabled)
+{
+    SeqlockRing<TestRecord> ring(testMagic, 1, 0);
+    EXPECT_FALSE(ring.enabled());
+    EXPECT_TRUE(ring.getMapping().empty());
+    ring.push([](TestRecord&) { FAIL(); });
+}
+
+TEST(SeqlockRing, readStopsAtRecordBeingWritten)
+{
+    SeqlockRing<TestRecord> ring(testMagic, 1, 4);
+    ring.push([](TestRecord& record) { record.value = 10; });
+
+    uint64_t next = 0;
+    std::vector<TestRecord> records;
+    ring.push([&](TestRecord& record) {
+        // The sequence number is taken, the record is not written yet
+        records = readRingRecords<TestRecord>(ring.getMapping(), testMagic, 1,
+                                              next);
+        record.value = 11;
+    });
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].sequence, 1);
+    EXPECT_EQ(records[0].value, 10);
+    EXPECT_EQ(next, 1);
+
+    records = readRingRecords<TestRecord>(ring.getMapping(), testMagic, 1,
+                                          next);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].sequence, 2);
+    EXPECT_EQ(records[0].value, 11);
+    EXPECT_EQ(next, 2);
+}
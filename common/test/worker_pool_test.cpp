@@ -0,0 +1,149 @@
+#include "common/worker_pool.hpp"
+
+#include <sdbusplus/async.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+/** @brief Run the event loop until the predicate holds or a timeout */
+template <typename Predicate>
+static bool runUntil(sdeventplus::Event& event, Predicate&& predicate)
+{
+    for (int i = 0; i < 100 && !predicate(); ++i)
+    {
+        event.run(std::chrono::milliseconds(50));
+    }
+    return predicate();
+}
+
+static exec::task<void> runOnPool(WorkerPool& pool, std::thread::id& worker,
+                                  int& result)
+{
+    result = co_await pool.run([&worker] {
+        worker = std::this_thread::get_id();
+        return 42;
+    });
+}
+
+TEST(WorkerPool, completionsRunOnEventLoop)
+{
+    auto event = sdeventplus::Event::get_default();
+    WorkerPool pool(event, 2);
+    auto mainThread = std::this_thread::get_id();
+
+    constexpr size_t numJobs = 8;
+    std::atomic<size_t> workDone = 0;
+    size_t completed = 0;
+    for (size_t i = 0; i < numJobs; ++i)
+    {
+        EXPECT_TRUE(pool.post(
+            [&] {
+                EXPECT_NE(std::this_thread::get_id(), mainThread);
+                workDone++;
+            },
+            [&] {
+                EXPECT_EQ(std::this_thread::get_id(), mainThread);
+                completed++;
+            }));
+    }
+
+    ASSERT_TRUE(runUntil(event, [&] { return completed == numJobs; }));
+    EXPECT_EQ(workDone, numJobs);
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.workers, 2);
+    EXPECT_EQ(stats.submitted, numJobs);
+    EXPECT_EQ(stats.completed, numJobs);
+    EXPECT_EQ(stats.queueDepth, 0);
+    EXPECT_EQ(stats.busyWorkers, 0);
+    EXPECT_EQ(stats.rejected, 0);
+}
+
+TEST(WorkerPool, queueIsBounded)
+{
+    auto event = sdeventplus::Event::get_default();
+    WorkerPool pool(event, 1, 1);
+
+    std::promise<void> gate;
+    auto released = gate.get_future().share();
+    size_t completed = 0;
+    auto blocked = [released] { released.wait(); };
+    auto done = [&completed] { completed++; };
+
+    // The first job occupies the only worker, the second one fills the queue
+    EXPECT_TRUE(pool.post(blocked, done));
+    for (int i = 0; i < 100 && !pool.getStats().busyWorkers; ++i)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(pool.post(blocked, done));
+    EXPECT_FALSE(pool.post(blocked, done));
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.busyWorkers, 1);
+    EXPECT_EQ(stats.queueDepth, 1);
+    EXPECT_EQ(stats.maxQueueDepth, 1);
+    EXPECT_EQ(stats.rejected, 1);
+
+    gate.set_value();
+    ASSERT_TRUE(runUntil(event, [&] { return completed == 2; }));
+    EXPECT_GT(pool.getStats().utilization, 0);
+}
+
+TEST(WorkerPool, coroutineResumesWithResult)
+{
+    auto event = sdeventplus::Event::get_default();
+    WorkerPool pool(event, 1);
+    exec::async_scope scope;
+
+    std::thread::id worker;
+    int result = 0;
+    scope.spawn(runOnPool(pool, worker, result),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+
+    ASSERT_TRUE(runUntil(event, [&] { return result == 42; }));
+    EXPECT_NE(worker, std::this_thread::get_id());
+    EXPECT_EQ(pool.getStats().completed, 1);
+}
+
+TEST(WorkerPool, stopRunsQueuedJobs)
+{
+    auto event = sdeventplus::Event::get_default();
+    WorkerPool pool(event, 1);
+    exec::async_scope scope;
+
+    constexpr size_t numJobs = 4;
+    std::atomic<size_t> workDone = 0;
+    size_t completed = 0;
+    for (size_t i = 0; i < numJobs; ++i)
+    {
+        EXPECT_TRUE(pool.post([&] { workDone++; }, [&] { completed++; }));
+    }
+    std::thread::id worker;
+    int result = 0;
+    scope.spawn(runOnPool(pool, worker, result),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+
+    // Without running the event loop, stopping the pool runs the queued jobs
+    // and their completions, and resumes the awaiting coroutine
+    pool.stop();
+    EXPECT_EQ(workDone, numJobs);
+    EXPECT_EQ(completed, numJobs);
+    EXPECT_EQ(result, 42);
+
+    // A stopped pool refuses jobs, an awaiter runs its callable in place
+    EXPECT_FALSE(pool.post([] {}, [] {}));
+    EXPECT_EQ(pool.getStats().rejected, 0);
+    result = 0;
+    scope.spawn(runOnPool(pool, worker, result),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+    EXPECT_EQ(result, 42);
+    EXPECT_EQ(worker, std::this_thread::get_id());
+}
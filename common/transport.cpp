@@ -1,10 +1,16 @@
 #include "common/transport.hpp"
 
+#include "common/loopback.hpp"
+
 #include <libpldm/transport.h>
 #include <libpldm/transport/af-mctp.h>
 #include <libpldm/transport/mctp-demux.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <ranges>
 #include <system_error>
 
@@ -100,7 +106,49 @@ static constexpr uint8_t MCTP_EID_VALID_MAX = 255;
     return pldmTransport;
 }
 
-struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd)
+/*
+ * The loopback transport carries the messages over AF_UNIX datagram sockets,
+ * see common/loopback.hpp. pldmd receives on the well-known socket path, and
+ * fails if another live process holds it rather than silently receiving
+ * nothing. Any other process using the transport, such as pldmtool, receives
+ * on an unnamed socket, the termini reply to the sender of a request.
+ */
+[[maybe_unused]] static int
+    pldm_transport_impl_loopback_init(pollfd& pollfd, LoopbackEndpoint endpoint)
+{
+    int fd = -ENAMETOOLONG;
+    if (endpoint == LoopbackEndpoint::Daemon)
+    {
+        auto address = pldm::loopback::endpointAddress(LOOPBACK_SOCKET_PATH);
+        if (address)
+        {
+            fd = pldm::loopback::bindSocket(address);
+        }
+    }
+    else
+    {
+        fd = pldm::loopback::bindSocket({});
+    }
+    if (fd == -EADDRINUSE)
+    {
+        throw std::system_error(EADDRINUSE, std::generic_category(),
+                                "The PLDM loopback socket " LOOPBACK_SOCKET_PATH
+                                " is held by another process");
+    }
+    if (fd < 0)
+    {
+        throw std::system_error(-fd, std::generic_category(),
+                                "Failed to bind the PLDM loopback socket");
+    }
+
+    pollfd.fd = fd;
+    pollfd.events = POLLIN;
+    pollfd.revents = 0;
+    return fd;
+}
+
+struct pldm_transport* transport_impl_init([[maybe_unused]] TransportImpl& impl,
+                                           [[maybe_unused]] pollfd& pollfd)
 {
 #if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
     return pldm_transport_impl_mctp_demux_init(impl, pollfd);
@@ -111,7 +159,7 @@ struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd)
 #endif
 }
 
-void transport_impl_destroy(TransportImpl& impl)
+void transport_impl_destroy([[maybe_unused]] TransportImpl& impl)
 {
 #if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
     pldm_transport_mctp_demux_destroy(impl.mctp_demux);
@@ -120,17 +168,31 @@ void transport_impl_destroy(TransportImpl& impl)
 #endif
 }
 
-PldmTransport::PldmTransport()
+PldmTransport::PldmTransport([[maybe_unused]] LoopbackEndpoint endpoint)
 {
+#if defined(PLDM_TRANSPORT_WITH_LOOPBACK)
+    loopbackFd = pldm_transport_impl_loopback_init(pfd, endpoint);
+#else
     transport = transport_impl_init(impl, pfd);
     if (!transport)
     {
         throw std::system_error(ENOMEM, std::generic_category());
     }
+#endif
 }
 
+PldmTransport::PldmTransport(int loopbackFd) :
+    pfd{loopbackFd, POLLIN, 0}, loopbackFd(loopbackFd),
+    loopbackConnected(true)
+{}
+
 PldmTransport::~PldmTransport()
 {
+    if (loopbackFd >= 0)
+    {
+        close(loopbackFd);
+        return;
+    }
     transport_impl_destroy(impl);
 }
 
@@ -142,17 +204,118 @@ int PldmTransport::getEventSource() const
 pldm_requester_rc_t PldmTransport::sendMsg(pldm_tid_t tid, const void* tx,
                                            size_t len)
 {
+    if (loopbackFd >= 0)
+    {
+        return pldm::loopback::sendMessage(
+            loopbackFd,
+            loopbackConnected
+                ? pldm::loopback::Address{}
+                : pldm::loopback::endpointAddress(LOOPBACK_SOCKET_PATH, tid),
+            tid, tx, len);
+    }
     return pldm_transport_send_msg(transport, tid, tx, len);
 }
 
 pldm_requester_rc_t PldmTransport::recvMsg(pldm_tid_t& tid, void*& rx,
                                            size_t& len)
 {
+    if (loopbackFd >= 0)
+    {
+        return recvLoopbackMsg(tid, rx, len);
+    }
     return pldm_transport_recv_msg(transport, &tid, (void**)&rx, &len);
 }
 
+pldm_requester_rc_t PldmTransport::recvLoopbackMsg(pldm_tid_t& tid, void*& rx,
+                                                   size_t& len)
+{
+    uint8_t eid = 0;
+    auto rc = pldm::loopback::recvMessage(loopbackFd, eid, loopbackBuffer);
+    if (rc != PLDM_REQUESTER_SUCCESS)
+    {
+        return rc;
+    }
+
+    rx = malloc(loopbackBuffer.size());
+    if (!rx)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    std::memcpy(rx, loopbackBuffer.data(), loopbackBuffer.size());
+    len = loopbackBuffer.size();
+    tid = eid;
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+bool PldmTransport::hasPendingMsg() const
+{
+    pollfd readiness = pfd;
+    readiness.revents = 0;
+    return poll(&readiness, 1, 0) > 0 && (readiness.revents & POLLIN);
+}
+
 pldm_requester_rc_t PldmTransport::sendRecvMsg(
     pldm_tid_t tid, const void* tx, size_t txLen, void*& rx, size_t& rxLen)
 {
-    return pldm_transport_send_recv_msg(transport, tid, tx, txLen, &rx, &rxLen);
+    if (loopbackFd < 0)
+    {
+        return pldm_transport_send_recv_msg(transport, tid, tx, txLen, &rx,
+                                            &rxLen);
+    }
+
+    if (!tx || txLen < sizeof(pldm_msg_hdr))
+    {
+        return PLDM_REQUESTER_NOT_REQ_MSG;
+    }
+    auto rc = sendMsg(tid, tx, txLen);
+    if (rc != PLDM_REQUESTER_SUCCESS)
+    {
+        return rc;
+    }
+
+    /* Wait for the response to the request, dropping any other message, as
+     * pldm_transport_send_recv_msg() does */
+    auto request = static_cast<const pldm_msg_hdr*>(tx);
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL);
+    while (true)
+    {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        pollfd readiness = pfd;
+        readiness.revents = 0;
+        int ret = poll(&readiness, 1, remaining.count());
+        if (ret < 0 && errno != EINTR)
+        {
+            return PLDM_REQUESTER_POLL_FAIL;
+        }
+        if (ret <= 0)
+        {
+            continue;
+        }
+
+        pldm_tid_t rxTid = 0;
+        void* rxMsg = nullptr;
+        size_t rxMsgLen = 0;
+        if (recvLoopbackMsg(rxTid, rxMsg, rxMsgLen) != PLDM_REQUESTER_SUCCESS)
+        {
+            continue;
+        }
+        auto response = static_cast<const pldm_msg_hdr*>(rxMsg);
+        if (rxTid == tid && !response->request &&
+            response->instance_id == request->instance_id &&
+            response->type == request->type &&
+            response->command == request->command)
+        {
+            rx = rxMsg;
+            rxLen = rxMsgLen;
+            return PLDM_REQUESTER_SUCCESS;
+        }
+        free(rxMsg);
+    }
 }
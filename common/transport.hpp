@@ -5,6 +5,7 @@
 #include <poll.h>
 
 #include <cstddef>
+#include <vector>
 
 struct pldm_transport_mctp_demux;
 struct pldm_transport_af_mctp;
@@ -15,11 +16,33 @@ union TransportImpl
     struct pldm_transport_af_mctp* af_mctp;
 };
 
+/** @brief The socket a loopback transport receives on */
+enum class LoopbackEndpoint
+{
+    Client, //!< an unnamed socket, the termini reply to the sender
+    Daemon, //!< the well-known socket path of pldmd
+};
+
 /* RAII for pldm_transport */
 class PldmTransport
 {
   public:
-    PldmTransport();
+    /** @brief Create the transport selected at build time
+     *
+     * @param[in] endpoint - the socket of a loopback transport, pldmd fails
+     *                       to start if another process holds its path
+     */
+    explicit PldmTransport(
+        LoopbackEndpoint endpoint = LoopbackEndpoint::Client);
+
+    /** @brief Create a loopback transport on a connected AF_UNIX datagram
+     *         socket, one end of a socketpair() whose other end is used by an
+     *         in-process terminus
+     *
+     * @param[in] loopbackFd - the socket, owned by the transport
+     */
+    explicit PldmTransport(int loopbackFd);
+
     PldmTransport(const PldmTransport& other) = delete;
     PldmTransport(const PldmTransport&& other) = delete;
     PldmTransport& operator=(const PldmTransport& other) = delete;
@@ -62,6 +85,12 @@ class PldmTransport
      */
     pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx, size_t& len);
 
+    /** @brief Check without blocking whether a message is ready to be received
+     *
+     * @return true if a call to recvMsg() will immediately yield a message
+     */
+    bool hasPendingMsg() const;
+
     /** @brief Synchronously exchange a request and response with the specified
      * terminus.
      *
@@ -89,6 +118,12 @@ class PldmTransport
                                     size_t txLen, void*& rx, size_t& rxLen);
 
   private:
+    /** @brief Receive a message from the loopback socket into a buffer
+     *         allocated with malloc(), as libpldm does
+     */
+    pldm_requester_rc_t recvLoopbackMsg(pldm_tid_t& tid, void*& rx,
+                                        size_t& len);
+
     /** @brief A pollfd object for holding a file descriptor from the libpldm
      *         transport implementation
      */
@@ -102,5 +137,17 @@ class PldmTransport
     /** @brief The abstract libpldm transport object for sending and receiving
      *         PLDM messages.
      */
-    struct pldm_transport* transport;
+    struct pldm_transport* transport = nullptr;
+
+    /** @brief The socket of the loopback transport, -1 for an MCTP transport
+     */
+    int loopbackFd = -1;
+
+    /** @brief The loopback socket is connected to its only peer, otherwise
+     *         messages are addressed to the socket of each terminus
+     */
+    bool loopbackConnected = false;
+
+    /** @brief Receive buffer of the loopback transport */
+    std::vector<uint8_t> loopbackBuffer;
 };
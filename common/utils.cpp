@@ -311,66 +311,74 @@ void reportError(const char* errorMsg)
 void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
                                   const PropertyValue& value) const
 {
-    auto setDbusValue = [&dBusMap, this](const auto& variant) {
-        auto& bus = getBus();
-        auto service =
-            getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
-        auto method = bus.new_method_call(
-            service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
-        method.append(dBusMap.interface.c_str(), dBusMap.propertyName.c_str(),
-                      variant);
-        bus.call_noreply(method, dbusTimeout);
+    auto& bus = getBus();
+    auto service =
+        getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
+    auto method = newSetPropertyCall(bus, service, dBusMap, value);
+    bus.call_noreply(method, dbusTimeout);
+}
+
+sdbusplus::message_t newSetPropertyCall(sdbusplus::bus_t& bus,
+                                        const std::string& service,
+                                        const DBusMapping& dBusMap,
+                                        const PropertyValue& value)
+{
+    auto method = bus.new_method_call(
+        service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
+    method.append(dBusMap.interface.c_str(), dBusMap.propertyName.c_str());
+    auto appendValue = [&method](const auto& variant) {
+        method.append(variant);
     };
 
     if (dBusMap.propertyType == "uint8_t")
     {
         std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "bool")
     {
         std::variant<bool> v = std::get<bool>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "int16_t")
     {
         std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "uint16_t")
     {
         std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "int32_t")
     {
         std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "uint32_t")
     {
         std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "int64_t")
     {
         std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "uint64_t")
     {
         std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "double")
     {
         std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else if (dBusMap.propertyType == "string")
     {
         std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
+        appendValue(v);
     }
     else
     {
@@ -378,6 +386,7 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
               dBusMap.propertyType);
         throw std::invalid_argument("UnSupported Dbus Type");
     }
+    return method;
 }
 
 PropertyValue DBusHandler::getDbusPropertyVariant(
@@ -559,7 +568,7 @@ uint16_t findStateSensorId(const pldm_pdr* pdrRepo, uint8_t tid,
     return PLDM_INVALID_EFFECTER_ID;
 }
 
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer)
+void printBuffer(bool isTx, std::span<const uint8_t> buffer)
 {
     if (buffer.empty())
     {
@@ -23,6 +23,7 @@
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -381,6 +382,22 @@ class DBusHandler : public DBusHandlerInterface
     }
 };
 
+/** @brief Create the method call setting a D-Bus property
+ *
+ *  @param[in] bus - the bus connection
+ *  @param[in] service - D-Bus service owning the object
+ *  @param[in] dBusMap - Object path, property name, interface and property
+ *                       type for the D-Bus object
+ *  @param[in] value - The value to be set
+ *
+ *  @return the method call
+ *  @throw std::invalid_argument for an unsupported property type
+ */
+sdbusplus::message_t newSetPropertyCall(sdbusplus::bus_t& bus,
+                                        const std::string& service,
+                                        const DBusMapping& dBusMap,
+                                        const PropertyValue& value);
+
 /** @brief Fetch parent D-Bus object based on pathname
  *
  *  @param[in] dbusObj - child D-Bus object
@@ -493,7 +510,7 @@ int emitStateSensorEventSignal(uint8_t tid, uint16_t sensorId,
  *
  *  @return - None
  */
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer);
+void printBuffer(bool isTx, std::span<const uint8_t> buffer);
 
 /** @brief Convert the buffer to std::string
  *
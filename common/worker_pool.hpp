@@ -0,0 +1,457 @@
+#pragma once
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace pldm
+{
+
+/** @struct WorkerPoolStats
+ *
+ *  Snapshot of the load of a WorkerPool
+ */
+struct WorkerPoolStats
+{
+    size_t workers = 0;       //!< number of worker threads
+    size_t queueDepth = 0;    //!< jobs waiting for a worker
+    size_t maxQueueDepth = 0; //!< highest queue depth seen
+    size_t busyWorkers = 0;   //!< workers currently running a job
+    uint64_t submitted = 0;   //!< jobs accepted by the pool
+    uint64_t completed = 0;   //!< jobs whose completion has run
+    uint64_t rejected = 0;    //!< jobs refused as the queue was full
+    std::chrono::nanoseconds busyTime{0}; //!< time spent running jobs
+    double utilization = 0; //!< busy time over the capacity of the workers
+};
+
+/** @class WorkerPool
+ *
+ *  A bounded pool of threads for blocking work, such as file and DMA I/O, the
+ *  PLDM daemon must not perform on its event loop. A job is run on a worker
+ *  and its completion is run back on the event loop. The workers hand the
+ *  finished jobs over through a lock-free list and wake the event loop
+ *  through an eventfd, only when the list was empty.
+ *
+ *  The work must not touch D-Bus or any other state owned by the event loop,
+ *  the completion is the place to do so. Jobs are posted from the event loop
+ *  only.
+ */
+class WorkerPool
+{
+  public:
+    using Work = std::function<void()>;
+    using Completion = std::function<void()>;
+
+    /** @brief Default maximum number of jobs waiting for a worker */
+    static constexpr size_t defaultMaxQueueDepth = 64;
+
+    WorkerPool() = delete;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] numWorkers - number of worker threads
+     *  @param[in] maxQueueDepth - maximum number of jobs waiting for a worker
+     */
+    explicit WorkerPool(sdeventplus::Event& event, size_t numWorkers = 2,
+                        size_t maxQueueDepth = defaultMaxQueueDepth) :
+        maxQueueDepth(maxQueueDepth), eventFd(openEventFd()),
+        completionSource(event, eventFd, EPOLLIN,
+                         [this](sdeventplus::source::IO&, int, uint32_t) {
+                             runCompletions();
+                         }),
+        startTime(std::chrono::steady_clock::now())
+    {
+        workers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i)
+        {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    /** @brief Stop the pool, see stop() */
+    ~WorkerPool()
+    {
+        stop();
+        close(eventFd);
+    }
+
+    /** @brief Stop the pool
+     *
+     *  The workers finish the queued jobs before they exit, then the
+     *  completions of all the jobs are run on the calling thread, which must
+     *  be the event loop thread. A coroutine awaiting the pool is therefore
+     *  always resumed and never left suspended. Jobs posted from then on are
+     *  refused, so an Awaiter runs its callable in place.
+     */
+    void stop()
+    {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping)
+            {
+                return;
+            }
+            stopping = true;
+        }
+        wakeWorker.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        runCompletions();
+    }
+
+    /** @brief Run a job on the pool
+     *
+     *  @param[in] work - run on a worker thread
+     *  @param[in] done - run on the event loop once the work has finished
+     *
+     *  @return true if the job was queued, false if the queue is full or the
+     *          pool is stopped
+     */
+    bool post(Work&& work, Completion&& done)
+    {
+        auto job = std::make_unique<Job>(std::move(work), std::move(done));
+        {
+            std::lock_guard lock(mutex);
+            if (stopping)
+            {
+                return false;
+            }
+            if (queue.size() >= maxQueueDepth)
+            {
+                rejected++;
+                return false;
+            }
+            queue.emplace_back(std::move(job));
+            peakQueueDepth = std::max(peakQueueDepth, queue.size());
+        }
+        submitted++;
+        wakeWorker.notify_one();
+        return true;
+    }
+
+    /** @brief Awaitable running a callable on the pool
+     *
+     *  The awaiting coroutine is resumed on the event loop with the result of
+     *  the callable, or the exception it has thrown, at the latest when the
+     *  pool is stopped. If the queue is full or the pool is stopped the
+     *  callable runs in place on the event loop.
+     */
+    template <typename F>
+    class Awaiter
+    {
+      public:
+        using Result = std::invoke_result_t<F&>;
+
+        Awaiter(WorkerPool& pool, F&& work) :
+            pool(pool), work(std::move(work))
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            if (pool.post([this] { invoke(); },
+                          [handle] { handle.resume(); }))
+            {
+                return true;
+            }
+            invoke();
+            return false;
+        }
+
+        Result await_resume()
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            if constexpr (!std::is_void_v<Result>)
+            {
+                return std::move(*result);
+            }
+        }
+
+      private:
+        void invoke()
+        {
+            try
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    work();
+                    result.emplace();
+                }
+                else
+                {
+                    result.emplace(work());
+                }
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+
+        WorkerPool& pool;
+        F work;
+        std::optional<std::conditional_t<std::is_void_v<Result>,
+                                         std::monostate, Result>>
+            result;
+        std::exception_ptr exception;
+    };
+
+    /** @brief Run a callable on the pool from a coroutine
+     *
+     *  @param[in] work - the callable, run on a worker thread
+     *
+     *  @return awaitable yielding the result of the callable
+     */
+    template <typename F>
+    Awaiter<std::decay_t<F>> run(F&& work)
+    {
+        return Awaiter<std::decay_t<F>>(*this, std::forward<F>(work));
+    }
+
+    /** @brief Get the current load of the pool */
+    WorkerPoolStats getStats() const
+    {
+        WorkerPoolStats stats;
+        stats.workers = workers.size();
+        {
+            std::lock_guard lock(mutex);
+            stats.queueDepth = queue.size();
+            stats.maxQueueDepth = peakQueueDepth;
+            stats.rejected = rejected;
+        }
+        stats.busyWorkers = busyWorkers.load(std::memory_order_relaxed);
+        stats.submitted = submitted;
+        stats.completed = completed;
+        stats.busyTime =
+            std::chrono::nanoseconds(busyTime.load(std::memory_order_relaxed));
+
+        auto capacity = (std::chrono::steady_clock::now() - startTime) *
+                        stats.workers;
+        if (capacity.count() > 0)
+        {
+            stats.utilization =
+                std::chrono::duration<double>(stats.busyTime) /
+                std::chrono::duration<double>(capacity);
+        }
+        return stats;
+    }
+
+  private:
+    /** @struct Job
+     *
+     *  A job of the pool, linked into the completion list once its work has
+     *  finished
+     */
+    struct Job
+    {
+        Job(Work&& work, Completion&& done) :
+            work(std::move(work)), done(std::move(done))
+        {}
+
+        Work work;
+        Completion done;
+        Job* next = nullptr;
+    };
+
+    static int openEventFd()
+    {
+        int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to create worker pool eventfd");
+        }
+        return fd;
+    }
+
+    /** @brief Main function of a worker thread */
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock lock(mutex);
+                wakeWorker.wait(lock,
+                                [this] { return stopping || !queue.empty(); });
+                // The queued jobs are still run when stopping, their
+                // completions may resume coroutines awaiting the pool
+                if (queue.empty())
+                {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            busyWorkers.fetch_add(1, std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                job->work();
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Worker pool job failed, error - {ERROR}", "ERROR",
+                           e);
+            }
+            busyTime.fetch_add(
+                std::chrono::nanoseconds(std::chrono::steady_clock::now() -
+                                         start)
+                    .count(),
+                std::memory_order_relaxed);
+            busyWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+            complete(job.release());
+        }
+    }
+
+    /** @brief Hand a finished job over to the event loop
+     *
+     *  @param[in] job - the job, owned by the completion list from here on
+     */
+    void complete(Job* job)
+    {
+        auto head = completions.load(std::memory_order_relaxed);
+        do
+        {
+            job->next = head;
+        } while (!completions.compare_exchange_weak(head, job,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+
+        // The event loop drains the whole list when woken up, so it only
+        // needs waking up for the first job of the list
+        if (!head)
+        {
+            uint64_t one = 1;
+            if (write(eventFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+            {
+                lg2::error("Failed to wake up the event loop, error - {ERROR}",
+                           "ERROR", errno);
+            }
+        }
+    }
+
+    /** @brief Run the completions of the finished jobs on the event loop */
+    void runCompletions()
+    {
+        // Reset the eventfd before taking the list, a job finishing after this
+        // point wakes the event loop up again
+        uint64_t count = 0;
+        if (read(eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+        {
+            lg2::error("Failed to read worker pool eventfd, error - {ERROR}",
+                       "ERROR", errno);
+        }
+
+        // The list is last in first out, reverse it to complete the jobs in
+        // the order they finished
+        auto job = completions.exchange(nullptr, std::memory_order_acquire);
+        Job* fifo = nullptr;
+        while (job)
+        {
+            auto next = job->next;
+            job->next = fifo;
+            fifo = job;
+            job = next;
+        }
+
+        while (fifo)
+        {
+            std::unique_ptr<Job> done(fifo);
+            fifo = fifo->next;
+            completed++;
+            if (done->done)
+            {
+                done->done();
+            }
+        }
+    }
+
+    /** @brief Maximum number of jobs waiting for a worker */
+    const size_t maxQueueDepth;
+
+    /** @brief Wakes the event loop up when jobs have finished */
+    int eventFd;
+
+    /** @brief Event source of the eventfd */
+    sdeventplus::source::IO completionSource;
+
+    /** @brief Time the pool was started, for the utilization */
+    std::chrono::steady_clock::time_point startTime;
+
+    /** @brief Guards the job queue and its counters */
+    mutable std::mutex mutex;
+
+    /** @brief Signalled when a job is queued or the pool stops */
+    std::condition_variable wakeWorker;
+
+    /** @brief Jobs waiting for a worker */
+    std::deque<std::unique_ptr<Job>> queue;
+
+    /** @brief Highest queue depth seen */
+    size_t peakQueueDepth = 0;
+
+    /** @brief Jobs refused as the queue was full */
+    uint64_t rejected = 0;
+
+    /** @brief Set when the pool is stopped */
+    bool stopping = false;
+
+    /** @brief Finished jobs, last in first out */
+    std::atomic<Job*> completions{nullptr};
+
+    /** @brief Workers currently running a job */
+    std::atomic<size_t> busyWorkers{0};
+
+    /** @brief Time spent running jobs, in nanoseconds */
+    std::atomic<int64_t> busyTime{0};
+
+    /** @brief Jobs accepted, only updated on the event loop */
+    uint64_t submitted = 0;
+
+    /** @brief Jobs completed, only updated on the event loop */
+    uint64_t completed = 0;
+
+    /** @brief The worker threads, started last and joined first */
+    std::vector<std::thread> workers;
+};
+
+} // namespace pldm
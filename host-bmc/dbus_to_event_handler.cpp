@@ -1,5 +1,6 @@
 #include "dbus_to_event_handler.hpp"
 
+#include "common/loop_watchdog.hpp"
 #include "libpldmresponder/pdr.hpp"
 
 #include <phosphor-logging/lg2.hpp>
@@ -113,6 +114,9 @@ void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
                               dbusMapping.interface.c_str()),
             [this, sensorEventDataVec, dbusValueMapping, dbusMapping, sensorId,
              offset](auto& msg) mutable {
+                watchdog::LoopWatchdog::Scope scope(
+                    {.kind = watchdog::SourceKind::Match,
+                     .name = "StateSensorChanged"});
                 DbusChangedProps props{};
                 std::string intf;
                 uint8_t previousState = PLDM_SENSOR_UNKNOWN;
@@ -1,5 +1,7 @@
 #include "dbus_to_terminus_effecters.hpp"
 
+#include "common/loop_watchdog.hpp"
+
 #include <libpldm/pdr.h>
 #include <libpldm/platform.h>
 
@@ -671,6 +673,9 @@ void HostEffecterParser::createHostEffecterMatch(
         propertiesChanged(objectPath, interface),
         [this, effecterInfoIndex, dbusInfoIndex,
          effecterId](sdbusplus::message_t& msg) {
+            watchdog::LoopWatchdog::Scope scope(
+                {.kind = watchdog::SourceKind::Match,
+                 .name = "HostEffecterChanged"});
             DbusChgHostEffecterProps props;
             std::string iface;
             msg.read(iface, props);
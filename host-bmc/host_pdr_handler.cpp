@@ -4,6 +4,7 @@
 #ifdef OEM_IBM
 #include <libpldm/oem/ibm/fru.h>
 #endif
+#include "common/loop_watchdog.hpp"
 #include "dbus/custom_dbus.hpp"
 
 #include <nlohmann/json.hpp>
@@ -100,6 +101,9 @@ HostPDRHandler::HostPDRHandler(
         propertiesChanged("/xyz/openbmc_project/state/host0",
                           "xyz.openbmc_project.State.Host"),
         [this, repo, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
+            watchdog::LoopWatchdog::Scope scope(
+                {.kind = watchdog::SourceKind::Match,
+                 .name = "HostStateChanged"});
             DbusChangedProps props{};
             std::string intf;
             msg.read(intf, props);
@@ -193,7 +197,8 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
         std::move(requestMsg),
-        std::bind_front(&HostPDRHandler::processHostPDRs, this));
+        std::bind_front(&HostPDRHandler::processHostPDRs, this),
+        pldm::requester::RequestClass::Bulk);
     if (rc)
     {
         error(
@@ -972,7 +977,8 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE_METADATA,
         std::move(requestMsg),
-        std::move(getFruRecordTableMetadataResponseHandler));
+        std::move(getFruRecordTableMetadataResponseHandler),
+        pldm::requester::RequestClass::Control, true);
     if (rc != PLDM_SUCCESS)
     {
         error(
@@ -78,7 +78,7 @@ Response Handler::getPLDMTypes(const pldm_msg* request,
         types[index].byte |= 1 << bit;
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TYPES_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_TYPES_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     auto rc = encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS,
                                     types.data(), responsePtr);
@@ -95,7 +95,7 @@ Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
     ver32_t version{};
     Type type;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_COMMANDS_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     auto rc = decode_get_commands_req(request, payloadLength, &type, &version);
@@ -137,7 +137,7 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
     Type type;
     uint8_t transferFlag;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_VERSION_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     uint8_t rc = decode_get_version_req(request, payloadLength, &transferHandle,
@@ -178,7 +178,7 @@ void Handler::_processSetEventReceiver(sdeventplus::source::EventBase&
 
 Response Handler::getTID(const pldm_msg* request, size_t /*payloadLength*/)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_TID_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     auto rc = encode_get_tid_resp(request->hdr.instance_id, PLDM_SUCCESS,
                                   TERMINUS_ID, responsePtr);
@@ -119,7 +119,7 @@ Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
 
     constexpr auto timeInterface = "xyz.openbmc_project.Time.EpochTime";
     constexpr auto bmcTimePath = "/xyz/openbmc_project/time/bmc";
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_DATE_TIME_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_DATE_TIME_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     EpochTimeUS timeUsec;
 
@@ -244,8 +244,8 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
+    auto response = newResponse(
+        PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_bios_table_resp(
@@ -280,7 +280,7 @@ Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
+    auto response = newResponse(PLDM_SET_BIOS_TABLE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
@@ -322,10 +322,8 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
     }
 
     auto entryLength = pldm_bios_table_attr_value_entry_length(entry);
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES +
-                          entryLength,
-                      0);
+    auto response = newResponse(
+        PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES + entryLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_bios_current_value_by_handle_resp(
         request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
@@ -356,8 +354,7 @@ Response Handler::setBIOSAttributeCurrentValue(const pldm_msg* request,
     rc = biosConfig.setAttrValue(attributeField.ptr, attributeField.length,
                                  false);
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     encode_set_bios_attribute_current_value_resp(request->hdr.instance_id, rc,
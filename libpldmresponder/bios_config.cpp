@@ -1159,6 +1159,9 @@ void BIOSConfig::listenPendingAttributes()
         pldm::utils::DBusHandler::getBus(),
         propertiesChanged(objPath, objInterface),
         [this](sdbusplus::message_t& msg) {
+            watchdog::LoopWatchdog::Scope scope(
+                {.kind = watchdog::SourceKind::Match,
+                 .name = "PendingBIOSAttributesChanged"});
             constexpr auto propertyName = "PendingAttributes";
 
             using Value =
@@ -3,6 +3,7 @@
 #include "bios_attribute.hpp"
 #include "bios_table.hpp"
 #include "common/instance_id.hpp"
+#include "common/loop_watchdog.hpp"
 #include "oem_handler.hpp"
 #include "platform_config.hpp"
 #include "requester/handler.hpp"
@@ -232,6 +233,9 @@ class BIOSConfig
                         propertiesChanged(dBusMap->objectPath,
                                           dBusMap->interface),
                         [this, biosAttrIndex](sdbusplus::message_t& msg) {
+                            watchdog::LoopWatchdog::Scope scope(
+                                {.kind = watchdog::SourceKind::Match,
+                                 .name = "BIOSAttributeChanged"});
                             DbusChObjProperties props;
                             std::string iface;
                             msg.read(iface, props);
@@ -245,6 +249,9 @@ class BIOSConfig
                         interfacesAdded() + argNpath(0, dBusMap->objectPath),
                         [this, biosAttrIndex, interface = dBusMap->interface](
                             sdbusplus::message_t& msg) {
+                            watchdog::LoopWatchdog::Scope scope(
+                                {.kind = watchdog::SourceKind::Match,
+                                 .name = "BIOSAttributeAdded"});
                             sdbusplus::message::object_path path;
                             DbusIfacesAdded interfaces;
 
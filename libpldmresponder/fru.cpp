@@ -144,13 +144,38 @@ void FruImpl::buildFRUTable()
         return;
     }
 
+    dbus::ObjectValueTree inventory;
+
+    try
+    {
+        inventory = pldm::utils::DBusHandler::getInventoryObjects<
+            pldm::utils::DBusHandler>();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to build FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+
+    buildFRUTable(inventory, pldm::utils::checkForFruPresence);
+}
+
+void FruImpl::buildFRUTable(
+    const dbus::ObjectValueTree& inventory,
+    const std::function<bool(const std::string&)>& isPresent)
+{
+    if (isBuilt)
+    {
+        return;
+    }
+
     fru_parser::DBusLookupInfo dbusInfo;
 
     try
     {
         dbusInfo = parser.inventoryLookup();
-        objects = pldm::utils::DBusHandler::getInventoryObjects<
-            pldm::utils::DBusHandler>();
     }
     catch (const std::exception& e)
     {
@@ -160,6 +185,7 @@ void FruImpl::buildFRUTable()
         return;
     }
 
+    objects = inventory;
     auto itemIntfsLookup = std::get<2>(dbusInfo);
 
     for (const auto& object : objects)
@@ -170,7 +196,7 @@ void FruImpl::buildFRUTable()
             if (itemIntfsLookup.contains(interface.first))
             {
                 // checking fru present property is available or not.
-                if (!pldm::utils::checkForFruPresence(object.first.str))
+                if (!isPresent(object.first.str))
                 {
                     continue;
                 }
@@ -452,9 +478,7 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
     constexpr uint8_t minor = 0x00;
     constexpr uint32_t maxSize = 0xFFFFFFFF;
 
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES,
-                      0);
+    auto response = newResponse(PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     impl.getFRURecordTableMetadata();
@@ -482,8 +506,7 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     auto rc =
@@ -535,7 +558,7 @@ Response Handler::getFRURecordByOption(const pldm_msg* request,
 
     auto respPayloadLength =
         PLDM_GET_FRU_RECORD_BY_OPTION_MIN_RESP_BYTES + fruData.size();
-    Response response(sizeof(pldm_msg_hdr) + respPayloadLength, 0);
+    auto response = newResponse(respPayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_fru_record_by_option_resp(
@@ -572,8 +595,7 @@ Response Handler::setFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_FRU_RECORD_TABLE_RESP_BYTES);
+    auto response = newResponse(PLDM_SET_FRU_RECORD_TABLE_RESP_BYTES);
     struct pldm_msg* responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_fru_record_table_resp(
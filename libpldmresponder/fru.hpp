@@ -10,6 +10,7 @@
 
 #include <sdbusplus/message.hpp>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <variant>
@@ -137,6 +138,17 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Build the FRU table from the given inventory objects, instead
+     *         of the objects of the inventory manager
+     *
+     *  @param[in] inventory - the inventory objects
+     *  @param[in] isPresent - returns whether the FRU of an inventory object
+     *                         path is present
+     */
+    void buildFRUTable(
+        const dbus::ObjectValueTree& inventory,
+        const std::function<bool(const std::string&)>& isPresent);
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
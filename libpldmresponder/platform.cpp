@@ -214,7 +214,7 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         }
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_GET_PDR_MIN_RESP_BYTES);
 
     if (payloadLength != PLDM_GET_PDR_REQ_BYTES)
     {
@@ -278,23 +278,19 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
-Response Handler::setStateEffecterStates(const pldm_msg* request,
-                                         size_t payloadLength)
+int Handler::decodeSetStateEffecterStatesReq(
+    const pldm_msg* request, size_t payloadLength, uint16_t& effecterId,
+    std::vector<set_effecter_state_field>& stateField)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    uint16_t effecterId;
     uint8_t compEffecterCnt;
     constexpr auto maxCompositeEffecterCnt = 8;
-    std::vector<set_effecter_state_field> stateField(maxCompositeEffecterCnt,
-                                                     {0, 0});
+    stateField.assign(maxCompositeEffecterCnt, {0, 0});
 
     if ((payloadLength > PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES) ||
         (payloadLength < sizeof(effecterId) + sizeof(compEffecterCnt) +
                              sizeof(set_effecter_state_field)))
     {
-        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        return PLDM_ERROR_INVALID_LENGTH;
     }
 
     int rc = decode_set_state_effecter_states_req(
@@ -303,11 +299,17 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
 
     if (rc != PLDM_SUCCESS)
     {
-        return CmdHandler::ccOnlyResponse(request, rc);
+        return rc;
     }
 
     stateField.resize(compEffecterCnt);
-    const pldm::utils::DBusHandler dBusIntf;
+    return PLDM_SUCCESS;
+}
+
+std::optional<int> Handler::setOemStateEffecterStates(
+    uint16_t effecterId, std::vector<set_effecter_state_field>& stateField)
+{
+    uint8_t compEffecterCnt = stateField.size();
     uint16_t entityType{};
     uint16_t entityInstance{};
     uint16_t stateSetId{};
@@ -317,21 +319,22 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
         oemPlatformHandler != nullptr &&
         !effecterDbusObjMaps.contains(effecterId))
     {
-        rc = oemPlatformHandler->oemSetStateEffecterStatesHandler(
+        return oemPlatformHandler->oemSetStateEffecterStatesHandler(
             entityType, entityInstance, stateSetId, compEffecterCnt, stateField,
             effecterId);
     }
-    else
-    {
-        rc = platform_state_effecter::setStateEffecterStatesHandler<
-            pldm::utils::DBusHandler, Handler>(dBusIntf, *this, effecterId,
-                                               stateField);
-    }
+    return std::nullopt;
+}
+
+Response Handler::setStateEffecterStatesResp(const pldm_msg* request, int rc)
+{
     if (rc != PLDM_SUCCESS)
     {
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
+    auto response = newResponse(PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_set_state_effecter_states_resp(request->hdr.instance_id, rc,
                                                responsePtr);
     if (rc != PLDM_SUCCESS)
@@ -342,6 +345,60 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
     return response;
 }
 
+Response Handler::setStateEffecterStates(const pldm_msg* request,
+                                         size_t payloadLength)
+{
+    uint16_t effecterId;
+    std::vector<set_effecter_state_field> stateField;
+    auto rc = decodeSetStateEffecterStatesReq(request, payloadLength,
+                                              effecterId, stateField);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    auto oemRc = setOemStateEffecterStates(effecterId, stateField);
+    if (oemRc)
+    {
+        rc = *oemRc;
+    }
+    else
+    {
+        const pldm::utils::DBusHandler dBusIntf;
+        rc = platform_state_effecter::setStateEffecterStatesHandler<
+            pldm::utils::DBusHandler, Handler>(dBusIntf, *this, effecterId,
+                                               stateField);
+    }
+    return setStateEffecterStatesResp(request, rc);
+}
+
+exec::task<Response> Handler::setStateEffecterStatesAsync(
+    const pldm_msg* request, size_t payloadLength)
+{
+    uint16_t effecterId;
+    std::vector<set_effecter_state_field> stateField;
+    auto rc = decodeSetStateEffecterStatesReq(request, payloadLength,
+                                              effecterId, stateField);
+    if (rc != PLDM_SUCCESS)
+    {
+        co_return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    // The OEM handlers talk to D-Bus synchronously
+    auto oemRc = setOemStateEffecterStates(effecterId, stateField);
+    if (oemRc)
+    {
+        rc = *oemRc;
+    }
+    else
+    {
+        rc = co_await platform_state_effecter::
+            setStateEffecterStatesHandlerAsync(*this, effecterId,
+                                               std::move(stateField));
+    }
+    co_return setStateEffecterStatesResp(request, rc);
+}
+
 Response Handler::platformEventMessage(const pldm_msg* request,
                                        size_t payloadLength)
 {
@@ -371,6 +428,15 @@ Response Handler::platformEventMessage(const pldm_msg* request,
                 oemPlatformHandler->setSurvTimer(tid, true);
             }
         }
+        /* The add-on handlers are told of the heartbeats too */
+        auto handlers = eventHandlers.find(eventClass);
+        if (handlers != eventHandlers.end())
+        {
+            for (const auto& handler : handlers->second)
+            {
+                handler(request, payloadLength, formatVersion, tid, offset);
+            }
+        }
     }
     else
     {
@@ -399,8 +465,7 @@ Response Handler::platformEventMessage(const pldm_msg* request,
             return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
         }
     }
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES, 0);
+    auto response = newResponse(PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_platform_event_message_resp(request->hdr.instance_id, rc,
@@ -683,7 +748,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
         getEffecterDataSize(effecterDataSize) +
         getEffecterDataSize(effecterDataSize);
 
-    Response response(responsePayloadLength + sizeof(pldm_msg_hdr));
+    auto response = newResponse(responsePayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = platform_numeric_effecter::getNumericEffecterValueHandler(
@@ -703,8 +768,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
 Response Handler::setNumericEffecterValue(const pldm_msg* request,
                                           size_t payloadLength)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
+    auto response = newResponse(PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
     uint16_t effecterId{};
     uint8_t effecterDataSize{};
     uint8_t effecterValue[4] = {};
@@ -817,9 +881,9 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
-        sizeof(get_sensor_state_field) * comSensorCnt);
+    auto response =
+        newResponse(PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                    sizeof(get_sensor_state_field) * comSensorCnt);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_state_sensor_readings_resp(
         request->hdr.instance_id, rc, comSensorCnt, stateField.data(),
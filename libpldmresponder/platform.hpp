@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <map>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -92,6 +93,14 @@ class Handler : public CmdHandler
             [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
                 return this->setStateEffecterStates(request, payloadLength);
             });
+        // The state effecters are mostly backed by D-Bus properties, set them
+        // without blocking the event loop on the D-Bus calls
+        asyncHandlers.emplace(
+            PLDM_SET_STATE_EFFECTER_STATES,
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
+                return this->setStateEffecterStatesAsync(request,
+                                                         payloadLength);
+            });
         handlers.emplace(
             PLDM_PLATFORM_EVENT_MESSAGE,
             [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
@@ -279,6 +288,17 @@ class Handler : public CmdHandler
     Response setStateEffecterStates(const pldm_msg* request,
                                     size_t payloadLength);
 
+    /** @brief Asynchronous handler for setStateEffecterStates, the D-Bus
+     *         properties of the effecter are set without blocking the event
+     *         loop
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @return Response - PLDM Response message
+     */
+    exec::task<Response> setStateEffecterStatesAsync(const pldm_msg* request,
+                                                     size_t payloadLength);
+
     /** @brief Handler for PlatformEventMessage
      *
      *  @param[in] request - Request message
@@ -513,6 +533,37 @@ class Handler : public CmdHandler
     void setEventReceiver();
 
   private:
+    /** @brief Decode a setStateEffecterStates request
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[out] effecterId - Effecter ID sent by the requester to act on
+     *  @param[out] stateField - The state field data for each of the states
+     *  @return PLDM completion code
+     */
+    static int decodeSetStateEffecterStatesReq(
+        const pldm_msg* request, size_t payloadLength, uint16_t& effecterId,
+        std::vector<set_effecter_state_field>& stateField);
+
+    /** @brief Set the states of an OEM effecter through the OEM handler
+     *
+     *  @param[in] effecterId - Effecter ID sent by the requester to act on
+     *  @param[in] stateField - The state field data for each of the states
+     *  @return PLDM completion code, std::nullopt if the effecter is not
+     *          handled by the OEM handler
+     */
+    std::optional<int> setOemStateEffecterStates(
+        uint16_t effecterId, std::vector<set_effecter_state_field>& stateField);
+
+    /** @brief Encode the response of setStateEffecterStates
+     *
+     *  @param[in] request - Request message
+     *  @param[in] rc - PLDM completion code of the request
+     *  @return Response - PLDM Response message
+     */
+    static Response setStateEffecterStatesResp(const pldm_msg* request,
+                                               int rc);
+
     uint8_t eid;
     InstanceIdDb* instanceIdDb;
     pdr_utils::Repo pdrRepo;
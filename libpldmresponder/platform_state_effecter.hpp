@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/dbus_async.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/pdr.hpp"
 #include "pdr_utils.hpp"
@@ -12,6 +13,8 @@
 
 #include <cstdint>
 #include <map>
+#include <utility>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -21,23 +24,29 @@ namespace responder
 {
 namespace platform_state_effecter
 {
-/** @brief Function to set the effecter requested by pldm requester
+/** @brief D-Bus property and the value to set it to */
+using PropertySetting =
+    std::pair<pldm::utils::DBusMapping, pldm::utils::PropertyValue>;
+
+/** @brief Function to look up the D-Bus properties to set for the states
+ *         requested by pldm requester
  *
- *  @tparam[in] DBusInterface - DBus interface type
  *  @tparam[in] Handler - pldm::responder::platform::Handler
- *  @param[in] dBusIntf - The interface object of DBusInterface
  *  @param[in] handler - The interface object of
  *             pldm::responder::platform::Handler
  *  @param[in] effecterId - Effecter ID sent by the requester to act on
  *  @param[in] stateField - The state field data for each of the states,
  * equal to composite effecter count in number
- *  @return - Success or failure in setting the states. Returns failure in
- * terms of PLDM completion codes if at least one state fails to be set
+ *  @param[out] settings - The properties to set, for the states preceding
+ *              the first invalid one if the lookup fails
+ *  @return - PLDM_SUCCESS, or the PLDM completion code of the first state
+ * which fails the lookup
  */
-template <class DBusInterface, class Handler>
-int setStateEffecterStatesHandler(
-    const DBusInterface& dBusIntf, Handler& handler, uint16_t effecterId,
-    const std::vector<set_effecter_state_field>& stateField)
+template <class Handler>
+int getStateEffecterSettings(
+    Handler& handler, uint16_t effecterId,
+    const std::vector<set_effecter_state_field>& stateField,
+    std::vector<PropertySetting>& settings)
 {
     using namespace pldm::responder::pdr;
     using namespace pldm::utils;
@@ -134,21 +143,18 @@ int setStateEffecterStatesHandler(
 
             if (stateField[currState].set_request == PLDM_REQUEST_SET)
             {
-                try
-                {
-                    dBusIntf.setDbusProperty(
-                        dbusMapping,
-                        dbusValToMap.at(stateField[currState].effecter_state));
-                }
-                catch (const std::exception& e)
+                auto value =
+                    dbusValToMap.find(stateField[currState].effecter_state);
+                if (value == dbusValToMap.end())
                 {
                     error(
-                        "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - '{ERROR}'",
+                        "No value of property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}' for effecter state '{EFFECTER_STATE}'",
                         "PROPERTY", dbusMapping.propertyName, "INTERFACE",
                         dbusMapping.interface, "PATH", dbusMapping.objectPath,
-                        "ERROR", e);
+                        "EFFECTER_STATE", stateField[currState].effecter_state);
                     return PLDM_ERROR;
                 }
+                settings.emplace_back(dbusMapping, value->second);
             }
             uint8_t* nextState =
                 reinterpret_cast<uint8_t*>(states) +
@@ -169,6 +175,85 @@ int setStateEffecterStatesHandler(
     return rc;
 }
 
+/** @brief Function to set the effecter requested by pldm requester
+ *
+ *  @tparam[in] DBusInterface - DBus interface type
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] dBusIntf - The interface object of DBusInterface
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] effecterId - Effecter ID sent by the requester to act on
+ *  @param[in] stateField - The state field data for each of the states,
+ * equal to composite effecter count in number
+ *  @return - Success or failure in setting the states. Returns failure in
+ * terms of PLDM completion codes if at least one state fails to be set
+ */
+template <class DBusInterface, class Handler>
+int setStateEffecterStatesHandler(
+    const DBusInterface& dBusIntf, Handler& handler, uint16_t effecterId,
+    const std::vector<set_effecter_state_field>& stateField)
+{
+    std::vector<PropertySetting> settings;
+    auto rc =
+        getStateEffecterSettings(handler, effecterId, stateField, settings);
+    for (const auto& [dbusMapping, value] : settings)
+    {
+        try
+        {
+            dBusIntf.setDbusProperty(dbusMapping, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - '{ERROR}'",
+                "PROPERTY", dbusMapping.propertyName, "INTERFACE",
+                dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR",
+                e);
+            return PLDM_ERROR;
+        }
+    }
+    return rc;
+}
+
+/** @brief Function to set the effecter requested by pldm requester without
+ *         blocking the event loop on the D-Bus calls
+ *
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] effecterId - Effecter ID sent by the requester to act on
+ *  @param[in] stateField - The state field data for each of the states,
+ * equal to composite effecter count in number
+ *  @return - Success or failure in setting the states. Returns failure in
+ * terms of PLDM completion codes if at least one state fails to be set
+ */
+template <class Handler>
+exec::task<int> setStateEffecterStatesHandlerAsync(
+    Handler& handler, uint16_t effecterId,
+    std::vector<set_effecter_state_field> stateField)
+{
+    std::vector<PropertySetting> settings;
+    auto rc =
+        getStateEffecterSettings(handler, effecterId, stateField, settings);
+    for (const auto& [dbusMapping, value] : settings)
+    {
+        try
+        {
+            co_await pldm::utils::setDbusPropertyAsync(dbusMapping, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - '{ERROR}'",
+                "PROPERTY", dbusMapping.propertyName, "INTERFACE",
+                dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR",
+                e);
+            co_return PLDM_ERROR;
+        }
+    }
+    co_return rc;
+}
+
 } // namespace platform_state_effecter
 } // namespace responder
 } // namespace pldm
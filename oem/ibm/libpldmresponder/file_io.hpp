@@ -1,6 +1,8 @@
 #pragma once
 
 #include "common/utils.hpp"
+#include "common/worker_pool.hpp"
+#include "file_table.hpp"
 #include "oem/ibm/requester/dbus_to_file_handler.hpp"
 #include "oem_ibm_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -168,7 +170,8 @@ class Handler : public CmdHandler
   public:
     Handler(oem_platform::Handler* oemPlatformHandler, int hostSockFd,
             uint8_t hostEid, pldm::InstanceIdDb* instanceIdDb,
-            pldm::requester::Handler<pldm::requester::Request>* handler) :
+            pldm::requester::Handler<pldm::requester::Request>* handler,
+            pldm::WorkerPool* workerPool = nullptr) :
         oemPlatformHandler(oemPlatformHandler)
     {
         handlers.emplace(
@@ -232,6 +235,38 @@ class Handler : public CmdHandler
                 return this->newFileAvailable(request, payloadLength);
             });
 
+        if (workerPool)
+        {
+            // The file and DMA transfers of these commands only touch the file
+            // system and the DMA device, run them on the worker pool so that a
+            // large transfer does not block the event loop
+            for (auto command : {PLDM_READ_FILE_INTO_MEMORY,
+                                 PLDM_WRITE_FILE_FROM_MEMORY, PLDM_READ_FILE,
+                                 PLDM_WRITE_FILE})
+            {
+                asyncHandlers.emplace(
+                    command,
+                    [workerPool, handler = handlers.at(command)](
+                        pldm_tid_t tid, const pldm_msg* request,
+                        size_t payloadLength) -> exec::task<Response> {
+                        // The file table is built lazily on the event loop,
+                        // once built it is not modified and the workers may
+                        // read it. While it is empty, e.g. without a config,
+                        // every lookup rebuilds it, so handle the request
+                        // here.
+                        if (pldm::filetable::buildFileTable(FILE_TABLE_JSON)
+                                .isEmpty())
+                        {
+                            co_return handler(tid, request, payloadLength);
+                        }
+                        co_return co_await workerPool->run(
+                            [&handler, tid, request, payloadLength] {
+                                return handler(tid, request, payloadLength);
+                            });
+                    });
+            }
+        }
+
         resDumpMatcher = std::make_unique<sdbusplus::bus::match_t>(
             pldm::utils::DBusHandler::getBus(),
             sdbusplus::bus::match::rules::interfacesAdded() +
@@ -114,6 +114,9 @@ class FileTable
 /** @brief Build the file attribute table if not already built using the
  *         file table config.
  *
+ *  The table is built on the event loop. Once it is not empty it is not
+ *  modified anymore and may be read from the worker threads.
+ *
  *  @param[in] fileTablePath - path of the file table config
  *
  *  @return FileTable& - Reference to instance of file table
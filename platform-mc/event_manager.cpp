@@ -9,7 +9,11 @@
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
 #include <cerrno>
+#include <chrono>
+#include <fstream>
 #include <memory>
+#include <optional>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -30,6 +34,10 @@ int EventManager::handlePlatformEvent(
                    tid);
         return PLDM_ERROR;
     }
+    if (termini[tid])
+    {
+        termini[tid]->recordEvent();
+    }
 
     /* EventClass sensorEvent `Table 11 - PLDM Event Types` DSP0248 */
     if (eventClass == PLDM_SENSOR_EVENT)
@@ -73,6 +81,13 @@ int EventManager::handlePlatformEvent(
         return processCperEvent(tid, eventId, eventData, eventDataSize);
     }
 
+    /* EventClass pldmPDRRepositoryChgEvent `Table 11 - PLDM Event Types`
+     * DSP0248 */
+    if (eventClass == PLDM_PDR_REPOSITORY_CHG_EVENT)
+    {
+        return processPdrRepositoryChgEvent(tid, eventData, eventDataSize);
+    }
+
     /* EventClass pldmMessagePollEvent `Table 11 - PLDM Event Types` DSP0248 */
     if (eventClass == PLDM_MESSAGE_POLL_EVENT)
     {
@@ -106,6 +121,38 @@ int EventManager::handlePlatformEvent(
     return PLDM_ERROR;
 }
 
+int EventManager::processPdrRepositoryChgEvent(
+    pldm_tid_t tid, const uint8_t* eventData, size_t eventDataSize)
+{
+    uint8_t eventDataFormat = 0;
+    uint8_t numberOfChangeRecords = 0;
+    size_t changeRecordDataOffset = 0;
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData, eventDataSize, &eventDataFormat, &numberOfChangeRecords,
+        &changeRecordDataOffset);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to decode PDR repository change event data from terminus ID {TID}, error {RC}",
+            "TID", tid, "RC", rc);
+        return rc;
+    }
+
+    lg2::info(
+        "Received PDR repository change event from terminus ID {TID}, format {FORMAT}",
+        "TID", tid, "FORMAT", eventDataFormat);
+
+    /* Whichever records changed, the cached PDRs are no longer those of the
+     * repository and are fetched again when the terminus is discovered */
+    auto mctpInfo = terminusManager.toMctpInfo(tid);
+    if (pdrCache && mctpInfo)
+    {
+        pdrCache->invalidate(std::get<1>(mctpInfo.value()));
+    }
+
+    return PLDM_SUCCESS;
+}
+
 int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
                                             const uint8_t* sensorData,
                                             size_t sensorDataLength)
@@ -126,6 +173,20 @@ int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
     }
 
     double value = static_cast<double>(presentReading);
+    switch (sensorDataSize)
+    {
+        case PLDM_SENSOR_DATA_SIZE_SINT8:
+            value = static_cast<int8_t>(presentReading);
+            break;
+        case PLDM_SENSOR_DATA_SIZE_SINT16:
+            value = static_cast<int16_t>(presentReading);
+            break;
+        case PLDM_SENSOR_DATA_SIZE_SINT32:
+            value = static_cast<int32_t>(presentReading);
+            break;
+        default:
+            break;
+    }
     lg2::error(
         "processNumericSensorEvent tid {TID}, sensorID {SID} value {VAL} previousState {PSTATE} eventState {ESTATE}",
         "TID", tid, "SID", sensorId, "VAL", value, "PSTATE", previousEventState,
@@ -149,6 +210,10 @@ int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
         return PLDM_ERROR;
     }
 
+    /* The event carries the present reading, the sensor needs not be polled
+     * for it */
+    sensor->updateReading(true, true, value);
+
     switch (previousEventState)
     {
         case PLDM_SENSOR_UNKNOWN:
@@ -392,7 +457,47 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
         return PLDM_ERROR;
     }
 
-    // Save event data to file
+    std::string dataType =
+        cperEvent->format_type == PLDM_PLATFORM_CPER_EVENT_WITH_HEADER
+            ? "CPER"
+            : "CPERSection";
+    auto cperData = pldm_platform_cper_event_event_data(cperEvent);
+    auto data = std::make_shared<std::vector<uint8_t>>(
+        cperData, cperData + cperEvent->event_data_length);
+
+    if (workerPool)
+    {
+        // Save the event data to file on the worker pool, the dump entry is
+        // created back on the event loop once the file is written
+        auto fileName = std::make_shared<std::optional<std::string>>();
+        auto queued = workerPool->post(
+            [fileName, data] { *fileName = saveCperData(*data); },
+            [this, fileName, dataType, terminusName] {
+                if (fileName->has_value())
+                {
+                    createCperDumpEntry(dataType, **fileName, terminusName);
+                }
+            });
+        if (queued)
+        {
+            return PLDM_SUCCESS;
+        }
+        lg2::warning(
+            "Worker pool is full, saving CPER event of terminus ID {TID} on the event loop",
+            "TID", tid);
+    }
+
+    auto fileName = saveCperData(*data);
+    if (!fileName)
+    {
+        return PLDM_ERROR;
+    }
+    return createCperDumpEntry(dataType, *fileName, terminusName);
+}
+
+std::optional<std::string>
+    EventManager::saveCperData(std::span<const uint8_t> data)
+{
     std::filesystem::path dirName{"/var/cper"};
     if (!std::filesystem::exists(dirName))
     {
@@ -404,7 +509,7 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
         {
             lg2::error("Failed to create /var/cper directory: {ERROR}", "ERROR",
                        e);
-            return PLDM_ERROR;
+            return std::nullopt;
         }
     }
 
@@ -414,7 +519,7 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
     {
         lg2::error("Failed to generate temp file, error {ERRORNO}", "ERRORNO",
                    std::strerror(errno));
-        return PLDM_ERROR;
+        return std::nullopt;
     }
     close(fd);
 
@@ -425,26 +530,16 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
     try
     {
         ofs.open(fileName);
-        ofs.write(reinterpret_cast<const char*>(
-                      pldm_platform_cper_event_event_data(cperEvent)),
-                  cperEvent->event_data_length);
-        if (cperEvent->format_type == PLDM_PLATFORM_CPER_EVENT_WITH_HEADER)
-        {
-            rc = createCperDumpEntry("CPER", fileName, terminusName);
-        }
-        else
-        {
-            rc = createCperDumpEntry("CPERSection", fileName, terminusName);
-        }
+        ofs.write(reinterpret_cast<const char*>(data.data()), data.size());
         ofs.close();
     }
     catch (const std::ofstream::failure& e)
     {
         lg2::error("Failed to save CPER to '{FILENAME}', error - {ERROR}.",
                    "FILENAME", fileName, "ERROR", e);
-        return PLDM_ERROR;
+        return std::nullopt;
     }
-    return rc;
+    return fileName;
 }
 
 int EventManager::createCperDumpEntry(const std::string& dataType,
@@ -682,8 +777,9 @@ exec::task<int> EventManager::pollForPlatformEventMessage(
 
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
-    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
-                                                  &responseLen);
+    rc = co_await terminusManager.sendRecvPldmMsg(
+        tid, request, &responseMsg, &responseLen,
+        requester::RequestClass::EventPolling);
     if (rc)
     {
         lg2::error(
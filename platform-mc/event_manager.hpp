@@ -4,12 +4,18 @@
 #include "libpldm/pldm.h"
 
 #include "common/types.hpp"
+#include "common/worker_pool.hpp"
 #include "numeric_sensor.hpp"
+#include "pdr_cache.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
 #include "requester/handler.hpp"
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
+#include <optional>
+#include <span>
+#include <string>
+
 namespace pldm
 {
 namespace platform_mc
@@ -40,9 +46,21 @@ class EventManager
     EventManager& operator=(EventManager&&) = delete;
     virtual ~EventManager() = default;
 
+    /** @brief Constructor
+     *
+     *  @param[in] terminusManager - reference to TerminusManager
+     *  @param[in] termini - list of discovered termini
+     *  @param[in] workerPool - pool running the file writes of CPER events,
+     *                          nullptr to write them on the event loop
+     *  @param[in] pdrCache - cache of the PDRs of the termini, invalidated by
+     *                        the PDR repository change events, may be nullptr
+     */
     explicit EventManager(TerminusManager& terminusManager,
-                          TerminiMapper& termini) :
-        terminusManager(terminusManager), termini(termini)
+                          TerminiMapper& termini,
+                          WorkerPool* workerPool = nullptr,
+                          PdrCache* pdrCache = nullptr) :
+        terminusManager(terminusManager), termini(termini),
+        workerPool(workerPool), pdrCache(pdrCache)
     {
         // Default response handler for PollForPlatFormEventMessage
         registerPolledEventHandler(
@@ -60,6 +78,14 @@ class EventManager
                 return this->handlePlatformEvent(tid, eventId, PLDM_CPER_EVENT,
                                                  eventData, eventDataSize);
             }});
+        registerPolledEventHandler(
+            PLDM_PDR_REPOSITORY_CHG_EVENT,
+            {[this](pldm_tid_t tid, uint16_t eventId, const uint8_t* eventData,
+                    size_t eventDataSize) {
+                return this->handlePlatformEvent(
+                    tid, eventId, PLDM_PDR_REPOSITORY_CHG_EVENT, eventData,
+                    eventDataSize);
+            }});
     };
 
     /** @brief Handle platform event
@@ -150,6 +176,29 @@ class EventManager
                                  const uint8_t* eventData,
                                  const size_t eventDataSize);
 
+    /** @brief Helper method to process the PLDM PDR repository change event
+     *         class, which invalidates the cached PDRs of the terminus
+     *
+     *  @param[in] tid - tid where the event is from
+     *  @param[in] eventData - PDR repository change event data
+     *  @param[in] eventDataSize - event data length
+     *
+     *  @return PLDM completion code
+     */
+    int processPdrRepositoryChgEvent(pldm_tid_t tid, const uint8_t* eventData,
+                                     size_t eventDataSize);
+
+    /** @brief Save CPER event data to a new file in /var/cper
+     *
+     *  Only touches the file system, so it may run on a worker thread.
+     *
+     *  @param[in] data - CPER event data
+     *
+     *  @return the path of the file, std::nullopt on failure
+     */
+    static std::optional<std::string> saveCperData(
+        std::span<const uint8_t> data);
+
     /** @brief Helper method to create CPER dump log
      *
      *  @param[in] dataType - CPER event data type
@@ -227,6 +276,12 @@ class EventManager
     /** @brief List of discovered termini */
     TerminiMapper& termini;
 
+    /** @brief Pool running the blocking file writes, may be nullptr */
+    WorkerPool* workerPool;
+
+    /** @brief Cache of the PDRs of the termini, may be nullptr */
+    PdrCache* pdrCache;
+
     /** @brief Available state for pldm request of terminus */
     std::unordered_map<pldm_tid_t, Availability> availableState;
 
@@ -16,17 +16,20 @@ exec::task<int> Manager::beforeDiscoverTerminus()
     co_return PLDM_SUCCESS;
 }
 
-exec::task<int> Manager::afterDiscoverTerminus()
+exec::task<int> Manager::afterDiscoverTerminus(pldm_tid_t tid)
 {
-    auto rc = co_await platformManager.initTerminus();
+    auto rc = co_await platformManager.initTerminus(tid);
     if (rc != PLDM_SUCCESS)
     {
-        lg2::error("Failed to initialize platform manager, error {RC}", "RC",
-                   rc);
+        lg2::error(
+            "Failed to initialize platform manager for terminus {TID}, error {RC}",
+            "TID", tid, "RC", rc);
     }
     else
     {
-        lg2::info("Successfully initialized platform manager");
+        lg2::info(
+            "Successfully initialized platform manager for terminus {TID}",
+            "TID", tid);
     }
     co_return rc;
 }
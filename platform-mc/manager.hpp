@@ -5,12 +5,16 @@
 #include "common/instance_id.hpp"
 #include "common/types.hpp"
 #include "event_manager.hpp"
+#include "pdr_cache.hpp"
 #include "platform_manager.hpp"
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "sensor_manager.hpp"
 #include "terminus_manager.hpp"
 
+#include <memory>
+#include <string_view>
+
 namespace pldm
 {
 namespace platform_mc
@@ -33,12 +37,16 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
     ~Manager() = default;
 
     explicit Manager(sdeventplus::Event& event, RequesterHandler& handler,
-                     pldm::InstanceIdDb& instanceIdDb) :
+                     pldm::InstanceIdDb& instanceIdDb,
+                     WorkerPool* workerPool = nullptr) :
+        pdrCache(std::string_view(PDR_CACHE_DIR).empty()
+                     ? nullptr
+                     : std::make_unique<PdrCache>(PDR_CACHE_DIR)),
         terminusManager(event, handler, instanceIdDb, termini, this,
                         pldm::BmcMctpEid),
-        platformManager(terminusManager, termini),
+        platformManager(terminusManager, termini, pdrCache.get()),
         sensorManager(event, terminusManager, termini, this),
-        eventManager(terminusManager, termini)
+        eventManager(terminusManager, termini, workerPool, pdrCache.get())
     {}
 
     /** @brief Helper function to do the actions before discovering terminus
@@ -47,11 +55,14 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
      */
     exec::task<int> beforeDiscoverTerminus();
 
-    /** @brief Helper function to do the actions after discovering terminus
+    /** @brief Helper function to do the actions after discovering a
+     *         terminus, each discovered terminus is handed over on its own as
+     *         soon as it is discovered
      *
+     *  @param[in] tid - TID of the discovered terminus
      *  @return coroutine return_value - PLDM completion code
      */
-    exec::task<int> afterDiscoverTerminus();
+    exec::task<int> afterDiscoverTerminus(pldm_tid_t tid);
 
     /** @brief Helper function to invoke registered handlers for
      *         the added MCTP endpoints
@@ -94,6 +105,13 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         }
     }
 
+    /** @brief Get the sensor manager polling the sensors of the termini
+     */
+    SensorManager& getSensorManager()
+    {
+        return sensorManager;
+    }
+
     /** @brief Helper function to stop sensor polling of the terminus TID
      */
     void stopSensorPolling(pldm_tid_t tid)
@@ -170,6 +188,55 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         return PLDM_SUCCESS;
     }
 
+    /** @brief PLDM PDR repository change event handler function
+     *
+     *  @param[in] request - Event message
+     *  @param[in] payloadLength - Event message payload size
+     *  @param[in] tid - Terminus ID
+     *  @param[in] eventDataOffset - Event data offset
+     *
+     *  @return PLDM error code: PLDM_SUCCESS when there is no error in handling
+     *          the event
+     */
+    int handlePdrRepositoryChgEvent(
+        const pldm_msg* request, size_t payloadLength,
+        uint8_t /* formatVersion */, uint8_t tid, size_t eventDataOffset)
+    {
+        /* The event of the host is handled by the host PDR handler */
+        if (!termini.contains(tid))
+        {
+            return PLDM_SUCCESS;
+        }
+        auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                         eventDataOffset;
+        auto eventDataSize = payloadLength - eventDataOffset;
+        eventManager.handlePlatformEvent(tid, PLDM_PLATFORM_EVENT_ID_NULL,
+                                         PLDM_PDR_REPOSITORY_CHG_EVENT,
+                                         eventData, eventDataSize);
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Heartbeat event handler function, the heartbeats keep the
+     *         events of a terminus alive for the sensor polling
+     *
+     *  @param[in] tid - Terminus ID
+     *
+     *  @return PLDM error code: PLDM_SUCCESS when there is no error in handling
+     *          the event
+     */
+    int handleHeartbeatEvent(const pldm_msg* /* request */,
+                             size_t /* payloadLength */,
+                             uint8_t /* formatVersion */, uint8_t tid,
+                             size_t /* eventDataOffset */)
+    {
+        auto it = termini.find(tid);
+        if (it != termini.end() && it->second)
+        {
+            it->second->recordEvent();
+        }
+        return PLDM_SUCCESS;
+    }
+
     /** @brief The function to trigger the event polling
      *
      *  @param[in] tid - Terminus ID
@@ -213,6 +280,9 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
     /** @brief List of discovered termini */
     TerminiMapper termini{};
 
+    /** @brief Cache of the PDRs of the termini, nullptr when disabled */
+    std::unique_ptr<PdrCache> pdrCache;
+
     /** @brief Terminus interface for calling the hook functions */
     TerminusManager terminusManager;
 
@@ -5,8 +5,14 @@
 #include "common/utils.hpp"
 #include "requester/handler.hpp"
 
+#include <systemd/sd-bus.h>
+
+#include <algorithm>
+#include <initializer_list>
 #include <limits>
 #include <regex>
+#include <utility>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -105,6 +111,7 @@ NumericSensor::NumericSensor(
     }
 
     path = sensorNameSpace + sensorName;
+    objectPath = path;
     try
     {
         std::string tmp{};
@@ -307,6 +314,7 @@ NumericSensor::NumericSensor(
     resolution = pdr->resolution;
     offset = pdr->offset;
     baseUnitModifier = pdr->unit_modifier;
+    conversion = SensorConversion(resolution, offset, baseUnitModifier);
     timeStamp = 0;
 
     /**
@@ -497,6 +505,7 @@ NumericSensor::NumericSensor(
     }
 
     path = sensorNameSpace + sensorName;
+    objectPath = path;
     try
     {
         std::string tmp{};
@@ -570,6 +579,7 @@ NumericSensor::NumericSensor(
     resolution = std::numeric_limits<double>::quiet_NaN();
     offset = std::numeric_limits<double>::quiet_NaN();
     baseUnitModifier = pdr->unit_modifier;
+    conversion = SensorConversion(resolution, offset, baseUnitModifier);
     timeStamp = 0;
     hysteresis = 0;
 
@@ -701,7 +711,7 @@ double NumericSensor::conversionFormula(double value)
 
 double NumericSensor::unitModifier(double value)
 {
-    return std::isnan(value) ? value : value * std::pow(10, baseUnitModifier);
+    return std::isnan(value) ? value : value * conversion.unitScale;
 }
 
 void NumericSensor::updateReading(bool available, bool functional, double value)
@@ -715,50 +725,35 @@ void NumericSensor::updateReading(bool available, bool functional, double value)
             "NAME", sensorName);
         return;
     }
-    availabilityIntf->available(available);
-    operationalStatusIntf->functional(functional);
-    double curValue = 0;
-    if (!useMetricInterface)
+    setAvailable(available);
+    setFunctional(functional);
+    double curValue = getReading();
+
+    double newValue = std::numeric_limits<double>::quiet_NaN();
+    if (functional && available)
     {
-        curValue = valueIntf->value();
+        newValue = conversion.convert(value);
     }
-    else
+
+    /* The readings to and from NaN are always published */
+    bool changed = newValue != curValue &&
+                   (!std::isnan(newValue) || !std::isnan(curValue));
+    if (changed && !std::isnan(newValue) && !std::isnan(curValue) &&
+        std::abs(newValue - curValue) < deadband)
     {
-        curValue = metricIntf->value();
+        changed = false;
     }
-
-    double newValue = std::numeric_limits<double>::quiet_NaN();
-    if (functional && available)
+    if (changed)
     {
-        newValue = unitModifier(conversionFormula(value));
-        if (newValue != curValue &&
-            (!std::isnan(newValue) || !std::isnan(curValue)))
-        {
-            if (!useMetricInterface)
-            {
-                valueIntf->value(newValue);
-                updateThresholds();
-            }
-            else
-            {
-                metricIntf->value(newValue);
-            }
-        }
+        setValue(newValue);
     }
-    else
+    if (!useMetricInterface && !std::isnan(newValue))
     {
-        if (newValue != curValue &&
-            (!std::isnan(newValue) || !std::isnan(curValue)))
-        {
-            if (!useMetricInterface)
-            {
-                valueIntf->value(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                metricIntf->value(std::numeric_limits<double>::quiet_NaN());
-            }
-        }
+        updateThresholds(value, newValue);
+    }
+    if (updateHandler)
+    {
+        updateHandler(*this);
     }
 }
 
@@ -772,17 +767,107 @@ void NumericSensor::handleErrGetSensorReading()
             "NAME", sensorName);
         return;
     }
-    operationalStatusIntf->functional(false);
+    setFunctional(false);
+    setValue(std::numeric_limits<double>::quiet_NaN());
+    if (updateHandler)
+    {
+        updateHandler(*this);
+    }
+}
+
+void NumericSensor::setValue(double value)
+{
+    auto curValue = getReading();
+    if (value == curValue || (std::isnan(value) && std::isnan(curValue)))
+    {
+        return;
+    }
     if (!useMetricInterface)
     {
-        valueIntf->value(std::numeric_limits<double>::quiet_NaN());
+        valueIntf->value(value, batchedPublication);
     }
     else
     {
-        metricIntf->value(std::numeric_limits<double>::quiet_NaN());
+        metricIntf->value(value, batchedPublication);
+    }
+    markPending(valueChange);
+}
+
+void NumericSensor::setAvailable(bool available)
+{
+    if (availabilityIntf->available() == available)
+    {
+        return;
+    }
+    availabilityIntf->available(available, batchedPublication);
+    markPending(availableChange);
+}
+
+void NumericSensor::setFunctional(bool functional)
+{
+    if (operationalStatusIntf->functional() == functional)
+    {
+        return;
+    }
+    operationalStatusIntf->functional(functional, batchedPublication);
+    markPending(functionalChange);
+}
+
+void NumericSensor::setBatchedPublication(bool batched)
+{
+    batchedPublication = batched;
+    if (!batched)
+    {
+        publish();
     }
 }
 
+void NumericSensor::publish()
+{
+    if (!pendingChanges)
+    {
+        return;
+    }
+    auto changes = std::exchange(pendingChanges, 0);
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto emit = [&](const char* interface,
+                    std::initializer_list<std::pair<PendingChange, const char*>>
+                        properties) {
+        std::vector<const char*> names;
+        for (const auto& [change, name] : properties)
+        {
+            if (changes & change)
+            {
+                names.push_back(name);
+            }
+        }
+        if (names.empty())
+        {
+            return;
+        }
+        names.push_back(nullptr);
+        auto rc = sd_bus_emit_properties_changed_strv(
+            bus.get(), objectPath.c_str(), interface,
+            const_cast<char**>(names.data()));
+        if (rc < 0)
+        {
+            lg2::error(
+                "Failed to emit PropertiesChanged of {INTF} for sensor {NAME}, error {RC}",
+                "INTF", interface, "NAME", sensorName, "RC", rc);
+        }
+    };
+
+    emit(useMetricInterface ? METRIC_VALUE_INTF : SENSOR_VALUE_INTF,
+         {{valueChange, "Value"}});
+    emit(AVAILABILITY_INTF, {{availableChange, "Available"}});
+    emit(OPERATIONAL_STATUS_INTF, {{functionalChange, "Functional"}});
+    emit(THRESHOLD_WARNING_INTF, {{warningHighChange, "WarningAlarmHigh"},
+                                  {warningLowChange, "WarningAlarmLow"}});
+    emit(THRESHOLD_CRITICAL_INTF, {{criticalHighChange, "CriticalAlarmHigh"},
+                                   {criticalLowChange, "CriticalAlarmLow"}});
+}
+
 bool NumericSensor::checkThreshold(bool alarm, bool direction, double value,
                                    double threshold, double hyst)
 {
@@ -811,57 +896,129 @@ bool NumericSensor::checkThreshold(bool alarm, bool direction, double value,
     return alarm;
 }
 
-void NumericSensor::updateThresholds()
+std::array<double, 4> NumericSensor::getThresholds() const
 {
-    double value = std::numeric_limits<double>::quiet_NaN();
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::array<double, 4> thresholds{nan, nan, nan, nan};
+    if (thresholdWarningIntf)
+    {
+        thresholds[0] = thresholdWarningIntf->warningHigh();
+        thresholds[1] = thresholdWarningIntf->warningLow();
+    }
+    if (thresholdCriticalIntf)
+    {
+        thresholds[2] = thresholdCriticalIntf->criticalHigh();
+        thresholds[3] = thresholdCriticalIntf->criticalLow();
+    }
+    return thresholds;
+}
 
-    if ((!useMetricInterface && !valueIntf) ||
-        (useMetricInterface && !metricIntf))
+uint8_t NumericSensor::getThresholdAlarms() const
+{
+    uint8_t alarms = 0;
+    if (thresholdWarningIntf)
     {
-        lg2::error(
-            "Failed to update thresholds sensor {NAME} D-Bus interfaces don't exist.",
-            "NAME", sensorName);
-        return;
+        alarms |= thresholdWarningIntf->warningAlarmHigh() ? warningHighAlarm
+                                                           : 0;
+        alarms |= thresholdWarningIntf->warningAlarmLow() ? warningLowAlarm : 0;
     }
-    if (!useMetricInterface)
+    if (thresholdCriticalIntf)
     {
-        value = valueIntf->value();
+        alarms |= thresholdCriticalIntf->criticalAlarmHigh() ? criticalHighAlarm
+                                                             : 0;
+        alarms |= thresholdCriticalIntf->criticalAlarmLow() ? criticalLowAlarm
+                                                            : 0;
     }
-    else
+    return alarms;
+}
+
+bool NumericSensor::refreshRawThresholds(const std::array<double, 4>& thresholds)
+{
+    /* The thresholds are D-Bus properties, they may have been set since
+     * they were translated */
+    auto same = [](double lhs, double rhs) {
+        return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+    };
+    if (!rawThresholdsSource ||
+        !std::ranges::equal(thresholds, *rawThresholdsSource, same))
+    {
+        rawThresholds =
+            RawThresholds::fromThresholds(conversion, thresholds, hysteresis);
+        rawThresholdsSource = thresholds;
+    }
+    return rawThresholds.has_value();
+}
+
+void NumericSensor::updateThresholds(double rawValue, double value)
+{
+    if (!thresholdWarningIntf && !thresholdCriticalIntf)
+    {
+        return;
+    }
+
+    auto thresholds = getThresholds();
+    auto alarms = getThresholdAlarms();
+    uint8_t newAlarms = alarms;
+    if (rawValue == std::trunc(rawValue) &&
+        std::abs(rawValue) < RawThresholds::rawLimit &&
+        refreshRawThresholds(thresholds))
     {
-        value = metricIntf->value();
+        newAlarms = rawThresholds->check(static_cast<int64_t>(rawValue),
+                                         alarms);
     }
-    if (thresholdWarningIntf &&
-        !std::isnan(thresholdWarningIntf->warningHigh()))
+    else
     {
-        auto threshold = thresholdWarningIntf->warningHigh();
-        auto alarm = thresholdWarningIntf->warningAlarmHigh();
-        auto newAlarm =
-            checkThreshold(alarm, true, value, threshold, hysteresis);
-        if (alarm != newAlarm)
+        for (size_t idx = 0; idx < RawThresholds::alarms.size(); ++idx)
         {
-            thresholdWarningIntf->warningAlarmHigh(newAlarm);
-            if (newAlarm)
+            auto alarm = RawThresholds::alarms[idx];
+            if (std::isnan(thresholds[idx]))
             {
-                thresholdWarningIntf->warningHighAlarmAsserted(value);
+                continue;
+            }
+            bool high = alarm == warningHighAlarm || alarm == criticalHighAlarm;
+            if (checkThreshold(alarms & alarm, high, value, thresholds[idx],
+                               hysteresis))
+            {
+                newAlarms |= alarm;
             }
             else
             {
-                thresholdWarningIntf->warningHighAlarmDeasserted(value);
+                newAlarms &= ~alarm;
             }
         }
     }
 
-    if (thresholdWarningIntf && !std::isnan(thresholdWarningIntf->warningLow()))
+    for (auto alarm : RawThresholds::alarms)
     {
-        auto threshold = thresholdWarningIntf->warningLow();
-        auto alarm = thresholdWarningIntf->warningAlarmLow();
-        auto newAlarm =
-            checkThreshold(alarm, false, value, threshold, hysteresis);
-        if (alarm != newAlarm)
+        if ((alarms ^ newAlarms) & alarm)
         {
-            thresholdWarningIntf->warningAlarmLow(newAlarm);
-            if (newAlarm)
+            setThresholdAlarm(alarm, newAlarms & alarm, value);
+        }
+    }
+}
+
+void NumericSensor::setThresholdAlarm(ThresholdAlarm alarm, bool asserted,
+                                      double value)
+{
+    switch (alarm)
+    {
+        case warningHighAlarm:
+            thresholdWarningIntf->warningAlarmHigh(asserted,
+                                                   batchedPublication);
+            markPending(warningHighChange);
+            if (asserted)
+            {
+                thresholdWarningIntf->warningHighAlarmAsserted(value);
+            }
+            else
+            {
+                thresholdWarningIntf->warningHighAlarmDeasserted(value);
+            }
+            break;
+        case warningLowAlarm:
+            thresholdWarningIntf->warningAlarmLow(asserted, batchedPublication);
+            markPending(warningLowChange);
+            if (asserted)
             {
                 thresholdWarningIntf->warningLowAlarmAsserted(value);
             }
@@ -869,20 +1026,12 @@ void NumericSensor::updateThresholds()
             {
                 thresholdWarningIntf->warningLowAlarmDeasserted(value);
             }
-        }
-    }
-
-    if (thresholdCriticalIntf &&
-        !std::isnan(thresholdCriticalIntf->criticalHigh()))
-    {
-        auto threshold = thresholdCriticalIntf->criticalHigh();
-        auto alarm = thresholdCriticalIntf->criticalAlarmHigh();
-        auto newAlarm =
-            checkThreshold(alarm, true, value, threshold, hysteresis);
-        if (alarm != newAlarm)
-        {
-            thresholdCriticalIntf->criticalAlarmHigh(newAlarm);
-            if (newAlarm)
+            break;
+        case criticalHighAlarm:
+            thresholdCriticalIntf->criticalAlarmHigh(asserted,
+                                                     batchedPublication);
+            markPending(criticalHighChange);
+            if (asserted)
             {
                 thresholdCriticalIntf->criticalHighAlarmAsserted(value);
             }
@@ -890,20 +1039,12 @@ void NumericSensor::updateThresholds()
             {
                 thresholdCriticalIntf->criticalHighAlarmDeasserted(value);
             }
-        }
-    }
-
-    if (thresholdCriticalIntf &&
-        !std::isnan(thresholdCriticalIntf->criticalLow()))
-    {
-        auto threshold = thresholdCriticalIntf->criticalLow();
-        auto alarm = thresholdCriticalIntf->criticalAlarmLow();
-        auto newAlarm =
-            checkThreshold(alarm, false, value, threshold, hysteresis);
-        if (alarm != newAlarm)
-        {
-            thresholdCriticalIntf->criticalAlarmLow(newAlarm);
-            if (newAlarm)
+            break;
+        case criticalLowAlarm:
+            thresholdCriticalIntf->criticalAlarmLow(asserted,
+                                                    batchedPublication);
+            markPending(criticalLowChange);
+            if (asserted)
             {
                 thresholdCriticalIntf->criticalLowAlarmAsserted(value);
             }
@@ -911,7 +1052,7 @@ void NumericSensor::updateThresholds()
             {
                 thresholdCriticalIntf->criticalLowAlarmDeasserted(value);
             }
-        }
+            break;
     }
 }
 
@@ -927,7 +1068,7 @@ int NumericSensor::triggerThresholdEvent(
         return PLDM_ERROR;
     }
 
-    auto value = unitModifier(conversionFormula(rawValue));
+    auto value = conversion.convert(rawValue);
     lg2::error(
         "triggerThresholdEvent eventType {TID}, direction {SID} value {VAL} newAlarm {PSTATE} assert {ESTATE}",
         "TID", eventType, "SID", direction, "VAL", value, "PSTATE", newAlarm,
@@ -5,6 +5,7 @@
 
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "sensor_conversion.hpp"
 
 #include <sdbusplus/server/object.hpp>
 #include <xyz/openbmc_project/Association/Definitions/server.hpp>
@@ -16,6 +17,12 @@
 #include <xyz/openbmc_project/State/Decorator/Availability/server.hpp>
 #include <xyz/openbmc_project/State/Decorator/OperationalStatus/server.hpp>
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
 #include <string>
 
 namespace pldm
@@ -25,6 +32,14 @@ namespace platform_mc
 
 constexpr const char* SENSOR_VALUE_INTF = "xyz.openbmc_project.Sensor.Value";
 constexpr const char* METRIC_VALUE_INTF = "xyz.openbmc_project.Metric.Value";
+constexpr const char* AVAILABILITY_INTF =
+    "xyz.openbmc_project.State.Decorator.Availability";
+constexpr const char* OPERATIONAL_STATUS_INTF =
+    "xyz.openbmc_project.State.Decorator.OperationalStatus";
+constexpr const char* THRESHOLD_WARNING_INTF =
+    "xyz.openbmc_project.Sensor.Threshold.Warning";
+constexpr const char* THRESHOLD_CRITICAL_INTF =
+    "xyz.openbmc_project.Sensor.Threshold.Critical";
 
 using SensorUnit = sdbusplus::xyz::openbmc_project::Sensor::server::Value::Unit;
 using ValueIntf = sdbusplus::server::object_t<
@@ -71,9 +86,97 @@ class NumericSensor
     void handleErrGetSensorReading();
 
     /** @brief Updating the sensor status to D-Bus interface
+     *
+     *  A reading which moved less than the deadband from the published one
+     *  is not published, the thresholds are still checked against it.
      */
     void updateReading(bool available, bool functional, double value = 0);
 
+    /** @brief Get the reading published on D-Bus
+     *
+     *  @return double - the reading, NaN when there is none
+     */
+    double getReading() const
+    {
+        if (useMetricInterface)
+        {
+            return metricIntf ? metricIntf->value()
+                              : std::numeric_limits<double>::quiet_NaN();
+        }
+        return valueIntf ? valueIntf->value()
+                         : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /** @brief Get the Available property published on D-Bus */
+    bool isAvailable() const
+    {
+        return availabilityIntf && availabilityIntf->available();
+    }
+
+    /** @brief Get the Functional property published on D-Bus */
+    bool isFunctional() const
+    {
+        return operationalStatusIntf && operationalStatusIntf->functional();
+    }
+
+    /** @brief Set the function called after each update of the sensor, by
+     *         a reading, an error or an event
+     *
+     *  @param[in] handler - the function, empty for none
+     */
+    void setUpdateHandler(std::function<void(const NumericSensor&)> handler)
+    {
+        updateHandler = std::move(handler);
+    }
+
+    /** @brief Set the deadband of the sensor
+     *
+     *  @param[in] deadband - smallest change of the reading, in the unit of
+     *                        the sensor, which is published. 0 publishes
+     *                        every change.
+     */
+    void setDeadband(double deadband)
+    {
+        this->deadband =
+            (std::isnan(deadband) || deadband < 0) ? 0 : deadband;
+    }
+
+    /** @brief Get the deadband of the sensor */
+    double getDeadband() const
+    {
+        return deadband;
+    }
+
+    /** @brief Set whether the changes of the sensor are published in batches
+     *
+     *  In batched publication the D-Bus properties are updated without
+     *  signal and publish() emits one PropertiesChanged signal per interface
+     *  for all the properties changed since the previous publication.
+     *  Turning the batched publication off publishes the pending changes.
+     *
+     *  @param[in] batched - true to publish the changes in batches
+     */
+    void setBatchedPublication(bool batched);
+
+    /** @brief Set the function called when a change of the sensor starts
+     *         waiting for publish(), whatever updated the sensor
+     *
+     *  @param[in] handler - the function, empty for none
+     */
+    void setPendingHandler(std::function<void()> handler)
+    {
+        pendingHandler = std::move(handler);
+    }
+
+    /** @brief Check whether changes of the sensor wait for publish() */
+    bool hasPendingChanges() const
+    {
+        return pendingChanges != 0;
+    }
+
+    /** @brief Emit the PropertiesChanged signals of the pending changes */
+    void publish();
+
     /** @brief ConversionFormula is used to convert raw value to the unit
      * specified in PDR
      *
@@ -203,6 +306,11 @@ class NumericSensor
     /** @brief  The time of sensor update interval in usec */
     uint64_t updateTime;
 
+    /** @brief Whether the sensor sends its numeric sensor events, as of its
+     *         last GetSensorReading
+     */
+    bool eventsEnabled = false;
+
     /** @brief  sensorName */
     std::string sensorName;
 
@@ -210,11 +318,80 @@ class NumericSensor
     std::string sensorNameSpace;
 
   private:
+    /** @enum PendingChange
+     *
+     *  The properties changed without signal in batched publication
+     */
+    enum PendingChange : uint8_t
+    {
+        valueChange = 1 << 0,
+        availableChange = 1 << 1,
+        functionalChange = 1 << 2,
+        warningHighChange = 1 << 3,
+        warningLowChange = 1 << 4,
+        criticalHighChange = 1 << 5,
+        criticalLowChange = 1 << 6,
+    };
+
     /**
      * @brief Check sensor reading if any threshold has been crossed and update
      * Threshold interfaces accordingly
+     *
+     * The raw readings are checked against the thresholds translated into the
+     * raw domain, the other readings against the thresholds.
+     *
+     * @param[in] rawValue - the raw sensor reading
+     * @param[in] value - the converted sensor reading
+     */
+    void updateThresholds(double rawValue, double value);
+
+    /** @brief Get the warning high, warning low, critical high and critical
+     *         low thresholds, NaN when not set
+     */
+    std::array<double, 4> getThresholds() const;
+
+    /** @brief Get the ThresholdAlarm bits of the asserted alarms */
+    uint8_t getThresholdAlarms() const;
+
+    /** @brief Translate the thresholds into the raw domain when they changed
+     *
+     *  @param[in] thresholds - the current thresholds
+     *
+     *  @return true when the raw readings can be checked with rawThresholds
+     */
+    bool refreshRawThresholds(const std::array<double, 4>& thresholds);
+
+    /** @brief Set a threshold alarm and signal its assertion or deassertion
+     *
+     *  @param[in] alarm - the alarm
+     *  @param[in] asserted - new state of the alarm
+     *  @param[in] value - the converted sensor reading
      */
-    void updateThresholds();
+    void setThresholdAlarm(ThresholdAlarm alarm, bool asserted, double value);
+
+    /** @brief Set the Value property of the Value or Metric interface */
+    void setValue(double value);
+
+    /** @brief Set the Available property */
+    void setAvailable(bool available);
+
+    /** @brief Set the Functional property */
+    void setFunctional(bool functional);
+
+    /** @brief Record a property changed without signal */
+    void markPending(PendingChange change)
+    {
+        if (!batchedPublication)
+        {
+            return;
+        }
+        auto first = !pendingChanges;
+        pendingChanges |= change;
+        if (first && pendingHandler)
+        {
+            pendingHandler();
+        }
+    }
 
     /** @brief Create the sensor inventory path.
      *
@@ -253,7 +430,34 @@ class NumericSensor
 
     /** @brief A power-of-10 multiplier for baseUnit */
     int8_t baseUnitModifier;
+
+    /** @brief The conversion formula and unit modifier, precomputed */
+    SensorConversion conversion;
+
+    /** @brief The thresholds translated into the raw domain */
+    std::optional<RawThresholds> rawThresholds;
+
+    /** @brief The thresholds rawThresholds was translated from */
+    std::optional<std::array<double, 4>> rawThresholdsSource;
     bool useMetricInterface = false;
+
+    /** @brief D-Bus object path of the sensor */
+    std::string objectPath;
+
+    /** @brief Smallest change of the reading which is published */
+    double deadband = 0;
+
+    /** @brief Whether the changes are published by publish() */
+    bool batchedPublication = false;
+
+    /** @brief The PendingChange bits of the changes not yet published */
+    uint8_t pendingChanges = 0;
+
+    /** @brief Called after each update of the sensor */
+    std::function<void(const NumericSensor&)> updateHandler;
+
+    /** @brief Called when the first change waits for publish() */
+    std::function<void()> pendingHandler;
 };
 } // namespace platform_mc
 } // namespace pldm
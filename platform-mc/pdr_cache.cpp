@@ -0,0 +1,207 @@
+#include "pdr_cache.hpp"
+
+#include "libpldm/utils.h"
+
+#include "requester/mctp_endpoint_discovery.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace platform_mc
+{
+namespace fs = std::filesystem;
+
+/* A cache file is the magic, the version, the signature of the repository,
+ * the number of PDRs, the size and the bytes of each PDR, then the CRC32 of
+ * everything before it. The integers are in the byte order of the BMC, the
+ * files are not meant to be moved to another machine.
+ */
+constexpr uint32_t cacheMagic = 0x43524450; // "PDRC"
+constexpr uint32_t cacheVersion = 1;
+
+namespace
+{
+
+template <typename T>
+void append(std::vector<uint8_t>& buffer, const T& value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename T>
+bool extract(std::span<const uint8_t>& buffer, T& value)
+{
+    if (buffer.size() < sizeof(value))
+    {
+        return false;
+    }
+    std::memcpy(&value, buffer.data(), sizeof(value));
+    buffer = buffer.subspan(sizeof(value));
+    return true;
+}
+
+} // namespace
+
+bool PdrCache::isCacheable(const UUID& uuid)
+{
+    return !uuid.empty() && uuid != emptyUUID &&
+           std::ranges::all_of(uuid, [](unsigned char c) {
+               return std::isxdigit(c) || c == '-';
+           });
+}
+
+fs::path PdrCache::getPath(const UUID& uuid) const
+{
+    return dir / uuid;
+}
+
+std::optional<std::vector<std::vector<uint8_t>>> PdrCache::load(
+    const UUID& uuid, const PdrRepositorySignature& signature) const
+{
+    if (!isCacheable(uuid))
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream file(getPath(uuid), std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+
+    uint32_t checksum = 0;
+    if (data.size() < sizeof(checksum))
+    {
+        return std::nullopt;
+    }
+    std::memcpy(&checksum, data.data() + data.size() - sizeof(checksum),
+                sizeof(checksum));
+    data.resize(data.size() - sizeof(checksum));
+    if (checksum != crc32(data.data(), data.size()))
+    {
+        lg2::warning("Ignoring the corrupted PDR cache of terminus {UUID}",
+                     "UUID", uuid);
+        return std::nullopt;
+    }
+
+    std::span<const uint8_t> buffer(data);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    PdrRepositorySignature cached{};
+    uint32_t pdrCount = 0;
+    if (!extract(buffer, magic) || !extract(buffer, version) ||
+        magic != cacheMagic || version != cacheVersion ||
+        !extract(buffer, cached.recordCount) ||
+        !extract(buffer, cached.repositorySize) ||
+        !extract(buffer, cached.largestRecordSize) ||
+        !extract(buffer, cached.updateTime) || !extract(buffer, pdrCount))
+    {
+        return std::nullopt;
+    }
+    if (cached != signature)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::vector<uint8_t>> pdrs;
+    pdrs.reserve(std::min<size_t>(pdrCount, buffer.size()));
+    for (uint32_t idx = 0; idx < pdrCount; ++idx)
+    {
+        uint32_t size = 0;
+        if (!extract(buffer, size) || buffer.size() < size)
+        {
+            return std::nullopt;
+        }
+        pdrs.emplace_back(buffer.begin(), buffer.begin() + size);
+        buffer = buffer.subspan(size);
+    }
+    if (!buffer.empty())
+    {
+        return std::nullopt;
+    }
+
+    return pdrs;
+}
+
+bool PdrCache::store(const UUID& uuid, const PdrRepositorySignature& signature,
+                     const std::vector<std::vector<uint8_t>>& pdrs) const
+{
+    if (!isCacheable(uuid))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    append(data, cacheMagic);
+    append(data, cacheVersion);
+    append(data, signature.recordCount);
+    append(data, signature.repositorySize);
+    append(data, signature.largestRecordSize);
+    append(data, signature.updateTime);
+    append(data, static_cast<uint32_t>(pdrs.size()));
+    for (const auto& pdr : pdrs)
+    {
+        append(data, static_cast<uint32_t>(pdr.size()));
+        data.insert(data.end(), pdr.begin(), pdr.end());
+    }
+    append(data, crc32(data.data(), data.size()));
+
+    /* Write a temporary file renamed over the cache file, so that a crash
+     * while writing does not leave a truncated cache file behind */
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    auto path = getPath(uuid);
+    auto tmpPath = fs::path(path).concat(".tmp");
+    {
+        std::ofstream file(tmpPath, std::ios::out | std::ios::binary |
+                                        std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.close();
+        if (!file)
+        {
+            lg2::warning("Failed to write the PDR cache of terminus {UUID}",
+                         "UUID", uuid);
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        lg2::warning(
+            "Failed to write the PDR cache of terminus {UUID}, error {ERROR}",
+            "UUID", uuid, "ERROR", ec.message());
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+void PdrCache::invalidate(const UUID& uuid) const
+{
+    if (!isCacheable(uuid))
+    {
+        return;
+    }
+
+    std::error_code ec;
+    fs::remove(getPath(uuid), ec);
+}
+
+} // namespace platform_mc
+} // namespace pldm
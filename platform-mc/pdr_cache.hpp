@@ -0,0 +1,104 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include "common/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct PdrRepositorySignature
+ *
+ *  What GetPDRRepositoryInfo reports about the PDR repository of a terminus.
+ *  The repository is assumed unchanged while its signature is.
+ */
+struct PdrRepositorySignature
+{
+    uint32_t recordCount = 0;
+    uint32_t repositorySize = 0;
+    uint32_t largestRecordSize = 0;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{};
+
+    bool operator==(const PdrRepositorySignature&) const = default;
+};
+
+/**
+ * @brief PdrCache
+ *
+ * Keeps the PDRs fetched from the termini on disk, one file per terminus
+ * named after its UUID, so that a terminus discovered again, e.g. after a
+ * restart of pldmd, does not have its repository walked again with GetPDR
+ * while the signature of the repository is unchanged. The cache is best
+ * effort: a file which cannot be read, is corrupted or was written from
+ * another repository is a miss.
+ */
+class PdrCache
+{
+  public:
+    PdrCache() = delete;
+    PdrCache(const PdrCache&) = delete;
+    PdrCache(PdrCache&&) = delete;
+    PdrCache& operator=(const PdrCache&) = delete;
+    PdrCache& operator=(PdrCache&&) = delete;
+    ~PdrCache() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] dir - directory of the cache files, created when the first
+     *                   file is stored
+     */
+    explicit PdrCache(const std::filesystem::path& dir) : dir(dir) {}
+
+    /** @brief Check whether the PDRs of a terminus can be cached, only the
+     *         termini with a UUID can
+     *
+     *  @param[in] uuid - UUID of the terminus
+     */
+    static bool isCacheable(const UUID& uuid);
+
+    /** @brief Load the cached PDRs of a terminus
+     *
+     *  @param[in] uuid - UUID of the terminus
+     *  @param[in] signature - current signature of the PDR repository
+     *
+     *  @return the PDRs, std::nullopt when they are not cached or were cached
+     *          with another signature
+     */
+    std::optional<std::vector<std::vector<uint8_t>>>
+        load(const UUID& uuid, const PdrRepositorySignature& signature) const;
+
+    /** @brief Cache the PDRs of a terminus, replacing the cached ones
+     *
+     *  @param[in] uuid - UUID of the terminus
+     *  @param[in] signature - signature of the PDR repository
+     *  @param[in] pdrs - the PDRs fetched from the repository
+     *
+     *  @return true when the PDRs were written
+     */
+    bool store(const UUID& uuid, const PdrRepositorySignature& signature,
+               const std::vector<std::vector<uint8_t>>& pdrs) const;
+
+    /** @brief Drop the cached PDRs of a terminus
+     *
+     *  @param[in] uuid - UUID of the terminus
+     */
+    void invalidate(const UUID& uuid) const;
+
+  private:
+    /** @brief Get the path of the cache file of a terminus */
+    std::filesystem::path getPath(const UUID& uuid) const;
+
+    /** @brief Directory of the cache files */
+    std::filesystem::path dir;
+};
+
+} // namespace platform_mc
+} // namespace pldm
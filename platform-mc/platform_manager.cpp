@@ -4,6 +4,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <ranges>
 
 PHOSPHOR_LOG2_USING;
@@ -15,59 +16,82 @@ namespace platform_mc
 
 exec::task<int> PlatformManager::initTerminus()
 {
-    for (auto& [tid, terminus] : termini)
+    /* The termini may change while one is initialized */
+    std::vector<pldm_tid_t> tids;
+    for (const auto& [tid, terminus] : termini)
     {
-        if (terminus->initialized)
+        if (!terminus->initialized)
         {
-            continue;
+            tids.push_back(tid);
         }
+    }
 
-        if (terminus->doesSupportCommand(PLDM_PLATFORM, PLDM_GET_PDR))
-        {
-            auto rc = co_await getPDRs(terminus);
-            if (rc)
-            {
-                lg2::error(
-                    "Failed to fetch PDRs for terminus with TID: {TID}, error: {ERROR}",
-                    "TID", tid, "ERROR", rc);
-                continue; // Continue to next terminus
-            }
+    for (const auto& tid : tids)
+    {
+        co_await initTerminus(tid);
+    }
 
-            terminus->parseTerminusPDRs();
-        }
+    co_return PLDM_SUCCESS;
+}
 
-        uint16_t terminusMaxBufferSize = terminus->maxBufferSize;
-        if (!terminus->doesSupportCommand(PLDM_PLATFORM,
-                                          PLDM_EVENT_MESSAGE_BUFFER_SIZE))
-        {
-            terminusMaxBufferSize = PLDM_PLATFORM_DEFAULT_MESSAGE_BUFFER_SIZE;
-        }
-        else
+exec::task<int> PlatformManager::initTerminus(pldm_tid_t tid)
+{
+    auto it = termini.find(tid);
+    if (it == termini.end())
+    {
+        co_return PLDM_ERROR;
+    }
+    /* Keep the terminus alive even if it is removed meanwhile */
+    auto terminus = it->second;
+    if (terminus->initialized)
+    {
+        co_return PLDM_SUCCESS;
+    }
+
+    if (terminus->doesSupportCommand(PLDM_PLATFORM, PLDM_GET_PDR))
+    {
+        auto rc = co_await getPDRs(terminus);
+        if (rc)
         {
-            /* Get maxBufferSize use PLDM command eventMessageBufferSize */
-            auto rc = co_await eventMessageBufferSize(
-                tid, terminus->maxBufferSize, terminusMaxBufferSize);
-            if (rc != PLDM_SUCCESS)
-            {
-                lg2::error(
-                    "Failed to get message buffer size for terminus with TID: {TID}, error: {ERROR}",
-                    "TID", tid, "ERROR", rc);
-                terminusMaxBufferSize =
-                    PLDM_PLATFORM_DEFAULT_MESSAGE_BUFFER_SIZE;
-            }
+            lg2::error(
+                "Failed to fetch PDRs for terminus with TID: {TID}, error: {ERROR}",
+                "TID", tid, "ERROR", rc);
+            co_return rc;
         }
-        terminus->maxBufferSize =
-            std::min(terminus->maxBufferSize, terminusMaxBufferSize);
 
-        auto rc = co_await configEventReceiver(tid);
-        if (rc)
+        terminus->parseTerminusPDRs();
+    }
+
+    uint16_t terminusMaxBufferSize = terminus->maxBufferSize;
+    if (!terminus->doesSupportCommand(PLDM_PLATFORM,
+                                      PLDM_EVENT_MESSAGE_BUFFER_SIZE))
+    {
+        terminusMaxBufferSize = PLDM_PLATFORM_DEFAULT_MESSAGE_BUFFER_SIZE;
+    }
+    else
+    {
+        /* Get maxBufferSize use PLDM command eventMessageBufferSize */
+        auto rc = co_await eventMessageBufferSize(
+            tid, terminus->maxBufferSize, terminusMaxBufferSize);
+        if (rc != PLDM_SUCCESS)
         {
             lg2::error(
-                "Failed to config event receiver for terminus with TID: {TID}, error: {ERROR}",
+                "Failed to get message buffer size for terminus with TID: {TID}, error: {ERROR}",
                 "TID", tid, "ERROR", rc);
+            terminusMaxBufferSize = PLDM_PLATFORM_DEFAULT_MESSAGE_BUFFER_SIZE;
         }
-        terminus->initialized = true;
     }
+    terminus->maxBufferSize =
+        std::min(terminus->maxBufferSize, terminusMaxBufferSize);
+
+    auto rc = co_await configEventReceiver(tid);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to config event receiver for terminus with TID: {TID}, error: {ERROR}",
+            "TID", tid, "ERROR", rc);
+    }
+    terminus->initialized = true;
 
     co_return PLDM_SUCCESS;
 }
@@ -163,6 +187,10 @@ exec::task<int> PlatformManager::configEventReceiver(pldm_tid_t tid)
                 "Failed to set event receiver for terminus with TID: {TID}, error: {ERROR}",
                 "TID", tid, "ERROR", rc);
         }
+        else
+        {
+            terminus->eventReceiverConfigured = true;
+        }
     }
 
     co_return PLDM_SUCCESS;
@@ -178,12 +206,15 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
     uint32_t recordCount = std::numeric_limits<uint32_t>::max();
     uint32_t repositorySize = 0;
     uint32_t largestRecordSize = std::numeric_limits<uint32_t>::max();
+    /* The PDRs are only cached for a repository which has a signature */
+    std::optional<PdrRepositorySignature> signature;
     if (terminus->doesSupportCommand(PLDM_PLATFORM,
                                      PLDM_GET_PDR_REPOSITORY_INFO))
     {
-        auto rc =
-            co_await getPDRRepositoryInfo(tid, repositoryState, recordCount,
-                                          repositorySize, largestRecordSize);
+        std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{};
+        auto rc = co_await getPDRRepositoryInfo(
+            tid, repositoryState, updateTime, recordCount, repositorySize,
+            largestRecordSize);
         if (rc)
         {
             lg2::error(
@@ -192,6 +223,8 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
         }
         else
         {
+            signature = PdrRepositorySignature{recordCount, repositorySize,
+                                               largestRecordSize, updateTime};
             recordCount =
                 std::min(recordCount + 1, std::numeric_limits<uint32_t>::max());
             largestRecordSize = std::min(largestRecordSize + 1,
@@ -204,6 +237,23 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
         co_return PLDM_ERROR_NOT_READY;
     }
 
+    /* The PDRs are cached by the UUID of the terminus */
+    std::optional<UUID> uuid;
+    auto mctpInfo = terminusManager.toMctpInfo(tid);
+    if (pdrCache && signature && mctpInfo &&
+        PdrCache::isCacheable(std::get<1>(mctpInfo.value())))
+    {
+        uuid = std::get<1>(mctpInfo.value());
+        auto pdrs = pdrCache->load(uuid.value(), signature.value());
+        if (pdrs && co_await revalidateCachedPDRs(tid, pdrs.value()))
+        {
+            lg2::info("Loaded {COUNT} PDRs of terminus {TID} from the cache",
+                      "COUNT", pdrs->size(), "TID", tid);
+            terminus->pdrs = std::move(pdrs.value());
+            co_return PLDM_SUCCESS;
+        }
+    }
+
     uint32_t recordHndl = 0;
     uint32_t nextRecordHndl = 0;
     uint32_t nextDataTransferHndl = 0;
@@ -278,9 +328,71 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
         receivedRecordCount++;
     } while (nextRecordHndl != 0 && receivedRecordCount < recordCount);
 
+    if (uuid)
+    {
+        pdrCache->store(uuid.value(), signature.value(), terminus->pdrs);
+    }
+
     co_return PLDM_SUCCESS;
 }
 
+exec::task<bool> PlatformManager::revalidateCachedPDRs(
+    pldm_tid_t tid, const std::vector<std::vector<uint8_t>>& pdrs)
+{
+    if (pdrs.empty())
+    {
+        co_return false;
+    }
+
+    uint32_t nextRecordHndl = 0;
+    uint32_t nextDataTransferHndl = 0;
+    uint8_t transferFlag = 0;
+    uint16_t responseCnt = 0;
+    constexpr uint16_t recvBufSize = PLDM_PLATFORM_GETPDR_MAX_RECORD_BYTES;
+    std::vector<uint8_t> recvBuf(recvBufSize);
+    uint8_t transferCrc = 0;
+
+    auto rc = co_await getPDR(tid, 0, 0, PLDM_GET_FIRSTPART, recvBufSize, 0,
+                              nextRecordHndl, nextDataTransferHndl,
+                              transferFlag, responseCnt, recvBuf, transferCrc);
+    if (rc)
+    {
+        co_return false;
+    }
+
+    /* The first part of the first PDR must be the start of the cached one,
+     * and all of it for a single-part PDR */
+    const auto& firstPdr = pdrs.front();
+    if (responseCnt > firstPdr.size() ||
+        (transferFlag == PLDM_PLATFORM_TRANSFER_START_AND_END &&
+         responseCnt != firstPdr.size()) ||
+        !std::equal(recvBuf.begin(), recvBuf.begin() + responseCnt,
+                    firstPdr.begin()))
+    {
+        lg2::info("The cached PDRs of terminus {TID} are stale", "TID", tid);
+        co_return false;
+    }
+
+    /* The next record must be the second cached PDR */
+    uint32_t cachedNextRecordHndl = 0;
+    if (pdrs.size() > 1)
+    {
+        if (pdrs[1].size() < sizeof(pldm_pdr_hdr))
+        {
+            co_return false;
+        }
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdrs[1].data());
+        cachedNextRecordHndl = le32toh(pdrHdr->record_handle);
+    }
+    if (nextRecordHndl != cachedNextRecordHndl)
+    {
+        lg2::info("The cached PDRs of terminus {TID} are stale", "TID", tid);
+        co_return false;
+    }
+
+    co_return true;
+}
+
 exec::task<int> PlatformManager::getPDR(
     const pldm_tid_t tid, const uint32_t recordHndl,
     const uint32_t dataTransferHndl, const uint8_t transferOpFlag,
@@ -304,8 +416,9 @@ exec::task<int> PlatformManager::getPDR(
 
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
-    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
-                                                  &responseLen);
+    rc = co_await terminusManager.sendRecvPldmMsg(
+        tid, request, &responseMsg, &responseLen,
+        requester::RequestClass::Bulk, true);
     if (rc)
     {
         lg2::error(
@@ -331,15 +444,17 @@ exec::task<int> PlatformManager::getPDR(
     {
         lg2::error("Error : GetPDR for terminus ID {TID}, complete code {CC}.",
                    "TID", tid, "CC", completionCode);
-        co_return rc;
+        co_return completionCode;
     }
 
     co_return completionCode;
 }
 
 exec::task<int> PlatformManager::getPDRRepositoryInfo(
-    const pldm_tid_t tid, uint8_t& repositoryState, uint32_t& recordCount,
-    uint32_t& repositorySize, uint32_t& largestRecordSize)
+    const pldm_tid_t tid, uint8_t& repositoryState,
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& updateTime,
+    uint32_t& recordCount, uint32_t& repositorySize,
+    uint32_t& largestRecordSize)
 {
     Request request(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
     auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
@@ -355,8 +470,9 @@ exec::task<int> PlatformManager::getPDRRepositoryInfo(
 
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
-    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
-                                                  &responseLen);
+    rc = co_await terminusManager.sendRecvPldmMsg(
+        tid, request, &responseMsg, &responseLen,
+        requester::RequestClass::Control, true);
     if (rc)
     {
         lg2::error(
@@ -366,7 +482,6 @@ exec::task<int> PlatformManager::getPDRRepositoryInfo(
     }
 
     uint8_t completionCode = 0;
-    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime = {};
     std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime = {};
     uint8_t dataTransferHandleTimeout = 0;
 
@@ -387,7 +502,7 @@ exec::task<int> PlatformManager::getPDRRepositoryInfo(
         lg2::error(
             "Error : GetPDRRepositoryInfo for terminus ID {TID}, complete code {CC}.",
             "TID", tid, "CC", completionCode);
-        co_return rc;
+        co_return completionCode;
     }
 
     co_return completionCode;
@@ -3,6 +3,7 @@
 #include "libpldm/platform.h"
 #include "libpldm/pldm.h"
 
+#include "pdr_cache.hpp"
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
@@ -29,17 +30,34 @@ class PlatformManager
     PlatformManager& operator=(PlatformManager&&) = delete;
     ~PlatformManager() = default;
 
+    /** @brief Constructor
+     *
+     *  @param[in] terminusManager - reference to TerminusManager
+     *  @param[in] termini - list of discovered termini
+     *  @param[in] pdrCache - cache of the PDRs of the termini, nullptr to
+     *                        always fetch the PDRs from the termini
+     */
     explicit PlatformManager(TerminusManager& terminusManager,
-                             TerminiMapper& termini) :
-        terminusManager(terminusManager), termini(termini)
+                             TerminiMapper& termini,
+                             PdrCache* pdrCache = nullptr) :
+        terminusManager(terminusManager), termini(termini), pdrCache(pdrCache)
     {}
 
-    /** @brief Initialize terminus which supports PLDM Type 2
+    /** @brief Initialize the termini which support PLDM Type 2, one after
+     *         the other
      *
      *  @return coroutine return_value - PLDM completion code
      */
     exec::task<int> initTerminus();
 
+    /** @brief Initialize a terminus which supports PLDM Type 2: fetch its
+     *         PDRs and configure its event receiver
+     *
+     *  @param[in] tid - TID of the terminus
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> initTerminus(pldm_tid_t tid);
+
     /** @brief Helper to get the supported event messages and set event receiver
      *
      *  @param[in] tid - Destination TID
@@ -48,13 +66,25 @@ class PlatformManager
     exec::task<int> configEventReceiver(pldm_tid_t tid);
 
   private:
-    /** @brief Fetch all PDRs from terminus.
+    /** @brief Fetch all PDRs from terminus, or from the PDR cache when the
+     *         signature of the PDR repository of the terminus did not change
      *
      *  @param[in] terminus - The terminus object to store fetched PDRs
      *  @return coroutine return_value - PLDM completion code
      */
     exec::task<int> getPDRs(std::shared_ptr<Terminus> terminus);
 
+    /** @brief Check that cached PDRs are still those of the terminus by
+     *         fetching the first part of its first PDR
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] pdrs - The cached PDRs
+     *  @return coroutine return_value - true when the first PDR and the
+     *          handle of the next one match the cached PDRs
+     */
+    exec::task<bool> revalidateCachedPDRs(
+        pldm_tid_t tid, const std::vector<std::vector<uint8_t>>& pdrs);
+
     /** @brief Fetch PDR from terminus
      *
      *  @param[in] tid - Destination TID
@@ -83,6 +113,7 @@ class PlatformManager
      *
      *  @param[in] tid - Destination TID
      *  @param[out] repositoryState - the state of repository
+     *  @param[out] updateTime - time of the last update of the repository
      *  @param[out] recordCount - number of records
      *  @param[out] repositorySize - repository size
      *  @param[out] largestRecordSize - largest record size
@@ -90,8 +121,10 @@ class PlatformManager
      *  @return coroutine return_value - PLDM completion code
      */
     exec::task<int> getPDRRepositoryInfo(
-        const pldm_tid_t tid, uint8_t& repositoryState, uint32_t& recordCount,
-        uint32_t& repositorySize, uint32_t& largestRecordSize);
+        const pldm_tid_t tid, uint8_t& repositoryState,
+        std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& updateTime,
+        uint32_t& recordCount, uint32_t& repositorySize,
+        uint32_t& largestRecordSize);
 
     /** @brief Send setEventReceiver command to destination EID.
      *
@@ -143,6 +176,9 @@ class PlatformManager
 
     /** @brief Managed termini list */
     TerminiMapper& termini;
+
+    /** @brief Cache of the PDRs of the termini, may be nullptr */
+    PdrCache* pdrCache;
 };
 } // namespace platform_mc
 } // namespace pldm
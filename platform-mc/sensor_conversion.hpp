@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct SensorConversion
+ *
+ *  The conversion formula and the unit modifier of a numeric sensor combined
+ *  into one multiply-add, computed once from the PDR rather than on every
+ *  reading: value = raw * scale + shift.
+ */
+struct SensorConversion
+{
+    /** @brief 10 to the power of the unit modifier */
+    double unitScale = 1;
+    double scale = 1;
+    double shift = 0;
+
+    SensorConversion() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] resolution - resolution of the sensor, NaN for 1
+     *  @param[in] offset - offset of the sensor, NaN for 0
+     *  @param[in] unitModifier - power-of-10 multiplier of the base unit
+     */
+    SensorConversion(double resolution, double offset, int8_t unitModifier) :
+        unitScale(std::pow(10, unitModifier)),
+        scale((std::isnan(resolution) ? 1 : resolution) * unitScale),
+        shift((std::isnan(offset) ? 0 : offset) * unitScale)
+    {}
+
+    /** @brief Convert a raw reading to the unit of the sensor */
+    double convert(double raw) const
+    {
+        return raw * scale + shift;
+    }
+};
+
+/** @brief The threshold alarms of a numeric sensor, as bits */
+enum ThresholdAlarm : uint8_t
+{
+    warningHighAlarm = 1 << 0,
+    warningLowAlarm = 1 << 1,
+    criticalHighAlarm = 1 << 2,
+    criticalLowAlarm = 1 << 3,
+};
+
+/** @struct RawThresholds
+ *
+ *  The warning and critical thresholds of a numeric sensor, with their
+ *  hysteresis, translated into the raw domain of the sensor so that the
+ *  thresholds are checked with integer compares before any conversion. A
+ *  raw reading crosses a translated threshold exactly when its converted
+ *  reading crosses the threshold.
+ */
+struct RawThresholds
+{
+    /** @brief Raw readings beyond which no threshold is translated, the
+     *         doubles represent every integer up to there
+     */
+    static constexpr int64_t rawLimit = int64_t{1} << 53;
+
+    /** @brief The thresholds in the order of the ThresholdAlarm bits */
+    static constexpr std::array<ThresholdAlarm, 4> alarms{
+        warningHighAlarm, warningLowAlarm, criticalHighAlarm,
+        criticalLowAlarm};
+
+    /** @brief Raw reading from which a high alarm is asserted, or up to which
+     *         a low alarm is asserted
+     */
+    std::array<int64_t, 4> assertAt{};
+
+    /** @brief Raw reading under which a high alarm is deasserted, or over
+     *         which a low alarm is deasserted
+     */
+    std::array<int64_t, 4> deassertAt{};
+
+    /** @brief The ThresholdAlarm bits of the thresholds which are set */
+    uint8_t enabled = 0;
+
+    /** @brief The conversion decreases with the raw reading, the raw readings
+     *         are negated to be compared
+     */
+    bool inverted = false;
+
+    /** @brief Translate the thresholds of a sensor into its raw domain
+     *
+     *  @param[in] conversion - conversion of the sensor
+     *  @param[in] thresholds - warning high, warning low, critical high and
+     *                          critical low thresholds in the unit of the
+     *                          sensor, NaN when not set
+     *  @param[in] hysteresis - hysteresis in the unit of the sensor
+     *
+     *  @return the translated thresholds, std::nullopt when the conversion
+     *          does not depend on the raw reading
+     */
+    static std::optional<RawThresholds>
+        fromThresholds(const SensorConversion& conversion,
+                       const std::array<double, 4>& thresholds,
+                       double hysteresis)
+    {
+        if (!std::isfinite(conversion.scale) || conversion.scale == 0 ||
+            !std::isfinite(conversion.shift))
+        {
+            return std::nullopt;
+        }
+
+        RawThresholds raw{};
+        raw.inverted = conversion.scale < 0;
+        /* Negating the raw reading and the scale gives the same product */
+        SensorConversion increasing = conversion;
+        increasing.scale = std::abs(conversion.scale);
+
+        for (size_t idx = 0; idx < alarms.size(); ++idx)
+        {
+            auto threshold = thresholds[idx];
+            if (std::isnan(threshold))
+            {
+                continue;
+            }
+            raw.enabled |= alarms[idx];
+            if (isHigh(alarms[idx]))
+            {
+                raw.assertAt[idx] = minRawAtLeast(increasing, threshold);
+                raw.deassertAt[idx] =
+                    minRawAtLeast(increasing, threshold - hysteresis);
+            }
+            else
+            {
+                raw.assertAt[idx] = maxRawAtMost(increasing, threshold);
+                raw.deassertAt[idx] =
+                    maxRawAtMost(increasing, threshold + hysteresis);
+            }
+        }
+        return raw;
+    }
+
+    /** @brief Check a raw reading against the thresholds
+     *
+     *  A high alarm is asserted from its threshold and deasserted under the
+     *  threshold minus the hysteresis, a low alarm is asserted up to its
+     *  threshold and deasserted over the threshold plus the hysteresis, in
+     *  between the alarm is kept.
+     *
+     *  @param[in] rawValue - raw reading
+     *  @param[in] current - the ThresholdAlarm bits currently asserted
+     *
+     *  @return the ThresholdAlarm bits asserted after the reading
+     */
+    uint8_t check(int64_t rawValue, uint8_t current) const
+    {
+        auto value = inverted ? -rawValue : rawValue;
+        /* Branchless, the thresholds are in the order high, low, high, low */
+        unsigned asserted = (value >= assertAt[0]) |
+                            (value <= assertAt[1]) << 1 |
+                            (value >= assertAt[2]) << 2 |
+                            (value <= assertAt[3]) << 3;
+        unsigned deasserted = (value < deassertAt[0]) |
+                              (value > deassertAt[1]) << 1 |
+                              (value < deassertAt[2]) << 2 |
+                              (value > deassertAt[3]) << 3;
+        asserted &= enabled;
+        deasserted &= enabled & ~asserted;
+        return static_cast<uint8_t>((current | asserted) & ~deasserted);
+    }
+
+  private:
+    static constexpr bool isHigh(ThresholdAlarm alarm)
+    {
+        return alarm == warningHighAlarm || alarm == criticalHighAlarm;
+    }
+
+    /** @brief Smallest raw reading converted to at least a value, with an
+     *         increasing conversion
+     */
+    static int64_t minRawAtLeast(const SensorConversion& conversion,
+                                 double value)
+    {
+        if (std::isnan(value))
+        {
+            /* No reading compares less than NaN */
+            return -rawLimit;
+        }
+        auto guess = std::ceil((value - conversion.shift) / conversion.scale);
+        if (!(guess > -rawLimit))
+        {
+            return -rawLimit;
+        }
+        if (!(guess < rawLimit))
+        {
+            return rawLimit;
+        }
+        /* The division may be off by the rounding of the conversion */
+        auto raw = static_cast<int64_t>(guess);
+        while (raw > -rawLimit && conversion.convert(raw - 1) >= value)
+        {
+            --raw;
+        }
+        while (raw < rawLimit && conversion.convert(raw) < value)
+        {
+            ++raw;
+        }
+        return raw;
+    }
+
+    /** @brief Largest raw reading converted to at most a value, with an
+     *         increasing conversion
+     */
+    static int64_t maxRawAtMost(const SensorConversion& conversion,
+                                double value)
+    {
+        if (std::isnan(value))
+        {
+            /* No reading compares greater than NaN */
+            return rawLimit;
+        }
+        auto guess = std::floor((value - conversion.shift) / conversion.scale);
+        if (!(guess > -rawLimit))
+        {
+            return -rawLimit;
+        }
+        if (!(guess < rawLimit))
+        {
+            return rawLimit;
+        }
+        auto raw = static_cast<int64_t>(guess);
+        while (raw < rawLimit && conversion.convert(raw + 1) <= value)
+        {
+            ++raw;
+        }
+        while (raw > -rawLimit && conversion.convert(raw) > value)
+        {
+            --raw;
+        }
+        return raw;
+    }
+};
+
+/** @brief Check the raw readings of a batch of sensors, e.g. of a whole
+ *         terminus, against their thresholds in one loop
+ *
+ *  @param[in] thresholds - the raw thresholds of each sensor
+ *  @param[in] readings - the raw reading of each sensor
+ *  @param[in,out] alarms - the ThresholdAlarm bits asserted for each sensor
+ *
+ *  @return the number of sensors whose alarms changed
+ */
+inline size_t checkRawThresholds(std::span<const RawThresholds> thresholds,
+                                 std::span<const int64_t> readings,
+                                 std::span<uint8_t> alarms)
+{
+    auto count = std::min({thresholds.size(), readings.size(), alarms.size()});
+    size_t changed = 0;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        auto updated = thresholds[idx].check(readings[idx], alarms[idx]);
+        changed += updated != alarms[idx];
+        alarms[idx] = updated;
+    }
+    return changed;
+}
+
+} // namespace platform_mc
+} // namespace pldm
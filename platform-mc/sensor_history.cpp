@@ -0,0 +1,226 @@
+#include "sensor_history.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+std::vector<uint64_t> parseHistoryWindows(std::string_view windows)
+{
+    std::vector<uint64_t> lengths;
+    while (!windows.empty())
+    {
+        auto comma = windows.find(',');
+        auto field = windows.substr(0, comma);
+        windows.remove_prefix(comma == std::string_view::npos ? windows.size()
+                                                              : comma + 1);
+
+        uint64_t seconds = 0;
+        auto [end, ec] = std::from_chars(field.data(),
+                                         field.data() + field.size(), seconds);
+        if (ec == std::errc{} && end == field.data() + field.size() &&
+            seconds && seconds <= UINT64_MAX / 1000000)
+        {
+            lengths.push_back(seconds * 1000000);
+        }
+    }
+    return lengths;
+}
+
+SensorHistory::SensorHistory(size_t sensorCount, size_t depth,
+                             std::span<const uint64_t> windows) :
+    sensorCount(sensorCount), depth(std::max<size_t>(depth, 1))
+{
+    std::ranges::copy_if(windows, std::back_inserter(this->windows),
+                         [](auto window) { return window != 0; });
+
+    blockSize = sizeof(Track) + this->windows.size() * sizeof(Rolling) +
+                this->depth * (sizeof(uint64_t) * 3 + sizeof(double));
+    blockSize = (blockSize + cacheLineSize - 1) / cacheLineSize *
+                cacheLineSize;
+
+    /* Zeroed, every ring and window is empty */
+    arena.reset(new (std::align_val_t{cacheLineSize})
+                    std::byte[sensorCount * blockSize]());
+}
+
+SensorHistory::Block SensorHistory::block(size_t slot) const
+{
+    auto base = arena.get() + slot * blockSize;
+    Block block{};
+    block.track = reinterpret_cast<Track*>(base);
+    base += sizeof(Track);
+    block.rolling = reinterpret_cast<Rolling*>(base);
+    base += windows.size() * sizeof(Rolling);
+    block.timestamps = reinterpret_cast<uint64_t*>(base);
+    base += depth * sizeof(uint64_t);
+    block.values = reinterpret_cast<double*>(base);
+    base += depth * sizeof(double);
+    block.minima = reinterpret_cast<uint64_t*>(base);
+    base += depth * sizeof(uint64_t);
+    block.maxima = reinterpret_cast<uint64_t*>(base);
+    return block;
+}
+
+void SensorHistory::push(size_t slot, uint64_t timestamp, double value)
+{
+    if (slot >= sensorCount || std::isnan(value))
+    {
+        return;
+    }
+    auto b = block(slot);
+    auto& track = *b.track;
+    auto seq = track.next;
+
+    /* The oldest reading leaves the ring, and its windows */
+    uint64_t oldest = seq + 1 > depth ? seq + 1 - depth : 0;
+    for (size_t idx = 0; idx < windows.size(); ++idx)
+    {
+        auto& rolling = b.rolling[idx];
+        for (; rolling.start < oldest; ++rolling.start)
+        {
+            rolling.sum -= b.values[rolling.start % depth];
+        }
+    }
+    while (track.minHead < track.minTail &&
+           b.minima[track.minHead % depth] < oldest)
+    {
+        ++track.minHead;
+    }
+    while (track.maxHead < track.maxTail &&
+           b.maxima[track.maxHead % depth] < oldest)
+    {
+        ++track.maxHead;
+    }
+
+    /* The readings which can no longer be the minimum or maximum of a
+     * window, as the new reading is in every window they are in */
+    while (track.minHead < track.minTail &&
+           b.values[b.minima[(track.minTail - 1) % depth] % depth] >= value)
+    {
+        --track.minTail;
+    }
+    while (track.maxHead < track.maxTail &&
+           b.values[b.maxima[(track.maxTail - 1) % depth] % depth] <= value)
+    {
+        --track.maxTail;
+    }
+
+    if (seq)
+    {
+        /* Keep the ring ordered by time */
+        timestamp = std::max(timestamp, b.timestamps[(seq - 1) % depth]);
+    }
+    b.timestamps[seq % depth] = timestamp;
+    b.values[seq % depth] = value;
+    b.minima[track.minTail++ % depth] = seq;
+    b.maxima[track.maxTail++ % depth] = seq;
+    track.next = seq + 1;
+
+    /* The readings out of each window, keeping the new one */
+    for (size_t idx = 0; idx < windows.size(); ++idx)
+    {
+        auto& rolling = b.rolling[idx];
+        rolling.sum += value;
+        for (; rolling.start < seq &&
+               timestamp - b.timestamps[rolling.start % depth] >= windows[idx];
+             ++rolling.start)
+        {
+            rolling.sum -= b.values[rolling.start % depth];
+        }
+    }
+
+    if (track.next % depth == 0)
+    {
+        resum(b);
+    }
+}
+
+void SensorHistory::resum(const Block& block)
+{
+    for (size_t idx = 0; idx < windows.size(); ++idx)
+    {
+        auto& rolling = block.rolling[idx];
+        rolling.sum = 0;
+        for (auto seq = rolling.start; seq < block.track->next; ++seq)
+        {
+            rolling.sum += block.values[seq % depth];
+        }
+    }
+}
+
+double SensorHistory::front(const Block& block, const uint64_t* queue,
+                            uint64_t head, uint64_t tail,
+                            uint64_t start) const
+{
+    /* The sequence numbers of a queue are increasing, and its last reading
+     * is the latest one, in every window */
+    while (head + 1 < tail)
+    {
+        auto middle = head + (tail - head) / 2;
+        if (queue[(middle - 1) % depth] < start)
+        {
+            head = middle;
+        }
+        else
+        {
+            tail = middle;
+        }
+    }
+    return block.values[queue[head % depth] % depth];
+}
+
+std::vector<HistorySample> SensorHistory::getSamples(size_t slot) const
+{
+    std::vector<HistorySample> samples;
+    if (slot >= sensorCount)
+    {
+        return samples;
+    }
+    auto b = block(slot);
+    auto next = b.track->next;
+    uint64_t oldest = next > depth ? next - depth : 0;
+    samples.reserve(next - oldest);
+    for (auto seq = oldest; seq < next; ++seq)
+    {
+        samples.emplace_back(b.timestamps[seq % depth], b.values[seq % depth]);
+    }
+    return samples;
+}
+
+std::vector<WindowStatistics> SensorHistory::getStatistics(size_t slot) const
+{
+    std::vector<WindowStatistics> statistics;
+    if (slot >= sensorCount)
+    {
+        return statistics;
+    }
+    auto b = block(slot);
+    const auto& track = *b.track;
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t idx = 0; idx < windows.size(); ++idx)
+    {
+        const auto& rolling = b.rolling[idx];
+        auto count = static_cast<uint32_t>(track.next - rolling.start);
+        if (!count)
+        {
+            statistics.emplace_back(windows[idx], 0, nan, nan, nan);
+            continue;
+        }
+        statistics.emplace_back(
+            windows[idx], count,
+            front(b, b.minima, track.minHead, track.minTail, rolling.start),
+            front(b, b.maxima, track.maxHead, track.maxTail, rolling.start),
+            rolling.sum / count);
+    }
+    return statistics;
+}
+
+} // namespace platform_mc
+} // namespace pldm
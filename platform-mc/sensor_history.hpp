@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct HistorySample
+ *
+ *  A reading kept in the history of a sensor
+ */
+struct HistorySample
+{
+    uint64_t timestamp; //!< in usec of CLOCK_MONOTONIC
+    double value;       //!< in the unit of the sensor
+};
+
+/** @struct WindowStatistics
+ *
+ *  The statistics of the readings of a sensor within a window ending at its
+ *  latest reading
+ */
+struct WindowStatistics
+{
+    uint64_t window; //!< length of the window in usec
+    uint32_t count;  //!< readings in the window, fewer than the window holds
+                     //!< when the history is shorter than the window
+    double min;      //!< NaN when there is no reading
+    double max;
+    double mean;
+};
+
+/** @brief Parse the windows of the sensor history statistics
+ *
+ *  @param[in] windows - comma separated lengths in seconds, e.g. "10,60,300"
+ *
+ *  @return the lengths in usec, the invalid and zero lengths skipped
+ */
+std::vector<uint64_t> parseHistoryWindows(std::string_view windows);
+
+/**
+ * @brief SensorHistory
+ *
+ * The latest readings of the numeric sensors of a terminus, a fixed number per
+ * sensor in a ring, with their minimum, maximum and mean within a few windows
+ * updated with each reading rather than computed when queried. The rings and
+ * the statistics of all the sensors of the terminus are allocated at once,
+ * in a cache line aligned block per sensor holding its timestamps, values and
+ * statistics together.
+ *
+ * The minimum and maximum are kept with a monotonic queue over the ring, from
+ * which the minimum or maximum of any window ending at the latest reading is
+ * found by a binary search. The sum of each window is updated as readings
+ * enter and leave it, and recomputed once per ring to bound the rounding
+ * errors.
+ */
+class SensorHistory
+{
+  public:
+    SensorHistory() = delete;
+    SensorHistory(const SensorHistory&) = delete;
+    SensorHistory& operator=(const SensorHistory&) = delete;
+    SensorHistory(SensorHistory&&) = default;
+    SensorHistory& operator=(SensorHistory&&) = default;
+    ~SensorHistory() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] sensorCount - number of sensors, indexed by slot
+     *  @param[in] depth - number of readings kept per sensor, at least 1
+     *  @param[in] windows - lengths in usec of the windows of the statistics
+     */
+    SensorHistory(size_t sensorCount, size_t depth,
+                  std::span<const uint64_t> windows);
+
+    /** @brief Add a reading of a sensor
+     *
+     *  @param[in] slot - slot of the sensor
+     *  @param[in] timestamp - time of the reading in usec of CLOCK_MONOTONIC,
+     *                         not before the previous reading of the sensor
+     *  @param[in] value - the reading, NaN readings are not kept
+     */
+    void push(size_t slot, uint64_t timestamp, double value);
+
+    /** @brief Get the readings kept of a sensor, oldest first */
+    std::vector<HistorySample> getSamples(size_t slot) const;
+
+    /** @brief Get the statistics of a sensor in each window, as of its latest
+     *         reading
+     */
+    std::vector<WindowStatistics> getStatistics(size_t slot) const;
+
+    /** @brief Get the number of sensors */
+    size_t size() const
+    {
+        return sensorCount;
+    }
+
+    /** @brief Get the size of the memory allocated for the history */
+    size_t getArenaSize() const
+    {
+        return sensorCount * blockSize;
+    }
+
+  private:
+    /** @struct Track
+     *
+     *  The positions in the ring and in the monotonic queues of a sensor, as
+     *  sequence numbers of its readings. A queue holds the sequence numbers
+     *  of the readings from position head to tail, modulo the depth.
+     */
+    struct Track
+    {
+        uint64_t next;    //!< sequence number of the next reading
+        uint64_t minHead; //!< the readings with increasing values
+        uint64_t minTail;
+        uint64_t maxHead; //!< the readings with decreasing values
+        uint64_t maxTail;
+    };
+
+    /** @struct Rolling
+     *
+     *  A window of a sensor
+     */
+    struct Rolling
+    {
+        uint64_t start; //!< sequence number of the oldest reading in it
+        double sum;     //!< sum of its readings
+    };
+
+    /** @struct Block
+     *
+     *  The block of a sensor in the arena
+     */
+    struct Block
+    {
+        Track* track;
+        Rolling* rolling;
+        uint64_t* timestamps;
+        double* values;
+        uint64_t* minima;
+        uint64_t* maxima;
+    };
+
+    /** @brief Frees the arena */
+    struct ArenaDeleter
+    {
+        void operator()(std::byte* arena) const
+        {
+            ::operator delete[](arena, std::align_val_t{cacheLineSize});
+        }
+    };
+
+    static constexpr size_t cacheLineSize = 64;
+
+    /** @brief Get the block of a sensor */
+    Block block(size_t slot) const;
+
+    /** @brief Recompute the sum of the windows of a sensor */
+    void resum(const Block& block);
+
+    /** @brief Find the first reading of a monotonic queue in a window, the
+     *         window holding at least the latest reading
+     *
+     *  @return the value of the reading
+     */
+    double front(const Block& block, const uint64_t* queue, uint64_t head,
+                 uint64_t tail, uint64_t start) const;
+
+    size_t sensorCount;
+    size_t depth;
+    std::vector<uint64_t> windows;
+
+    /** @brief Size of the block of a sensor, a multiple of cacheLineSize */
+    size_t blockSize;
+
+    /** @brief The blocks of all the sensors */
+    std::unique_ptr<std::byte[], ArenaDeleter> arena;
+};
+
+} // namespace platform_mc
+} // namespace pldm
@@ -1,10 +1,12 @@
 #include "sensor_manager.hpp"
 
+#include "common/loop_watchdog.hpp"
 #include "manager.hpp"
 #include "terminus_manager.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <exception>
 
 namespace pldm
@@ -16,7 +18,25 @@ SensorManager::SensorManager(sdeventplus::Event& event,
                              TerminusManager& terminusManager,
                              TerminiMapper& termini, Manager* manager) :
     event(event), terminusManager(terminusManager), termini(termini),
-    pollingTime(SENSOR_POLLING_TIME), manager(manager)
+    pollingTime(SENSOR_POLLING_TIME),
+    pollingConcurrency(SENSOR_POLLING_CONCURRENCY),
+    eventLivenessTime(std::chrono::seconds(SENSOR_EVENT_LIVENESS_TIME)),
+    publicationLatency(SENSOR_PUBLICATION_LATENCY),
+    schedulerTimer(event.get(),
+                   watchdog::LoopWatchdog::wrap(
+                       {.kind = watchdog::SourceKind::Timer,
+                        .name = "SensorPolling"},
+                       std::bind_front(&SensorManager::dispatch, this))),
+    publicationTimer(event.get(),
+                     watchdog::LoopWatchdog::wrap(
+                         {.kind = watchdog::SourceKind::Timer,
+                          .name = "SensorPublication"},
+                         std::bind_front(&SensorManager::publishChanges,
+                                         this))),
+    readingRing(SENSOR_READING_RING_ENTRIES, SENSOR_READING_RING_NAME),
+    historyDepth(SENSOR_HISTORY_DEPTH),
+    historyWindows(parseHistoryWindows(SENSOR_HISTORY_WINDOWS)),
+    manager(manager)
 {}
 
 void SensorManager::startPolling(pldm_tid_t tid)
@@ -26,221 +46,486 @@ void SensorManager::startPolling(pldm_tid_t tid)
         return;
     }
 
-    /* tid already initializes roundRobinSensors list */
-    if (sensorPollTimers.contains(tid))
+    if (polling.contains(tid))
     {
-        lg2::info("Terminus ID {TID}: sensor poll timer already exists.", "TID",
+        lg2::info("Terminus ID {TID}: sensors are already polled.", "TID",
                   tid);
         return;
     }
-    // numeric sensor
-    auto terminus = termini[tid];
-    for (auto& sensor : terminus->numericSensors)
+
+    updateAvailableState(tid, true);
+
+    auto& terminusPolling = polling[tid];
+    terminusPolling.generation = ++pollingGeneration;
+
+    std::vector<uint16_t> sensorIds;
+    for (const auto& sensor : termini[tid]->numericSensors)
     {
-        roundRobinSensors[tid].push(sensor);
+        sensorIds.push_back(sensor->sensorId);
+    }
+    snapshot.addTerminus(tid, std::move(sensorIds));
+    if (historyDepth)
+    {
+        /* All the rings of the terminus in one allocation */
+        histories.try_emplace(tid, termini[tid]->numericSensors.size(),
+                              historyDepth, historyWindows);
     }
 
-    updateAvailableState(tid, true);
+    // numeric sensor
+    auto start = now();
+    for (auto& sensor : termini[tid]->numericSensors)
+    {
+        sensor->setBatchedPublication(publicationLatency != 0);
+        /* The changes by events are published with the ones by readings */
+        sensor->setPendingHandler(
+            [this, weak = std::weak_ptr<NumericSensor>(sensor)]() {
+                if (auto pending = weak.lock())
+                {
+                    deferPublication(std::move(pending));
+                }
+            });
+        if (auto slot = snapshot.getSlot(tid, sensor->sensorId))
+        {
+            sensor->setUpdateHandler(
+                [this, slot = *slot](const NumericSensor& updated) {
+                    recordUpdate(updated, slot);
+                });
+        }
+        auto polled = std::make_shared<PolledSensor>(sensor, start);
+        terminusPolling.sensors.push_back(polled);
+        schedule(std::move(polled));
+    }
 
-    if (!roundRobinSensors[tid].size())
+    if (terminusPolling.sensors.empty())
     {
         lg2::info("Terminus ID {TID}: no sensors to poll.", "TID", tid);
         return;
     }
 
-    sensorPollTimers[tid] = std::make_unique<sdbusplus::Timer>(
-        event.get(),
-        std::bind_front(&SensorManager::doSensorPolling, this, tid));
+    armTimer();
+}
 
-    try
+void SensorManager::stopPolling(pldm_tid_t tid)
+{
+    /* The scheduled sensors and the readings in flight of the terminus are
+     * dropped when they come up */
+    auto it = polling.find(tid);
+    if (it != polling.end())
     {
-        if (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning())
+        for (auto& polled : it->second.sensors)
         {
-            sensorPollTimers[tid]->start(
-                duration_cast<std::chrono::milliseconds>(
-                    std::chrono::milliseconds(pollingTime)),
-                true);
+            polled->polled = false;
+            /* Publishes the pending changes of the sensor */
+            polled->sensor->setBatchedPublication(false);
+            polled->sensor->setPendingHandler({});
+            polled->sensor->setUpdateHandler({});
         }
+        polling.erase(it);
+    }
+    snapshot.removeTerminus(tid);
+    histories.erase(tid);
+
+    availableState.erase(tid);
+}
+
+void SensorManager::updateAvailableState(pldm_tid_t tid, Availability state)
+{
+    availableState[tid] = state;
+    if (!state)
+    {
+        return;
+    }
+
+    auto it = polling.find(tid);
+    if (it == polling.end() || it->second.parked.empty())
+    {
+        return;
+    }
+
+    auto due = now();
+    for (auto& polled : std::exchange(it->second.parked, {}))
+    {
+        polled->deadline = due;
+        schedule(std::move(polled));
+    }
+    armTimer();
+}
+
+std::vector<std::shared_ptr<const PolledSensor>>
+    SensorManager::getPolledSensors() const
+{
+    std::vector<std::shared_ptr<const PolledSensor>> sensors;
+    for (const auto& [tid, terminusPolling] : polling)
+    {
+        sensors.insert(sensors.end(), terminusPolling.sensors.begin(),
+                       terminusPolling.sensors.end());
+    }
+    return sensors;
+}
+
+void SensorManager::resetPollingStats()
+{
+    for (auto& [tid, terminusPolling] : polling)
+    {
+        for (auto& polled : terminusPolling.sensors)
+        {
+            polled->stats = {};
+        }
+    }
+}
+
+bool SensorManager::setDeadband(pldm_tid_t tid, uint16_t sensorId,
+                                double deadband)
+{
+    auto it = termini.find(tid);
+    if (it == termini.end() || !it->second)
+    {
+        return false;
+    }
+    for (auto& sensor : it->second->numericSensors)
+    {
+        if (sensor->sensorId == sensorId)
+        {
+            sensor->setDeadband(deadband);
+            return true;
+        }
+    }
+    return false;
+}
+
+void SensorManager::deferPublication(std::shared_ptr<NumericSensor> sensor)
+{
+    unpublished.push_back(std::move(sensor));
+    if (publicationTimer.isRunning())
+    {
+        return;
+    }
+    try
+    {
+        publicationTimer.start(std::chrono::milliseconds(publicationLatency));
     }
     catch (const std::exception& e)
     {
         lg2::error(
-            "Terminus ID {TID}: Failed to start sensor polling timer. Exception: {EXCEPTION}",
-            "TID", tid, "EXCEPTION", e);
-        return;
+            "Failed to start sensor publication timer. Exception: {ERROR}",
+            "ERROR", e);
+        publishChanges();
     }
 }
 
-void SensorManager::stopPolling(pldm_tid_t tid)
+void SensorManager::publishChanges()
 {
-    /* Stop polling timer */
-    if (sensorPollTimers.contains(tid))
+    if (publicationTimer.isRunning())
     {
-        sensorPollTimers[tid]->stop();
-        sensorPollTimers.erase(tid);
+        publicationTimer.stop();
     }
+    for (auto& sensor : std::exchange(unpublished, {}))
+    {
+        sensor->publish();
+    }
+}
 
-    roundRobinSensors.erase(tid);
+void SensorManager::recordUpdate(const NumericSensor& sensor, size_t slot)
+{
+    SensorSample sample{sensor.sensorId, sensor.getReading(),
+                        sensor.isAvailable(), sensor.isFunctional(), now()};
+    snapshot.update(sensor.tid, slot, sample);
+    readingRing.push(sensor.tid, sample);
 
-    if (doSensorPollingTaskHandles.contains(tid))
+    auto it = histories.find(sensor.tid);
+    if (it != histories.end() && sample.available && sample.functional)
     {
-        auto& [scope, rcOpt] = doSensorPollingTaskHandles[tid];
-        scope.request_stop();
-        doSensorPollingTaskHandles.erase(tid);
+        it->second.push(slot, sample.timestamp, sample.value);
     }
+}
 
-    availableState.erase(tid);
+bool SensorManager::isPollingCycleComplete() const
+{
+    return std::ranges::all_of(polling, [](const auto& entry) {
+        const auto& terminusPolling = entry.second;
+        /* The event poll is not a reading */
+        return terminusPolling.ready.empty() &&
+               terminusPolling.inFlight ==
+                   (terminusPolling.pollingEvents ? 1u : 0u);
+    });
 }
 
-void SensorManager::doSensorPolling(pldm_tid_t tid)
+uint64_t SensorManager::now()
 {
-    auto it = doSensorPollingTaskHandles.find(tid);
-    if (it != doSensorPollingTaskHandles.end())
+    uint64_t usec = 0;
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &usec);
+    return usec;
+}
+
+void SensorManager::schedule(std::shared_ptr<PolledSensor> polled)
+{
+    auto deadline = polled->deadline;
+    polled->seq = scheduleSeq;
+    scheduled.emplace(deadline, scheduleSeq++, std::move(polled));
+}
+
+void SensorManager::armTimer()
+{
+    /* Drop the sensors of the termini no longer polled, and the superseded
+     * entries */
+    while (!scheduled.empty() &&
+           (!scheduled.top().sensor->polled ||
+            scheduled.top().seq != scheduled.top().sensor->seq))
+    {
+        scheduled.pop();
+    }
+
+    if (scheduled.empty())
     {
-        auto& [scope, rcOpt] = it->second;
-        if (!rcOpt.has_value())
+        if (schedulerTimer.isRunning())
         {
-            return;
+            schedulerTimer.stop();
         }
-        doSensorPollingTaskHandles.erase(tid);
-    }
-
-    auto& [scope, rcOpt] =
-        doSensorPollingTaskHandles
-            .emplace(std::piecewise_construct, std::forward_as_tuple(tid),
-                     std::forward_as_tuple())
-            .first->second;
-    scope.spawn(
-        stdexec::just() | stdexec::let_value([this, &rcOpt,
-                                              tid] -> exec::task<void> {
-            auto res =
-                co_await stdexec::stopped_as_optional(doSensorPollingTask(tid));
-            if (res.has_value())
-            {
-                rcOpt = *res;
-            }
-            else
-            {
-                lg2::info("Stopped polling for Terminus ID {TID}", "TID", tid);
-                try
-                {
-                    if (sensorPollTimers.contains(tid) &&
-                        sensorPollTimers[tid] &&
-                        sensorPollTimers[tid]->isRunning())
-                    {
-                        sensorPollTimers[tid]->stop();
-                    }
-                }
-                catch (const std::exception& e)
-                {
-                    lg2::error(
-                        "Terminus ID {TID}: Failed to stop polling timer. Exception: {EXCEPTION}",
-                        "TID", tid, "EXCEPTION", e);
-                }
-                rcOpt = PLDM_SUCCESS;
-            }
-        }),
-        exec::default_task_context<void>(exec::inline_scheduler{}));
+        return;
+    }
+
+    auto current = now();
+    auto deadline = scheduled.top().deadline;
+    uint64_t delay = deadline > current ? deadline - current : 0;
+    delay = std::min<uint64_t>(delay, uint64_t{pollingTime} * 1000);
+    try
+    {
+        schedulerTimer.start(std::chrono::microseconds(delay));
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to start sensor polling timer. Exception: {ERROR}",
+                   "ERROR", e);
+    }
 }
 
-exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
+void SensorManager::dispatch()
 {
-    uint64_t t0 = 0;
-    uint64_t t1 = 0;
-    uint64_t elapsed = 0;
-    uint64_t pollingTimeInUsec = pollingTime * 1000;
-    uint8_t rc = PLDM_SUCCESS;
+    auto current = now();
+    for (auto& [tid, terminusPolling] : polling)
+    {
+        updateEventLiveness(tid, terminusPolling, current);
+    }
 
-    do
+    while (!scheduled.empty() && scheduled.top().deadline <= current)
     {
-        if ((!sensorPollTimers.contains(tid)) ||
-            (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning()))
+        auto seq = scheduled.top().seq;
+        auto polled = scheduled.top().sensor;
+        scheduled.pop();
+
+        auto it = polling.find(polled->sensor->tid);
+        if (!polled->polled || seq != polled->seq || it == polling.end())
         {
-            co_return PLDM_ERROR;
+            continue;
         }
 
-        sd_event_now(event.get(), CLOCK_MONOTONIC, &t0);
-
         /**
          * Terminus is not available for PLDM request.
          * The terminus manager will trigger recovery process to recovery the
          * communication between the local terminus and the remote terminus.
-         * The sensor polling should be stopped while recovering the
-         * communication.
+         * The sensor is set aside until the terminus is available again.
          */
-        if (!getAvailableState(tid))
+        if (!getAvailableState(it->first))
         {
-            lg2::info(
-                "Terminus ID {TID} is not available for PLDM request from {NOW}.",
-                "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
-            co_await stdexec::just_stopped();
+            it->second.parked.push_back(std::move(polled));
+            continue;
         }
+        it->second.ready.push_back(std::move(polled));
+    }
+
+    /* Starting the requests may complete some and erase their terminus */
+    std::vector<pldm_tid_t> tids;
+    tids.reserve(polling.size());
+    for (const auto& [tid, terminusPolling] : polling)
+    {
+        tids.push_back(tid);
+    }
+    for (auto tid : tids)
+    {
+        startRequests(tid);
+    }
+
+    armTimer();
+}
+
+void SensorManager::updateEventLiveness(
+    pldm_tid_t tid, TerminusPolling& terminusPolling, uint64_t current)
+{
+    /* The event times are in usec of CLOCK_MONOTONIC, as the current time of
+     * the event loop, an event received since the loop woke up is later */
+    auto liveness = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            eventLivenessTime)
+            .count());
+    auto it = termini.find(tid);
+    bool eventDriven =
+        liveness && it != termini.end() && it->second &&
+        it->second->eventReceiverConfigured && it->second->lastEventTime &&
+        (*it->second->lastEventTime >= current ||
+         current - *it->second->lastEventTime < liveness);
+    if (eventDriven == terminusPolling.eventDriven)
+    {
+        return;
+    }
+    terminusPolling.eventDriven = eventDriven;
+
+    if (eventDriven)
+    {
+        lg2::info(
+            "Terminus ID {TID} sends events, its sensors with events enabled are polled every {TIME} ms.",
+            "TID", tid, "TIME", eventLivenessTime.count());
+        return;
+    }
 
-        if (!termini.contains(tid))
+    /* The sensors waiting for their liveness poll are due now. The sensors
+     * with a deadline ahead are the scheduled ones. */
+    lg2::info(
+        "Terminus ID {TID} sent no event for {TIME} ms, polling its sensors at their update interval.",
+        "TID", tid, "TIME", eventLivenessTime.count());
+    for (auto& polled : terminusPolling.sensors)
+    {
+        if (polled->sensor->eventsEnabled && polled->deadline > current)
         {
-            co_return PLDM_SUCCESS;
+            polled->deadline = current;
+            schedule(polled);
         }
+    }
+}
 
-        auto& terminus = termini[tid];
+void SensorManager::startRequests(pldm_tid_t tid)
+{
+    auto it = polling.find(tid);
+    if (it == polling.end() || !getAvailableState(tid))
+    {
+        return;
+    }
+    auto& terminusPolling = it->second;
 
-        if (manager && terminus->pollEvent)
+    auto terminusIt = termini.find(tid);
+    if (manager && terminusIt != termini.end() &&
+        terminusIt->second->pollEvent && !terminusPolling.pollingEvents &&
+        terminusPolling.inFlight < pollingConcurrency)
+    {
+        terminusPolling.pollingEvents = true;
+        terminusPolling.inFlight++;
+        scope.spawn(pollEventsTask(tid, terminusPolling.generation),
+                    exec::default_task_context<void>(exec::inline_scheduler{}));
+        /* The event poll may have completed inline and erased the terminus */
+        it = polling.find(tid);
+        if (it == polling.end())
         {
-            co_await manager->pollForPlatformEvent(
-                tid, terminus->pollEventId, terminus->pollDataTransferHandle);
+            return;
         }
+    }
 
-        sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-        auto toBeUpdated = roundRobinSensors[tid].size();
-        while (((t1 - t0) < pollingTimeInUsec) && (toBeUpdated > 0))
+    while (it->second.inFlight < pollingConcurrency &&
+           !it->second.ready.empty())
+    {
+        auto polled = std::move(it->second.ready.front());
+        it->second.ready.pop_front();
+        it->second.inFlight++;
+        scope.spawn(readSensorTask(std::move(polled)),
+                    exec::default_task_context<void>(exec::inline_scheduler{}));
+        it = polling.find(tid);
+        if (it == polling.end())
         {
-            if (!getAvailableState(tid))
-            {
-                lg2::info(
-                    "Terminus ID {TID} is not available for PLDM request from {NOW}.",
-                    "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
-                co_await stdexec::just_stopped();
-            }
+            return;
+        }
+    }
+}
 
-            auto sensor = roundRobinSensors[tid].front();
+exec::task<void> SensorManager::pollEventsTask(pldm_tid_t tid,
+                                               uint64_t generation)
+{
+    auto terminusIt = termini.find(tid);
+    if (terminusIt != termini.end())
+    {
+        auto terminus = terminusIt->second;
+        co_await stdexec::stopped_as_optional(manager->pollForPlatformEvent(
+            tid, terminus->pollEventId, terminus->pollDataTransferHandle));
+    }
 
-            sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-            elapsed = t1 - sensor->timeStamp;
-            if ((sensor->updateTime <= elapsed) || (!sensor->timeStamp))
-            {
-                rc = co_await getSensorReading(sensor);
+    /* The terminus stopped being polled, possibly polled again since */
+    auto it = polling.find(tid);
+    if (it == polling.end() || it->second.generation != generation)
+    {
+        co_return;
+    }
+    it->second.inFlight--;
+    it->second.pollingEvents = false;
 
-                if ((!sensorPollTimers.contains(tid)) ||
-                    (sensorPollTimers[tid] &&
-                     !sensorPollTimers[tid]->isRunning()))
-                {
-                    co_return PLDM_ERROR;
-                }
-                sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-                if (rc == PLDM_SUCCESS)
-                {
-                    sensor->timeStamp = t1;
-                }
-                else
-                {
-                    lg2::error(
-                        "Failed to get sensor value for terminus {TID}, error: {RC}",
-                        "TID", tid, "RC", rc);
-                }
-            }
+    startRequests(tid);
+    armTimer();
+}
 
-            toBeUpdated--;
-            if (roundRobinSensors.contains(tid))
+exec::task<void>
+    SensorManager::readSensorTask(std::shared_ptr<PolledSensor> polled)
+{
+    auto sensor = polled->sensor;
+    auto tid = sensor->tid;
+    auto res = co_await stdexec::stopped_as_optional(getSensorReading(sensor));
+
+    /* The terminus stopped being polled, possibly polled again since */
+    if (!polled->polled)
+    {
+        co_return;
+    }
+    auto it = polling.find(tid);
+    if (it == polling.end())
+    {
+        co_return;
+    }
+    auto terminusPolling = &it->second;
+    terminusPolling->inFlight--;
+
+    auto completion = now();
+    if (!res.has_value())
+    {
+        /* Stopped as the terminus is not available */
+        lg2::info(
+            "Terminus ID {TID} is not available for PLDM request from {NOW}.",
+            "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
+        terminusPolling->parked.push_back(std::move(polled));
+    }
+    else
+    {
+        auto period = getPeriod(*polled);
+        if (*res == PLDM_SUCCESS)
+        {
+            sensor->timeStamp = completion;
+
+            auto lateness = completion > polled->deadline
+                                ? completion - polled->deadline
+                                : 0;
+            auto& stats = polled->stats;
+            stats.readings++;
+            stats.totalLatenessUs += lateness;
+            stats.maxLatenessUs = std::max(stats.maxLatenessUs, lateness);
+            if (lateness > period)
             {
-                roundRobinSensors[tid].pop();
-                roundRobinSensors[tid].push(std::move(sensor));
+                stats.deadlineMisses++;
             }
-            sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
+            polled->deadline = completion + period;
+        }
+        else
+        {
+            lg2::error(
+                "Failed to get sensor value for terminus {TID}, error: {RC}",
+                "TID", tid, "RC", *res);
+            polled->deadline =
+                completion +
+                std::min<uint64_t>(period, uint64_t{pollingTime} * 1000);
         }
+        schedule(std::move(polled));
+    }
 
-        sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-    } while ((t1 - t0) >= pollingTimeInUsec);
+    startRequests(tid);
+    armTimer();
 
-    co_return PLDM_SUCCESS;
+    if (!unpublished.empty() && isPollingCycleComplete())
+    {
+        publishChanges();
+    }
 }
 
 exec::task<int>
@@ -275,8 +560,9 @@ exec::task<int>
 
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
-    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
-                                                  &responseLen);
+    rc = co_await terminusManager.sendRecvPldmMsg(
+        tid, request, &responseMsg, &responseLen,
+        requester::RequestClass::SensorPolling, true);
     if (rc)
     {
         lg2::error(
@@ -285,8 +571,7 @@ exec::task<int>
         co_return rc;
     }
 
-    if ((!sensorPollTimers.contains(tid)) ||
-        (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning()))
+    if (!polling.contains(tid))
     {
         co_return PLDM_ERROR;
     }
@@ -321,6 +606,10 @@ exec::task<int>
         co_return completionCode;
     }
 
+    sensor->eventsEnabled =
+        sensorEventMessageEnable == PLDM_EVENTS_ENABLED ||
+        sensorEventMessageEnable == PLDM_STATE_EVENTS_ONLY_ENABLED;
+
     double value = std::numeric_limits<double>::quiet_NaN();
     switch (sensorOperationalState)
     {
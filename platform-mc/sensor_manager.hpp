@@ -5,12 +5,21 @@
 
 #include "common/types.hpp"
 #include "requester/handler.hpp"
+#include "sensor_history.hpp"
+#include "sensor_reading_ring.hpp"
+#include "sensor_snapshot.hpp"
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <queue>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -19,12 +28,76 @@ namespace pldm
 namespace platform_mc
 {
 
+/** @struct SensorPollingStats
+ *
+ *  How timely the readings of a sensor are. The deadline of a reading is one
+ *  update interval after the previous reading.
+ */
+struct SensorPollingStats
+{
+    uint64_t readings = 0;        //!< Readings completed
+    uint64_t deadlineMisses = 0;  //!< Readings completed more than one update
+                                  //!< interval after their deadline
+    uint64_t totalLatenessUs = 0; //!< Time from deadline to completion, summed
+    uint64_t maxLatenessUs = 0;   //!< Longest time from deadline to completion
+};
+
+/** @struct PolledSensor
+ *
+ *  A sensor in the polling schedule
+ */
+struct PolledSensor
+{
+    std::shared_ptr<NumericSensor> sensor;
+
+    /** @brief When the sensor is due, in usec of CLOCK_MONOTONIC */
+    uint64_t deadline = 0;
+
+    /** @brief Cleared when the terminus of the sensor stops being polled */
+    bool polled = true;
+
+    /** @brief Sequence number of the schedule entry of the sensor, the
+     *         other entries of the sensor were superseded
+     */
+    uint64_t seq = 0;
+
+    SensorPollingStats stats{};
+};
+
 /**
  * @brief SensorManager
  *
  * This class manages the sensors found in terminus and provides
  * function calls for other classes to start/stop sensor monitoring.
  *
+ * The sensors of all the termini are polled by one earliest deadline first
+ * scheduler: a sensor is due one update interval, from its PDR, after its
+ * previous reading, and the due sensors are read by increasing deadline with
+ * at most SENSOR_POLLING_CONCURRENCY requests in flight to each terminus. A
+ * single timer wakes the scheduler up at the earliest deadline, or at the
+ * latest after the polling time to poll the events of the termini. The
+ * sensors of an unavailable terminus are set aside until it is available
+ * again.
+ *
+ * When SENSOR_EVENT_LIVENESS_TIME is not 0 and a terminus configured to send
+ * its events to the BMC sent an event or a heartbeat within that time, its
+ * sensors with their events enabled are updated from their numeric sensor
+ * events and only polled every SENSOR_EVENT_LIVENESS_TIME. Once the terminus
+ * sends nothing for that long, they are polled at their update interval
+ * again.
+ *
+ * When SENSOR_PUBLICATION_LATENCY is not 0 the polled sensors publish their
+ * changes in batches: the changes are published when no reading is due or in
+ * flight any more, i.e. at the end of a polling cycle, and at the latest
+ * SENSOR_PUBLICATION_LATENCY milliseconds after the first one.
+ *
+ * Every update of the sensors of the polled termini, by a reading, an error
+ * or an event, is recorded into a SensorSnapshot to read all the sensors of a
+ * terminus at once and, when SENSOR_READING_RING_ENTRIES is not 0, appended
+ * to the SensorReadingRing exported in shared memory. When
+ * SENSOR_HISTORY_DEPTH is not 0, the readings are also kept in a
+ * SensorHistory per terminus, with their statistics in the
+ * SENSOR_HISTORY_WINDOWS.
  */
 class SensorManager
 {
@@ -48,12 +121,10 @@ class SensorManager
      */
     void stopPolling(pldm_tid_t tid);
 
-    /** @brief Set available state of terminus for pldm request.
+    /** @brief Set available state of terminus for pldm request. The sensors
+     *         set aside while the terminus was unavailable are due again.
      */
-    void updateAvailableState(pldm_tid_t tid, Availability state)
-    {
-        availableState[tid] = state;
-    };
+    void updateAvailableState(pldm_tid_t tid, Availability state);
 
     /** @brief Get available state of terminus for pldm request.
      */
@@ -66,24 +137,204 @@ class SensorManager
         return availableState[tid];
     };
 
+    /** @brief Set the maximum number of requests in flight to each terminus
+     *
+     *  @param[in] concurrency - maximum number of requests, at least one
+     */
+    void setPollingConcurrency(size_t concurrency)
+    {
+        pollingConcurrency = std::max<size_t>(concurrency, 1);
+    }
+
+    /** @brief Set the time after which the termini sending no event have
+     *         their event-driven sensors polled again
+     *
+     *  @param[in] livenessTime - the time, 0 polls every sensor at its update
+     *                            interval
+     */
+    void setEventLivenessTime(std::chrono::milliseconds livenessTime)
+    {
+        eventLivenessTime = std::max(livenessTime, std::chrono::milliseconds(0));
+    }
+
+    /** @brief Get the sensors being polled
+     *
+     *  @return the sensors of all the polled termini, with their statistics
+     */
+    std::vector<std::shared_ptr<const PolledSensor>> getPolledSensors() const;
+
+    /** @brief Clear the polling statistics of all the sensors */
+    void resetPollingStats();
+
+    /** @brief Set the deadband of a sensor
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] sensorId - Sensor ID
+     *  @param[in] deadband - smallest change of the reading which is
+     *                        published, in the unit of the sensor
+     *
+     *  @return false when the terminus has no such numeric sensor
+     */
+    bool setDeadband(pldm_tid_t tid, uint16_t sensorId, double deadband);
+
+    /** @brief Get the current state of the sensors of the polled termini */
+    const SensorSnapshot& getSnapshot() const
+    {
+        return snapshot;
+    }
+
+    /** @brief Get the history of the sensors of a polled terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *
+     *  @return the history, nullptr when the terminus is not polled or the
+     *          history is disabled. The slots are those of the snapshot.
+     */
+    const SensorHistory* getHistory(pldm_tid_t tid) const
+    {
+        auto it = histories.find(tid);
+        return it != histories.end() ? &it->second : nullptr;
+    }
+
   protected:
-    /** @brief start a coroutine for polling all sensors.
+    /** @struct ScheduleEntry
+     *
+     *  A sensor waiting for its deadline
      */
-    virtual void doSensorPolling(pldm_tid_t tid);
+    struct ScheduleEntry
+    {
+        uint64_t deadline;
+        uint64_t seq; //!< Keeps the sensors of a same deadline in FIFO order
+        std::shared_ptr<PolledSensor> sensor;
 
-    /** @brief polling all sensors in each terminus
+        friend bool operator>(const ScheduleEntry& lhs,
+                              const ScheduleEntry& rhs)
+        {
+            return std::tie(lhs.deadline, lhs.seq) >
+                   std::tie(rhs.deadline, rhs.seq);
+        }
+    };
+
+    /** @struct TerminusPolling
      *
-     *  @param[in] tid - Destination TID
-     *  @return coroutine return_value - PLDM completion code
+     *  The polling state of a terminus
      */
-    exec::task<int> doSensorPollingTask(pldm_tid_t tid);
+    struct TerminusPolling
+    {
+        /** @brief Tells apart the successive polling of a terminus */
+        uint64_t generation = 0;
+
+        std::vector<std::shared_ptr<PolledSensor>> sensors;
+
+        /** @brief Due sensors waiting for a request slot, by deadline */
+        std::deque<std::shared_ptr<PolledSensor>> ready;
+
+        /** @brief Sensors set aside while the terminus is unavailable */
+        std::vector<std::shared_ptr<PolledSensor>> parked;
+
+        /** @brief Requests in flight to the terminus */
+        size_t inFlight = 0;
+
+        /** @brief Whether the events of the terminus are being polled */
+        bool pollingEvents = false;
+
+        /** @brief Whether the terminus sends events, its sensors with events
+         *         enabled are then only polled for liveness
+         */
+        bool eventDriven = false;
+    };
+
+    /** @brief Wake the scheduler up at the earliest deadline */
+    void armTimer();
+
+    /** @brief Hand the due sensors over to their termini and start the
+     *         readings
+     */
+    void dispatch();
+
+    /** @brief Schedule a sensor for its deadline */
+    void schedule(std::shared_ptr<PolledSensor> polled);
+
+    /** @brief Start reading the ready sensors of a terminus, and polling its
+     *         events, within its request slots
+     *
+     *  @param[in] tid - Terminus ID
+     */
+    void startRequests(pldm_tid_t tid);
+
+    /** @brief Read a sensor then schedule it again
+     *
+     *  @param[in] polled - the sensor
+     */
+    exec::task<void> readSensorTask(std::shared_ptr<PolledSensor> polled);
+
+    /** @brief Poll the events of a terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] generation - generation of the polling of the terminus
+     */
+    exec::task<void> pollEventsTask(pldm_tid_t tid, uint64_t generation);
+
+    /** @brief Queue a sensor with changes to publish, and start the
+     *         publication deadline. Called on the first pending change of
+     *         the sensor, by a reading or an event.
+     */
+    void deferPublication(std::shared_ptr<NumericSensor> sensor);
+
+    /** @brief Publish the changes of the queued sensors */
+    void publishChanges();
+
+    /** @brief Record the update of a sensor into the snapshot and the
+     *         reading ring
+     *
+     *  @param[in] sensor - the sensor
+     *  @param[in] slot - slot of the sensor in the snapshot
+     */
+    void recordUpdate(const NumericSensor& sensor, size_t slot);
+
+    /** @brief Check whether no reading is due or in flight */
+    bool isPollingCycleComplete() const;
+
+    /** @brief Get the current time in usec of CLOCK_MONOTONIC */
+    uint64_t now();
+
+    /** @brief Switch a terminus between event-driven and polled sensors as
+     *         it starts or stops sending events
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] terminusPolling - polling state of the terminus
+     *  @param[in] current - the current time in usec of CLOCK_MONOTONIC
+     */
+    void updateEventLiveness(pldm_tid_t tid, TerminusPolling& terminusPolling,
+                             uint64_t current);
+
+    /** @brief Get the polling period of a sensor in usec: its update
+     *         interval, or the liveness time when it is event-driven
+     */
+    uint64_t getPeriod(const PolledSensor& polled) const
+    {
+        const auto& sensor = *polled.sensor;
+        if (sensor.eventsEnabled && eventLivenessTime.count())
+        {
+            auto it = polling.find(sensor.tid);
+            if (it != polling.end() && it->second.eventDriven)
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                           eventLivenessTime)
+                    .count();
+            }
+        }
+        return sensor.updateTime ? sensor.updateTime
+                                 : uint64_t{pollingTime} * 1000;
+    }
 
     /** @brief Sending getSensorReading command for the sensor
      *
      *  @param[in] sensor - the sensor to be updated
      *  @return coroutine return_value - PLDM completion code
      */
-    exec::task<int> getSensorReading(std::shared_ptr<NumericSensor> sensor);
+    virtual exec::task<int>
+        getSensorReading(std::shared_ptr<NumericSensor> sensor);
 
     /** @brief Reference to to PLDM daemon's main event loop.
      */
@@ -95,23 +346,68 @@ class SensorManager
     /** @brief List of discovered termini */
     TerminiMapper& termini;
 
-    /** @brief sensor polling interval in ms. */
+    /** @brief Longest time in ms the scheduler sleeps while sensors are
+     *         scheduled, and delay before retrying a failed reading
+     */
     uint32_t pollingTime;
 
-    /** @brief sensor polling timers */
-    std::map<pldm_tid_t, std::unique_ptr<sdbusplus::Timer>> sensorPollTimers;
+    /** @brief Maximum number of requests in flight to each terminus */
+    size_t pollingConcurrency;
+
+    /** @brief Time after which a terminus sending no event is polled again,
+     *         0 when the sensors are always polled
+     */
+    std::chrono::milliseconds eventLivenessTime;
+
+    /** @brief Longest time in ms the changes of the sensors wait to be
+     *         published, 0 when each change is published when it is read
+     */
+    uint32_t publicationLatency;
+
+    /** @brief Timer waking the scheduler up */
+    sdbusplus::Timer schedulerTimer;
+
+    /** @brief Timer publishing the changes at their latency deadline */
+    sdbusplus::Timer publicationTimer;
+
+    /** @brief The sensors with changes to publish */
+    std::vector<std::shared_ptr<NumericSensor>> unpublished;
+
+    /** @brief The current state of the sensors of the polled termini */
+    SensorSnapshot snapshot;
+
+    /** @brief The sensor updates exported in shared memory */
+    SensorReadingRing readingRing;
+
+    /** @brief Number of readings kept per sensor, 0 keeps none */
+    size_t historyDepth;
+
+    /** @brief Lengths in usec of the windows of the history statistics */
+    std::vector<uint64_t> historyWindows;
 
-    /** @brief coroutine handle of doSensorPollingTasks */
-    std::map<pldm_tid_t, std::pair<exec::async_scope, std::optional<int>>>
-        doSensorPollingTaskHandles;
+    /** @brief The history of the sensors of the polled termini */
+    std::map<pldm_tid_t, SensorHistory> histories;
+
+    /** @brief The sensors waiting for their deadline, earliest first */
+    std::priority_queue<ScheduleEntry, std::vector<ScheduleEntry>,
+                        std::greater<>>
+        scheduled;
+
+    /** @brief Sequence number of the next scheduled sensor */
+    uint64_t scheduleSeq = 0;
+
+    /** @brief Polling state of the polled termini */
+    std::map<pldm_tid_t, TerminusPolling> polling;
+
+    /** @brief Generation of the last terminus started being polled */
+    uint64_t pollingGeneration = 0;
+
+    /** @brief Scope of the readings and event polls in flight */
+    exec::async_scope scope;
 
     /** @brief Available state for pldm request of terminus */
     std::map<pldm_tid_t, Availability> availableState;
 
-    /** @brief round robin sensor list */
-    std::map<pldm_tid_t, std::queue<std::shared_ptr<NumericSensor>>>
-        roundRobinSensors;
-
     /** @brief pointer to Manager */
     Manager* manager;
 };
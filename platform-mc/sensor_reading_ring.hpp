@@ -0,0 +1,184 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include "common/seqlock_ring.hpp"
+#include "sensor_snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @brief Magic number at the start of the sensor reading ring */
+constexpr std::array<char, 8> readingRingMagic = {'P', 'L', 'D', 'M',
+                                                  'S', 'E', 'N', 'S'};
+
+/** @brief Version of the sensor reading ring layout */
+constexpr uint32_t readingRingVersion = 1;
+
+/** @brief Record flags of the state of the sensor */
+constexpr uint8_t readingFlagAvailable = 0x01;
+constexpr uint8_t readingFlagFunctional = 0x02;
+
+/** @struct ReadingRecord
+ *
+ *  A sensor update in the seqlock ring, sequence number N is in the record
+ *  N % recordCount
+ */
+struct ReadingRecord
+{
+    uint64_t sequence;    //!< 1 based sequence number, 0 if the record is
+                          //!< empty or being written
+    uint64_t timestampUs; //!< CLOCK_MONOTONIC time of the update, in usec
+    double value;         //!< in the unit of the sensor, NaN if none
+    uint16_t sensorId;
+    uint8_t tid;
+    uint8_t flags;        //!< readingFlagAvailable, readingFlagFunctional
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ReadingRecord) == 32);
+static_assert(offsetof(ReadingRecord, sequence) == 0);
+
+/** @brief Read the records of the sensor reading ring written since a
+ *         sequence number, see readRingRecords()
+ *
+ *  @param[in] ring - the mapped ring
+ *  @param[in,out] next - sequence number of the first record to read,
+ *                        updated to the first record not read yet
+ *
+ *  @return the complete records in the order they were written, empty if
+ *          the mapping is not a sensor reading ring of a known layout
+ */
+inline std::vector<ReadingRecord>
+    readReadingRecords(std::span<const uint8_t> ring, uint64_t& next)
+{
+    return readRingRecords<ReadingRecord>(ring, readingRingMagic,
+                                          readingRingVersion, next);
+}
+
+/** @class SensorReadingRing
+ *
+ *  Exports the sensor updates into a ring in POSIX shared memory, for the
+ *  local consumers reading the sensors at a high rate without a D-Bus call
+ *  per scan. The ring is written by the daemon only, the consumers map it
+ *  read-only and follow it with readReadingRecords(). Writing a record takes
+ *  no lock and never allocates memory.
+ */
+class SensorReadingRing
+{
+  public:
+    SensorReadingRing() = delete;
+    SensorReadingRing(const SensorReadingRing&) = delete;
+    SensorReadingRing(SensorReadingRing&&) = delete;
+    SensorReadingRing& operator=(const SensorReadingRing&) = delete;
+    SensorReadingRing& operator=(SensorReadingRing&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] recordCount - number of records kept, 0 disables the ring
+     *  @param[in] name - name of the POSIX shared memory object, e.g.
+     *                    /pldm-sensor-readings
+     */
+    SensorReadingRing(size_t recordCount, const std::string& name) :
+        name(name), ring(readingRingMagic, readingRingVersion, recordCount,
+                         openSharedMemory(recordCount, name))
+    {
+        if (!ring.enabled() && recordCount && !name.empty())
+        {
+            shm_unlink(name.c_str());
+        }
+    }
+
+    ~SensorReadingRing()
+    {
+        if (ring.enabled())
+        {
+            shm_unlink(name.c_str());
+        }
+    }
+
+    /** @brief Check whether the ring is exported */
+    bool enabled() const
+    {
+        return ring.enabled();
+    }
+
+    /** @brief Get the mapped ring, empty if the ring is disabled */
+    std::span<const uint8_t> getMapping() const
+    {
+        return ring.getMapping();
+    }
+
+    /** @brief Append a sensor update to the ring
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] sample - the state of the sensor
+     */
+    void push(pldm_tid_t tid, const SensorSample& sample)
+    {
+        ring.push([&](ReadingRecord& record) {
+            record.timestampUs = sample.timestamp;
+            record.value = sample.value;
+            record.sensorId = sample.sensorId;
+            record.tid = tid;
+            record.flags = (sample.available ? readingFlagAvailable : 0) |
+                           (sample.functional ? readingFlagFunctional : 0);
+        });
+    }
+
+  private:
+    /** @brief Create the shared memory object of the ring
+     *
+     *  @param[in] recordCount - number of records
+     *  @param[in] name - name of the shared memory object
+     *
+     *  @return the file descriptor, -1 if the ring is disabled or on error
+     */
+    static int openSharedMemory(size_t recordCount, const std::string& name)
+    {
+        if (!recordCount || name.empty())
+        {
+            return -1;
+        }
+
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 ||
+            ftruncate(fd, SeqlockRing<ReadingRecord>::mapSize(recordCount)) <
+                0)
+        {
+            lg2::error(
+                "Failed to create the sensor reading ring {NAME}, error - {ERROR}",
+                "NAME", name, "ERROR", errno);
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return -1;
+        }
+        return fd;
+    }
+
+    /** @brief Name of the shared memory object */
+    std::string name;
+
+    /** @brief The ring of sensor updates */
+    SeqlockRing<ReadingRecord> ring;
+};
+
+} // namespace platform_mc
+} // namespace pldm
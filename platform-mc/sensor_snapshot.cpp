@@ -0,0 +1,94 @@
+#include "sensor_snapshot.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+void SensorSnapshot::addTerminus(pldm_tid_t tid,
+                                 std::vector<uint16_t> sensorIds)
+{
+    std::ranges::sort(sensorIds);
+    auto duplicates = std::ranges::unique(sensorIds);
+    sensorIds.erase(duplicates.begin(), duplicates.end());
+
+    auto count = sensorIds.size();
+    auto& columns = termini[tid];
+    columns.sensorIds = std::move(sensorIds);
+    columns.values.assign(count, std::numeric_limits<double>::quiet_NaN());
+    columns.available.assign(count, 0);
+    columns.functional.assign(count, 0);
+    columns.timestamps.assign(count, 0);
+}
+
+std::optional<size_t> SensorSnapshot::getSlot(pldm_tid_t tid,
+                                              uint16_t sensorId) const
+{
+    auto it = termini.find(tid);
+    if (it == termini.end())
+    {
+        return std::nullopt;
+    }
+    const auto& ids = it->second.sensorIds;
+    auto id = std::ranges::lower_bound(ids, sensorId);
+    if (id == ids.end() || *id != sensorId)
+    {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(id - ids.begin());
+}
+
+void SensorSnapshot::update(pldm_tid_t tid, size_t slot,
+                            const SensorSample& sample)
+{
+    auto it = termini.find(tid);
+    if (it == termini.end() || slot >= it->second.sensorIds.size())
+    {
+        return;
+    }
+    auto& columns = it->second;
+    columns.values[slot] = sample.value;
+    columns.available[slot] = sample.available;
+    columns.functional[slot] = sample.functional;
+    columns.timestamps[slot] = sample.timestamp;
+}
+
+std::optional<std::vector<SensorSample>>
+    SensorSnapshot::getReadings(pldm_tid_t tid,
+                                std::span<const uint16_t> sensorIds) const
+{
+    auto it = termini.find(tid);
+    if (it == termini.end())
+    {
+        return std::nullopt;
+    }
+    const auto& columns = it->second;
+
+    std::vector<SensorSample> samples;
+    if (sensorIds.empty())
+    {
+        samples.reserve(columns.sensorIds.size());
+        for (size_t slot = 0; slot < columns.sensorIds.size(); ++slot)
+        {
+            samples.push_back(columns.sample(slot));
+        }
+        return samples;
+    }
+
+    samples.reserve(sensorIds.size());
+    for (auto sensorId : sensorIds)
+    {
+        auto id = std::ranges::lower_bound(columns.sensorIds, sensorId);
+        if (id != columns.sensorIds.end() && *id == sensorId)
+        {
+            samples.push_back(columns.sample(id - columns.sensorIds.begin()));
+        }
+    }
+    return samples;
+}
+
+} // namespace platform_mc
+} // namespace pldm
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct SensorSample
+ *
+ *  The state of a numeric sensor as of its last update
+ */
+struct SensorSample
+{
+    uint16_t sensorId;
+    double value;       //!< in the unit of the sensor, NaN when there is none
+    bool available;
+    bool functional;
+    uint64_t timestamp; //!< last update in usec of CLOCK_MONOTONIC, 0 when
+                        //!< the sensor was never updated
+};
+
+/**
+ * @brief SensorSnapshot
+ *
+ * The current state of the numeric sensors of the polled termini, kept by
+ * SensorManager in one set of columns per terminus so that the readings of a
+ * whole terminus are copied out at once. The sensors of a terminus have a
+ * fixed slot, in the order of their sensor IDs, from the time the terminus
+ * starts being polled until it stops.
+ */
+class SensorSnapshot
+{
+  public:
+    /** @brief Add the columns of a terminus, its sensors not yet updated
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] sensorIds - the IDs of the numeric sensors of the terminus
+     */
+    void addTerminus(pldm_tid_t tid, std::vector<uint16_t> sensorIds);
+
+    /** @brief Remove the columns of a terminus */
+    void removeTerminus(pldm_tid_t tid)
+    {
+        termini.erase(tid);
+    }
+
+    /** @brief Get the slot of a sensor
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] sensorId - Sensor ID
+     *
+     *  @return the slot, std::nullopt when the terminus has no such sensor
+     */
+    std::optional<size_t> getSlot(pldm_tid_t tid, uint16_t sensorId) const;
+
+    /** @brief Update the state of a sensor
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] slot - slot of the sensor
+     *  @param[in] sample - the state of the sensor, its sensorId is ignored
+     */
+    void update(pldm_tid_t tid, size_t slot, const SensorSample& sample);
+
+    /** @brief Get the state of sensors of a terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] sensorIds - the sensors, all the sensors of the terminus
+     *                         when empty. The unknown sensors are skipped.
+     *
+     *  @return the states in the order of sensorIds, or of the sensor IDs
+     *          for all the sensors, std::nullopt when the terminus is not in
+     *          the snapshot
+     */
+    std::optional<std::vector<SensorSample>>
+        getReadings(pldm_tid_t tid, std::span<const uint16_t> sensorIds) const;
+
+  private:
+    /** @struct Columns
+     *
+     *  The sensors of a terminus, a column per field indexed by slot
+     */
+    struct Columns
+    {
+        std::vector<uint16_t> sensorIds; //!< sorted
+        std::vector<double> values;
+        std::vector<uint8_t> available;
+        std::vector<uint8_t> functional;
+        std::vector<uint64_t> timestamps;
+
+        SensorSample sample(size_t slot) const
+        {
+            return {sensorIds[slot], values[slot], available[slot] != 0,
+                    functional[slot] != 0, timestamps[slot]};
+        }
+    };
+
+    std::map<pldm_tid_t, Columns> termini;
+};
+
+} // namespace platform_mc
+} // namespace pldm
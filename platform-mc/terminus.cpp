@@ -6,6 +6,8 @@
 
 #include <common/utils.hpp>
 
+#include <time.h>
+
 #include <ranges>
 
 namespace pldm
@@ -19,6 +21,14 @@ Terminus::Terminus(pldm_tid_t tid, uint64_t supportedTypes) :
     supportedTypes(supportedTypes)
 {}
 
+void Terminus::recordEvent()
+{
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    lastEventTime = static_cast<uint64_t>(now.tv_sec) * 1000000 +
+                    static_cast<uint64_t>(now.tv_nsec) / 1000;
+}
+
 bool Terminus::doesSupportType(uint8_t type)
 {
     return supportedTypes.test(type);
@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <bitset>
+#include <chrono>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -169,6 +171,17 @@ class Terminus
      */
     bitfield8_t synchronyConfigurationSupported;
 
+    /** @brief Whether the terminus was set to send its events to the BMC */
+    bool eventReceiverConfigured = false;
+
+    /** @brief When the last event or heartbeat of the terminus was received,
+     *         in usec of CLOCK_MONOTONIC as the sensor polling deadlines
+     */
+    std::optional<uint64_t> lastEventTime;
+
+    /** @brief Record the receipt of an event or heartbeat of the terminus */
+    void recordEvent();
+
     /** @brief A list of numericSensors */
     std::vector<std::shared_ptr<NumericSensor>> numericSensors{};
 
@@ -4,6 +4,9 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <exception>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -162,7 +165,6 @@ TerminiMapper::iterator
 
 exec::task<int> TerminusManager::discoverMctpTerminusTask()
 {
-    std::vector<pldm_tid_t> addedTids;
     while (!queuedMctpInfos.empty())
     {
         if (manager)
@@ -170,34 +172,67 @@ exec::task<int> TerminusManager::discoverMctpTerminusTask()
             co_await manager->beforeDiscoverTerminus();
         }
 
+        /* The endpoints are shared by up to initConcurrency workers, so the
+         * bring-up of the list takes about as long as its slowest terminus
+         * rather than the sum of all of them.
+         */
         const MctpInfos& mctpInfos = queuedMctpInfos.front();
-        for (const auto& mctpInfo : mctpInfos)
+        size_t next = 0;
+        exec::async_scope scope;
+        auto workers = std::min(initConcurrency, mctpInfos.size());
+        for (size_t worker = 0; worker < workers; ++worker)
         {
-            auto it = findTerminusPtr(mctpInfo);
-            if (it == termini.end())
-            {
-                co_await initMctpTerminus(mctpInfo);
-            }
-
-            /* Get TID of initialized terminus */
-            auto tid = toTid(mctpInfo);
-            if (!tid)
-            {
-                co_return PLDM_ERROR;
-            }
-            addedTids.push_back(tid.value());
+            scope.spawn(
+                discoverMctpTerminiTask(mctpInfos, next),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
         }
+        co_await scope.on_empty();
 
-        if (manager)
+        queuedMctpInfos.pop();
+    }
+
+    co_return PLDM_SUCCESS;
+}
+
+exec::task<void> TerminusManager::discoverMctpTerminiTask(
+    const MctpInfos& mctpInfos, size_t& next)
+{
+    while (next < mctpInfos.size())
+    {
+        const auto& mctpInfo = mctpInfos[next++];
+        try
         {
-            co_await manager->afterDiscoverTerminus();
-            for (const auto& tid : addedTids)
-            {
-                manager->startSensorPolling(tid);
-            }
+            co_await discoverMctpEndpointTask(mctpInfo);
         }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to discover the terminus of EID {EID}, {ERROR}",
+                       "EID", std::get<0>(mctpInfo), "ERROR", e);
+        }
+    }
+}
 
-        queuedMctpInfos.pop();
+exec::task<int>
+    TerminusManager::discoverMctpEndpointTask(const MctpInfo& mctpInfo)
+{
+    auto it = findTerminusPtr(mctpInfo);
+    if (it == termini.end())
+    {
+        co_await initMctpTerminus(mctpInfo);
+    }
+
+    /* Get TID of initialized terminus */
+    auto tid = toTid(mctpInfo);
+    if (!tid)
+    {
+        co_return PLDM_ERROR;
+    }
+
+    /* The terminus is ready as soon as its own initialization completes */
+    if (manager)
+    {
+        co_await manager->afterDiscoverTerminus(*tid);
+        manager->startSensorPolling(*tid);
     }
 
     co_return PLDM_SUCCESS;
@@ -269,17 +304,11 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
                 isMapped = false;
             }
         }
-        /* Use the terminus TID for mapping */
+        /* Use the terminus TID for mapping, unless it is held by a
+         * terminus still being initialized, then a new TID is assigned */
         else
         {
-            auto mappedTid = storeTerminusInfo(mctpInfo, tid);
-            if (!mappedTid)
-            {
-                lg2::error("Failed to store Terminus Info for terminus {TID}.",
-                           "TID", tid);
-                co_return PLDM_ERROR;
-            }
-            isMapped = true;
+            isMapped = storeTerminusInfo(mctpInfo, tid).has_value();
         }
     }
 
@@ -330,9 +359,12 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
         co_return PLDM_ERROR;
     }
 
+    /* The terminus may be removed while its commands are fetched */
+    std::shared_ptr<Terminus> terminus;
     try
     {
-        termini[tid] = std::make_shared<Terminus>(tid, supportedTypes);
+        terminus = std::make_shared<Terminus>(tid, supportedTypes);
+        termini[tid] = terminus;
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -347,7 +379,7 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
     std::vector<uint8_t> pldmCmds(size);
     while ((type < PLDM_MAX_TYPES))
     {
-        if (!termini[tid]->doesSupportType(type))
+        if (!terminus->doesSupportType(type))
         {
             type++;
             continue;
@@ -361,7 +393,7 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
                 "Failed to Get PLDM Version for terminus {TID}, PLDM Type {TYPE}, error {ERROR}",
                 "TID", tid, "TYPE", type, "ERROR", rc);
         }
-        termini[tid]->setSupportedTypeVersions(type, version);
+        terminus->setSupportedTypeVersions(type, version);
         std::vector<bitfield8_t> cmds(PLDM_MAX_CMDS_PER_TYPE / 8);
         rc = co_await getPLDMCommands(tid, type, version, cmds.data());
         if (rc)
@@ -385,20 +417,20 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
         }
         type++;
     }
-    termini[tid]->setSupportedCommands(pldmCmds);
+    terminus->setSupportedCommands(pldmCmds);
 
     co_return PLDM_SUCCESS;
 }
 
 exec::task<int> TerminusManager::sendRecvPldmMsgOverMctp(
     mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
-    size_t* responseLen)
+    size_t* responseLen, requester::RequestClass requestClass, bool idempotent)
 {
     int rc = 0;
     try
     {
-        std::tie(rc, *responseMsg, *responseLen) =
-            co_await handler.sendRecvMsg(eid, std::move(request));
+        std::tie(rc, *responseMsg, *responseLen) = co_await handler.sendRecvMsg(
+            eid, std::move(request), requestClass, idempotent);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -518,7 +550,8 @@ exec::task<int>
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
 
-    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen);
+    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen,
+                                  requester::RequestClass::Control, true);
     if (rc)
     {
         lg2::error("Failed to send GetPLDMTypes for terminus {TID}, error {RC}",
@@ -566,7 +599,8 @@ exec::task<int> TerminusManager::getPLDMCommands(
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
 
-    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen);
+    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen,
+                                  requester::RequestClass::Control, true);
     if (rc)
     {
         lg2::error(
@@ -600,7 +634,7 @@ exec::task<int> TerminusManager::getPLDMCommands(
 
 exec::task<int> TerminusManager::sendRecvPldmMsg(
     pldm_tid_t tid, Request& request, const pldm_msg** responseMsg,
-    size_t* responseLen)
+    size_t* responseLen, requester::RequestClass requestClass, bool idempotent)
 {
     /**
      * Size of tidPool is `std::numeric_limits<pldm_tid_t>::max() + 1`
@@ -630,8 +664,8 @@ exec::task<int> TerminusManager::sendRecvPldmMsg(
     auto eid = std::get<0>(mctpInfo.value());
     auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
     requestMsg->hdr.instance_id = instanceIdDb.next(eid);
-    auto rc = co_await sendRecvPldmMsgOverMctp(eid, request, responseMsg,
-                                               responseLen);
+    auto rc = co_await sendRecvPldmMsgOverMctp(
+        eid, request, responseMsg, responseLen, requestClass, idempotent);
 
     co_return rc;
 }
@@ -655,7 +689,8 @@ exec::task<int> TerminusManager::getPLDMVersion(pldm_tid_t tid, uint8_t type,
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
 
-    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen);
+    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen,
+                                  requester::RequestClass::Control, true);
     if (rc)
     {
         lg2::error(
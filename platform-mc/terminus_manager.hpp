@@ -9,6 +9,7 @@
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "terminus.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <memory>
@@ -69,6 +70,16 @@ class TerminusManager
      */
     void discoverMctpTerminus(const MctpInfos& mctpInfos);
 
+    /** @brief Set the maximum number of termini discovered and initialized
+     *         concurrently
+     *
+     *  @param[in] concurrency - the limit, at least 1
+     */
+    void setInitConcurrency(size_t concurrency)
+    {
+        initConcurrency = std::max<size_t>(concurrency, 1);
+    }
+
     /** @brief remove MCTP endpoints
      *
      *  @param[in] mctpInfos - list information of the MCTP endpoints
@@ -84,11 +95,16 @@ class TerminusManager
      *  @param[in] request - request PLDM message
      *  @param[out] responseMsg - response PLDM message
      *  @param[out] responseLen - length of response PLDM message
+     *  @param[in] requestClass - scheduling class of the request
+     *  @param[in] idempotent - the request is read-only and may share the
+     *                          response of an identical pending request
      *  @return coroutine return_value - PLDM completion code
      */
-    exec::task<int> sendRecvPldmMsg(pldm_tid_t tid, Request& request,
-                                    const pldm_msg** responseMsg,
-                                    size_t* responseLen);
+    exec::task<int> sendRecvPldmMsg(
+        pldm_tid_t tid, Request& request, const pldm_msg** responseMsg,
+        size_t* responseLen,
+        requester::RequestClass requestClass = requester::RequestClass::Control,
+        bool idempotent = false);
 
     /** @brief Send request PLDM message to eid. The function will
      *         return when received the response message from terminus.
@@ -97,11 +113,16 @@ class TerminusManager
      *  @param[in] request - request PLDM message
      *  @param[out] responseMsg - response PLDM message
      *  @param[out] responseLen - length of response PLDM message
+     *  @param[in] requestClass - scheduling class of the request
+     *  @param[in] idempotent - the request is read-only and may share the
+     *                          response of an identical pending request
      *  @return coroutine return_value - PLDM completion code
      */
     virtual exec::task<int> sendRecvPldmMsgOverMctp(
         mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
-        size_t* responseLen);
+        size_t* responseLen,
+        requester::RequestClass requestClass = requester::RequestClass::Control,
+        bool idempotent = false);
 
     /** @brief member functions to map/unmap tid
      */
@@ -167,6 +188,24 @@ class TerminusManager
      */
     exec::task<int> discoverMctpTerminusTask();
 
+    /** @brief A worker of discoverMctpTerminusTask(), discovering the MCTP
+     *         endpoints of a list one after the other until none is left
+     *
+     *  @param[in] mctpInfos - list information of the MCTP endpoints
+     *  @param[in,out] next - index of the next endpoint to discover, shared
+     *                        by the workers
+     */
+    exec::task<void> discoverMctpTerminiTask(const MctpInfos& mctpInfos,
+                                             size_t& next);
+
+    /** @brief Discover and initialize the terminus of an MCTP endpoint, then
+     *         start its sensor polling
+     *
+     *  @param[in] mctpInfo - information of the MCTP endpoint
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> discoverMctpEndpointTask(const MctpInfo& mctpInfo);
+
     /** @brief Initialize terminus and then instantiate terminus object to keeps
      *         the data fetched from terminus
      *
@@ -256,6 +295,9 @@ class TerminusManager
     /** @brief A Manager interface for calling the hook functions **/
     Manager* manager;
 
+    /** @brief Maximum number of termini initialized concurrently */
+    size_t initConcurrency = TERMINUS_INIT_CONCURRENCY;
+
     /** @brief local EID */
     mctp_eid_t localEid;
 };
@@ -158,10 +158,14 @@ TEST_F(EventManagerTest, processNumericSensorEventTest)
         PLDM_SENSOR_NORMAL,
         PLDM_SENSOR_DATA_SIZE_UINT8,
         SENSOR_READING};
+    EXPECT_FALSE(termini[tid]->lastEventTime);
     auto rc = eventManager.handlePlatformEvent(
         tid, 0x00, PLDM_SENSOR_EVENT, eventData.data(), eventData.size());
     EXPECT_EQ(PLDM_SUCCESS, rc);
     EXPECT_EQ(PLDM_EVENT_NO_LOGGING, platformEventStatus);
+    // The event keeps the terminus alive and updates the reading
+    EXPECT_TRUE(termini[tid]->lastEventTime);
+    EXPECT_FALSE(std::isnan(termini[tid]->numericSensors[0]->getReading()));
 }
 
 TEST_F(EventManagerTest, SetEventReceiverTest)
@@ -17,7 +17,8 @@ class MockSensorManager : public SensorManager
                       Manager* manager) :
         SensorManager(event, terminusManager, termini, manager) {};
 
-    MOCK_METHOD(void, doSensorPolling, (pldm_tid_t tid), (override));
+    MOCK_METHOD(exec::task<int>, getSensorReading,
+                (std::shared_ptr<NumericSensor> sensor), (override));
 };
 
 } // namespace platform_mc
@@ -23,7 +23,8 @@ class MockTerminusManager : public TerminusManager
 
     exec::task<int> sendRecvPldmMsgOverMctp(
         mctp_eid_t /*eid*/, Request& /*request*/, const pldm_msg** responseMsg,
-        size_t* responseLen) override
+        size_t* responseLen, requester::RequestClass /*requestClass*/,
+        bool /*idempotent*/) override
     {
         if (responseMsgs.empty() || responseMsg == nullptr ||
             responseLen == nullptr)
@@ -270,3 +270,132 @@ TEST(NumericSensor, checkThreshold)
                                      hysteresis);
     EXPECT_EQ(false, lowAlarm);
 }
+
+TEST(NumericSensor, deadbandAndBatchedPublication)
+{
+    std::vector<uint8_t> pdr1{
+        0x1,
+        0x0,
+        0x0,
+        0x0,                     // record handle
+        0x1,                     // PDRHeaderVersion
+        PLDM_NUMERIC_SENSOR_PDR, // PDRType
+        0x0,
+        0x0,                     // recordChangeNumber
+        PLDM_PDR_NUMERIC_SENSOR_PDR_FIXED_LENGTH +
+            PLDM_PDR_NUMERIC_SENSOR_PDR_VARIED_SENSOR_DATA_SIZE_MIN_LENGTH +
+            PLDM_PDR_NUMERIC_SENSOR_PDR_VARIED_RANGE_FIELD_MIN_LENGTH,
+        0,                             // dataLength
+        0,
+        0,                             // PLDMTerminusHandle
+        0x1,
+        0x0,                           // sensorID=1
+        PLDM_ENTITY_POWER_SUPPLY,
+        0,                             // entityType=Power Supply(120)
+        1,
+        0,                             // entityInstanceNumber
+        0x1,
+        0x0,                           // containerID=1
+        PLDM_NO_INIT,                  // sensorInit
+        false,                         // sensorAuxiliaryNamesPDR
+        PLDM_SENSOR_UNIT_DEGRESS_C,    // baseUint(2)=degrees C
+        1,                             // unitModifier = 1
+        0,                             // rateUnit
+        0,                             // baseOEMUnitHandle
+        0,                             // auxUnit
+        0,                             // auxUnitModifier
+        0,                             // auxRateUnit
+        0,                             // rel
+        0,                             // auxOEMUnitHandle
+        true,                          // isLinear
+        PLDM_RANGE_FIELD_FORMAT_SINT8, // sensorDataSize
+        0,
+        0,
+        0xc0,
+        0x3f, // resolution=1.5
+        0,
+        0,
+        0x80,
+        0x3f, // offset=1.0
+        0,
+        0,    // accuracy
+        0,    // plusTolerance
+        0,    // minusTolerance
+        2,    // hysteresis
+        0,    // supportedThresholds
+        0,    // thresholdAndHysteresisVolatility
+        0,
+        0,
+        0x80,
+        0x3f, // stateTransistionInterval=1.0
+        0,
+        0,
+        0x80,
+        0x3f,                          // updateInverval=1.0
+        255,                           // maxReadable
+        0,                             // minReadable
+        PLDM_RANGE_FIELD_FORMAT_UINT8, // rangeFieldFormat
+        0,                             // rangeFieldsupport
+        0,                             // nominalValue
+        0,                             // normalMax
+        0,                             // normalMin
+        0,                             // warningHigh
+        0,                             // warningLow
+        0,                             // criticalHigh
+        0,                             // criticalLow
+        0,                             // fatalHigh
+        0                              // fatalLow
+    };
+
+    auto numericSensorPdr = std::make_shared<pldm_numeric_sensor_value_pdr>();
+    auto rc = decode_numeric_sensor_pdr_data(pdr1.data(), pdr1.size(),
+                                             numericSensorPdr.get());
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    std::string sensorName{"test1"};
+    std::string inventoryPath{
+        "/xyz/openbmc_project/inventroy/Item/Board/PLDM_device_1"};
+    pldm::platform_mc::NumericSensor sensor(0x01, true, numericSensorPdr,
+                                            sensorName, inventoryPath);
+
+    // (40*1.5 + 1.0 ) * 10^1 = 610
+    sensor.updateReading(true, true, 40);
+    EXPECT_EQ(610, sensor.getReading());
+    EXPECT_FALSE(sensor.hasPendingChanges());
+
+    // 625 is less than the deadband away from 610, 640 is not
+    sensor.setDeadband(20);
+    sensor.updateReading(true, true, 41);
+    EXPECT_EQ(610, sensor.getReading());
+    sensor.updateReading(true, true, 42);
+    EXPECT_EQ(640, sensor.getReading());
+
+    // Going to NaN is published whatever the deadband
+    sensor.updateReading(false, false);
+    EXPECT_TRUE(std::isnan(sensor.getReading()));
+    sensor.updateReading(true, true, 42);
+    EXPECT_EQ(640, sensor.getReading());
+
+    size_t deferred = 0;
+    sensor.setPendingHandler([&deferred]() { deferred++; });
+    sensor.setBatchedPublication(true);
+    sensor.updateReading(true, true, 42);
+    EXPECT_FALSE(sensor.hasPendingChanges());
+    sensor.updateReading(true, true, 50);
+    EXPECT_EQ(760, sensor.getReading());
+    EXPECT_TRUE(sensor.hasPendingChanges());
+    EXPECT_EQ(1, deferred);
+
+    // The handler is called once per publication
+    sensor.updateReading(true, true, 60);
+    EXPECT_EQ(1, deferred);
+    sensor.publish();
+    EXPECT_FALSE(sensor.hasPendingChanges());
+
+    sensor.handleErrGetSensorReading();
+    EXPECT_TRUE(sensor.hasPendingChanges());
+    EXPECT_EQ(2, deferred);
+    sensor.setBatchedPublication(false);
+    EXPECT_FALSE(sensor.hasPendingChanges());
+    EXPECT_TRUE(std::isnan(sensor.getReading()));
+}
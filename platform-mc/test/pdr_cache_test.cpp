@@ -0,0 +1,88 @@
+#include "platform-mc/pdr_cache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+namespace fs = std::filesystem;
+
+class PdrCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_pdr_cache.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+    const pldm::UUID uuid = "9a2ee4b0-1c2f-4f61-8d6e-3b0f3d1b7c52";
+    const PdrRepositorySignature signature{
+        2, 0x100, 59, {0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+    const std::vector<std::vector<uint8_t>> pdrs{{0x0, 0x0, 0x0, 0x0, 0x1},
+                                                 {0x1, 0x0, 0x0, 0x0, 0x1, 0x2}};
+};
+
+TEST_F(PdrCacheTest, storeLoad)
+{
+    PdrCache cache(dir / "pdr-cache");
+    EXPECT_FALSE(cache.load(uuid, signature));
+
+    EXPECT_TRUE(cache.store(uuid, signature, pdrs));
+    auto cached = cache.load(uuid, signature);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(pdrs, cached.value());
+
+    // The PDRs cached for another repository are a miss
+    auto updated = signature;
+    updated.updateTime[12]++;
+    EXPECT_FALSE(cache.load(uuid, updated));
+    updated = signature;
+    updated.recordCount++;
+    EXPECT_FALSE(cache.load(uuid, updated));
+}
+
+TEST_F(PdrCacheTest, invalidate)
+{
+    PdrCache cache(dir);
+    EXPECT_TRUE(cache.store(uuid, signature, pdrs));
+    cache.invalidate(uuid);
+    EXPECT_FALSE(cache.load(uuid, signature));
+}
+
+TEST_F(PdrCacheTest, corruptedFile)
+{
+    PdrCache cache(dir);
+    EXPECT_TRUE(cache.store(uuid, signature, pdrs));
+
+    auto size = fs::file_size(dir / uuid);
+    {
+        std::fstream file(dir / uuid,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(size / 2);
+        file.put(0x5a);
+    }
+    EXPECT_FALSE(cache.load(uuid, signature));
+
+    fs::resize_file(dir / uuid, size / 2);
+    EXPECT_FALSE(cache.load(uuid, signature));
+}
+
+TEST_F(PdrCacheTest, uncacheableUuid)
+{
+    PdrCache cache(dir);
+    EXPECT_FALSE(PdrCache::isCacheable(""));
+    EXPECT_FALSE(PdrCache::isCacheable("00000000-0000-0000-0000-000000000000"));
+    EXPECT_FALSE(PdrCache::isCacheable("../9a2ee4b0"));
+    EXPECT_FALSE(cache.store("", signature, pdrs));
+    EXPECT_TRUE(fs::is_empty(dir));
+}
@@ -6,6 +6,9 @@
 #include <sdeventplus/event.hpp>
 
 #include <bitset>
+#include <cstdlib>
+#include <filesystem>
+#include <span>
 
 #include <gtest/gtest.h>
 
@@ -512,3 +515,115 @@ TEST_F(PlatformManagerTest, negativeInitTerminusTest2)
     EXPECT_EQ(0, terminus->pdrs.size());
     EXPECT_EQ(0, terminus->numericSensors.size());
 }
+
+TEST_F(PlatformManagerTest, initTerminusFromPdrCacheTest)
+{
+    char tmpdir[] = "/tmp/pldm_pdr_cache.XXXXXX";
+    std::filesystem::path cacheDir(mkdtemp(tmpdir));
+    pldm::platform_mc::PdrCache pdrCache(cacheDir);
+    pldm::platform_mc::PlatformManager cachingPlatformManager(
+        mockTerminusManager, termini, &pdrCache);
+
+    // Add terminus with a UUID
+    const pldm::UUID uuid = "9a2ee4b0-1c2f-4f61-8d6e-3b0f3d1b7c52";
+    auto mappedTid =
+        mockTerminusManager.mapTid(pldm::MctpInfo(10, uuid, "", 1));
+    auto tid = mappedTid.value();
+
+    /* Set supported command by terminus */
+    auto size = PLDM_MAX_TYPES * (PLDM_MAX_CMDS_PER_TYPE / 8);
+    std::vector<uint8_t> pldmCmds(size);
+    uint8_t type = PLDM_PLATFORM;
+    uint8_t cmd = PLDM_GET_PDR;
+    auto idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + (cmd / 8);
+    pldmCmds[idx] = pldmCmds[idx] | (1 << (cmd % 8));
+    cmd = PLDM_GET_PDR_REPOSITORY_INFO;
+    idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + (cmd / 8);
+    pldmCmds[idx] = pldmCmds[idx] | (1 << (cmd % 8));
+    auto addTerminus = [&]() {
+        termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(
+            tid, 1 << PLDM_BASE | 1 << PLDM_PLATFORM);
+        termini[tid]->setSupportedCommands(pldmCmds);
+        return termini[tid];
+    };
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES>
+        getPDRRepositoryInfoResp{
+            0x0, 0x02, 0x50, PLDM_SUCCESS,
+            0x0,                                     // repositoryState
+            0x0, 0x0,  0x0,  0x0,          0x0, 0x0, 0x0,
+            0x0, 0x0,  0x0,  0x0,          0x0, 0x1, // updateTime
+            0x0, 0x0,  0x0,  0x0,          0x0, 0x0, 0x0,
+            0x0, 0x0,  0x0,  0x0,          0x0, 0x0, // OEMUpdateTime
+            2,   0x0,  0x0,  0x0,                    // recordCount
+            0x0, 0x1,  0x0,  0x0,                    // repositorySize
+            27,  0x0,  0x0,  0x0,                    // largestRecordSize
+            0x0 // dataTransferHandleTimeout
+        };
+
+    // Entity Auxiliary Names PDRs "S0" and "S1"
+    auto makePdr = [](uint8_t recordHandle, uint8_t name) {
+        return std::vector<uint8_t>{
+            recordHandle, 0x0, 0x0, 0x0, 0x1, PLDM_ENTITY_AUXILIARY_NAMES_PDR,
+            0x1, 0x0, 0x11, 0, 3, 0x80, 0x1, 0x0, 0, 0, 0, 01, 0x65, 0x6e,
+            0x00, 0x00, 0x53, 0x00, name, 0x00, 0x00};
+    };
+    auto makeGetPdrResp = [](uint8_t nextRecordHandle,
+                             const std::vector<uint8_t>& pdr) {
+        std::vector<uint8_t> resp{
+            0x0, 0x02, 0x51, PLDM_SUCCESS, nextRecordHandle,
+            0x0, 0x0,  0x0,                    // nextRecordHandle
+            0x0, 0x0,  0x0,  0x0,              // nextDataTransferHandle
+            PLDM_PLATFORM_TRANSFER_START_AND_END,
+            static_cast<uint8_t>(pdr.size()), 0x0 // responseCount
+        };
+        resp.insert(resp.end(), pdr.begin(), pdr.end());
+        return resp;
+    };
+    auto pdr0 = makePdr(0, 0x30);
+    auto pdr1 = makePdr(1, 0x31);
+    auto getPdrResp0 = makeGetPdrResp(1, pdr0);
+    auto getPdrResp1 = makeGetPdrResp(0, pdr1);
+    auto enqueue = [&](std::span<uint8_t> resp) {
+        EXPECT_EQ(PLDM_SUCCESS, mockTerminusManager.enqueueResponse(
+                                    reinterpret_cast<pldm_msg*>(resp.data()),
+                                    resp.size()));
+    };
+
+    // Cold discovery walks the repository and caches it
+    auto terminus = addTerminus();
+    enqueue(getPDRRepositoryInfoResp);
+    enqueue(getPdrResp0);
+    enqueue(getPdrResp1);
+    stdexec::sync_wait(cachingPlatformManager.initTerminus());
+    EXPECT_EQ(true, terminus->initialized);
+    ASSERT_EQ(2, terminus->pdrs.size());
+    EXPECT_TRUE(std::filesystem::exists(cacheDir / uuid));
+
+    // Warm discovery only fetches the first PDR to revalidate the cache
+    terminus = addTerminus();
+    enqueue(getPDRRepositoryInfoResp);
+    enqueue(getPdrResp0);
+    stdexec::sync_wait(cachingPlatformManager.initTerminus());
+    EXPECT_EQ(true, terminus->initialized);
+    ASSERT_EQ(2, terminus->pdrs.size());
+    EXPECT_EQ(pdr0, terminus->pdrs[0]);
+    EXPECT_EQ(pdr1, terminus->pdrs[1]);
+    EXPECT_TRUE(mockTerminusManager.responseMsgs.empty());
+
+    // A first PDR not matching the cache has the repository walked again
+    auto changedPdr0 = makePdr(0, 0x32);
+    auto changedGetPdrResp0 = makeGetPdrResp(1, changedPdr0);
+    terminus = addTerminus();
+    enqueue(getPDRRepositoryInfoResp);
+    enqueue(changedGetPdrResp0);
+    enqueue(changedGetPdrResp0);
+    enqueue(getPdrResp1);
+    stdexec::sync_wait(cachingPlatformManager.initTerminus());
+    ASSERT_EQ(2, terminus->pdrs.size());
+    EXPECT_EQ(changedPdr0, terminus->pdrs[0]);
+    EXPECT_TRUE(mockTerminusManager.responseMsgs.empty());
+
+    std::filesystem::remove_all(cacheDir);
+}
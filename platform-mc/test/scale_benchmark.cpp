@@ -0,0 +1,247 @@
+#include "common/latency_histogram.hpp"
+#include "common/transport.hpp"
+#include "common/types.hpp"
+#include "platform-mc/manager.hpp"
+#include "pldmd/rx_drain.hpp"
+#include "requester/handler.hpp"
+#include "requester/metrics.hpp"
+#include "test/test_instance_id.hpp"
+#include "utilities/simulator/simulator.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+#include <sys/socket.h>
+
+#include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <thread>
+
+/* Runs platform-mc against simulated termini and reports the time to discover
+ * them, the sensor polling throughput and the lag of the event loop while
+ * polling. The termini are served by a thread over a loopback socketpair, the
+ * event loop stands in for the one of pldmd.
+ *
+ * Usage: platform_mc_scale_benchmark [termini.json [seconds]]
+ *
+ * The termini are described as for pldm-simulator, by default 50 termini of
+ * 200 sensors each.
+ */
+
+using namespace std::chrono;
+using namespace sdeventplus;
+using namespace sdeventplus::source;
+
+constexpr auto lagInterval = milliseconds(10);
+constexpr auto discoveryTimeout = seconds(300);
+
+static nlohmann::json defaultTermini()
+{
+    return {{"termini",
+             {{{"eid", 10},
+               {"count", 50},
+               {"name", "SIM"},
+               {"eventStorm", {{"rate", 10}}},
+               {"sensors", {{{"count", 200}, {"dataSize", "uint16"}}}}}}}};
+}
+
+/* Run the event loop until a condition holds or a time is reached */
+static void runUntil(Event& event, const std::function<bool()>& done,
+                     steady_clock::time_point deadline)
+{
+    while (!done() && steady_clock::now() < deadline)
+    {
+        sd_event_run(event.get(), duration_cast<microseconds>(lagInterval)
+                                      .count());
+    }
+}
+
+static uint64_t countTimeouts(const pldm::requester::RequesterMetrics& metrics)
+{
+    uint64_t timeouts = 0;
+    for (const auto& [key, entry] : metrics.getAll())
+    {
+        timeouts += entry.timeouts;
+    }
+    return timeouts;
+}
+
+int main(int argc, char** argv)
+{
+    auto description = defaultTermini();
+    if (argc > 1)
+    {
+        std::ifstream jsonFile(argv[1]);
+        description = nlohmann::json::parse(jsonFile, nullptr, false);
+        if (description.is_discarded())
+        {
+            fprintf(stderr, "Failed to parse %s\n", argv[1]);
+            return 1;
+        }
+    }
+    auto pollingTime = seconds(argc > 2 ? std::stoi(argv[2]) : 10);
+    auto config = pldm::simulator::parseConfig(description);
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0,
+                   fds))
+    {
+        perror("socketpair");
+        return 1;
+    }
+    pldm::simulator::Simulator simulator(config, fds[1]);
+    const auto& stats = simulator.getStats();
+    std::atomic<bool> stop = false;
+    std::thread simulatorThread([&simulator, &stop] { simulator.run(stop); });
+
+    auto event = Event::get_default();
+    TestInstanceIdDb instanceIdDb;
+    PldmTransport transport(fds[0]);
+    pldm::requester::Handler<pldm::requester::Request> reqHandler(
+        &transport, event, instanceIdDb, false);
+    pldm::platform_mc::Manager manager(event, reqHandler, instanceIdDb);
+
+    auto rxHandler = [&](pldm_tid_t eid, std::span<const uint8_t> msg) {
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(msg.data());
+        auto pldmMsg = reinterpret_cast<const pldm_msg*>(msg.data());
+        auto payloadLength = msg.size() - sizeof(pldm_msg_hdr);
+        if (!hdr->request)
+        {
+            reqHandler.handleResponse(eid, hdr->instance_id, hdr->type,
+                                      hdr->command, pldmMsg, payloadLength);
+            return;
+        }
+        if (hdr->type != PLDM_PLATFORM ||
+            hdr->command != PLDM_PLATFORM_EVENT_MESSAGE)
+        {
+            return;
+        }
+
+        // Stand in for the platform responder of pldmd, which hands the
+        // pldmMessagePollEvents to platform-mc
+        uint8_t formatVersion = 0;
+        uint8_t tid = 0;
+        uint8_t eventClass = 0;
+        size_t offset = 0;
+        auto rc = decode_platform_event_message_req(
+            pldmMsg, payloadLength, &formatVersion, &tid, &eventClass, &offset);
+        if (rc == PLDM_SUCCESS && eventClass == PLDM_MESSAGE_POLL_EVENT)
+        {
+            rc = manager.handlePldmMessagePollEvent(
+                pldmMsg, payloadLength, formatVersion, tid, offset);
+        }
+        pldm::Response response(sizeof(pldm_msg_hdr) +
+                                PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        if (encode_platform_event_message_resp(hdr->instance_id, rc,
+                                               PLDM_EVENT_NO_LOGGING,
+                                               responsePtr) == PLDM_SUCCESS)
+        {
+            transport.sendMsg(eid, response.data(), response.size());
+        }
+    };
+    IO io(event, transport.getEventSource(), EPOLLIN,
+          [&transport, &rxHandler](IO&, int, uint32_t revents) {
+              if (revents & EPOLLIN)
+              {
+                  pldm::drainRxMsgs(transport, pldm::maxRxMsgsPerWakeup,
+                                    rxHandler);
+              }
+          });
+
+    // The loop lag is how late a periodic timer fires
+    pldm::LatencyHistogram loopLag;
+    auto lastTick = steady_clock::now();
+    utility::Timer<ClockId::Monotonic> lagTimer(
+        event,
+        [&loopLag, &lastTick](utility::Timer<ClockId::Monotonic>&) {
+            auto now = steady_clock::now();
+            loopLag.record(duration_cast<microseconds>(now - lastTick -
+                                                       lagInterval));
+            lastTick = now;
+        },
+        lagInterval);
+
+    pldm::MctpInfos mctpInfos;
+    size_t sensors = 0;
+    for (const auto& terminus : config.termini)
+    {
+        mctpInfos.emplace_back(terminus.eid, "", "", 1);
+        sensors += terminus.sensors.size();
+    }
+
+    auto start = steady_clock::now();
+    manager.handleMctpEndpoints(mctpInfos);
+    runUntil(
+        event,
+        [&stats, &simulator] {
+            return stats.configured.load() == simulator.size();
+        },
+        start + discoveryTimeout);
+    duration<double> discovery = steady_clock::now() - start;
+    auto discovered = stats.configured.load();
+
+    // Measure the polling of all the discovered termini
+    loopLag = {};
+    manager.getSensorManager().resetPollingStats();
+    auto readings = stats.sensorReadings.load();
+    auto delivered = stats.eventsDelivered.load();
+    auto timeouts = countTimeouts(reqHandler.getMetrics());
+    start = steady_clock::now();
+    runUntil(event, [] { return false; }, start + pollingTime);
+    duration<double> elapsed = steady_clock::now() - start;
+    readings = stats.sensorReadings.load() - readings;
+    delivered = stats.eventsDelivered.load() - delivered;
+    timeouts = countTimeouts(reqHandler.getMetrics()) - timeouts;
+
+    printf("termini      %10zu discovered of %zu\n", discovered,
+           simulator.size());
+    printf("sensors      %10zu\n", sensors);
+    printf("discovery    %10.3f s\n", discovery.count());
+    printf("polling      %10.0f readings/s\n", readings / elapsed.count());
+    printf("events       %10.0f events/s\n", delivered / elapsed.count());
+    printf("timeouts     %10llu\n", static_cast<unsigned long long>(timeouts));
+    printf("loop lag     %10llu us p50 %llu us p99 %llu us max\n",
+           static_cast<unsigned long long>(loopLag.getPercentile(50).count()),
+           static_cast<unsigned long long>(loopLag.getPercentile(99).count()),
+           static_cast<unsigned long long>(loopLag.count ? loopLag.max : 0));
+
+    uint64_t deadlineMisses = 0;
+    for (const auto& polled : manager.getSensorManager().getPolledSensors())
+    {
+        deadlineMisses += polled->stats.deadlineMisses;
+    }
+    printf("misses       %10llu sensor deadlines\n",
+           static_cast<unsigned long long>(deadlineMisses));
+
+    // Stop polling and let the requests in flight complete before tearing
+    // down the managers
+    manager.handleRemovedMctpEndpoints(mctpInfos);
+    auto requests = stats.requests.load();
+    auto quietSince = steady_clock::now();
+    runUntil(
+        event,
+        [&stats, &requests, &quietSince] {
+            auto now = steady_clock::now();
+            if (stats.requests.load() != requests)
+            {
+                requests = stats.requests.load();
+                quietSince = now;
+            }
+            return now - quietSince > seconds(1);
+        },
+        steady_clock::now() + seconds(10));
+
+    stop = true;
+    simulatorThread.join();
+    return discovered == simulator.size() ? 0 : 1;
+}
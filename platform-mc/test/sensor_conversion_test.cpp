@@ -0,0 +1,150 @@
+#include "platform-mc/sensor_conversion.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+namespace
+{
+
+/* The threshold check of NumericSensor, in the unit of the sensor */
+bool checkThreshold(bool alarm, bool direction, double value, double threshold,
+                    double hyst)
+{
+    if (direction)
+    {
+        if (value >= threshold)
+        {
+            return true;
+        }
+        if (value < (threshold - hyst))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if (value <= threshold)
+        {
+            return true;
+        }
+        if (value > (threshold + hyst))
+        {
+            return false;
+        }
+    }
+    return alarm;
+}
+
+uint8_t checkConverted(double value, uint8_t alarms,
+                       const std::array<double, 4>& thresholds,
+                       double hysteresis)
+{
+    for (size_t idx = 0; idx < RawThresholds::alarms.size(); ++idx)
+    {
+        auto alarm = RawThresholds::alarms[idx];
+        if (std::isnan(thresholds[idx]))
+        {
+            continue;
+        }
+        bool high = alarm == warningHighAlarm || alarm == criticalHighAlarm;
+        if (checkThreshold(alarms & alarm, high, value, thresholds[idx],
+                           hysteresis))
+        {
+            alarms |= alarm;
+        }
+        else
+        {
+            alarms &= ~alarm;
+        }
+    }
+    return alarms;
+}
+
+} // namespace
+
+TEST(SensorConversion, convert)
+{
+    // (40*1.5 + 1.0 ) * 10^1 = 610
+    SensorConversion conversion(1.5, 1.0, 1);
+    EXPECT_EQ(610, conversion.convert(40));
+
+    SensorConversion identity(std::numeric_limits<double>::quiet_NaN(),
+                              std::numeric_limits<double>::quiet_NaN(), 0);
+    EXPECT_EQ(42, identity.convert(42));
+}
+
+TEST(RawThresholds, matchConvertedThresholds)
+{
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<SensorConversion> conversions{
+        {1.5, 1.0, 1}, {0.1, -20, 0}, {-0.25, 100, 0}, {0.3, 0.7, -3},
+        {1, 0, 0}};
+    const std::vector<std::array<double, 4>> thresholds{
+        {100, 20, 150, 0},
+        {37.5, nan, 42.1, -5.05},
+        {nan, nan, nan, nan},
+        {0.0213, 0.0021, nan, 0.0006}};
+    const std::vector<double> hystereses{0, 2, 0.35};
+
+    for (const auto& conversion : conversions)
+    {
+        for (const auto& threshold : thresholds)
+        {
+            for (auto hysteresis : hystereses)
+            {
+                auto raw = RawThresholds::fromThresholds(conversion, threshold,
+                                                         hysteresis);
+                ASSERT_TRUE(raw);
+
+                /* Sweep up then down so that the hysteresis matters */
+                uint8_t rawAlarms = 0;
+                uint8_t convertedAlarms = 0;
+                for (int pass = 0; pass < 2; ++pass)
+                {
+                    for (int64_t step = -1000; step <= 1000; ++step)
+                    {
+                        auto reading = pass ? -step : step;
+                        rawAlarms = raw->check(reading, rawAlarms);
+                        convertedAlarms =
+                            checkConverted(conversion.convert(reading),
+                                           convertedAlarms, threshold,
+                                           hysteresis);
+                        EXPECT_EQ(convertedAlarms, rawAlarms);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RawThresholds, constantConversion)
+{
+    SensorConversion conversion(0, 1, 0);
+    EXPECT_FALSE(RawThresholds::fromThresholds(conversion, {1, 0, 2, -1}, 0));
+}
+
+TEST(RawThresholds, batch)
+{
+    SensorConversion conversion(1, 0, 0);
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto raw = RawThresholds::fromThresholds(conversion, {50, 10, nan, nan}, 5);
+    ASSERT_TRUE(raw);
+
+    std::vector<RawThresholds> thresholds(4, *raw);
+    std::vector<int64_t> readings{30, 50, 47, 5};
+    std::vector<uint8_t> alarms{0, 0, warningHighAlarm, 0};
+    EXPECT_EQ(2, checkRawThresholds(thresholds, readings, alarms));
+    EXPECT_EQ((std::vector<uint8_t>{0, warningHighAlarm, warningHighAlarm,
+                                    warningLowAlarm}),
+              alarms);
+
+    readings = {30, 44, 47, 16};
+    EXPECT_EQ(2, checkRawThresholds(thresholds, readings, alarms));
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, warningHighAlarm, 0}), alarms);
+}
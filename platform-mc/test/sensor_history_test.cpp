@@ -0,0 +1,94 @@
+#include "platform-mc/sensor_history.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+TEST(SensorHistory, parseHistoryWindows)
+{
+    EXPECT_EQ((std::vector<uint64_t>{10000000, 60000000, 300000000}),
+              parseHistoryWindows("10,60,300"));
+    EXPECT_EQ((std::vector<uint64_t>{5000000}),
+              parseHistoryWindows("0,x,5,-1,"));
+    EXPECT_TRUE(parseHistoryWindows("").empty());
+}
+
+TEST(SensorHistory, samples)
+{
+    const std::vector<uint64_t> windows{1000};
+    SensorHistory history(2, 3, windows);
+    EXPECT_EQ(2, history.size());
+    EXPECT_EQ(0, history.getArenaSize() % 64);
+
+    auto statistics = history.getStatistics(0);
+    ASSERT_EQ(1, statistics.size());
+    EXPECT_EQ(0, statistics[0].count);
+    EXPECT_TRUE(std::isnan(statistics[0].mean));
+
+    // The ring keeps the latest readings, NaN readings are not kept
+    for (uint64_t step = 1; step <= 5; ++step)
+    {
+        history.push(0, step * 10, static_cast<double>(step));
+    }
+    history.push(0, 60, std::numeric_limits<double>::quiet_NaN());
+    auto samples = history.getSamples(0);
+    ASSERT_EQ(3, samples.size());
+    EXPECT_EQ(30, samples[0].timestamp);
+    EXPECT_EQ(3, samples[0].value);
+    EXPECT_EQ(50, samples[2].timestamp);
+    EXPECT_EQ(5, samples[2].value);
+
+    // The other sensor has its own ring
+    EXPECT_TRUE(history.getSamples(1).empty());
+    EXPECT_TRUE(history.getSamples(2).empty());
+}
+
+TEST(SensorHistory, matchBruteForce)
+{
+    const std::vector<uint64_t> windows{35, 100, 1000000};
+    constexpr size_t depth = 16;
+    SensorHistory history(1, depth, windows);
+
+    std::vector<HistorySample> readings;
+    uint64_t timestamp = 0;
+    for (int step = 0; step < 500; ++step)
+    {
+        timestamp += 1 + (step * 7) % 13;
+        double value = ((step * 37) % 101) * 0.5 - 20;
+        history.push(0, timestamp, value);
+        readings.emplace_back(timestamp, value);
+
+        auto statistics = history.getStatistics(0);
+        ASSERT_EQ(windows.size(), statistics.size());
+        for (size_t idx = 0; idx < windows.size(); ++idx)
+        {
+            // The readings still in the ring and in the window
+            double min = std::numeric_limits<double>::infinity();
+            double max = -min;
+            double sum = 0;
+            uint32_t count = 0;
+            auto first = readings.size() > depth ? readings.size() - depth : 0;
+            for (auto it = readings.begin() + first; it != readings.end(); ++it)
+            {
+                if (timestamp - it->timestamp >= windows[idx])
+                {
+                    continue;
+                }
+                min = std::min(min, it->value);
+                max = std::max(max, it->value);
+                sum += it->value;
+                count++;
+            }
+            EXPECT_EQ(windows[idx], statistics[idx].window);
+            EXPECT_EQ(count, statistics[idx].count);
+            EXPECT_EQ(min, statistics[idx].min);
+            EXPECT_EQ(max, statistics[idx].max);
+            EXPECT_NEAR(sum / count, statistics[idx].mean, 1e-9);
+        }
+    }
+}
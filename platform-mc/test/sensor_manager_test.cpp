@@ -6,6 +6,8 @@
 
 #include <sdeventplus/event.hpp>
 
+#include <chrono>
+
 #include <gtest/gtest.h>
 
 using namespace ::testing;
@@ -150,29 +152,163 @@ class SensorManagerTest : public testing::Test
 
 TEST_F(SensorManagerTest, sensorPollingTest)
 {
-    uint64_t seconds = 10;
+    uint64_t seconds = 3;
 
+    // A sensor read every 1s and one every 100ms
     pldm_tid_t tid = 1;
+    auto pdr3 = pdr1;
+    pdr3[0] = 0x2;  // record handle
+    pdr3[12] = 0x2; // sensorID=2
     termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0);
     termini[tid]->pdrs.push_back(pdr1);
     termini[tid]->pdrs.push_back(pdr2);
+    termini[tid]->pdrs.push_back(pdr3);
     termini[tid]->parseTerminusPDRs();
+    ASSERT_EQ(2, termini[tid]->numericSensors.size());
+    for (auto& sensor : termini[tid]->numericSensors)
+    {
+        sensor->updateTime = sensor->sensorId == 1 ? 1000000 : 100000;
+    }
 
-    uint64_t t0, t1;
-    ASSERT_TRUE(sd_event_now(event.get(), CLOCK_MONOTONIC, &t0) >= 0);
-    ON_CALL(sensorManager, doSensorPolling(tid))
-        .WillByDefault([this, &t0, &t1](unsigned char) {
-            ASSERT_TRUE(sd_event_now(event.get(), CLOCK_MONOTONIC, &t1) >= 0);
-            EXPECT_GE(t1 - t0, SENSOR_POLLING_TIME * 1000);
-            t0 = t1;
-        });
-    EXPECT_CALL(sensorManager, doSensorPolling(tid))
-        .Times(AtLeast(2))
-        .WillRepeatedly(Return());
+    std::map<uint16_t, size_t> readings;
+    ON_CALL(sensorManager, getSensorReading(_))
+        .WillByDefault(
+            [&readings](std::shared_ptr<pldm::platform_mc::NumericSensor>
+                            sensor) -> exec::task<int> {
+                readings[sensor->sensorId]++;
+                co_return PLDM_SUCCESS;
+            });
+    EXPECT_CALL(sensorManager, getSensorReading(_)).Times(AtLeast(2));
 
     sensorManager.startPolling(tid);
 
     runEventLoopForSeconds(seconds);
 
+    // The fast sensor is not starved behind the slow one
+    EXPECT_GE(readings[1], 3);
+    EXPECT_LE(readings[1], 4);
+    EXPECT_GE(readings[2], 20);
+    EXPECT_LE(readings[2], 31);
+
+    auto polledSensors = sensorManager.getPolledSensors();
+    ASSERT_EQ(2, polledSensors.size());
+    for (const auto& polled : polledSensors)
+    {
+        EXPECT_EQ(readings[polled->sensor->sensorId], polled->stats.readings);
+    }
+
+    sensorManager.stopPolling(tid);
+    EXPECT_TRUE(sensorManager.getPolledSensors().empty());
+}
+
+TEST_F(SensorManagerTest, unavailableTerminusTest)
+{
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0);
+    termini[tid]->pdrs.push_back(pdr1);
+    termini[tid]->pdrs.push_back(pdr2);
+    termini[tid]->parseTerminusPDRs();
+    termini[tid]->numericSensors[0]->updateTime = 100000;
+
+    size_t readings = 0;
+    ON_CALL(sensorManager, getSensorReading(_))
+        .WillByDefault(
+            [&readings](std::shared_ptr<pldm::platform_mc::NumericSensor>)
+                -> exec::task<int> {
+                readings++;
+                co_return PLDM_SUCCESS;
+            });
+    EXPECT_CALL(sensorManager, getSensorReading(_)).Times(AtLeast(1));
+
+    // The sensors of an unavailable terminus are not read
+    sensorManager.startPolling(tid);
+    sensorManager.updateAvailableState(tid, false);
+    runEventLoopForSeconds(1);
+    EXPECT_EQ(0, readings);
+
+    // and are read again as soon as it is available
+    sensorManager.updateAvailableState(tid, true);
+    runEventLoopForSeconds(1);
+    EXPECT_GE(readings, 5);
+
+    sensorManager.stopPolling(tid);
+}
+
+TEST_F(SensorManagerTest, eventDrivenSensorTest)
+{
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0);
+    termini[tid]->pdrs.push_back(pdr1);
+    termini[tid]->pdrs.push_back(pdr2);
+    termini[tid]->parseTerminusPDRs();
+    termini[tid]->numericSensors[0]->updateTime = 100000;
+    termini[tid]->eventReceiverConfigured = true;
+    termini[tid]->recordEvent();
+    sensorManager.setEventLivenessTime(std::chrono::seconds(2));
+
+    size_t readings = 0;
+    ON_CALL(sensorManager, getSensorReading(_))
+        .WillByDefault(
+            [&readings](std::shared_ptr<pldm::platform_mc::NumericSensor>
+                            sensor) -> exec::task<int> {
+                readings++;
+                sensor->eventsEnabled = true;
+                co_return PLDM_SUCCESS;
+            });
+    EXPECT_CALL(sensorManager, getSensorReading(_)).Times(AtLeast(1));
+
+    // The sensor sends events, it is only polled for liveness
+    sensorManager.startPolling(tid);
+    runEventLoopForSeconds(1);
+    EXPECT_LE(readings, 2);
+
+    // The terminus sent nothing for the liveness time, it is polled again
+    runEventLoopForSeconds(2);
+    EXPECT_GE(readings, 6);
+
+    sensorManager.stopPolling(tid);
+}
+
+TEST_F(SensorManagerTest, snapshotTest)
+{
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0);
+    termini[tid]->pdrs.push_back(pdr1);
+    termini[tid]->pdrs.push_back(pdr2);
+    termini[tid]->parseTerminusPDRs();
+    termini[tid]->numericSensors[0]->updateTime = 100000;
+
+    ON_CALL(sensorManager, getSensorReading(_))
+        .WillByDefault(
+            [](std::shared_ptr<pldm::platform_mc::NumericSensor> sensor)
+                -> exec::task<int> {
+                sensor->updateReading(true, true, 40);
+                co_return PLDM_SUCCESS;
+            });
+    EXPECT_CALL(sensorManager, getSensorReading(_)).Times(AtLeast(1));
+
+    // The sensors are in the snapshot, not updated, once polled
+    sensorManager.startPolling(tid);
+    auto readings = sensorManager.getSnapshot().getReadings(tid, {});
+    ASSERT_TRUE(readings);
+    ASSERT_EQ(1, readings->size());
+    EXPECT_EQ(0, readings->front().timestamp);
+
+    // (40*1.5 + 1.0 ) * 10^1 = 610
+    runEventLoopForSeconds(1);
+    std::vector<uint16_t> sensorIds{1, 2};
+    readings = sensorManager.getSnapshot().getReadings(tid, sensorIds);
+    ASSERT_TRUE(readings);
+    ASSERT_EQ(1, readings->size());
+    EXPECT_EQ(1, readings->front().sensorId);
+    EXPECT_EQ(610, readings->front().value);
+    EXPECT_TRUE(readings->front().available);
+    EXPECT_TRUE(readings->front().functional);
+    EXPECT_GT(readings->front().timestamp, 0);
+
+    // No history is kept with sensor-history-depth 0
+    EXPECT_FALSE(sensorManager.getHistory(tid));
+
     sensorManager.stopPolling(tid);
+    EXPECT_FALSE(sensorManager.getSnapshot().getReadings(tid, {}));
 }
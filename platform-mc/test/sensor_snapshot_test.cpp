@@ -0,0 +1,114 @@
+#include "platform-mc/sensor_reading_ring.hpp"
+#include "platform-mc/sensor_snapshot.hpp"
+
+#include <unistd.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+TEST(SensorSnapshot, getReadings)
+{
+    SensorSnapshot snapshot;
+    snapshot.addTerminus(1, {7, 3, 5});
+    snapshot.addTerminus(2, {3});
+
+    EXPECT_FALSE(snapshot.getSlot(1, 4));
+    auto slot = snapshot.getSlot(1, 5);
+    ASSERT_TRUE(slot);
+    snapshot.update(1, *slot, {5, 42.5, true, true, 1000});
+
+    // All the sensors of the terminus, by sensor ID
+    auto readings = snapshot.getReadings(1, {});
+    ASSERT_TRUE(readings);
+    ASSERT_EQ(3, readings->size());
+    EXPECT_EQ(3, (*readings)[0].sensorId);
+    EXPECT_TRUE(std::isnan((*readings)[0].value));
+    EXPECT_FALSE((*readings)[0].available);
+    EXPECT_EQ(0, (*readings)[0].timestamp);
+    EXPECT_EQ(5, (*readings)[1].sensorId);
+    EXPECT_EQ(42.5, (*readings)[1].value);
+    EXPECT_TRUE((*readings)[1].available);
+    EXPECT_TRUE((*readings)[1].functional);
+    EXPECT_EQ(1000, (*readings)[1].timestamp);
+    EXPECT_EQ(7, (*readings)[2].sensorId);
+
+    // The requested sensors in order, the unknown ones skipped
+    std::vector<uint16_t> sensorIds{7, 4, 5};
+    readings = snapshot.getReadings(1, sensorIds);
+    ASSERT_TRUE(readings);
+    ASSERT_EQ(2, readings->size());
+    EXPECT_EQ(7, (*readings)[0].sensorId);
+    EXPECT_EQ(5, (*readings)[1].sensorId);
+
+    // The other terminus is not updated
+    readings = snapshot.getReadings(2, {});
+    ASSERT_TRUE(readings);
+    ASSERT_EQ(1, readings->size());
+    EXPECT_EQ(0, (*readings)[0].timestamp);
+
+    snapshot.removeTerminus(1);
+    EXPECT_FALSE(snapshot.getReadings(1, {}));
+    EXPECT_FALSE(snapshot.getSlot(1, 5));
+}
+
+TEST(SensorReadingRing, disabled)
+{
+    SensorReadingRing ring(0, "/pldm-sensor-readings-test");
+    EXPECT_FALSE(ring.enabled());
+    ring.push(1, {1, 1, true, true, 1});
+    EXPECT_TRUE(ring.getMapping().empty());
+}
+
+TEST(SensorReadingRing, readRecords)
+{
+    auto name = "/pldm-sensor-readings-test-" + std::to_string(getpid());
+    SensorReadingRing ring(4, name);
+    ASSERT_TRUE(ring.enabled());
+
+    uint64_t next = 0;
+    EXPECT_TRUE(readReadingRecords(ring.getMapping(), next).empty());
+    EXPECT_EQ(0, next);
+
+    ring.push(1, {3, 21.5, true, true, 100});
+    ring.push(2, {4, 0, true, false, 200});
+    auto records = readReadingRecords(ring.getMapping(), next);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(2, next);
+    EXPECT_EQ(1, records[0].sequence);
+    EXPECT_EQ(1, records[0].tid);
+    EXPECT_EQ(3, records[0].sensorId);
+    EXPECT_EQ(21.5, records[0].value);
+    EXPECT_EQ(100, records[0].timestampUs);
+    EXPECT_EQ(readingFlagAvailable | readingFlagFunctional, records[0].flags);
+    EXPECT_EQ(2, records[1].tid);
+    EXPECT_EQ(readingFlagAvailable, records[1].flags);
+
+    // A reader more than a ring behind gets the records still in the ring
+    for (uint16_t sensorId = 10; sensorId < 16; ++sensorId)
+    {
+        ring.push(1, {sensorId, 1, true, true, 300});
+    }
+    records = readReadingRecords(ring.getMapping(), next);
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(8, next);
+    EXPECT_EQ(5, records[0].sequence);
+    EXPECT_EQ(12, records[0].sensorId);
+    EXPECT_EQ(15, records[3].sensorId);
+
+    // A copy of the ring, e.g. a dump, decodes the same
+    uint64_t from = 6;
+    std::vector<uint8_t> copy(ring.getMapping().begin(),
+                              ring.getMapping().end());
+    records = readReadingRecords(copy, from);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(14, records[0].sensorId);
+
+    copy[0] = 'X';
+    from = 0;
+    EXPECT_TRUE(readReadingRecords(copy, from).empty());
+}
@@ -0,0 +1,301 @@
+#include "libpldm/platform.h"
+
+#include "platform-mc/terminus.hpp"
+#include "utilities/simulator/simulated_terminus.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::simulator;
+
+static std::vector<uint8_t> request(uint8_t type, uint8_t command,
+                                    std::vector<uint8_t> payload = {})
+{
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr));
+    pldm_header_info header{};
+    header.msg_type = PLDM_REQUEST;
+    header.instance = 3;
+    header.pldm_type = type;
+    header.command = command;
+    pack_pldm_header(&header, reinterpret_cast<pldm_msg_hdr*>(msg.data()));
+    msg.insert(msg.end(), payload.begin(), payload.end());
+    return msg;
+}
+
+static const pldm_msg* asMsg(const std::vector<uint8_t>& response)
+{
+    return reinterpret_cast<const pldm_msg*>(response.data());
+}
+
+static size_t payloadLength(const std::vector<uint8_t>& response)
+{
+    return response.size() - sizeof(pldm_msg_hdr);
+}
+
+TEST(SimulatedTerminusTest, parseConfig)
+{
+    auto config = parseConfig(nlohmann::json::parse(R"({
+        "seed": 7,
+        "termini": [
+            {"eid": 10, "count": 3, "latency_us": 100, "loss_percent": 50,
+             "sensors": [{"count": 2}, {"sensorId": 100, "dataSize": "sint8",
+                          "min": -5, "max": 5}]},
+            {"eid": 20, "name": "Board", "tid": 4}
+        ]})"));
+
+    EXPECT_EQ(config.seed, 7);
+    ASSERT_EQ(config.termini.size(), 4);
+    EXPECT_EQ(config.termini[0].eid, 10);
+    EXPECT_EQ(config.termini[2].eid, 12);
+    EXPECT_EQ(config.termini[2].name, "SIM_12");
+    EXPECT_EQ(config.termini[0].faults.latency.count(), 100);
+    EXPECT_DOUBLE_EQ(config.termini[0].faults.lossRate, 0.5);
+    ASSERT_EQ(config.termini[0].sensors.size(), 3);
+    EXPECT_EQ(config.termini[0].sensors[1].sensorId, 2);
+    EXPECT_EQ(config.termini[0].sensors[2].sensorId, 100);
+    EXPECT_EQ(config.termini[0].sensors[2].dataSize,
+              PLDM_SENSOR_DATA_SIZE_SINT8);
+    EXPECT_EQ(config.termini[3].name, "Board");
+    EXPECT_EQ(config.termini[3].tid, 4);
+
+    EXPECT_THROW(parseConfig(nlohmann::json::parse(
+                     R"({"termini": [{"eid": 10}, {"eid": 10}]})")),
+                 std::invalid_argument);
+    EXPECT_THROW(parseConfig(nlohmann::json::parse(
+                     R"({"termini": [{"eid": 250, "count": 10}]})")),
+                 std::invalid_argument);
+    EXPECT_THROW(parseConfig(nlohmann::json::parse(R"({"termini": [{
+                     "eid": 10, "sensors": [{"dataSize": "uint8",
+                     "max": 300}]}]})")),
+                 std::invalid_argument);
+}
+
+TEST(SimulatedTerminusTest, pdrsParsedByTerminus)
+{
+    auto config = parseConfig(nlohmann::json::parse(R"({"termini": [
+        {"eid": 10, "name": "S0", "pdrTransferSize": 16,
+         "sensors": [{"count": 3, "dataSize": "uint32", "max": 100000}]}]})"));
+    SimulatedTerminus sim(config.termini[0]);
+    ASSERT_EQ(sim.getPdrs().size(), 4);
+
+    // Fetch the PDRs with GetPDR, in parts of at most 16 bytes
+    pldm::platform_mc::Terminus terminus(1, 1 << PLDM_BASE |
+                                                1 << PLDM_PLATFORM);
+    uint32_t recordHandle = 0;
+    do
+    {
+        std::vector<uint8_t> record;
+        uint32_t dataTransferHandle = 0;
+        uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+        uint8_t transferFlag = 0;
+        uint32_t nextRecordHandle = 0;
+        do
+        {
+            std::vector<uint8_t> getPdr(sizeof(pldm_msg_hdr) +
+                                        PLDM_GET_PDR_REQ_BYTES);
+            ASSERT_EQ(encode_get_pdr_req(
+                          0, recordHandle, dataTransferHandle, transferOpFlag,
+                          255, 0, reinterpret_cast<pldm_msg*>(getPdr.data()),
+                          PLDM_GET_PDR_REQ_BYTES),
+                      PLDM_SUCCESS);
+            auto response = sim.handleRequest(getPdr);
+
+            uint8_t completionCode = 0;
+            uint16_t count = 0;
+            uint8_t transferCrc = 0;
+            std::vector<uint8_t> data(255);
+            ASSERT_EQ(decode_get_pdr_resp(
+                          asMsg(response), payloadLength(response),
+                          &completionCode, &nextRecordHandle,
+                          &dataTransferHandle, &transferFlag, &count,
+                          data.data(), data.size(), &transferCrc),
+                      PLDM_SUCCESS);
+            ASSERT_EQ(completionCode, PLDM_SUCCESS);
+            EXPECT_LE(count, 16);
+            record.insert(record.end(), data.begin(), data.begin() + count);
+            transferOpFlag = PLDM_GET_NEXTPART;
+        } while (transferFlag != PLDM_END &&
+                 transferFlag != PLDM_START_AND_END);
+        terminus.pdrs.push_back(std::move(record));
+        recordHandle = nextRecordHandle;
+    } while (recordHandle);
+
+    ASSERT_EQ(terminus.pdrs, sim.getPdrs());
+    terminus.parseTerminusPDRs();
+    EXPECT_EQ(terminus.getTerminusName().value_or(""), "S0");
+    ASSERT_EQ(terminus.numericSensors.size(), 3);
+    EXPECT_EQ(terminus.numericSensors[2]->sensorId, 3);
+}
+
+TEST(SimulatedTerminusTest, getSensorReading)
+{
+    auto config = parseConfig(nlohmann::json::parse(R"({"termini": [
+        {"eid": 10, "sensors": [{"count": 2, "dataSize": "sint16",
+                                 "min": -1, "max": 1}]}]})"));
+    SimulatedTerminus sim(config.termini[0]);
+
+    std::vector<int16_t> readings;
+    for (size_t idx = 0; idx < 4; ++idx)
+    {
+        auto response = sim.handleRequest(
+            request(PLDM_PLATFORM, PLDM_GET_SENSOR_READING, {2, 0, 0}));
+        uint8_t completionCode = 0;
+        uint8_t dataSize = 0;
+        uint8_t operationalState = 0;
+        uint8_t eventMessageEnable = 0;
+        uint8_t presentState = 0;
+        uint8_t previousState = 0;
+        uint8_t eventState = 0;
+        union_sensor_data_size reading{};
+        ASSERT_EQ(decode_get_sensor_reading_resp(
+                      asMsg(response), payloadLength(response),
+                      &completionCode, &dataSize, &operationalState,
+                      &eventMessageEnable, &presentState, &previousState,
+                      &eventState, reinterpret_cast<uint8_t*>(&reading)),
+                  PLDM_SUCCESS);
+        EXPECT_EQ(completionCode, PLDM_SUCCESS);
+        EXPECT_EQ(dataSize, PLDM_SENSOR_DATA_SIZE_SINT16);
+        EXPECT_EQ(operationalState, PLDM_SENSOR_ENABLED);
+        EXPECT_EQ(eventMessageEnable, PLDM_NO_EVENT_GENERATION);
+        readings.push_back(reading.value_s16);
+    }
+    EXPECT_EQ(readings, (std::vector<int16_t>{-1, 0, 1, -1}));
+    EXPECT_EQ(sim.sensorReadings, 4);
+
+    auto response = sim.handleRequest(
+        request(PLDM_PLATFORM, PLDM_GET_SENSOR_READING, {3, 0, 0}));
+    EXPECT_EQ(asMsg(response)->payload[0], PLDM_PLATFORM_INVALID_SENSOR_ID);
+}
+
+TEST(SimulatedTerminusTest, sensorEventMessageEnable)
+{
+    auto config = parseConfig(nlohmann::json::parse(R"({"termini": [
+        {"eid": 10, "sensors": [{"dataSize": "uint8",
+                                 "eventMessageEnable": "eventsEnabled"}]}]})"));
+    SimulatedTerminus sim(config.termini[0]);
+
+    auto response = sim.handleRequest(
+        request(PLDM_PLATFORM, PLDM_GET_SENSOR_READING, {1, 0, 0}));
+    uint8_t completionCode = 0;
+    uint8_t dataSize = 0;
+    uint8_t operationalState = 0;
+    uint8_t eventMessageEnable = 0;
+    uint8_t presentState = 0;
+    uint8_t previousState = 0;
+    uint8_t eventState = 0;
+    union_sensor_data_size reading{};
+    ASSERT_EQ(decode_get_sensor_reading_resp(
+                  asMsg(response), payloadLength(response), &completionCode,
+                  &dataSize, &operationalState, &eventMessageEnable,
+                  &presentState, &previousState, &eventState,
+                  reinterpret_cast<uint8_t*>(&reading)),
+              PLDM_SUCCESS);
+    EXPECT_EQ(completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(dataSize, PLDM_SENSOR_DATA_SIZE_UINT8);
+    EXPECT_EQ(eventMessageEnable, PLDM_EVENTS_ENABLED);
+
+    EXPECT_THROW(parseConfig(nlohmann::json::parse(R"({"termini": [{
+                     "eid": 10, "sensors": [{"eventMessageEnable":
+                     "always"}]}]})")),
+                 std::invalid_argument);
+}
+
+TEST(SimulatedTerminusTest, pollSensorEvents)
+{
+    auto config = parseConfig(nlohmann::json::parse(R"({"termini": [
+        {"eid": 10, "tid": 5, "sensors": [{"count": 1}]}]})"));
+    SimulatedTerminus sim(config.termini[0]);
+
+    // No event receiver yet, the events wait
+    EXPECT_TRUE(sim.queueSensorEvent());
+    EXPECT_TRUE(sim.queueSensorEvent());
+    EXPECT_FALSE(sim.needsPollEvent());
+
+    auto response = sim.handleRequest(request(
+        PLDM_PLATFORM, PLDM_SET_EVENT_RECEIVER,
+        {PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_ASYNC, 0, 8}));
+    EXPECT_EQ(asMsg(response)->payload[0], PLDM_SUCCESS);
+    ASSERT_TRUE(sim.needsPollEvent());
+
+    auto pollEvent = sim.pollEventRequest(1);
+    EXPECT_FALSE(sim.needsPollEvent());
+    uint8_t formatVersion = 0;
+    uint8_t tid = 0;
+    uint8_t eventClass = 0;
+    size_t offset = 0;
+    ASSERT_EQ(decode_platform_event_message_req(
+                  asMsg(pollEvent), payloadLength(pollEvent), &formatVersion,
+                  &tid, &eventClass, &offset),
+              PLDM_SUCCESS);
+    EXPECT_EQ(tid, 5);
+    EXPECT_EQ(eventClass, PLDM_MESSAGE_POLL_EVENT);
+
+    uint8_t transferOperationFlag = PLDM_GET_FIRSTPART;
+    uint16_t eventIdToAcknowledge = PLDM_PLATFORM_EVENT_ID_NULL;
+    std::vector<uint16_t> eventIds;
+    for (size_t idx = 0; idx < 4; ++idx)
+    {
+        std::vector<uint8_t> poll(
+            sizeof(pldm_msg_hdr) +
+            PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES);
+        ASSERT_EQ(encode_poll_for_platform_event_message_req(
+                      0, 1, transferOperationFlag, 0, eventIdToAcknowledge,
+                      reinterpret_cast<pldm_msg*>(poll.data()), poll.size()),
+                  PLDM_SUCCESS);
+        response = sim.handleRequest(poll);
+
+        uint8_t completionCode = 0;
+        uint8_t eventTid = 0;
+        uint16_t eventId = 0;
+        uint32_t nextDataTransferHandle = 0;
+        uint8_t transferFlag = 0;
+        uint8_t polledEventClass = 0;
+        uint32_t eventDataSize = 0;
+        uint8_t* eventData = nullptr;
+        uint32_t checksum = 0;
+        ASSERT_EQ(decode_poll_for_platform_event_message_resp(
+                      asMsg(response), payloadLength(response),
+                      &completionCode, &eventTid, &eventId,
+                      &nextDataTransferHandle, &transferFlag,
+                      &polledEventClass, &eventDataSize,
+                      reinterpret_cast<void**>(&eventData), &checksum),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(completionCode, PLDM_SUCCESS);
+
+        if (transferOperationFlag == PLDM_GET_FIRSTPART)
+        {
+            ASSERT_EQ(transferFlag, PLDM_PLATFORM_TRANSFER_START_AND_END);
+            EXPECT_EQ(polledEventClass, PLDM_SENSOR_EVENT);
+            EXPECT_EQ(checksum, crc32(eventData, eventDataSize));
+            uint16_t sensorId = 0;
+            uint8_t sensorEventClass = 0;
+            size_t classOffset = 0;
+            ASSERT_EQ(decode_sensor_event_data(eventData, eventDataSize,
+                                               &sensorId, &sensorEventClass,
+                                               &classOffset),
+                      PLDM_SUCCESS);
+            EXPECT_EQ(sensorId, 1);
+            EXPECT_EQ(sensorEventClass, PLDM_NUMERIC_SENSOR_STATE);
+            eventIds.push_back(eventId);
+            transferOperationFlag = PLDM_ACKNOWLEDGEMENT_ONLY;
+            eventIdToAcknowledge = eventId;
+        }
+        else
+        {
+            // Acknowledged, the second one is the last event
+            EXPECT_EQ(eventId, eventIds.size() == 1
+                                   ? PLDM_PLATFORM_EVENT_ID_ACK
+                                   : PLDM_PLATFORM_EVENT_ID_NONE);
+            transferOperationFlag = PLDM_GET_FIRSTPART;
+            eventIdToAcknowledge = PLDM_PLATFORM_EVENT_ID_NULL;
+        }
+    }
+
+    EXPECT_EQ(eventIds, (std::vector<uint16_t>{1, 2}));
+    EXPECT_EQ(sim.eventsDelivered, 2);
+    EXPECT_EQ(sim.getQueuedEvents(), 0);
+}
@@ -542,3 +542,53 @@ TEST_F(TerminusManagerTest, doesSupportCommandTest)
     EXPECT_EQ(false, termini[1]->doesSupportCommand(
                          PLDM_FRU, PLDM_GET_FRU_RECORD_BY_OPTION));
 }
+
+TEST_F(TerminusManagerTest, discoverMultipleMctpTerminiTest)
+{
+    const size_t getTidRespLen = PLDM_GET_TID_RESP_BYTES;
+    const size_t setTidRespLen = PLDM_SET_TID_RESP_BYTES;
+    const size_t getPldmTypesRespLen = PLDM_GET_TYPES_RESP_BYTES;
+
+    auto rc = mockTerminusManager.clearQueuedResponses();
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    mockTerminusManager.setInitConcurrency(2);
+
+    // Neither terminus has a TID nor supports any PLDM type
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getTidRespLen> getTidResp{
+        0x00, 0x02, 0x02, 0x00, 0x00};
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + setTidRespLen> setTidResp{
+        0x00, 0x02, 0x01, 0x00};
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getPldmTypesRespLen>
+        getPldmTypesResp{0x00, 0x02, 0x04, 0x00, 0x00, 0x00,
+                         0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    for (size_t terminus = 0; terminus < 2; ++terminus)
+    {
+        rc = mockTerminusManager.enqueueResponse(
+            reinterpret_cast<pldm_msg*>(getTidResp.data()), sizeof(getTidResp));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+        rc = mockTerminusManager.enqueueResponse(
+            reinterpret_cast<pldm_msg*>(setTidResp.data()), sizeof(setTidResp));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+        rc = mockTerminusManager.enqueueResponse(
+            reinterpret_cast<pldm_msg*>(getPldmTypesResp.data()),
+            sizeof(getPldmTypesResp));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    pldm::MctpInfos mctpInfos{};
+    mctpInfos.emplace_back(pldm::MctpInfo(12, "", "", 1));
+    mctpInfos.emplace_back(pldm::MctpInfo(13, "", "", 1));
+    mockTerminusManager.discoverMctpTerminus(mctpInfos);
+    EXPECT_EQ(2, termini.size());
+
+    auto tid0 = mockTerminusManager.toTid(mctpInfos[0]);
+    auto tid1 = mockTerminusManager.toTid(mctpInfos[1]);
+    ASSERT_TRUE(tid0.has_value());
+    ASSERT_TRUE(tid1.has_value());
+    EXPECT_NE(tid0.value(), tid1.value());
+    EXPECT_TRUE(termini.contains(tid0.value()));
+    EXPECT_TRUE(termini.contains(tid1.value()));
+
+    mockTerminusManager.removeMctpTerminus(mctpInfos);
+    EXPECT_EQ(0, termini.size());
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "common/loop_watchdog.hpp"
+#include "dbus_impl_metrics.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the event loop watchdog */
+constexpr auto loopWatchdogInterface = "pldm.LoopWatchdog";
+
+/** @brief Period of the probe of the event loop lag */
+constexpr std::chrono::milliseconds lagProbeInterval{100};
+
+/** @brief A callback which stalled the event loop as returned by GetStalls:
+ *         kind, name, EID or TID, PLDM type, command code, stalls, total and
+ *         longest time held in usec. A PLDM message handler has no name, the
+ *         other callbacks have no PLDM type and command.
+ */
+using StallEntry = std::tuple<std::string, std::string, uint8_t, uint8_t,
+                              uint8_t, uint64_t, uint64_t, uint64_t>;
+
+/** @brief What the watchdog recorded as returned by GetStalls: threshold in
+ *         usec, histograms of the time held by each dispatch and of the loop
+ *         lag, and the callbacks which stalled the loop the most
+ */
+using StallsReply = std::tuple<uint64_t, LatencyEntry, LatencyEntry,
+                               std::vector<StallEntry>>;
+
+/** @class LoopWatchdog
+ *  @brief Publishes the event loop watchdog on D-Bus.
+ *  @details Like pldm.Metrics, the interface has no YAML definition.
+ *  GetStalls returns what the watchdog recorded, with at most the given
+ *  number of callbacks. SetThreshold enables the watchdog with a non-zero
+ *  threshold in microseconds and disables it with zero, Reset clears what
+ *  was recorded.
+ */
+class LoopWatchdog
+{
+  public:
+    LoopWatchdog() = delete;
+    LoopWatchdog(const LoopWatchdog&) = delete;
+    LoopWatchdog& operator=(const LoopWatchdog&) = delete;
+    LoopWatchdog(LoopWatchdog&&) = delete;
+    LoopWatchdog& operator=(LoopWatchdog&&) = delete;
+    ~LoopWatchdog() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] event - The event loop watched
+     *  @param[in] watchdog - The watchdog of the event loop
+     */
+    LoopWatchdog(sdbusplus::bus_t& bus, const std::string& path,
+                 sdeventplus::Event& event, watchdog::LoopWatchdog& watchdog) :
+        event(event), loopWatchdog(watchdog),
+        interface(bus, path.c_str(), loopWatchdogInterface, vtable, this)
+    {
+        setThreshold(watchdog.getThreshold());
+    }
+
+    /** @brief Get what the watchdog recorded
+     *
+     *  @param[in] watchdog - The watchdog of the event loop
+     *  @param[in] count - Maximum number of callbacks in the top stalls
+     *
+     *  @return the reply of GetStalls
+     */
+    static StallsReply toReply(const watchdog::LoopWatchdog& watchdog,
+                               size_t count)
+    {
+        std::vector<StallEntry> topStalls;
+        for (const auto& [source, stats] : watchdog.getTopStalls(count))
+        {
+            topStalls.emplace_back(std::string(toString(source.kind)),
+                                   std::string(source.name), source.eid,
+                                   source.type, source.command, stats.stalls,
+                                   stats.totalUs, stats.maxUs);
+        }
+
+        return {static_cast<uint64_t>(watchdog.getThreshold().count()),
+                Metrics::toEntry(watchdog.getHoldTimes()),
+                Metrics::toEntry(watchdog.getLag()), std::move(topStalls)};
+    }
+
+  private:
+    /** @brief Set the threshold of the watchdog and run the lag probe while
+     *         it is enabled
+     */
+    void setThreshold(std::chrono::microseconds threshold)
+    {
+        loopWatchdog.setThreshold(threshold);
+        if (!loopWatchdog.isEnabled())
+        {
+            lagProbe.reset();
+        }
+        else if (!lagProbe)
+        {
+            lagProbe.emplace(event, lagProbeInterval, loopWatchdog);
+        }
+    }
+
+    /** @brief Implementation for GetStalls */
+    static int getStalls(sd_bus_message* msg, void* context,
+                         sd_bus_error* error)
+    {
+        auto self = static_cast<LoopWatchdog*>(context);
+        try
+        {
+            auto call = sdbusplus::message_t(msg);
+            uint32_t count = 0;
+            call.read(count);
+            auto reply = call.new_method_return();
+            reply.append(toReply(self->loopWatchdog, count));
+            reply.method_return();
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to reply with the loop watchdog stalls, {ERROR}",
+                       "ERROR", e);
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    /** @brief Implementation for SetThreshold */
+    static int setThresholdMethod(sd_bus_message* msg, void* context,
+                                  sd_bus_error* error)
+    {
+        auto self = static_cast<LoopWatchdog*>(context);
+        try
+        {
+            auto call = sdbusplus::message_t(msg);
+            uint64_t thresholdUs = 0;
+            call.read(thresholdUs);
+            self->setThreshold(std::chrono::microseconds(thresholdUs));
+            call.new_method_return().method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    /** @brief Implementation for Reset */
+    static int reset(sd_bus_message* msg, void* context, sd_bus_error* error)
+    {
+        auto self = static_cast<LoopWatchdog*>(context);
+        try
+        {
+            self->loopWatchdog.reset();
+            sdbusplus::message_t(msg).new_method_return().method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStalls", "u",
+                                  "(t(ttttata(ttt))(ttttata(ttt))a(ssyyyttt))",
+                                  getStalls),
+        sdbusplus::vtable::method("SetThreshold", "t", "", setThresholdMethod),
+        sdbusplus::vtable::method("Reset", "", "", reset),
+        sdbusplus::vtable::end()};
+
+    sdeventplus::Event& event;
+    watchdog::LoopWatchdog& loopWatchdog;
+    std::optional<watchdog::LagProbe> lagProbe;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
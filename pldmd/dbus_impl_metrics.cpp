@@ -0,0 +1,157 @@
+#include "dbus_impl_metrics.hpp"
+
+#include "common/worker_pool.hpp"
+#include "invoker.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+LatencyEntry Metrics::toEntry(const LatencyHistogram& histogram)
+{
+    if (!histogram.count)
+    {
+        return {0, 0, 0, 0, {}, {}};
+    }
+
+    std::vector<uint64_t> percentiles;
+    for (const auto& [name, percentile] : metricsPercentiles)
+    {
+        percentiles.push_back(histogram.getPercentile(percentile).count());
+    }
+    std::vector<LatencyBucket> buckets;
+    histogram.forEachBucket(
+        [&buckets](uint64_t low, uint64_t high, uint64_t count) {
+            buckets.emplace_back(low, high, count);
+        });
+    return {histogram.count, histogram.sum, histogram.min, histogram.max,
+            std::move(percentiles), std::move(buckets)};
+}
+
+std::vector<MetricsEntry>
+    Metrics::toEntries(const requester::RequesterMetrics& metrics)
+{
+    std::vector<MetricsEntry> entries;
+    for (const auto& [key, entry] : metrics.getAll())
+    {
+        entries.emplace_back(
+            key.eid, key.type, key.command, entry.requests, entry.responses,
+            entry.errorResponses, entry.retries, entry.timeouts,
+            entry.sendFailures, entry.cancelled, entry.queueDepth,
+            entry.maxQueueDepth, toEntry(entry.latency));
+    }
+    std::ranges::sort(entries, {}, [](const auto& entry) {
+        return std::make_tuple(std::get<0>(entry), std::get<1>(entry),
+                               std::get<2>(entry));
+    });
+    return entries;
+}
+
+int Metrics::getMetrics(sd_bus_message* msg, void* context,
+                        sd_bus_error* error)
+{
+    auto self = static_cast<Metrics*>(context);
+    try
+    {
+        auto call = sdbusplus::message_t(msg);
+        auto reply = call.new_method_return();
+        reply.append(toEntries(self->metrics));
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to reply with the requester metrics, {ERROR}",
+                   "ERROR", e);
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+int Metrics::getHandlerStats(sd_bus_message* msg, void* context,
+                             sd_bus_error* error)
+{
+    auto self = static_cast<Metrics*>(context);
+    try
+    {
+        std::vector<HandlerStatsEntry> handlerStats;
+        self->invoker.forEachHandlerStats(
+            [&handlerStats](Type type, Command command,
+                            const responder::HandlerStats& stats) {
+                handlerStats.emplace_back(type, command, stats.async,
+                                          stats.calls, stats.totalTime.count(),
+                                          stats.maxTime.count());
+            });
+        auto call = sdbusplus::message_t(msg);
+        auto reply = call.new_method_return();
+        reply.append(handlerStats);
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to reply with the handler usage, {ERROR}", "ERROR",
+                   e);
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+int Metrics::getWorkerPoolStats(sd_bus_message* msg, void* context,
+                                sd_bus_error* error)
+{
+    auto self = static_cast<Metrics*>(context);
+    try
+    {
+        auto stats = self->workerPool.getStats();
+        auto call = sdbusplus::message_t(msg);
+        auto reply = call.new_method_return();
+        reply.append(WorkerPoolStatsEntry(
+            stats.workers, stats.queueDepth, stats.maxQueueDepth,
+            stats.busyWorkers, stats.submitted, stats.completed,
+            stats.rejected, stats.busyTime.count(), stats.utilization));
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to reply with the worker pool load, {ERROR}",
+                   "ERROR", e);
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+int Metrics::reset(sd_bus_message* msg, void* context, sd_bus_error* error)
+{
+    auto self = static_cast<Metrics*>(context);
+    try
+    {
+        self->metrics.reset();
+        self->invoker.resetHandlerStats();
+        sdbusplus::message_t(msg).new_method_return().method_return();
+    }
+    catch (const std::exception& e)
+    {
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "requester/metrics.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+class WorkerPool;
+
+namespace responder
+{
+class Invoker;
+}
+
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the requester metrics. The debug interfaces of
+ *         pldmd are private to pldmd and pldmtool, they are kept out of the
+ *         xyz.openbmc_project namespace of phosphor-dbus-interfaces.
+ */
+constexpr auto metricsInterface = "pldm.Metrics";
+
+/** @brief Percentiles of the latency reported for each command */
+constexpr std::array<std::pair<const char*, double>, 4> metricsPercentiles = {
+    {{"P50", 50}, {"P90", 90}, {"P99", 99}, {"P999", 99.9}}};
+
+/** @brief A non-empty bucket of a latency histogram: lowest and highest
+ *         latency in usec and count
+ */
+using LatencyBucket = std::tuple<uint64_t, uint64_t, uint64_t>;
+
+/** @brief A latency histogram: count, sum, min and max in usec, 0 when it is
+ *         empty, the metricsPercentiles in usec and the non-empty buckets
+ */
+using LatencyEntry =
+    std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, std::vector<uint64_t>,
+               std::vector<LatencyBucket>>;
+
+/** @brief The metrics of a command to an endpoint as returned by GetMetrics:
+ *         EID, PLDM type, command code, requests, responses, error
+ *         responses, retries, timeouts, send failures, cancelled requests,
+ *         queue depth, highest queue depth and latency
+ */
+using MetricsEntry =
+    std::tuple<uint8_t, uint8_t, uint8_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+               LatencyEntry>;
+
+/** @brief Usage of the handler of a command as returned by GetHandlerStats:
+ *         PLDM type, command code, async, calls, total and longest time in
+ *         nsec
+ */
+using HandlerStatsEntry =
+    std::tuple<uint8_t, uint8_t, bool, uint64_t, uint64_t, uint64_t>;
+
+/** @brief Load of the worker pool as returned by GetWorkerPoolStats: workers,
+ *         queue depth, highest queue depth, busy workers, submitted,
+ *         completed and rejected jobs, busy time in nsec and utilization
+ */
+using WorkerPoolStatsEntry = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t,
+                                        uint64_t, uint64_t, uint64_t, uint64_t,
+                                        double>;
+
+/** @class Metrics
+ *  @brief Publishes the requester metrics on D-Bus.
+ *  @details The pldm.Metrics interface has no YAML definition, its methods
+ *  return the entries documented with their types. GetMetrics returns the
+ *  metrics of each endpoint and command, sorted by endpoint and command.
+ *  GetHandlerStats returns the usage of the responder's command handlers and
+ *  GetWorkerPoolStats the load of the pool of threads running the blocking
+ *  command handlers. Reset clears the counters, the latency histograms and
+ *  the handler usage.
+ */
+class Metrics
+{
+  public:
+    Metrics() = delete;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+    Metrics& operator=(Metrics&&) = delete;
+    ~Metrics() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] metrics - The metrics of the requester handler
+     *  @param[in] invoker - The invoker of the command handlers
+     *  @param[in] workerPool - The pool running the blocking command handlers
+     */
+    Metrics(sdbusplus::bus_t& bus, const std::string& path,
+            requester::RequesterMetrics& metrics, responder::Invoker& invoker,
+            const WorkerPool& workerPool) :
+        metrics(metrics), invoker(invoker), workerPool(workerPool),
+        interface(bus, path.c_str(), metricsInterface, vtable, this)
+    {}
+
+    /** @brief Get the D-Bus entry of a latency histogram */
+    static LatencyEntry toEntry(const LatencyHistogram& histogram);
+
+    /** @brief Get the D-Bus entries of the requester metrics, sorted by
+     *         endpoint and command
+     */
+    static std::vector<MetricsEntry>
+        toEntries(const requester::RequesterMetrics& metrics);
+
+  private:
+    /** @brief Implementation for GetMetrics */
+    static int getMetrics(sd_bus_message* msg, void* context,
+                          sd_bus_error* error);
+
+    /** @brief Implementation for GetHandlerStats */
+    static int getHandlerStats(sd_bus_message* msg, void* context,
+                               sd_bus_error* error);
+
+    /** @brief Implementation for GetWorkerPoolStats */
+    static int getWorkerPoolStats(sd_bus_message* msg, void* context,
+                                  sd_bus_error* error);
+
+    /** @brief Implementation for Reset */
+    static int reset(sd_bus_message* msg, void* context, sd_bus_error* error);
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method(
+            "GetMetrics", "", "a(yyyttttttttt(ttttata(ttt)))", getMetrics),
+        sdbusplus::vtable::method("GetHandlerStats", "", "a(yybttt)",
+                                  getHandlerStats),
+        sdbusplus::vtable::method("GetWorkerPoolStats", "", "(ttttttttd)",
+                                  getWorkerPoolStats),
+        sdbusplus::vtable::method("Reset", "", "", reset),
+        sdbusplus::vtable::end()};
+
+    requester::RequesterMetrics& metrics;
+    responder::Invoker& invoker;
+    const WorkerPool& workerPool;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
+
+#include <libpldm/base.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <exception>
+#include <string>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the request windows of the endpoints */
+constexpr auto requestWindowInterface = "pldm.RequestWindow";
+
+/** @class RequestWindow
+ *  @brief Sets the number of requests in flight to each endpoint over D-Bus.
+ *  @details Like pldm.Metrics, the interface has no YAML definition.
+ *  GetWindowSize returns the window of an endpoint, the request-window-size
+ *  option unless it was set. SetWindowSize sets the window of an endpoint,
+ *  from 1 to the number of instance IDs, and fails with InvalidArgument
+ *  otherwise. The window of an endpoint lasts until pldmd restarts.
+ */
+class RequestWindow
+{
+  public:
+    RequestWindow() = delete;
+    RequestWindow(const RequestWindow&) = delete;
+    RequestWindow& operator=(const RequestWindow&) = delete;
+    RequestWindow(RequestWindow&&) = delete;
+    RequestWindow& operator=(RequestWindow&&) = delete;
+    ~RequestWindow() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] handler - The requester handler
+     */
+    RequestWindow(sdbusplus::bus_t& bus, const std::string& path,
+                  requester::Handler<requester::Request>& handler) :
+        handler(handler),
+        interface(bus, path.c_str(), requestWindowInterface, vtable, this)
+    {}
+
+  private:
+    /** @brief Implementation for GetWindowSize */
+    static int getWindowSize(sd_bus_message* msg, void* context,
+                             sd_bus_error* error)
+    {
+        auto self = static_cast<RequestWindow*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t(msg);
+            uint8_t eid = 0;
+            m.read(eid);
+            auto windowSize = self->handler.getEndpointWindowSize(eid);
+            auto reply = m.new_method_return();
+            reply.append(static_cast<uint32_t>(windowSize));
+            reply.method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    /** @brief Implementation for SetWindowSize */
+    static int setWindowSize(sd_bus_message* msg, void* context,
+                             sd_bus_error* error)
+    {
+        auto self = static_cast<RequestWindow*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t(msg);
+            uint8_t eid = 0;
+            uint32_t windowSize = 0;
+            m.read(eid, windowSize);
+            if (self->handler.setEndpointWindowSize(eid, windowSize) !=
+                PLDM_SUCCESS)
+            {
+                return sd_bus_error_set(
+                    error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                    "Request window size out of range");
+            }
+            m.new_method_return().method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetWindowSize", "y", "u", getWindowSize),
+        sdbusplus::vtable::method("SetWindowSize", "yu", "", setWindowSize),
+        sdbusplus::vtable::end()};
+
+    requester::Handler<requester::Request>& handler;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,115 @@
+#include "dbus_impl_sensor_history.hpp"
+
+#include "platform-mc/sensor_manager.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+namespace
+{
+
+/** @brief Find the history and the slot of the sensor of a method call */
+std::optional<std::pair<const platform_mc::SensorHistory*, size_t>>
+    findHistory(sdbusplus::message_t& m,
+                const platform_mc::SensorManager& sensorManager)
+{
+    uint8_t tid = 0;
+    uint16_t sensorId = 0;
+    m.read(tid, sensorId);
+
+    auto history = sensorManager.getHistory(tid);
+    auto slot = sensorManager.getSnapshot().getSlot(tid, sensorId);
+    if (!history || !slot)
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(history, *slot);
+}
+
+} // namespace
+
+int SensorHistory::getSamples(sd_bus_message* msg, void* context,
+                              sd_bus_error* error)
+{
+    auto self = static_cast<SensorHistory*>(context);
+    try
+    {
+        auto m = sdbusplus::message_t(msg);
+        auto found = findHistory(m, self->sensorManager);
+        if (!found)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                "No history of such numeric sensor");
+        }
+
+        std::vector<std::tuple<uint64_t, double>> samples;
+        for (const auto& sample : found->first->getSamples(found->second))
+        {
+            samples.emplace_back(sample.timestamp, sample.value);
+        }
+        auto reply = m.new_method_return();
+        reply.append(samples);
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to reply with the sensor history, {ERROR}", "ERROR",
+                   e);
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+int SensorHistory::getStatistics(sd_bus_message* msg, void* context,
+                                 sd_bus_error* error)
+{
+    auto self = static_cast<SensorHistory*>(context);
+    try
+    {
+        auto m = sdbusplus::message_t(msg);
+        auto found = findHistory(m, self->sensorManager);
+        if (!found)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                "No history of such numeric sensor");
+        }
+
+        std::vector<std::tuple<uint64_t, uint32_t, double, double, double>>
+            statistics;
+        for (const auto& window : found->first->getStatistics(found->second))
+        {
+            statistics.emplace_back(window.window, window.count, window.min,
+                                    window.max, window.mean);
+        }
+        auto reply = m.new_method_return();
+        reply.append(statistics);
+        reply.method_return();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to reply with the sensor statistics, {ERROR}",
+                   "ERROR", e);
+        return sd_bus_error_set(
+            error, "xyz.openbmc_project.Common.Error.InternalFailure",
+            e.what());
+    }
+    return 1;
+}
+
+} // namespace dbus_api
+} // namespace pldm
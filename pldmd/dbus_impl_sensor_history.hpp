@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <string>
+
+namespace pldm
+{
+namespace platform_mc
+{
+class SensorManager;
+}
+
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the history of the platform-mc sensors */
+constexpr auto sensorHistoryInterface = "pldm.SensorHistory";
+
+/** @class SensorHistory
+ *  @brief Publishes the history of the platform-mc sensors on D-Bus.
+ *  @details Like pldm.SensorPolling, the interface has no YAML definition. For
+ *  a terminus ID and a sensor ID, GetSamples returns the readings kept of the
+ *  sensor, oldest first, as their time in usec of CLOCK_MONOTONIC and value.
+ *  GetStatistics returns for each window its length in usec, the number of
+ *  readings in it and their minimum, maximum and mean, as of the latest
+ *  reading. Both fail with InvalidArgument when the sensor has no history, e.g.
+ *  with sensor-history-depth 0.
+ */
+class SensorHistory
+{
+  public:
+    SensorHistory() = delete;
+    SensorHistory(const SensorHistory&) = delete;
+    SensorHistory& operator=(const SensorHistory&) = delete;
+    SensorHistory(SensorHistory&&) = delete;
+    SensorHistory& operator=(SensorHistory&&) = delete;
+    ~SensorHistory() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] sensorManager - The sensor manager of platform-mc
+     */
+    SensorHistory(sdbusplus::bus_t& bus, const std::string& path,
+                  platform_mc::SensorManager& sensorManager) :
+        sensorManager(sensorManager),
+        interface(bus, path.c_str(), sensorHistoryInterface, vtable, this)
+    {}
+
+  private:
+    /** @brief Implementation for GetSamples */
+    static int getSamples(sd_bus_message* msg, void* context,
+                          sd_bus_error* error);
+
+    /** @brief Implementation for GetStatistics */
+    static int getStatistics(sd_bus_message* msg, void* context,
+                             sd_bus_error* error);
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetSamples", "yq", "a(td)", getSamples),
+        sdbusplus::vtable::method("GetStatistics", "yq", "a(tuddd)",
+                                  getStatistics),
+        sdbusplus::vtable::end()};
+
+    platform_mc::SensorManager& sensorManager;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "platform-mc/sensor_manager.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <exception>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the sensor polling statistics */
+constexpr auto sensorPollingInterface = "pldm.SensorPolling";
+
+/** @brief The statistics of a polled sensor as returned by GetStats: TID,
+ *         sensor ID, name, update interval in usec, deadband, readings,
+ *         deadline misses, total and longest lateness in usec
+ */
+using PolledSensorEntry =
+    std::tuple<uint8_t, uint16_t, std::string, uint64_t, double, uint64_t,
+               uint64_t, uint64_t, uint64_t>;
+
+/** @class SensorPolling
+ *  @brief Publishes the statistics of the sensor polling scheduler on D-Bus.
+ *  @details Like pldm.Metrics, the interface has no YAML definition. GetStats
+ *  returns, for each polled sensor, its update interval, its readings, how
+ *  late they completed after their deadline and how many completed more than
+ *  one update interval late. Reset clears the statistics. SetDeadband sets
+ *  the smallest change of the reading of a sensor which is published on
+ *  D-Bus.
+ */
+class SensorPolling
+{
+  public:
+    SensorPolling() = delete;
+    SensorPolling(const SensorPolling&) = delete;
+    SensorPolling& operator=(const SensorPolling&) = delete;
+    SensorPolling(SensorPolling&&) = delete;
+    SensorPolling& operator=(SensorPolling&&) = delete;
+    ~SensorPolling() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] sensorManager - The sensor manager of platform-mc
+     */
+    SensorPolling(sdbusplus::bus_t& bus, const std::string& path,
+                  platform_mc::SensorManager& sensorManager) :
+        sensorManager(sensorManager),
+        interface(bus, path.c_str(), sensorPollingInterface, vtable, this)
+    {}
+
+    /** @brief Get the statistics of the polled sensors
+     *
+     *  @param[in] sensorManager - The sensor manager of platform-mc
+     *
+     *  @return an entry per sensor
+     */
+    static std::vector<PolledSensorEntry>
+        toEntries(const platform_mc::SensorManager& sensorManager)
+    {
+        std::vector<PolledSensorEntry> sensors;
+        for (const auto& polled : sensorManager.getPolledSensors())
+        {
+            const auto& sensor = *polled->sensor;
+            const auto& stats = polled->stats;
+            sensors.emplace_back(sensor.tid, sensor.sensorId,
+                                 sensor.sensorName, sensor.updateTime,
+                                 sensor.getDeadband(), stats.readings,
+                                 stats.deadlineMisses, stats.totalLatenessUs,
+                                 stats.maxLatenessUs);
+        }
+        return sensors;
+    }
+
+  private:
+    /** @brief Implementation for GetStats */
+    static int getStats(sd_bus_message* msg, void* context,
+                        sd_bus_error* error)
+    {
+        auto self = static_cast<SensorPolling*>(context);
+        try
+        {
+            auto reply = sdbusplus::message_t(msg).new_method_return();
+            reply.append(toEntries(self->sensorManager));
+            reply.method_return();
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error(
+                "Failed to reply with the sensor polling statistics, {ERROR}",
+                "ERROR", e);
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    /** @brief Implementation for Reset */
+    static int reset(sd_bus_message* msg, void* context, sd_bus_error* error)
+    {
+        auto self = static_cast<SensorPolling*>(context);
+        try
+        {
+            self->sensorManager.resetPollingStats();
+            sdbusplus::message_t(msg).new_method_return().method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    /** @brief Implementation for SetDeadband */
+    static int setDeadband(sd_bus_message* msg, void* context,
+                           sd_bus_error* error)
+    {
+        auto self = static_cast<SensorPolling*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t(msg);
+            uint8_t tid = 0;
+            uint16_t sensorId = 0;
+            double deadband = 0;
+            m.read(tid, sensorId, deadband);
+            if (!self->sensorManager.setDeadband(tid, sensorId, deadband))
+            {
+                return sd_bus_error_set(
+                    error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                    "No such numeric sensor");
+            }
+            m.new_method_return().method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStats", "", "a(yqstdtttt)", getStats),
+        sdbusplus::vtable::method("Reset", "", "", reset),
+        sdbusplus::vtable::method("SetDeadband", "yqd", "", setDeadband),
+        sdbusplus::vtable::end()};
+
+    platform_mc::SensorManager& sensorManager;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "platform-mc/sensor_manager.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <exception>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface of the snapshot of the platform-mc sensors */
+constexpr auto sensorSnapshotInterface = "pldm.SensorSnapshot";
+
+/** @class SensorSnapshot
+ *  @brief Reads the platform-mc sensors of a terminus in one D-Bus call.
+ *  @details Like pldm.SensorPolling, the interface has no YAML definition.
+ *  GetReadings takes a terminus ID and sensor IDs, all the sensors of the
+ *  terminus when there is none, and returns for each sensor its ID, value,
+ *  Available and Functional properties and the time of its last update in usec
+ *  of CLOCK_MONOTONIC, 0 when it was never updated. The unknown sensor IDs are
+ *  skipped.
+ */
+class SensorSnapshot
+{
+  public:
+    SensorSnapshot() = delete;
+    SensorSnapshot(const SensorSnapshot&) = delete;
+    SensorSnapshot& operator=(const SensorSnapshot&) = delete;
+    SensorSnapshot(SensorSnapshot&&) = delete;
+    SensorSnapshot& operator=(SensorSnapshot&&) = delete;
+    ~SensorSnapshot() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] sensorManager - The sensor manager of platform-mc
+     */
+    SensorSnapshot(sdbusplus::bus_t& bus, const std::string& path,
+                   platform_mc::SensorManager& sensorManager) :
+        sensorManager(sensorManager),
+        interface(bus, path.c_str(), sensorSnapshotInterface, vtable, this)
+    {}
+
+  private:
+    /** @brief A sensor in the reply of GetReadings */
+    using Reading = std::tuple<uint16_t, double, bool, bool, uint64_t>;
+
+    /** @brief Implementation for GetReadings */
+    static int getReadings(sd_bus_message* msg, void* context,
+                           sd_bus_error* error)
+    {
+        auto self = static_cast<SensorSnapshot*>(context);
+        try
+        {
+            auto m = sdbusplus::message_t(msg);
+            uint8_t tid = 0;
+            std::vector<uint16_t> sensorIds;
+            m.read(tid, sensorIds);
+
+            auto samples =
+                self->sensorManager.getSnapshot().getReadings(tid, sensorIds);
+            if (!samples)
+            {
+                return sd_bus_error_set(
+                    error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                    "No such polled terminus");
+            }
+
+            std::vector<Reading> readings;
+            readings.reserve(samples->size());
+            for (const auto& sample : *samples)
+            {
+                readings.emplace_back(sample.sensorId, sample.value,
+                                      sample.available, sample.functional,
+                                      sample.timestamp);
+            }
+            auto reply = m.new_method_return();
+            reply.append(readings);
+            reply.method_return();
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to reply with the sensor readings, {ERROR}",
+                       "ERROR", e);
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InternalFailure",
+                e.what());
+        }
+        return 1;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetReadings", "yaq", "a(qdbbt)",
+                                  getReadings),
+        sdbusplus::vtable::end()};
+
+    platform_mc::SensorManager& sensorManager;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
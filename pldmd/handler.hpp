@@ -2,6 +2,9 @@
 
 #include <libpldm/base.h>
 
+#include <sdbusplus/async.hpp>
+
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <map>
@@ -16,10 +19,100 @@ namespace responder
 {
 
 using Response = std::vector<uint8_t>;
+
+/** @class ResponsePool
+ *
+ *  A free list of response message buffers. A released buffer keeps its
+ *  capacity, so once the pool is warm the command handlers fill in responses
+ *  without allocating memory. Each thread has its own pool, the command
+ *  handlers run on the worker threads allocate their responses from the pool
+ *  of the worker, and the buffers are released to the pool of the event
+ *  loop once the response is sent.
+ */
+class ResponsePool
+{
+  public:
+    /** @brief Maximum number of free buffers kept in the pool */
+    static constexpr size_t maxFreeBuffers = 16;
+
+    /** @brief Larger buffers, e.g. of BIOS table transfers, are not kept */
+    static constexpr size_t maxBufferCapacity = 4096;
+
+    /** @brief Capacity of a new buffer, enough for most responses */
+    static constexpr size_t minBufferCapacity = 64;
+
+    ResponsePool(const ResponsePool&) = delete;
+    ResponsePool(ResponsePool&&) = delete;
+    ResponsePool& operator=(const ResponsePool&) = delete;
+    ResponsePool& operator=(ResponsePool&&) = delete;
+    ~ResponsePool() = default;
+
+    static ResponsePool& getInstance()
+    {
+        static thread_local ResponsePool responsePool;
+        return responsePool;
+    }
+
+    /** @brief Get a zero filled buffer, reusing a free one if available
+     *
+     *  @param[in] size - size of the buffer
+     *  @return the buffer
+     */
+    Response acquire(size_t size)
+    {
+        Response response;
+        if (freeBuffers.empty())
+        {
+            response.reserve(std::max(size, minBufferCapacity));
+        }
+        else
+        {
+            response = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+        response.assign(size, 0);
+        return response;
+    }
+
+    /** @brief Return a buffer to the pool once the response is sent
+     *
+     *  @param[in] response - the buffer
+     */
+    void release(Response&& response)
+    {
+        if (freeBuffers.size() < maxFreeBuffers && response.capacity() &&
+            response.capacity() <= maxBufferCapacity)
+        {
+            response.clear();
+            freeBuffers.push_back(std::move(response));
+        }
+    }
+
+    /** @brief Get the number of free buffers in the pool */
+    size_t size() const
+    {
+        return freeBuffers.size();
+    }
+
+  private:
+    ResponsePool()
+    {
+        freeBuffers.reserve(maxFreeBuffers);
+    }
+
+    std::vector<Response> freeBuffers;
+};
+
 class CmdHandler;
 using HandlerFunc = std::function<Response(
     pldm_tid_t tid, const pldm_msg* request, size_t reqMsgLen)>;
 
+/** @brief Handler of a command which completes asynchronously, the request
+ *         message stays valid until the returned task completes
+ */
+using AsyncHandlerFunc = std::function<exec::task<Response>(
+    pldm_tid_t tid, const pldm_msg* request, size_t reqMsgLen)>;
+
 class CmdHandler
 {
   public:
@@ -39,6 +132,29 @@ class CmdHandler
         return handlers.at(pldmCommand)(tid, request, reqMsgLen);
     }
 
+    /** @brief Look up the handler of a PLDM command
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return the command handler, nullptr if the command is not supported
+     */
+    const HandlerFunc* getHandler(Command pldmCommand) const
+    {
+        auto it = handlers.find(pldmCommand);
+        return it != handlers.end() ? &it->second : nullptr;
+    }
+
+    /** @brief Look up the asynchronous handler of a PLDM command
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return the command handler, nullptr if the command is not handled
+     *          asynchronously
+     */
+    const AsyncHandlerFunc* getAsyncHandler(Command pldmCommand) const
+    {
+        auto it = asyncHandlers.find(pldmCommand);
+        return it != asyncHandlers.end() ? &it->second : nullptr;
+    }
+
     /** @brief Create a response message containing only cc
      *
      *  @param[in] request - PLDM request message
@@ -47,7 +163,7 @@ class CmdHandler
      */
     static Response ccOnlyResponse(const pldm_msg* request, uint8_t cc)
     {
-        Response response(sizeof(pldm_msg), 0);
+        auto response = ResponsePool::getInstance().acquire(sizeof(pldm_msg));
         auto ptr = reinterpret_cast<pldm_msg*>(response.data());
         auto rc =
             encode_cc_only_resp(request->hdr.instance_id, request->hdr.type,
@@ -56,11 +172,29 @@ class CmdHandler
         return response;
     }
 
+    /** @brief Create a zero filled response message from the response pool
+     *
+     *  @param[in] payloadLength - length of the response payload
+     *  @return PLDM response message
+     */
+    static Response newResponse(size_t payloadLength)
+    {
+        return ResponsePool::getInstance().acquire(sizeof(pldm_msg_hdr) +
+                                                   payloadLength);
+    }
+
   protected:
     /** @brief map of PLDM command code to handler - to be populated by derived
      *         classes.
      */
     std::map<Command, HandlerFunc> handlers;
+
+    /** @brief map of PLDM command code to asynchronous handler - optionally
+     *         populated by derived classes for the commands which wait on
+     *         D-Bus or other PLDM termini. An asynchronous handler takes
+     *         precedence over a handler of the same command.
+     */
+    std::map<Command, AsyncHandlerFunc> asyncHandlers;
 };
 
 } // namespace responder
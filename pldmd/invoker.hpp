@@ -1,11 +1,23 @@
 #pragma once
 
+#include "common/loop_watchdog.hpp"
 #include "handler.hpp"
 
 #include <libpldm/base.h>
 
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/async.hpp>
+
+#include <array>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 namespace pldm
 {
@@ -15,37 +27,323 @@ using Type = uint8_t;
 namespace responder
 {
 
+/** @brief Callback sending the response of an asynchronous handler */
+using ResponseCallback =
+    std::function<void(pldm_tid_t tid, Response&& response)>;
+
+/** @struct HandlerStats
+ *
+ *  Usage of the handler of a command. The time spent in the synchronous
+ *  handlers is time the event loop is blocked for.
+ */
+struct HandlerStats
+{
+    bool async = false; //!< the command is handled asynchronously
+    uint64_t calls = 0; //!< number of requests handled
+    std::chrono::nanoseconds totalTime{0}; //!< time spent in the handler
+    std::chrono::nanoseconds maxTime{0};   //!< longest single call
+};
+
 class Invoker
 {
   public:
+    /** @brief A synchronous handler blocking the event loop for longer than
+     *         this is logged
+     */
+    static constexpr std::chrono::milliseconds blockingThreshold{10};
+
     /** @brief Register a handler for a PLDM Type
+     *
+     *  The commands of the handler are looked up once here and entered into
+     *  the dispatch table, so the handler must have registered all of its
+     *  commands by the time it is handed to the invoker.
      *
      *  @param[in] pldmType - PLDM type code
      *  @param[in] handler - PLDM Type handler
      */
     void registerHandler(Type pldmType, std::unique_ptr<CmdHandler> handler)
     {
-        handlers.emplace(pldmType, std::move(handler));
+        auto [it, inserted] = handlers.emplace(pldmType, std::move(handler));
+        if (!inserted)
+        {
+            return;
+        }
+
+        auto commands = std::make_unique<CommandTable>();
+        for (size_t command = 0; command < commands->size(); ++command)
+        {
+            auto& entry = (*commands)[command];
+            entry.asyncHandler = it->second->getAsyncHandler(command);
+            entry.handler = entry.asyncHandler
+                                ? nullptr
+                                : it->second->getHandler(command);
+            entry.stats.async = entry.asyncHandler != nullptr;
+        }
+        dispatchTable[pldmType] = std::move(commands);
     }
 
-    /** @brief Invoke a PLDM command handler
+    /** @brief Invoke a synchronous PLDM command handler
      *
      *  @param[in] tid - PLDM request TID
      *  @param[in] pldmType - PLDM type code
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
-     *  @return PLDM response message
+     *  @return PLDM response message, a PLDM_ERROR_UNSUPPORTED_PLDM_CMD
+     *          response if the type or command has no synchronous handler or
+     *          the handler throws std::out_of_range, a PLDM_ERROR response if
+     *          it throws another exception
      */
     Response handle(pldm_tid_t tid, Type pldmType, Command pldmCommand,
                     const pldm_msg* request, size_t reqMsgLen)
     {
-        return handlers.at(pldmType)->handle(tid, pldmCommand, request,
-                                             reqMsgLen);
+        auto entry = findEntry(pldmType, pldmCommand);
+        if (!entry || !entry->handler) [[unlikely]]
+        {
+            return CmdHandler::ccOnlyResponse(request,
+                                              PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+        }
+
+        watchdog::LoopWatchdog::Scope scope(
+            {watchdog::SourceKind::Command, tid, pldmType, pldmCommand});
+        auto start = std::chrono::steady_clock::now();
+        Response response;
+        try
+        {
+            response = (*entry->handler)(tid, request, reqMsgLen);
+        }
+        catch (const std::exception& e)
+        {
+            response = failedResponse(request, e);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        auto& stats = entry->stats;
+        stats.calls++;
+        stats.totalTime += elapsed;
+        if (elapsed > stats.maxTime)
+        {
+            stats.maxTime = elapsed;
+            if (elapsed > blockingThreshold)
+            {
+                lg2::warning(
+                    "Synchronous handler of PLDM type {TYPE} command {COMMAND} blocked the event loop for {DURATION_US} us",
+                    "TYPE", pldmType, "COMMAND", pldmCommand, "DURATION_US",
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        elapsed)
+                        .count());
+            }
+        }
+        return response;
+    }
+
+    /** @brief Dispatch a PLDM request to its command handler
+     *
+     *  A synchronous handler is invoked right away. An asynchronous handler
+     *  is started on the invoker's scope with a copy of the request, the
+     *  event loop keeps serving other messages while it is pending and the
+     *  response is passed to the callback once it completes.
+     *
+     *  @param[in] tid - PLDM request TID
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] requestMsg - PLDM request message, including the header
+     *  @param[in] respond - callback sending the response of an asynchronous
+     *                       handler
+     *  @return the PLDM response message, std::nullopt if the response is
+     *          passed to the callback
+     */
+    std::optional<Response> dispatch(pldm_tid_t tid, Type pldmType,
+                                     Command pldmCommand,
+                                     std::span<const uint8_t> requestMsg,
+                                     const ResponseCallback& respond)
+    {
+        auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+        auto reqMsgLen = requestMsg.size() - sizeof(pldm_msg_hdr);
+
+        auto entry = findEntry(pldmType, pldmCommand);
+        if (!entry || !entry->asyncHandler)
+        {
+            return handle(tid, pldmType, pldmCommand, request, reqMsgLen);
+        }
+
+        entry->stats.calls++;
+        pendingHandlers++;
+        scope.spawn(
+            handleAsync(tid, *entry->asyncHandler,
+                        std::vector<uint8_t>(requestMsg.begin(),
+                                             requestMsg.end()),
+                        respond),
+            exec::default_task_context<void>(exec::inline_scheduler{}));
+        return std::nullopt;
+    }
+
+    /** @brief Get the number of asynchronous handlers not completed yet
+     *
+     *  The invoker must not be destroyed before they have completed, since
+     *  they run on its scope.
+     */
+    size_t getPendingHandlers() const
+    {
+        return pendingHandlers;
+    }
+
+    /** @brief Get the usage of the handler of a PLDM command
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return the handler usage, std::nullopt if the command is not supported
+     */
+    std::optional<HandlerStats> getHandlerStats(Type pldmType,
+                                                Command pldmCommand) const
+    {
+        const auto& commands = dispatchTable[pldmType];
+        if (!commands)
+        {
+            return std::nullopt;
+        }
+        const auto& entry = (*commands)[pldmCommand];
+        if (!entry.handler && !entry.asyncHandler)
+        {
+            return std::nullopt;
+        }
+        return entry.stats;
+    }
+
+    /** @brief Call a function with the usage of the handler of each supported
+     *         command, ordered by PLDM type and command code
+     *
+     *  @param[in] func - called with the PLDM type, the command code and the
+     *                    handler usage
+     */
+    void forEachHandlerStats(
+        const std::function<void(Type, Command, const HandlerStats&)>& func)
+        const
+    {
+        for (size_t type = 0; type < dispatchTable.size(); ++type)
+        {
+            if (!dispatchTable[type])
+            {
+                continue;
+            }
+            const auto& commands = *dispatchTable[type];
+            for (size_t command = 0; command < commands.size(); ++command)
+            {
+                const auto& entry = commands[command];
+                if (entry.handler || entry.asyncHandler)
+                {
+                    func(type, command, entry.stats);
+                }
+            }
+        }
+    }
+
+    /** @brief Clear the usage of the command handlers */
+    void resetHandlerStats()
+    {
+        for (auto& commands : dispatchTable)
+        {
+            if (!commands)
+            {
+                continue;
+            }
+            for (auto& entry : *commands)
+            {
+                entry.stats = HandlerStats{entry.stats.async};
+            }
+        }
+    }
+
+    /** @brief Log the failure of a command handler and build its response
+     *
+     *  @param[in] request - PLDM request message
+     *  @param[in] e - the exception thrown by the handler
+     *  @return a PLDM_ERROR_UNSUPPORTED_PLDM_CMD response for
+     *          std::out_of_range, e.g. a command unknown to the handler, a
+     *          PLDM_ERROR response otherwise
+     */
+    static Response failedResponse(const pldm_msg* request,
+                                   const std::exception& e)
+    {
+        lg2::error(
+            "Handler of PLDM type {TYPE} command {COMMAND} failed, error - {ERROR}",
+            "TYPE", static_cast<uint8_t>(request->hdr.type), "COMMAND",
+            request->hdr.command, "ERROR", e);
+        auto cc = dynamic_cast<const std::out_of_range*>(&e)
+                      ? PLDM_ERROR_UNSUPPORTED_PLDM_CMD
+                      : PLDM_ERROR;
+        return CmdHandler::ccOnlyResponse(request, cc);
     }
 
   private:
+    /** @struct CommandEntry
+     *
+     *  Dispatch table entry of a command, at most one of the handlers is set
+     */
+    struct CommandEntry
+    {
+        const HandlerFunc* handler = nullptr;
+        const AsyncHandlerFunc* asyncHandler = nullptr;
+        HandlerStats stats;
+    };
+
+    /** @brief Handlers of the commands of one PLDM type, indexed by command
+     *         code
+     */
+    using CommandTable = std::array<CommandEntry, 256>;
+
+    /** @brief Look up the dispatch table entry of a command
+     *
+     *  @return the entry, nullptr if the PLDM type is not supported
+     */
+    CommandEntry* findEntry(Type pldmType, Command pldmCommand)
+    {
+        const auto& commands = dispatchTable[pldmType];
+        return commands ? &(*commands)[pldmCommand] : nullptr;
+    }
+
+    /** @brief Run an asynchronous handler and send its response
+     *
+     *  @param[in] tid - PLDM request TID
+     *  @param[in] handler - the command handler
+     *  @param[in] requestMsg - PLDM request message, owned by the coroutine
+     *  @param[in] respond - callback sending the response
+     */
+    exec::task<void> handleAsync(pldm_tid_t tid,
+                                 const AsyncHandlerFunc& handler,
+                                 std::vector<uint8_t> requestMsg,
+                                 ResponseCallback respond)
+    {
+        auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+        Response response;
+        try
+        {
+            response = co_await handler(
+                tid, request, requestMsg.size() - sizeof(pldm_msg_hdr));
+        }
+        catch (const std::exception& e)
+        {
+            response = failedResponse(request, e);
+        }
+        respond(tid, std::move(response));
+        pendingHandlers--;
+    }
+
+    /** @brief The registered PLDM type handlers, owning the command handlers
+     *         referenced by the dispatch table
+     */
     std::map<Type, std::unique_ptr<CmdHandler>> handlers;
+
+    /** @brief Command tables indexed by PLDM type code, nullptr for the
+     *         unsupported types
+     */
+    std::array<std::unique_ptr<CommandTable>, 256> dispatchTable{};
+
+    /** @brief Number of asynchronous handlers not completed yet */
+    size_t pendingHandlers = 0;
+
+    /** @brief Scope of the pending asynchronous handlers */
+    exec::async_scope scope;
 };
 
 } // namespace responder
@@ -54,6 +54,7 @@ class OemIBM
      * @param[in] fruHandler - fruHandler handler
      * @param[in] baseHandler - baseHandler handler
      * @param[in] reqHandler - reqHandler handler
+     * @param[in] workerPool - pool running the blocking file I/O handlers
      */
     explicit OemIBM(
         const pldm::utils::DBusHandler* dBusIntf, int mctp_fd, uint8_t mctp_eid,
@@ -63,10 +64,11 @@ class OemIBM
         responder::platform::Handler* platformHandler,
         responder::fru::Handler* fruHandler,
         responder::base::Handler* baseHandler,
-        pldm::requester::Handler<pldm::requester::Request>* reqHandler) :
+        pldm::requester::Handler<pldm::requester::Request>* reqHandler,
+        pldm::WorkerPool* workerPool = nullptr) :
         dBusIntf(dBusIntf), mctp_fd(mctp_fd), mctp_eid(mctp_eid), repo(repo),
         instanceIdDb(instanceIdDb), event(event), invoker(invoker),
-        reqHandler(reqHandler)
+        reqHandler(reqHandler), workerPool(workerPool)
     {
         createOemFruHandler();
         fruHandler->setOemFruHandler(oemFruHandler.get());
@@ -162,7 +164,7 @@ class OemIBM
         invoker.registerHandler(
             PLDM_OEM, std::make_unique<pldm::responder::oem_ibm::Handler>(
                           oemPlatformHandler.get(), mctp_fd, mctp_eid,
-                          &instanceIdDb, reqHandler));
+                          &instanceIdDb, reqHandler, workerPool));
     }
 
   private:
@@ -194,6 +196,9 @@ class OemIBM
     /** @brief pointer to the requester class*/
     requester::Handler<requester::Request>* reqHandler;
 
+    /** @brief pointer to the pool running the blocking file I/O handlers */
+    pldm::WorkerPool* workerPool;
+
     /** @brief pointer to the oem_ibm_handler class*/
     std::unique_ptr<responder::oem_platform::Handler> oemPlatformHandler{};
 
@@ -1,15 +1,24 @@
 
 #include "common/flight_recorder.hpp"
 #include "common/instance_id.hpp"
+#include "common/loop_watchdog.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
+#include "common/worker_pool.hpp"
+#include "dbus_impl_loop_watchdog.hpp"
+#include "dbus_impl_metrics.hpp"
+#include "dbus_impl_request_window.hpp"
 #include "dbus_impl_requester.hpp"
+#include "dbus_impl_sensor_history.hpp"
+#include "dbus_impl_sensor_polling.hpp"
+#include "dbus_impl_sensor_snapshot.hpp"
 #include "fw-update/manager.hpp"
 #include "invoker.hpp"
 #include "platform-mc/manager.hpp"
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
+#include "rx_drain.hpp"
 
 #include <err.h>
 #include <getopt.h>
@@ -25,11 +34,13 @@
 #include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -38,6 +49,7 @@
 #include <iterator>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -101,9 +113,10 @@ void requestPLDMServiceName()
 }
 
 static std::optional<Response>
-    processRxMsg(const std::vector<uint8_t>& requestMsg, Invoker& invoker,
+    processRxMsg(std::span<const uint8_t> requestMsg, Invoker& invoker,
                  requester::Handler<requester::Request>& handler,
-                 fw_update::Manager* fwManager, pldm_tid_t tid)
+                 fw_update::Manager* fwManager, pldm_tid_t tid,
+                 const ResponseCallback& respond)
 {
     uint8_t eid = tid;
 
@@ -117,43 +130,25 @@ static std::optional<Response>
 
     if (PLDM_RESPONSE != hdrFields.msg_type)
     {
-        Response response;
+        if (hdrFields.pldm_type != PLDM_FWUP)
+        {
+            return invoker.dispatch(tid, hdrFields.pldm_type,
+                                    hdrFields.command, requestMsg, respond);
+        }
+
+        watchdog::LoopWatchdog::Scope scope(
+            {watchdog::SourceKind::Command, eid, PLDM_FWUP, hdrFields.command});
         auto request = reinterpret_cast<const pldm_msg*>(hdr);
         size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
         try
         {
-            if (hdrFields.pldm_type != PLDM_FWUP)
-            {
-                response =
-                    invoker.handle(tid, hdrFields.pldm_type, hdrFields.command,
-                                   request, requestLen);
-            }
-            else
-            {
-                response = fwManager->handleRequest(eid, hdrFields.command,
-                                                    request, requestLen);
-            }
+            return fwManager->handleRequest(eid, hdrFields.command, request,
+                                            requestLen);
         }
-        catch (const std::out_of_range& e)
+        catch (const std::exception& e)
         {
-            uint8_t completion_code = PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
-            response.resize(sizeof(pldm_msg_hdr));
-            auto responseHdr = reinterpret_cast<pldm_msg_hdr*>(response.data());
-            pldm_header_info header{};
-            header.msg_type = PLDM_RESPONSE;
-            header.instance = hdrFields.instance;
-            header.pldm_type = hdrFields.pldm_type;
-            header.command = hdrFields.command;
-            if (PLDM_SUCCESS != pack_pldm_header(&header, responseHdr))
-            {
-                error(
-                    "Failed to add response header for processing Rx, error - {ERROR}",
-                    "ERROR", e);
-                return std::nullopt;
-            }
-            response.insert(response.end(), completion_code);
+            return Invoker::failedResponse(request, e);
         }
-        return response;
     }
     else if (PLDM_RESPONSE == hdrFields.msg_type)
     {
@@ -192,10 +187,7 @@ int main(int argc, char** argv)
     }
     // Setup PLDM requester transport
     auto hostEID = pldm::utils::readHostEID();
-    /* To maintain current behaviour until we have the infrastructure to find
-     * and use the correct TIDs */
-    pldm_tid_t TID = hostEID;
-    PldmTransport pldmTransport{};
+    PldmTransport pldmTransport{LoopbackEndpoint::Daemon};
     auto event = Event::get_default();
     auto& bus = pldm::utils::DBusHandler::getBus();
     sdbusplus::server::manager_t objManager(bus,
@@ -204,14 +196,37 @@ int main(int argc, char** argv)
         bus, "/xyz/openbmc_project/sensors");
 
     InstanceIdDb instanceIdDb;
+    // Hand instance IDs out from in-process leases, the idle leases are
+    // returned to the database shared with the other PLDM processes
+    instanceIdDb.enableLeases();
+    sdbusplus::Timer leaseTimer(event.get(), [&instanceIdDb] {
+        instanceIdDb.releaseExpiredLeases();
+    });
+    leaseTimer.start(InstanceIdDb::defaultLeaseIdleTimeout, true);
     dbus_api::Requester dbusImplReq(bus, "/xyz/openbmc_project/pldm",
                                     instanceIdDb);
     sdbusplus::server::manager_t inventoryManager(
         bus, "/xyz/openbmc_project/inventory");
 
     Invoker invoker{};
+    // Declared after the invoker, so the pool is destroyed before the command
+    // handlers it runs go away. It is stopped explicitly before the pending
+    // asynchronous handlers of the invoker are joined at exit.
+    WorkerPool workerPool(event);
     requester::Handler<requester::Request> reqHandler(&pldmTransport, event,
                                                       instanceIdDb, verbose);
+    dbus_api::Metrics dbusImplMetrics(bus, "/xyz/openbmc_project/pldm",
+                                      reqHandler.getMetrics(), invoker,
+                                      workerPool);
+    dbus_api::RequestWindow dbusImplRequestWindow(
+        bus, "/xyz/openbmc_project/pldm", reqHandler);
+    // The event loop watchdog is off unless it is given a threshold, either
+    // at build time or over D-Bus
+    auto& loopWatchdog = watchdog::LoopWatchdog::getInstance();
+    loopWatchdog.setThreshold(
+        std::chrono::milliseconds(LOOP_WATCHDOG_THRESHOLD));
+    dbus_api::LoopWatchdog dbusImplLoopWatchdog(
+        bus, "/xyz/openbmc_project/pldm", event, loopWatchdog);
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
         pldm_pdr_init(), pldm_pdr_destroy);
@@ -276,7 +291,14 @@ int main(int argc, char** argv)
     // Platform handler.
 
     std::unique_ptr<platform_mc::Manager> platformManager =
-        std::make_unique<platform_mc::Manager>(event, reqHandler, instanceIdDb);
+        std::make_unique<platform_mc::Manager>(event, reqHandler, instanceIdDb,
+                                               &workerPool);
+    dbus_api::SensorPolling dbusImplSensorPolling(
+        bus, "/xyz/openbmc_project/pldm", platformManager->getSensorManager());
+    dbus_api::SensorSnapshot dbusImplSensorSnapshot(
+        bus, "/xyz/openbmc_project/pldm", platformManager->getSensorManager());
+    dbus_api::SensorHistory dbusImplSensorHistory(
+        bus, "/xyz/openbmc_project/pldm", platformManager->getSensorManager());
 
     pldm::responder::platform::EventMap addOnEventHandlers{
         {PLDM_CPER_EVENT,
@@ -299,6 +321,20 @@ int main(int argc, char** argv)
                              size_t eventDataOffset) {
              return platformManager->handleSensorEvent(
                  request, payloadLength, formatVersion, tid, eventDataOffset);
+         }}},
+        {PLDM_PDR_REPOSITORY_CHG_EVENT,
+         {[&platformManager](const pldm_msg* request, size_t payloadLength,
+                             uint8_t formatVersion, uint8_t tid,
+                             size_t eventDataOffset) {
+             return platformManager->handlePdrRepositoryChgEvent(
+                 request, payloadLength, formatVersion, tid, eventDataOffset);
+         }}},
+        {PLDM_HEARTBEAT_TIMER_ELAPSED_EVENT,
+         {[&platformManager](const pldm_msg* request, size_t payloadLength,
+                             uint8_t formatVersion, uint8_t tid,
+                             size_t eventDataOffset) {
+             return platformManager->handleHeartbeatEvent(
+                 request, payloadLength, formatVersion, tid, eventDataOffset);
          }}}};
 
     auto platformHandler = std::make_unique<platform::Handler>(
@@ -326,7 +362,7 @@ int main(int argc, char** argv)
         &dbusHandler, pldmTransport.getEventSource(), hostEID, pdrRepo.get(),
         instanceIdDb, event, invoker, hostPDRHandler.get(),
         platformHandler.get(), fruHandler.get(), baseHandler.get(),
-        &reqHandler);
+        &reqHandler, &workerPool);
 #endif
 
     invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
@@ -346,8 +382,47 @@ int main(int argc, char** argv)
         std::make_unique<MctpDiscovery>(
             bus, std::initializer_list<MctpDiscoveryHandlerIntf*>{
                      fwManager.get(), platformManager.get()});
-    auto callback = [verbose, &invoker, &reqHandler, &fwManager, &pldmTransport,
-                     TID](IO& io, int fd, uint32_t revents) mutable {
+    ResponseCallback sendResponse = [verbose, &pldmTransport](
+                                        pldm_tid_t tid, Response&& response) {
+        FlightRecorder::GetInstance().saveRecord(response, true, tid);
+        if (verbose)
+        {
+            printBuffer(Tx, response);
+        }
+
+        auto returnCode =
+            pldmTransport.sendMsg(tid, response.data(), response.size());
+        if (returnCode != PLDM_REQUESTER_SUCCESS)
+        {
+            warning(
+                "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
+                "TID", tid, "RETURN_CODE", returnCode);
+        }
+        ResponsePool::getInstance().release(std::move(response));
+    };
+
+    auto rxHandler = [verbose, &invoker, &reqHandler, &fwManager,
+                      &sendResponse](pldm_tid_t tid,
+                                     std::span<const uint8_t> requestMsg) {
+        FlightRecorder::GetInstance().saveRecord(requestMsg, false, tid);
+        if (verbose)
+        {
+            printBuffer(Rx, requestMsg);
+        }
+        // process message and send response, the response of an asynchronous
+        // handler is sent once the handler completes
+        auto response = processRxMsg(requestMsg, invoker, reqHandler,
+                                     fwManager.get(), tid, sendResponse);
+        if (response.has_value())
+        {
+            sendResponse(tid, std::move(*response));
+        }
+    };
+
+    auto callback = [&pldmTransport, rxHandler](IO& io, int fd,
+                                                uint32_t revents) {
+        watchdog::LoopWatchdog::Scope scope(
+            {.kind = watchdog::SourceKind::IO, .name = "PLDMReceive"});
         if (!(revents & EPOLLIN))
         {
             return;
@@ -357,44 +432,13 @@ int main(int argc, char** argv)
             return;
         }
 
-        int returnCode = 0;
-        void* requestMsg;
-        size_t recvDataLength;
-        returnCode = pldmTransport.recvMsg(TID, requestMsg, recvDataLength);
+        // Receive all the pending messages, the budget keeps the event loop
+        // fair to the other sources, the IO source stays ready if any remain
+        auto returnCode =
+            drainRxMsgs(pldmTransport, maxRxMsgsPerWakeup, rxHandler);
 
-        if (returnCode == PLDM_REQUESTER_SUCCESS)
-        {
-            std::vector<uint8_t> requestMsgVec(
-                static_cast<uint8_t*>(requestMsg),
-                static_cast<uint8_t*>(requestMsg) + recvDataLength);
-            FlightRecorder::GetInstance().saveRecord(requestMsgVec, false);
-            if (verbose)
-            {
-                printBuffer(Rx, requestMsgVec);
-            }
-            // process message and send response
-            auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
-                                         fwManager.get(), TID);
-            if (response.has_value())
-            {
-                FlightRecorder::GetInstance().saveRecord(*response, true);
-                if (verbose)
-                {
-                    printBuffer(Tx, *response);
-                }
-
-                returnCode = pldmTransport.sendMsg(TID, (*response).data(),
-                                                   (*response).size());
-                if (returnCode != PLDM_REQUESTER_SUCCESS)
-                {
-                    warning(
-                        "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
-                        "TID", TID, "RETURN_CODE", returnCode);
-                }
-            }
-        }
         // TODO check that we get here if mctp-demux dies?
-        else if (returnCode == PLDM_REQUESTER_RECV_FAIL)
+        if (returnCode == PLDM_REQUESTER_RECV_FAIL)
         {
             // MCTP daemon has closed the socket this daemon is connected to.
             // This may or may not be an error scenario, in either case the
@@ -406,14 +450,13 @@ int main(int argc, char** argv)
                 "RC", returnCode);
             io.get_event().exit(0);
         }
-        else
+        else if (returnCode != PLDM_REQUESTER_SUCCESS &&
+                 returnCode != PLDM_REQUESTER_TRANSPORT_BUSY)
         {
             warning(
                 "Failed to receive PLDM request for pldmTransport, response code '{RETURN_CODE}'",
                 "RETURN_CODE", returnCode);
         }
-        /* Free requestMsg after using */
-        free(requestMsg);
     };
 
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
@@ -439,6 +482,20 @@ int main(int argc, char** argv)
     sdeventplus::source::Signal sigUsr1(
         event, SIGUSR1, std::bind_front(&interruptFlightRecorderCallBack));
     int returnCode = event.loop();
+
+    // Join the asynchronous handlers still pending before exiting. Stopping
+    // the pool runs its queued jobs and resumes the handlers awaiting them,
+    // the handlers awaiting D-Bus replies are resumed by processing the bus
+    // directly, the event loop has finished.
+    workerPool.stop();
+    while (invoker.getPendingHandlers())
+    {
+        if (!bus.process_discard())
+        {
+            bus.wait();
+        }
+    }
+
     if (returnCode)
     {
         exit(EXIT_FAILURE);
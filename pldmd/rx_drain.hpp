@@ -0,0 +1,64 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <span>
+
+namespace pldm
+{
+
+/** @brief Maximum number of messages received per wakeup of the event loop, so
+ *         that a storm of messages does not starve the other event sources
+ */
+constexpr size_t maxRxMsgsPerWakeup = 32;
+
+/** @brief Receive and dispatch the messages pending on a transport
+ *
+ *  The first message is received unconditionally, as the caller was woken up
+ *  for it, the following ones only while the transport has more messages
+ *  ready. The handler gets a non-owning view of the transport's receive buffer,
+ *  which is only valid for the duration of the call.
+ *
+ *  @tparam Transport - transport providing recvMsg() and hasPendingMsg()
+ *  @tparam RxHandler - callable taking the TID and message of type
+ *                      std::span<const uint8_t>
+ *
+ *  @param[in] transport - the transport to receive from
+ *  @param[in] budget - maximum number of messages to receive
+ *  @param[in] handler - invoked for every received message
+ *
+ *  @return PLDM_REQUESTER_SUCCESS, or the error code of the failed receive
+ */
+template <typename Transport, typename RxHandler>
+pldm_requester_rc_t drainRxMsgs(Transport& transport, size_t budget,
+                                RxHandler&& handler)
+{
+    for (size_t count = 0; count < budget; ++count)
+    {
+        if (count && !transport.hasPendingMsg())
+        {
+            break;
+        }
+
+        pldm_tid_t tid = 0;
+        void* rxMsg = nullptr;
+        size_t rxMsgLen = 0;
+        auto rc = transport.recvMsg(tid, rxMsg, rxMsgLen);
+        if (rc != PLDM_REQUESTER_SUCCESS)
+        {
+            return rc;
+        }
+
+        std::unique_ptr<void, decltype(&free)> rxBuffer(rxMsg, free);
+        handler(tid, std::span<const uint8_t>(static_cast<uint8_t*>(rxMsg),
+                                              rxMsgLen));
+    }
+
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+} // namespace pldm
@@ -0,0 +1,176 @@
+#include "pldm_flight_recorder_cmd.hpp"
+
+#include "common/flight_recorder_format.hpp"
+#include "pldm_cmd_helper.hpp"
+
+#include <libpldm/base.h>
+
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <tuple>
+
+namespace pldmtool
+{
+
+namespace flight_recorder
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+using namespace pldm::flightrecorder;
+
+constexpr auto defaultDumpPath = "/tmp/pldm_flight_recorder";
+
+const std::map<uint8_t, const char*> pldmTypeNames{
+    {PLDM_BASE, "base"},         {PLDM_SMBIOS, "smbios"},
+    {PLDM_PLATFORM, "platform"}, {PLDM_BIOS, "bios"},
+    {PLDM_FRU, "fru"},           {PLDM_FWUP, "fw_update"},
+    {PLDM_RDE, "rde"},           {PLDM_OEM, "oem"}};
+
+/** @brief Format a CLOCK_REALTIME time in ns as local time with microseconds
+ */
+std::string formatTime(int64_t realtimeNs)
+{
+    constexpr int64_t nsPerSec = 1000000000;
+    time_t seconds = realtimeNs / nsPerSec;
+    struct tm localTime
+    {};
+    localtime_r(&seconds, &localTime);
+
+    char buffer[32] = {};
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &localTime);
+    std::ostringstream time;
+    time << buffer << "." << std::setfill('0') << std::setw(6)
+         << (realtimeNs % nsPerSec) / 1000;
+    return time.str();
+}
+
+} // namespace
+
+class DecodeRecorder
+{
+  public:
+    explicit DecodeRecorder(CLI::App* app)
+    {
+        app->add_option("-f,--file", path,
+                        "flight recorder file or dump, default " +
+                            std::string(defaultDumpPath));
+        app->callback([this]() { exec(); });
+    }
+
+    void exec()
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << "\n";
+            return;
+        }
+        std::vector<uint8_t> contents((std::istreambuf_iterator<char>(file)),
+                                      std::istreambuf_iterator<char>());
+
+        auto recording = parseRecording(contents);
+        if (!recording)
+        {
+            std::cerr << path << " is not a PLDM flight recorder file\n";
+            return;
+        }
+
+        // Outstanding requests by TID, instance ID, type, command and
+        // direction, to annotate the responses with the latency of the
+        // exchange
+        std::map<std::tuple<uint8_t, uint8_t, uint8_t, uint8_t, bool>,
+                 uint64_t>
+            requests;
+
+        ordered_json output = ordered_json::array();
+        for (const auto& [header, data] : recording->records)
+        {
+            ordered_json record;
+            bool tx = header.flags & recordFlagTx;
+            auto captured = std::min<size_t>(header.length, data.size());
+            record["Sequence"] = header.sequence;
+            record["Time"] = formatTime(header.timestampNs +
+                                        recording->header.realtimeOffsetNs);
+            record["Direction"] = tx ? "Tx" : "Rx";
+            record["TID"] = header.tid;
+            record["Length"] = header.length;
+            if (captured < header.length)
+            {
+                record["Truncated"] = true;
+            }
+
+            pldm_header_info hdrFields{};
+            if (captured >= sizeof(pldm_msg_hdr) &&
+                unpack_pldm_header(
+                    reinterpret_cast<const pldm_msg_hdr*>(data.data()),
+                    &hdrFields) == PLDM_SUCCESS)
+            {
+                bool isResponse = hdrFields.msg_type == PLDM_RESPONSE;
+                auto type = pldmTypeNames.find(hdrFields.pldm_type);
+                record["InstanceID"] = hdrFields.instance;
+                record["MessageType"] = isResponse ? "Response" : "Request";
+                record["PLDMType"] = type != pldmTypeNames.end()
+                                         ? type->second
+                                         : std::to_string(hdrFields.pldm_type);
+                record["Command"] = hdrFields.command;
+
+                auto key = std::make_tuple(header.tid, hdrFields.instance,
+                                           hdrFields.pldm_type,
+                                           hdrFields.command, tx);
+                if (!isResponse)
+                {
+                    requests[key] = header.timestampNs;
+                }
+                else
+                {
+                    if (captured > sizeof(pldm_msg_hdr))
+                    {
+                        record["CompletionCode"] =
+                            data[sizeof(pldm_msg_hdr)];
+                    }
+                    std::get<bool>(key) = !tx;
+                    auto request = requests.find(key);
+                    if (request != requests.end())
+                    {
+                        record["Latency_us"] =
+                            (header.timestampNs - request->second) / 1000;
+                        requests.erase(request);
+                    }
+                }
+            }
+
+            std::ostringstream hex;
+            for (size_t i = 0; i < captured; ++i)
+            {
+                hex << (i ? " " : "") << std::setfill('0') << std::setw(2)
+                    << std::hex << static_cast<unsigned>(data[i]);
+            }
+            record["Data"] = hex.str();
+            output.emplace_back(std::move(record));
+        }
+        DisplayInJson(output);
+    }
+
+  private:
+    std::string path = defaultDumpPath;
+};
+
+namespace
+{
+std::unique_ptr<DecodeRecorder> decodeRecorder;
+}
+
+void registerCommand(CLI::App& app)
+{
+    auto flightRecorder = app.add_subcommand(
+        "flightrecorder", "decode a pldmd flight recorder file or dump");
+    decodeRecorder = std::make_unique<DecodeRecorder>(flightRecorder);
+}
+
+} // namespace flight_recorder
+} // namespace pldmtool
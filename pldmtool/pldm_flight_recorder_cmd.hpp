@@ -0,0 +1,14 @@
+#pragma once
+
+#include <CLI/CLI.hpp>
+
+namespace pldmtool
+{
+
+namespace flight_recorder
+{
+
+void registerCommand(CLI::App& app);
+}
+
+} // namespace pldmtool
@@ -0,0 +1,248 @@
+#include "pldm_metrics_cmd.hpp"
+
+#include "common/utils.hpp"
+#include "pldm_cmd_helper.hpp"
+#include "pldmd/dbus_impl_metrics.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace metrics
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+
+constexpr auto pldmService = "xyz.openbmc_project.PLDM";
+constexpr auto pldmObjPath = "/xyz/openbmc_project/pldm";
+
+/** @brief Convert a latency histogram of GetMetrics to JSON */
+ordered_json toJson(const pldm::dbus_api::LatencyEntry& latency,
+                    bool showBuckets)
+{
+    const auto& [count, sum, min, max, percentiles, buckets] = latency;
+    ordered_json output{{"Count", count}};
+    if (!count)
+    {
+        return output;
+    }
+    output["Min_us"] = min;
+    output["Mean_us"] = sum / count;
+    output["Max_us"] = max;
+    for (size_t idx = 0; idx < percentiles.size() &&
+                         idx < pldm::dbus_api::metricsPercentiles.size();
+         ++idx)
+    {
+        output[std::string(pldm::dbus_api::metricsPercentiles[idx].first) +
+               "_us"] = percentiles[idx];
+    }
+    if (showBuckets)
+    {
+        auto& array = output["Buckets"] = ordered_json::array();
+        for (const auto& [low, high, bucketCount] : buckets)
+        {
+            array.push_back({low, high, bucketCount});
+        }
+    }
+    return output;
+}
+
+} // namespace
+
+class GetMetrics
+{
+  public:
+    explicit GetMetrics(CLI::App* app)
+    {
+        app->add_option("-m,--mctp_eid", eid,
+                        "only show the requests to this MCTP endpoint");
+        app->add_flag("-r,--reset", reset,
+                      "clear the counters and latency histograms afterwards");
+        app->add_flag("-b,--buckets", showBuckets,
+                      "show the latency histogram buckets");
+        app->add_flag("--handlers", showHandlers,
+                      "show the usage of the command handlers instead");
+        app->add_flag("--workers", showWorkers,
+                      "show the load of the worker pool instead");
+        app->callback([this]() { exec(); });
+    }
+
+    void exec()
+    {
+        if (showHandlers)
+        {
+            execHandlers();
+            return;
+        }
+        if (showWorkers)
+        {
+            execWorkers();
+            return;
+        }
+
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        std::vector<pldm::dbus_api::MetricsEntry> metrics;
+        try
+        {
+            auto method =
+                bus.new_method_call(pldmService, pldmObjPath,
+                                    pldm::dbus_api::metricsInterface,
+                                    "GetMetrics");
+            auto reply = bus.call(method, dbusTimeout);
+            reply.read(metrics);
+
+            if (reset)
+            {
+                method = bus.new_method_call(pldmService, pldmObjPath,
+                                             pldm::dbus_api::metricsInterface,
+                                             "Reset");
+                bus.call_noreply(method, dbusTimeout);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get the requester metrics from pldmd, "
+                      << e.what() << "\n";
+            return;
+        }
+
+        ordered_json output = ordered_json::array();
+        for (const auto& [entryEid, type, command, requests, responses,
+                          errorResponses, retries, timeouts, sendFailures,
+                          cancelled, queueDepth, maxQueueDepth, latency] :
+             metrics)
+        {
+            if (eid && entryEid != *eid)
+            {
+                continue;
+            }
+            output.push_back({{"EID", entryEid},
+                              {"PLDMType", type},
+                              {"Command", command},
+                              {"Requests", requests},
+                              {"Responses", responses},
+                              {"ErrorResponses", errorResponses},
+                              {"Retries", retries},
+                              {"Timeouts", timeouts},
+                              {"SendFailures", sendFailures},
+                              {"Cancelled", cancelled},
+                              {"QueueDepth", queueDepth},
+                              {"MaxQueueDepth", maxQueueDepth},
+                              {"Latency", toJson(latency, showBuckets)}});
+        }
+        DisplayInJson(output);
+    }
+
+    /** @brief Show the usage of the command handlers of pldmd */
+    void execHandlers()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        std::vector<pldm::dbus_api::HandlerStatsEntry> handlerStats;
+        try
+        {
+            auto method =
+                bus.new_method_call(pldmService, pldmObjPath,
+                                    pldm::dbus_api::metricsInterface,
+                                    "GetHandlerStats");
+            auto reply = bus.call(method, dbusTimeout);
+            reply.read(handlerStats);
+
+            if (reset)
+            {
+                method = bus.new_method_call(pldmService, pldmObjPath,
+                                             pldm::dbus_api::metricsInterface,
+                                             "Reset");
+                bus.call_noreply(method, dbusTimeout);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get the handler usage from pldmd, "
+                      << e.what() << "\n";
+            return;
+        }
+
+        ordered_json output = ordered_json::array();
+        for (const auto& [type, command, async, calls, totalTime, maxTime] :
+             handlerStats)
+        {
+            ordered_json entry{{"PLDMType", type},
+                               {"Command", command},
+                               {"Async", async},
+                               {"Calls", calls}};
+            if (!async)
+            {
+                /* The time of an asynchronous handler is not measured, it
+                 * does not block the event loop */
+                entry["TotalTime_us"] = totalTime / 1000;
+                entry["MaxTime_us"] = maxTime / 1000;
+            }
+            output.emplace_back(std::move(entry));
+        }
+        DisplayInJson(output);
+    }
+
+    /** @brief Show the load of the worker pool of pldmd */
+    void execWorkers()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        pldm::dbus_api::WorkerPoolStatsEntry stats;
+        try
+        {
+            auto method =
+                bus.new_method_call(pldmService, pldmObjPath,
+                                    pldm::dbus_api::metricsInterface,
+                                    "GetWorkerPoolStats");
+            auto reply = bus.call(method, dbusTimeout);
+            reply.read(stats);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get the worker pool load from pldmd, "
+                      << e.what() << "\n";
+            return;
+        }
+
+        const auto& [workers, queueDepth, maxQueueDepth, busyWorkers,
+                     submitted, completed, rejected, busyTime,
+                     utilization] = stats;
+        ordered_json output{{"Workers", workers},
+                            {"QueueDepth", queueDepth},
+                            {"MaxQueueDepth", maxQueueDepth},
+                            {"BusyWorkers", busyWorkers},
+                            {"Submitted", submitted},
+                            {"Completed", completed},
+                            {"Rejected", rejected},
+                            {"BusyTime_us", busyTime / 1000},
+                            {"Utilization", utilization}};
+        DisplayInJson(output);
+    }
+
+  private:
+    std::optional<uint8_t> eid;
+    bool reset = false;
+    bool showBuckets = false;
+    bool showHandlers = false;
+    bool showWorkers = false;
+};
+
+namespace
+{
+std::unique_ptr<GetMetrics> getMetrics;
+}
+
+void registerCommand(CLI::App& app)
+{
+    auto metrics = app.add_subcommand(
+        "metrics", "requester latency histograms and counters of pldmd");
+    getMetrics = std::make_unique<GetMetrics>(metrics);
+}
+
+} // namespace metrics
+} // namespace pldmtool
@@ -0,0 +1,118 @@
+#include "pldm_sensor_history_cmd.hpp"
+
+#include "common/utils.hpp"
+#include "pldm_cmd_helper.hpp"
+#include "pldmd/dbus_impl_sensor_history.hpp"
+
+#include <tuple>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace sensor_history
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+
+constexpr auto pldmService = "xyz.openbmc_project.PLDM";
+constexpr auto pldmObjPath = "/xyz/openbmc_project/pldm";
+
+} // namespace
+
+class GetSensorHistory
+{
+  public:
+    explicit GetSensorHistory(CLI::App* app)
+    {
+        app->add_option("-t,--tid", tid, "terminus ID of the sensor")
+            ->required();
+        app->add_option("-i,--sensor_id", sensorId, "ID of the numeric sensor")
+            ->required();
+        app->add_flag("-s,--samples", showSamples,
+                      "show the readings kept, oldest first");
+        app->callback([this]() { exec(); });
+    }
+
+    void exec()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        std::vector<std::tuple<uint64_t, uint32_t, double, double, double>>
+            statistics;
+        std::vector<std::tuple<uint64_t, double>> samples;
+        try
+        {
+            auto method = bus.new_method_call(
+                pldmService, pldmObjPath,
+                pldm::dbus_api::sensorHistoryInterface, "GetStatistics");
+            method.append(tid, sensorId);
+            auto reply = bus.call(method, dbusTimeout);
+            reply.read(statistics);
+
+            if (showSamples)
+            {
+                method = bus.new_method_call(
+                    pldmService, pldmObjPath,
+                    pldm::dbus_api::sensorHistoryInterface, "GetSamples");
+                method.append(tid, sensorId);
+                reply = bus.call(method, dbusTimeout);
+                reply.read(samples);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get the sensor history from pldmd, "
+                      << e.what() << "\n";
+            return;
+        }
+
+        ordered_json output{{"TID", tid}, {"SensorID", sensorId}};
+        auto windows = ordered_json::array();
+        for (const auto& [window, count, min, max, mean] : statistics)
+        {
+            /* NaN is shown as null */
+            windows.push_back({{"Window_us", window},
+                               {"Readings", count},
+                               {"Min", min},
+                               {"Max", max},
+                               {"Mean", mean}});
+        }
+        output["Windows"] = std::move(windows);
+
+        if (showSamples)
+        {
+            auto readings = ordered_json::array();
+            for (const auto& [timestamp, value] : samples)
+            {
+                readings.push_back(
+                    {{"Timestamp_us", timestamp}, {"Value", value}});
+            }
+            output["Samples"] = std::move(readings);
+        }
+        DisplayInJson(output);
+    }
+
+  private:
+    uint8_t tid = 0;
+    uint16_t sensorId = 0;
+    bool showSamples = false;
+};
+
+namespace
+{
+std::unique_ptr<GetSensorHistory> getSensorHistory;
+}
+
+void registerCommand(CLI::App& app)
+{
+    auto history = app.add_subcommand(
+        "sensorhistory",
+        "recent readings and windowed statistics of a platform-mc sensor");
+    getSensorHistory = std::make_unique<GetSensorHistory>(history);
+}
+
+} // namespace sensor_history
+} // namespace pldmtool
@@ -1,9 +1,12 @@
 #include "pldm_base_cmd.hpp"
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
+#include "pldm_flight_recorder_cmd.hpp"
 #include "pldm_fru_cmd.hpp"
 #include "pldm_fw_update_cmd.hpp"
+#include "pldm_metrics_cmd.hpp"
 #include "pldm_platform_cmd.hpp"
+#include "pldm_sensor_history_cmd.hpp"
 #include "pldmtool/oem/ibm/pldm_oem_ibm.hpp"
 
 #include <CLI/CLI.hpp>
@@ -74,6 +77,9 @@ int main(int argc, char** argv)
     pldmtool::platform::registerCommand(app);
     pldmtool::fru::registerCommand(app);
     pldmtool::fw_update::registerCommand(app);
+    pldmtool::flight_recorder::registerCommand(app);
+    pldmtool::metrics::registerCommand(app);
+    pldmtool::sensor_history::registerCommand(app);
 
 #ifdef OEM_IBM
     pldmtool::oem_ibm::registerCommand(app);
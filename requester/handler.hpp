@@ -1,28 +1,36 @@
 #pragma once
 
 #include "common/instance_id.hpp"
+#include "common/loop_watchdog.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
+#include "metrics.hpp"
 #include "request.hpp"
+#include "timing_wheel.hpp"
 
 #include <libpldm/base.h>
 #include <sys/socket.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/async.hpp>
-#include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -64,6 +72,99 @@ struct RequestKeyHasher
     }
 };
 
+/** @enum RequestClass
+ *
+ *  The class of a PLDM request message, used to schedule the queued requests of
+ *  one endpoint so that bulk transfers do not delay latency-sensitive commands.
+ */
+enum class RequestClass : uint8_t
+{
+    Control = 0,   //!< Latency-sensitive control, e.g. effecter updates
+    SensorPolling, //!< Periodic sensor reading
+    EventPolling,  //!< Platform event message polling
+    Bulk,          //!< Bulk PDR/FRU record fetch
+    FirmwareData,  //!< Firmware update exchanges
+};
+
+/** @brief Number of request classes */
+constexpr size_t numRequestClasses =
+    static_cast<size_t>(RequestClass::FirmwareData) + 1;
+
+/** @brief The relative share of the endpoint's send opportunities given to
+ *         each request class when several classes have queued requests
+ */
+using RequestClassWeights = std::array<uint16_t, numRequestClasses>;
+
+/** @brief Default weights, indexed by RequestClass */
+constexpr RequestClassWeights defaultRequestClassWeights = {16, 8, 8, 2, 1};
+
+/** @struct RequestClassStats
+ *
+ *  Queue depth counters of one request class of one endpoint.
+ */
+struct RequestClassStats
+{
+    size_t queueDepth = 0;    //!< Number of requests currently queued
+    size_t maxQueueDepth = 0; //!< High watermark of the queue depth
+    uint64_t enqueued = 0;    //!< Total number of requests queued
+    uint64_t dequeued = 0;    //!< Total number of requests sent
+};
+
+/** @struct EndpointRttStats
+ *
+ *  Round-trip time estimate and retry counters of one endpoint. The retry
+ *  interval is derived from the smoothed RTT and the RTT variance in the same
+ *  way TCP derives its retransmission timeout (RFC 6298).
+ */
+struct EndpointRttStats
+{
+    std::chrono::microseconds rtt{0};          //!< Latest RTT sample
+    std::chrono::microseconds srtt{0};         //!< Smoothed RTT
+    std::chrono::microseconds rttvar{0};       //!< RTT variance
+    std::chrono::microseconds retryTimeout{0}; //!< Current retry interval
+    uint64_t samples = 0;                      //!< Number of RTT samples
+    uint64_t retries = 0;  //!< Total number of request retries
+    uint64_t timeouts = 0; //!< Number of requests which got no response
+
+    /** @brief Update the estimate with a new RTT sample
+     *
+     *  @param[in] sample - the measured RTT
+     *  @param[in] granularity - resolution of the retry timer
+     *  @param[in] floor - lower bound of the retry interval
+     *  @param[in] ceiling - upper bound of the retry interval
+     */
+    void addSample(std::chrono::microseconds sample,
+                   std::chrono::microseconds granularity,
+                   std::chrono::microseconds floor,
+                   std::chrono::microseconds ceiling)
+    {
+        rtt = sample;
+        if (!samples++)
+        {
+            srtt = sample;
+            rttvar = sample / 2;
+        }
+        else
+        {
+            auto delta = srtt > sample ? srtt - sample : sample - srtt;
+            rttvar = (3 * rttvar + delta) / 4;
+            srtt = (7 * srtt + sample) / 8;
+        }
+        retryTimeout =
+            std::clamp(srtt + std::max(granularity, 4 * rttvar), floor, ceiling);
+    }
+
+    /** @brief Double the retry interval after a request got no response
+     *
+     *  @param[in] ceiling - upper bound of the retry interval
+     */
+    void backOff(std::chrono::microseconds ceiling)
+    {
+        timeouts++;
+        retryTimeout = std::min(2 * retryTimeout, ceiling);
+    }
+};
+
 using ResponseHandler = std::function<void(
     mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)>;
 
@@ -87,23 +188,106 @@ struct RegisteredRequest
     RequestKey key;                  //!< Responder MCTP endpoint ID
     std::vector<uint8_t> reqMsg;     //!< Request messages queue
     ResponseHandler responseHandler; //!< Waiting for response flag
+    RequestClass requestClass;       //!< Scheduling class of the request
 };
 
+/** @brief The maximum number of outstanding requests to one endpoint, bounded
+ *         by the number of PLDM instance IDs available per terminus.
+ */
+constexpr size_t maxRequestWindowSize = PLDM_INSTANCE_MAX + 1;
+
+using RequestQueue = std::deque<std::shared_ptr<RegisteredRequest>>;
+
 /** @struct EndpointMessageQueue
  *
- *  This struct is used to save the list of request messages of one endpoint and
- *  the existing of the request message to the endpoint with its' EID.
+ *  This struct is used to save the lists of request messages of one endpoint,
+ *  one per request class, and the number of request messages in flight to the
+ *  endpoint with its' EID.
  */
 struct EndpointMessageQueue
 {
     mctp_eid_t eid; //!< Responder MCTP endpoint ID
-    std::deque<std::shared_ptr<RegisteredRequest>> requestQueue; //!< Queue
-    bool activeRequest; //!< Waiting for response flag
+    std::array<RequestQueue, numRequestClasses> requestQueues{}; //!< Queues
+    std::array<int32_t, numRequestClasses> credits{}; //!< Scheduling credits
+    std::array<RequestClassStats, numRequestClasses> stats{}; //!< Counters
+    size_t activeRequests = 0; //!< Number of requests waiting for response
+    size_t windowSize = 1;     //!< Maximum number of requests in flight
+    EndpointRttStats rttStats{}; //!< RTT estimate and retry counters
+    uint64_t coalesced = 0; //!< Requests served by another pending request
 
     bool operator==(const mctp_eid_t& mctpEid) const
     {
         return (eid == mctpEid);
     }
+
+    /** @brief Check whether no request is queued in any request class */
+    bool empty() const
+    {
+        return std::ranges::all_of(requestQueues, [](const auto& queue) {
+            return queue.empty();
+        });
+    }
+
+    /** @brief Queue a request message at the back of its class queue
+     *
+     *  @param[in] request - the registered request
+     */
+    void push(std::shared_ptr<RegisteredRequest> request)
+    {
+        auto idx = static_cast<size_t>(request->requestClass);
+        requestQueues[idx].push_back(std::move(request));
+        auto& classStats = stats[idx];
+        classStats.enqueued++;
+        classStats.queueDepth = requestQueues[idx].size();
+        classStats.maxQueueDepth =
+            std::max(classStats.maxQueueDepth, classStats.queueDepth);
+    }
+
+    /** @brief Dequeue the next request message using smooth weighted round
+     *         robin over the non-empty request classes
+     *
+     *  Each non-empty class earns its weight in credits on every dequeue, the
+     *  class with the most credits is served and pays back the total weight of
+     *  the competing classes. Over time every class gets a share of the sends
+     *  proportional to its weight, and no class with queued requests starves.
+     *
+     *  @param[in] weights - weight of each request class
+     *
+     *  @return the request to be sent, nullptr if all queues are empty
+     */
+    std::shared_ptr<RegisteredRequest> pop(const RequestClassWeights& weights)
+    {
+        int32_t totalWeight = 0;
+        std::optional<size_t> selected;
+        for (size_t idx = 0; idx < numRequestClasses; ++idx)
+        {
+            if (requestQueues[idx].empty())
+            {
+                credits[idx] = 0;
+                continue;
+            }
+            auto weight = std::max<int32_t>(weights[idx], 1);
+            credits[idx] += weight;
+            totalWeight += weight;
+            if (!selected || credits[idx] > credits[*selected])
+            {
+                selected = idx;
+            }
+        }
+
+        if (!selected)
+        {
+            return nullptr;
+        }
+
+        auto idx = *selected;
+        credits[idx] -= totalWeight;
+        auto request = requestQueues[idx].front();
+        requestQueues[idx].pop_front();
+        stats[idx].queueDepth = requestQueues[idx].size();
+        stats[idx].dequeued++;
+        return request;
+    }
 };
 
 /** @class Handler
@@ -136,7 +320,10 @@ class Handler
      *  @param[in] verbose - verbose tracing flag
      *  @param[in] instanceIdExpiryInterval - instance ID expiration interval
      *  @param[in] numRetries - number of request retries
-     *  @param[in] responseTimeOut - time to wait between each retry
+     *  @param[in] responseTimeOut - time to wait between each retry until the
+     *                               round-trip time of the endpoint is known
+     *  @param[in] responseTimeOutFloor - lower bound of the retry interval
+     *  @param[in] responseTimeOutCeiling - upper bound of the retry interval
      */
     explicit Handler(
         PldmTransport* pldmTransport, sdeventplus::Event& event,
@@ -145,10 +332,20 @@ class Handler
             std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
         uint8_t numRetries = static_cast<uint8_t>(NUMBER_OF_REQUEST_RETRIES),
         std::chrono::milliseconds responseTimeOut =
-            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+            std::chrono::milliseconds(RESPONSE_TIME_OUT),
+        std::chrono::milliseconds responseTimeOutFloor =
+            std::chrono::milliseconds(RESPONSE_TIME_OUT_FLOOR),
+        std::chrono::milliseconds responseTimeOutCeiling =
+            std::chrono::milliseconds(RESPONSE_TIME_OUT_CEILING)) :
         pldmTransport(pldmTransport), event(event), instanceIdDb(instanceIdDb),
         verbose(verbose), instanceIdExpiryInterval(instanceIdExpiryInterval),
-        numRetries(numRetries), responseTimeOut(responseTimeOut)
+        numRetries(numRetries), responseTimeOut(responseTimeOut),
+        responseTimeOutFloor(responseTimeOutFloor),
+        responseTimeOutCeiling(
+            std::max(responseTimeOutFloor, responseTimeOutCeiling)),
+        defaultWindowSize(
+            std::clamp<size_t>(REQUEST_WINDOW_SIZE, 1, maxRequestWindowSize)),
+        timingWheel(event)
     {}
 
     void instanceIdExpiryCallBack(RequestKey key)
@@ -159,24 +356,28 @@ class Handler
             info(
                 "Instance ID expiry for EID '{EID}' using InstanceID '{INSTANCEID}'",
                 "EID", key.eid, "INSTANCEID", key.instanceId);
-            auto& [request, responseHandler,
-                   timerInstance] = this->handlers[key];
+            auto& [request, responseHandler, timerInstance,
+                   sendTime] = this->handlers.at(key);
             request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", rc);
-            }
+            timerInstance.stop();
+            auto& rttStats = endpointMessageQueues[eid]->rttStats;
+            rttStats.retries += request->getRetryCount();
+            rttStats.backOff(retryTimeoutCeiling());
+            metrics.recordTimeout(eid, key.type, key.command,
+                                  request->getRetryCount());
             // Call response handler with an empty response to indicate no
             // response
-            responseHandler(eid, nullptr, 0);
+            {
+                watchdog::LoopWatchdog::Scope scope(
+                    {watchdog::SourceKind::Response, eid, key.type,
+                     key.command});
+                responseHandler(eid, nullptr, 0);
+            }
             this->removeRequestContainer.emplace(
                 key,
                 std::make_unique<sdeventplus::source::Defer>(
                     event, std::bind(&Handler::removeRequestEntry, this, key)));
-            endpointMessageQueues[eid]->activeRequest = false;
+            releaseWindowSlot(eid);
 
             /* try to send new request if the endpoint is free */
             pollEndpointQueue(eid);
@@ -191,62 +392,153 @@ class Handler
     }
 
     /** @brief Send the remaining PLDM request messages in endpoint queue
+     *         until the endpoint's window of outstanding requests is full
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      */
     int pollEndpointQueue(mctp_eid_t eid)
     {
-        if (endpointMessageQueues[eid]->activeRequest ||
-            endpointMessageQueues[eid]->requestQueue.empty())
+        auto& endpointQueue = endpointMessageQueues[eid];
+        while (endpointQueue->activeRequests < endpointQueue->windowSize &&
+               !endpointQueue->empty())
         {
-            return PLDM_SUCCESS;
+            auto rc = sendQueuedRequest(eid);
+            if (rc)
+            {
+                return rc;
+            }
         }
 
-        endpointMessageQueues[eid]->activeRequest = true;
-        auto requestMsg = endpointMessageQueues[eid]->requestQueue.front();
-        endpointMessageQueues[eid]->requestQueue.pop_front();
-
-        auto request = std::make_unique<RequestInterface>(
-            pldmTransport, requestMsg->key.eid, event,
-            std::move(requestMsg->reqMsg), numRetries, responseTimeOut,
-            verbose);
-        auto timer = std::make_unique<sdbusplus::Timer>(
-            event.get(), std::bind(&Handler::instanceIdExpiryCallBack, this,
-                                   requestMsg->key));
+        return PLDM_SUCCESS;
+    }
 
-        auto rc = request->start();
-        if (rc)
+    /** @brief Set the number of requests which are allowed to be in flight to
+     *         an endpoint at the same time, REQUEST_WINDOW_SIZE by default
+     *
+     *  The window is clamped to the number of instance IDs available for the
+     *  endpoint. Queued requests are sent immediately if the window grows.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] windowSize - maximum number of outstanding requests
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR_INVALID_DATA
+     *          if the window size is out of range
+     */
+    int setEndpointWindowSize(mctp_eid_t eid, size_t windowSize)
+    {
+        if (!windowSize || windowSize > maxRequestWindowSize)
         {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
             error(
-                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
-                "RC", rc);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return rc;
+                "Invalid request window size '{SIZE}' for EID '{EID}', the range is 1 to {MAX}",
+                "SIZE", windowSize, "EID", eid, "MAX", maxRequestWindowSize);
+            return PLDM_ERROR_INVALID_DATA;
         }
 
-        try
+        getEndpointQueue(eid)->windowSize = windowSize;
+        /* try to send new requests if the window has grown */
+        pollEndpointQueue(eid);
+
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Get the number of requests which are allowed to be in flight to
+     *         an endpoint at the same time
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return the window size of the endpoint
+     */
+    size_t getEndpointWindowSize(mctp_eid_t eid) const
+    {
+        auto it = endpointMessageQueues.find(eid);
+        if (it == endpointMessageQueues.end())
         {
-            timer->start(duration_cast<std::chrono::microseconds>(
-                instanceIdExpiryInterval));
+            return defaultWindowSize;
         }
-        catch (const std::runtime_error& e)
+        return it->second->windowSize;
+    }
+
+    /** @brief Set the scheduling weight of a request class
+     *
+     *  @param[in] requestClass - the request class
+     *  @param[in] weight - relative share of the sends, must be non-zero
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR_INVALID_DATA
+     *          if the weight is zero
+     */
+    int setRequestClassWeight(RequestClass requestClass, uint16_t weight)
+    {
+        if (!weight)
         {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failed to start the instance ID expiry timer, error - {ERROR}",
-                "ERROR", e);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return PLDM_ERROR;
+            return PLDM_ERROR_INVALID_DATA;
         }
-
-        handlers.emplace(requestMsg->key,
-                         std::make_tuple(std::move(request),
-                                         std::move(requestMsg->responseHandler),
-                                         std::move(timer)));
+        requestClassWeights[static_cast<size_t>(requestClass)] = weight;
         return PLDM_SUCCESS;
     }
 
+    /** @brief Get the queue depth counters of a request class of an endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] requestClass - the request class
+     *
+     *  @return the counters, all zero if no request was queued to the endpoint
+     */
+    RequestClassStats getRequestClassStats(mctp_eid_t eid,
+                                           RequestClass requestClass) const
+    {
+        auto it = endpointMessageQueues.find(eid);
+        if (it == endpointMessageQueues.end())
+        {
+            return {};
+        }
+        return it->second->stats[static_cast<size_t>(requestClass)];
+    }
+
+    /** @brief Get the round-trip time estimate and retry counters of an
+     *         endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return the estimate, with the initial retry interval and no samples if
+     *          no request was sent to the endpoint
+     */
+    EndpointRttStats getEndpointRttStats(mctp_eid_t eid) const
+    {
+        auto it = endpointMessageQueues.find(eid);
+        if (it == endpointMessageQueues.end())
+        {
+            EndpointRttStats rttStats{};
+            rttStats.retryTimeout = initialRetryTimeout();
+            return rttStats;
+        }
+        return it->second->rttStats;
+    }
+
+    /** @brief Get the number of idempotent requests to an endpoint which were
+     *         attached to an identical pending request instead of being sent
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return the number of coalesced requests
+     */
+    uint64_t getCoalescedRequestCount(mctp_eid_t eid) const
+    {
+        auto it = endpointMessageQueues.find(eid);
+        if (it == endpointMessageQueues.end())
+        {
+            return 0;
+        }
+        return it->second->coalesced;
+    }
+
+    /** @brief Get the latency histograms, counters and queue depths of the
+     *         requests, per endpoint and command
+     */
+    RequesterMetrics& getMetrics()
+    {
+        return metrics;
+    }
+
     /** @brief Register a PLDM request message
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
@@ -255,12 +547,18 @@ class Handler
      *  @param[in] command - PLDM command
      *  @param[in] requestMsg - PLDM request message
      *  @param[in] responseHandler - Response handler for this request
+     *  @param[in] requestClass - scheduling class of the request
+     *  @param[in] idempotent - the request has no side effects, so it can be
+     *                          served by the response of an identical request
+     *                          to the same endpoint which is still pending
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
     int registerRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
                         uint8_t command, pldm::Request&& requestMsg,
-                        ResponseHandler&& responseHandler)
+                        ResponseHandler&& responseHandler,
+                        RequestClass requestClass = RequestClass::Control,
+                        bool idempotent = false)
     {
         RequestKey key{eid, instanceId, type, command};
 
@@ -272,20 +570,40 @@ class Handler
             return PLDM_ERROR;
         }
 
-        auto inputRequest = std::make_shared<RegisteredRequest>(
-            key, std::move(requestMsg), std::move(responseHandler));
-        if (endpointMessageQueues.contains(eid))
+        if (idempotent && requestMsg.size() >= sizeof(pldm_msg_hdr))
         {
-            endpointMessageQueues[eid]->requestQueue.push_back(inputRequest);
-        }
-        else
-        {
-            std::deque<std::shared_ptr<RegisteredRequest>> reqQueue;
-            reqQueue.push_back(inputRequest);
-            endpointMessageQueues[eid] =
-                std::make_shared<EndpointMessageQueue>(eid, reqQueue, false);
+            /* The instance ID is the only part of identical requests which
+             * differs, leave it out of the signature */
+            CoalesceKey signature{eid, requestMsg};
+            reinterpret_cast<pldm_msg*>(std::get<1>(signature).data())
+                ->hdr.instance_id = 0;
+
+            auto pending = coalesceKeys.find(signature);
+            if (pending != coalesceKeys.end())
+            {
+                coalescedRequests.at(pending->second)
+                    .waiters.emplace_back(key, std::move(responseHandler));
+                getEndpointQueue(eid)->coalesced++;
+                return PLDM_SUCCESS;
+            }
+
+            coalesceKeys.emplace(signature, key);
+            auto& group = coalescedRequests[key];
+            group.signature = std::move(signature);
+            group.waiters.emplace_back(key, std::move(responseHandler));
+            responseHandler = [this, key](mctp_eid_t eid,
+                                          const pldm_msg* response,
+                                          size_t respMsgLen) {
+                completeCoalescedRequests(key, eid, response, respMsgLen);
+            };
         }
 
+        auto inputRequest = std::make_shared<RegisteredRequest>(
+            key, std::move(requestMsg), std::move(responseHandler),
+            requestClass);
+        getEndpointQueue(eid)->push(std::move(inputRequest));
+        metrics.recordQueued(eid, type, command);
+
         /* try to send new request if the endpoint is free */
         pollEndpointQueue(eid);
 
@@ -306,22 +624,65 @@ class Handler
     {
         RequestKey key{eid, instanceId, type, command};
 
+        /* The instance ID of a request which failed to be sent is already
+         * freed */
+        auto failed = std::ranges::find_if(
+            failedRequests,
+            [&key](const auto& entry) { return entry.first == key; });
+        if (failed != failedRequests.end())
+        {
+            failedRequests.erase(failed);
+            return PLDM_SUCCESS;
+        }
+
+        for (auto it = coalescedRequests.begin(); it != coalescedRequests.end();
+             ++it)
+        {
+            auto& waiters = it->second.waiters;
+            auto waiter = std::ranges::find_if(
+                waiters,
+                [&key](const auto& entry) { return entry.first == key; });
+            if (waiter == waiters.end())
+            {
+                continue;
+            }
+
+            /* Only the request which was sent uses its instance ID on the
+             * bus, the exchange goes on for the remaining waiters */
+            auto sentKey = it->first;
+            waiters.erase(waiter);
+            if (key != sentKey)
+            {
+                instanceIdDb.free(key.eid, key.instanceId);
+            }
+            if (!waiters.empty())
+            {
+                return PLDM_SUCCESS;
+            }
+
+            /* Nobody waits for the response anymore */
+            coalesceKeys.erase(it->second.signature);
+            coalescedRequests.erase(it);
+            key = sentKey;
+            instanceId = key.instanceId;
+            break;
+        }
+
         /* handlers only contain key when the message is already sent */
         if (handlers.contains(key))
         {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
+            auto& [request, responseHandler, timerInstance,
+                   sendTime] = handlers.at(key);
             request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", static_cast<int>(rc));
-            }
+            timerInstance.stop();
+            endpointMessageQueues[eid]->rttStats.retries +=
+                request->getRetryCount();
+            metrics.recordCancelled(eid, key.type, key.command,
+                                    request->getRetryCount());
 
             instanceIdDb.free(key.eid, key.instanceId);
             handlers.erase(key);
-            endpointMessageQueues[eid]->activeRequest = false;
+            releaseWindowSlot(eid);
             /* try to send new request if the endpoint is free */
             pollEndpointQueue(eid);
 
@@ -336,22 +697,24 @@ class Handler
                     "EID", (unsigned)eid, "INSTANCEID", (unsigned)instanceId);
                 return PLDM_ERROR;
             }
-            auto requestMsg = endpointMessageQueues[eid]->requestQueue;
-            /* Find the registered request in the requestQueue */
-            for (auto it = requestMsg.begin(); it != requestMsg.end();)
+            auto& endpointQueue = endpointMessageQueues[eid];
+            /* Find the registered request in the request queues */
+            for (size_t idx = 0; idx < numRequestClasses; ++idx)
             {
-                auto msg = *it;
-                if (msg->key == key)
+                auto& requestQueue = endpointQueue->requestQueues[idx];
+                auto it = std::ranges::find_if(
+                    requestQueue, [&key](const auto& msg) {
+                        return msg->key == key;
+                    });
+                if (it != requestQueue.end())
                 {
-                    // erase and get the next valid iterator
-                    it = endpointMessageQueues[eid]->requestQueue.erase(it);
+                    requestQueue.erase(it);
+                    endpointQueue->stats[idx].queueDepth = requestQueue.size();
+                    metrics.recordDequeued(eid, type, command);
+                    metrics.recordCancelled(eid, type, command, 0);
                     instanceIdDb.free(key.eid, key.instanceId);
                     return PLDM_SUCCESS;
                 }
-                else
-                {
-                    ++it; // increment iterator only if not erasing
-                }
             }
         }
 
@@ -374,20 +737,28 @@ class Handler
         RequestKey key{eid, instanceId, type, command};
         if (handlers.contains(key) && !removeRequestContainer.contains(key))
         {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
+            auto& [request, responseHandler, timerInstance,
+                   sendTime] = handlers.at(key);
             request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
+            timerInstance.stop();
+            updateRttStats(eid, *request, sendTime);
+            metrics.recordResponse(
+                eid, type, command,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - sendTime),
+                request->getRetryCount(),
+                response && respMsgLen
+                    ? std::optional<uint8_t>(response->payload[0])
+                    : std::nullopt);
             {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", rc);
+                watchdog::LoopWatchdog::Scope scope(
+                    {watchdog::SourceKind::Response, eid, type, command});
+                responseHandler(eid, response, respMsgLen);
             }
-            responseHandler(eid, response, respMsgLen);
             instanceIdDb.free(key.eid, key.instanceId);
             handlers.erase(key);
 
-            endpointMessageQueues[eid]->activeRequest = false;
+            releaseWindowSlot(eid);
             /* try to send new request if the endpoint is free */
             pollEndpointQueue(eid);
         }
@@ -407,8 +778,10 @@ class Handler
      *          Return [PLDM_ERROR_NOT_READY, nullptr, 0] if timed out.
      *          Return [PLDM_SUCCESS, resp, len] if succeeded
      */
-    stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto
-        sendRecvMsg(mctp_eid_t eid, pldm::Request&& request);
+    stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto sendRecvMsg(
+        mctp_eid_t eid, pldm::Request&& request,
+        RequestClass requestClass = RequestClass::Control,
+        bool idempotent = false);
 
   private:
     PldmTransport* pldmTransport; //!< PLDM transport object
@@ -419,15 +792,32 @@ class Handler
         instanceIdExpiryInterval;     //!< Instance ID expiration interval
     uint8_t numRetries;               //!< number of request retries
     std::chrono::milliseconds
-        responseTimeOut;              //!< time to wait between each retry
+        responseTimeOut;              //!< initial time to wait for a response
+    std::chrono::milliseconds
+        responseTimeOutFloor;         //!< lower bound of the retry interval
+    std::chrono::milliseconds
+        responseTimeOutCeiling;       //!< upper bound of the retry interval
+    size_t defaultWindowSize;         //!< outstanding requests limit of the
+                                      //!< endpoints, REQUEST_WINDOW_SIZE
+    RequestClassWeights requestClassWeights =
+        defaultRequestClassWeights;   //!< weights of the request classes
+
+    /** @brief Latency histograms and counters of the requests */
+    RequesterMetrics metrics;
+
+    /** @brief Timing wheel for the request retry and instance ID expiration
+     *         timers, so that all of them share a single sd-event time source
+     */
+    TimingWheel timingWheel;
 
     /** @brief Container for storing the details of the PLDM request
-     *         message, handler for the corresponding PLDM response and the
-     *         timer object for the Instance ID expiration
+     *         message, handler for the corresponding PLDM response, the
+     *         timer object for the Instance ID expiration and the time the
+     *         request was sent
      */
     using RequestValue =
         std::tuple<std::unique_ptr<RequestInterface>, ResponseHandler,
-                   std::unique_ptr<sdbusplus::Timer>>;
+                   WheelTimer, std::chrono::steady_clock::time_point>;
 
     // Manage the requests of responders base on MCTP EID
     std::map<mctp_eid_t, std::shared_ptr<EndpointMessageQueue>>
@@ -436,6 +826,39 @@ class Handler
     /** @brief Container for storing the PLDM request entries */
     std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
 
+    /** @brief The endpoint and the request message with its instance ID
+     *         cleared, identifying identical idempotent requests
+     */
+    using CoalesceKey = std::tuple<mctp_eid_t, pldm::Request>;
+
+    /** @struct CoalescedRequests
+     *
+     *  The idempotent requests which are served by one request exchange.
+     */
+    struct CoalescedRequests
+    {
+        CoalesceKey signature; //!< signature of the requests
+        std::vector<std::pair<RequestKey, ResponseHandler>>
+            waiters;           //!< requests waiting for the response
+    };
+
+    /** @brief Pending idempotent request exchanges, by the key of the request
+     *         which is sent
+     */
+    std::unordered_map<RequestKey, CoalescedRequests, RequestKeyHasher>
+        coalescedRequests;
+
+    /** @brief Key of the pending request exchange of each signature */
+    std::map<CoalesceKey, RequestKey> coalesceKeys;
+
+    /** @brief Coalesced requests which failed to be sent, waiting for their
+     *         empty response
+     */
+    std::vector<std::pair<RequestKey, ResponseHandler>> failedRequests;
+
+    /** @brief Calls the response handlers of failedRequests */
+    std::unique_ptr<sdeventplus::source::Defer> failedRequestsDefer;
+
     /** @brief Container to store information about the request entries to be
      *         removed after the instance ID timer expires
      */
@@ -443,6 +866,238 @@ class Handler
                        RequestKeyHasher>
         removeRequestContainer;
 
+    /** @brief Send the request message at the front of the endpoint queue and
+     *         arm its instance ID expiry timer
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int sendQueuedRequest(mctp_eid_t eid)
+    {
+        auto& endpointQueue = endpointMessageQueues[eid];
+        endpointQueue->activeRequests++;
+        auto requestMsg = endpointQueue->pop(requestClassWeights);
+        const auto& [reqEid, reqInstanceId, reqType,
+                     reqCommand] = requestMsg->key;
+        metrics.recordDequeued(reqEid, reqType, reqCommand);
+
+        auto request = std::make_unique<RequestInterface>(
+            pldmTransport, requestMsg->key.eid, timingWheel,
+            std::move(requestMsg->reqMsg), numRetries,
+            std::chrono::ceil<std::chrono::milliseconds>(
+                endpointQueue->rttStats.retryTimeout),
+            verbose);
+
+        auto sendTime = std::chrono::steady_clock::now();
+        auto rc = request->start();
+        if (rc)
+        {
+            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
+            abandonCoalescedRequests(requestMsg->key);
+            metrics.recordSendFailure(reqEid, reqType, reqCommand);
+            error(
+                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
+                "RC", rc);
+            endpointQueue->activeRequests--;
+            return rc;
+        }
+
+        metrics.recordSent(reqEid, reqType, reqCommand);
+        auto key = requestMsg->key;
+        handlers.emplace(
+            std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(
+                std::move(request), std::move(requestMsg->responseHandler),
+                WheelTimer(timingWheel,
+                           [this, key] { instanceIdExpiryCallBack(key); }),
+                sendTime));
+        try
+        {
+            auto& timer = std::get<WheelTimer>(handlers.at(key));
+            timer.start(duration_cast<std::chrono::microseconds>(
+                instanceIdExpiryInterval));
+        }
+        catch (const std::runtime_error& e)
+        {
+            handlers.erase(key);
+            instanceIdDb.free(key.eid, key.instanceId);
+            abandonCoalescedRequests(key);
+            error(
+                "Failed to start the instance ID expiry timer, error - {ERROR}",
+                "ERROR", e);
+            endpointQueue->activeRequests--;
+            return PLDM_ERROR;
+        }
+
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Get the message queue of an endpoint, creating it if needed
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return the message queue of the endpoint
+     */
+    std::shared_ptr<EndpointMessageQueue>& getEndpointQueue(mctp_eid_t eid)
+    {
+        auto& endpointQueue = endpointMessageQueues[eid];
+        if (!endpointQueue)
+        {
+            endpointQueue = std::make_shared<EndpointMessageQueue>();
+            endpointQueue->eid = eid;
+            endpointQueue->windowSize = defaultWindowSize;
+            endpointQueue->rttStats.retryTimeout = initialRetryTimeout();
+        }
+        return endpointQueue;
+    }
+
+    /** @brief Get the retry interval used until the first RTT sample of an
+     *         endpoint is taken
+     */
+    std::chrono::microseconds initialRetryTimeout() const
+    {
+        auto ceiling = retryTimeoutCeiling();
+        return std::clamp<std::chrono::microseconds>(
+            responseTimeOut, std::min<std::chrono::microseconds>(
+                                 responseTimeOutFloor, ceiling),
+            ceiling);
+    }
+
+    /** @brief Get the upper bound of the retry interval
+     *
+     *  The request and all its retries have to fit in the expiration interval
+     *  of its instance ID, the configured ceiling is lowered to allow it.
+     */
+    std::chrono::microseconds retryTimeoutCeiling() const
+    {
+        return std::min<std::chrono::microseconds>(
+            responseTimeOutCeiling,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                instanceIdExpiryInterval) /
+                (numRetries + 1));
+    }
+
+    /** @brief Update the RTT estimate of an endpoint with a response
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] request - the request the response belongs to
+     *  @param[in] sendTime - the time the request was sent
+     */
+    void updateRttStats(mctp_eid_t eid, const RequestInterface& request,
+                        std::chrono::steady_clock::time_point sendTime)
+    {
+        auto& rttStats = endpointMessageQueues[eid]->rttStats;
+        auto retries = request.getRetryCount();
+        rttStats.retries += retries;
+
+        /* Karn's algorithm, a response to a retried request can't be matched
+         * to one of its sends and yields no sample */
+        if (retries)
+        {
+            return;
+        }
+        auto ceiling = retryTimeoutCeiling();
+        rttStats.addSample(std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - sendTime),
+                           timingWheel.resolution(),
+                           std::min<std::chrono::microseconds>(
+                               responseTimeOutFloor, ceiling),
+                           ceiling);
+    }
+
+    /** @brief Release one slot of the endpoint's window of outstanding
+     *         requests
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    void releaseWindowSlot(mctp_eid_t eid)
+    {
+        auto& endpointQueue = endpointMessageQueues[eid];
+        if (endpointQueue->activeRequests)
+        {
+            endpointQueue->activeRequests--;
+        }
+    }
+
+    /** @brief Pass the response of an idempotent request to all the requests
+     *         which were coalesced with it
+     *
+     *  @param[in] key - key of the request which was sent
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] response - PLDM response message
+     *  @param[in] respMsgLen - length of the response message
+     */
+    void completeCoalescedRequests(RequestKey key, mctp_eid_t eid,
+                                   const pldm_msg* response, size_t respMsgLen)
+    {
+        auto node = coalescedRequests.extract(key);
+        if (node.empty())
+        {
+            return;
+        }
+        coalesceKeys.erase(node.mapped().signature);
+
+        /* The response handlers may register new requests */
+        for (auto& [waiterKey, responseHandler] : node.mapped().waiters)
+        {
+            if (waiterKey != key)
+            {
+                instanceIdDb.free(waiterKey.eid, waiterKey.instanceId);
+            }
+            responseHandler(eid, response, respMsgLen);
+        }
+    }
+
+    /** @brief Stop coalescing requests with an idempotent request which
+     *         failed to be sent, the requests which were coalesced with it
+     *         get an empty response like on timeout
+     *
+     *  The sending may fail within registerRequest, so the response handlers
+     *  are called from the event loop.
+     *
+     *  @param[in] key - key of the request which failed to be sent
+     */
+    void abandonCoalescedRequests(RequestKey key)
+    {
+        auto node = coalescedRequests.extract(key);
+        if (node.empty())
+        {
+            return;
+        }
+        coalesceKeys.erase(node.mapped().signature);
+        for (auto& [waiterKey, responseHandler] : node.mapped().waiters)
+        {
+            if (waiterKey != key)
+            {
+                instanceIdDb.free(waiterKey.eid, waiterKey.instanceId);
+            }
+            failedRequests.emplace_back(waiterKey, std::move(responseHandler));
+        }
+        if (!failedRequestsDefer)
+        {
+            failedRequestsDefer = std::make_unique<sdeventplus::source::Defer>(
+                event, std::bind(&Handler::notifyFailedRequests, this));
+        }
+    }
+
+    /** @brief Call the response handlers of the requests which failed to be
+     *         sent with an empty response
+     */
+    void notifyFailedRequests()
+    {
+        failedRequestsDefer.reset();
+        /* The response handlers may register new requests */
+        auto requests = std::exchange(failedRequests, {});
+        for (auto& [key, responseHandler] : requests)
+        {
+            watchdog::LoopWatchdog::Scope scope(
+                {watchdog::SourceKind::Response, key.eid, key.type,
+                 key.command});
+            responseHandler(key.eid, nullptr, 0);
+        }
+    }
+
     /** @brief Remove request entry for which the instance ID expired
      *
      *  @param[in] key - key for the Request
@@ -473,8 +1128,10 @@ struct SendRecvMsgOperation
 
     explicit SendRecvMsgOperation(Handler<RequestInterface>& handler,
                                   mctp_eid_t eid, pldm::Request&& request,
+                                  RequestClass requestClass, bool idempotent,
                                   R&& r) :
-        handler(handler), request(std::move(request)), receiver(std::move(r))
+        handler(handler), requestClass(requestClass), idempotent(idempotent),
+        request(std::move(request)), receiver(std::move(r))
     {
         auto requestMsg =
             reinterpret_cast<const pldm_msg*>(this->request.data());
@@ -511,7 +1168,8 @@ struct SendRecvMsgOperation
         auto rc = op.handler.registerRequest(
             op.requestKey.eid, op.requestKey.instanceId, op.requestKey.type,
             op.requestKey.command, std::move(op.request),
-            std::bind(&SendRecvMsgOperation::onComplete, &op, _1, _2, _3));
+            std::bind(&SendRecvMsgOperation::onComplete, &op, _1, _2, _3),
+            op.requestClass, op.idempotent);
         if (rc)
         {
             return stdexec::set_value(std::move(op.receiver), rc,
@@ -570,6 +1228,14 @@ struct SendRecvMsgOperation
      */
     RequestKey requestKey;
 
+    /** @brief The scheduling class of the request message.
+     */
+    RequestClass requestClass;
+
+    /** @brief The request message may be coalesced with an identical one.
+     */
+    bool idempotent;
+
     /** @brief The request message to be sent.
      */
     pldm::Request request;
@@ -608,8 +1274,10 @@ struct SendRecvMsgSender
     SendRecvMsgSender() = delete;
 
     explicit SendRecvMsgSender(requester::Handler<RequestInterface>& handler,
-                               mctp_eid_t eid, pldm::Request&& request) :
-        handler(handler), eid(eid), request(std::move(request))
+                               mctp_eid_t eid, pldm::Request&& request,
+                               RequestClass requestClass, bool idempotent) :
+        handler(handler), eid(eid), request(std::move(request)),
+        requestClass(requestClass), idempotent(idempotent)
     {}
 
     friend auto tag_invoke(stdexec::get_completion_signatures_t,
@@ -623,7 +1291,8 @@ struct SendRecvMsgSender
     friend auto tag_invoke(stdexec::connect_t, SendRecvMsgSender&& self, R r)
     {
         return SendRecvMsgOperation<RequestInterface, R>(
-            self.handler, self.eid, std::move(self.request), std::move(r));
+            self.handler, self.eid, std::move(self.request), self.requestClass,
+            self.idempotent, std::move(r));
     }
 
   private:
@@ -637,12 +1306,21 @@ struct SendRecvMsgSender
 
     /** @brief Request message */
     pldm::Request request;
+
+    /** @brief Scheduling class of the request message */
+    RequestClass requestClass;
+
+    /** @brief Request message may be coalesced with an identical one */
+    bool idempotent;
 };
 
 /** @brief Wrap registerRequest with coroutine API.
  *
  *  @param[in] eid - endpoint ID of the remote MCTP endpoint
  *  @param[in] request - PLDM request message
+ *  @param[in] requestClass - scheduling class of the request
+ *  @param[in] idempotent - the request may be served by the response of an
+ *                          identical pending request to the same endpoint
  *
  *  @return Return [PLDM_ERROR, _, _] if registerRequest fails.
  *          Return [PLDM_ERROR_NOT_READY, nullptr, 0] if timed out.
@@ -651,9 +1329,12 @@ struct SendRecvMsgSender
 template <class RequestInterface>
 stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto
     Handler<RequestInterface>::sendRecvMsg(mctp_eid_t eid,
-                                           pldm::Request&& request)
+                                           pldm::Request&& request,
+                                           RequestClass requestClass,
+                                           bool idempotent)
 {
-    return SendRecvMsgSender(*this, eid, std::move(request)) |
+    return SendRecvMsgSender(*this, eid, std::move(request), requestClass,
+                             idempotent) |
            stdexec::then([](int rc, const pldm_msg* resp, size_t respLen) {
                return std::make_tuple(rc, resp, respLen);
            });
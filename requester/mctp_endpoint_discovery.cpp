@@ -2,6 +2,7 @@
 
 #include "mctp_endpoint_discovery.hpp"
 
+#include "common/loop_watchdog.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 
@@ -10,6 +11,8 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <algorithm>
+#include <charconv>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -26,12 +29,18 @@ namespace pldm
 MctpDiscovery::MctpDiscovery(
     sdbusplus::bus_t& bus,
     std::initializer_list<MctpDiscoveryHandlerIntf*> list) :
-    bus(bus), mctpEndpointAddedSignal(
-                  bus, interfacesAdded(MCTPPath),
-                  std::bind_front(&MctpDiscovery::discoverEndpoints, this)),
+    bus(bus),
+    mctpEndpointAddedSignal(
+        bus, interfacesAdded(MCTPPath),
+        watchdog::LoopWatchdog::wrap(
+            {.kind = watchdog::SourceKind::Match, .name = "MCTPEndpointAdded"},
+            std::bind_front(&MctpDiscovery::discoverEndpoints, this))),
     mctpEndpointRemovedSignal(
         bus, interfacesRemoved(MCTPPath),
-        std::bind_front(&MctpDiscovery::removeEndpoints, this)),
+        watchdog::LoopWatchdog::wrap(
+            {.kind = watchdog::SourceKind::Match,
+             .name = "MCTPEndpointRemoved"},
+            std::bind_front(&MctpDiscovery::removeEndpoints, this))),
     handlers(list)
 {
     getMctpInfos(existingMctpInfos);
@@ -40,6 +49,10 @@ MctpDiscovery::MctpDiscovery(
 
 void MctpDiscovery::getMctpInfos(MctpInfos& mctpInfos)
 {
+#if defined(PLDM_TRANSPORT_WITH_LOOPBACK)
+    getLoopbackMctpInfos(LOOPBACK_SOCKET_PATH, mctpInfos);
+#endif
+
     // Find all implementations of the MCTP Endpoint interface
     pldm::utils::GetSubTreeResponse mapperResponse;
     try
@@ -75,6 +88,36 @@ void MctpDiscovery::getMctpInfos(MctpInfos& mctpInfos)
     }
 }
 
+void MctpDiscovery::getLoopbackMctpInfos(const std::filesystem::path& basePath,
+                                         MctpInfos& mctpInfos)
+{
+    std::error_code ec;
+    auto prefix = basePath.filename().string() + ".";
+    for (const auto& entry :
+         std::filesystem::directory_iterator(basePath.parent_path(), ec))
+    {
+        auto name = entry.path().filename().string();
+        if (!name.starts_with(prefix) || !entry.is_socket(ec))
+        {
+            continue;
+        }
+
+        unsigned value = 0;
+        auto suffix = std::string_view(name).substr(prefix.size());
+        auto [end, err] = std::from_chars(
+            suffix.data(), suffix.data() + suffix.size(), value);
+        if (err != std::errc() || end != suffix.data() + suffix.size() ||
+            value > UINT8_MAX)
+        {
+            continue;
+        }
+        info("Found simulated terminus with EID '{EID}' at '{PATH}'", "EID",
+             value, "PATH", entry.path().string());
+        mctpInfos.emplace_back(
+            MctpInfo(static_cast<eid>(value), emptyUUID, "", 0));
+    }
+}
+
 MctpEndpointProps MctpDiscovery::getMctpEndpointProps(
     const std::string& service, const std::string& path)
 {
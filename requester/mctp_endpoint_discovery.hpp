@@ -147,6 +147,16 @@ class MctpDiscovery
     UUID getEndpointUUIDProp(const std::string& service,
                              const std::string& path);
 
+    /** @brief Get the simulated termini listening on loopback transport
+     *         sockets
+     *
+     *  @param[in] basePath - socket path of pldmd, the termini listen on the
+     *                        path suffixed with their EID
+     *  @param[out] mctpInfos - the termini found are appended
+     */
+    static void getLoopbackMctpInfos(const std::filesystem::path& basePath,
+                                     MctpInfos& mctpInfos);
+
     static constexpr uint8_t mctpTypePLDM = 1;
 };
 
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "common/latency_histogram.hpp"
+
+#include <libpldm/base.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @struct CommandMetrics
+ *
+ *  Counters and latency distribution of the requests of one PLDM command to
+ *  one endpoint
+ */
+struct CommandMetrics
+{
+    LatencyHistogram latency;    //!< Time from the first send to the response
+    uint64_t requests = 0;       //!< Requests sent
+    uint64_t responses = 0;      //!< Responses received
+    uint64_t errorResponses = 0; //!< Responses with an error completion code
+    uint64_t retries = 0;        //!< Request retries
+    uint64_t timeouts = 0;       //!< Requests whose instance ID expired
+    uint64_t sendFailures = 0;   //!< Requests which failed to be sent
+    uint64_t cancelled = 0;      //!< Requests unregistered by the caller
+    size_t queueDepth = 0;       //!< Requests queued waiting to be sent
+    size_t maxQueueDepth = 0;    //!< High watermark of the queue depth
+};
+
+/** @struct MetricsKey
+ *
+ *  Identifies the metrics of a PLDM command to an endpoint
+ */
+struct MetricsKey
+{
+    mctp_eid_t eid;  //!< MCTP endpoint ID
+    uint8_t type;    //!< PLDM type
+    uint8_t command; //!< PLDM command
+
+    bool operator==(const MetricsKey&) const = default;
+};
+
+/** @struct MetricsKeyHasher
+ *
+ *  The key fits into the hash value, so the hash is the key.
+ */
+struct MetricsKeyHasher
+{
+    std::size_t operator()(const MetricsKey& key) const
+    {
+        return (key.eid << 16 | key.type << 8 | key.command);
+    }
+};
+
+/** @class RequesterMetrics
+ *
+ *  The metrics of the requests sent by the requester handler, per endpoint,
+ *  PLDM type and PLDM command. The handler updates them on the event loop,
+ *  an update is a hash lookup and a few increments.
+ */
+class RequesterMetrics
+{
+  public:
+    using Metrics = std::unordered_map<MetricsKey, CommandMetrics,
+                                       MetricsKeyHasher>;
+
+    /** @brief Get the metrics of a command to an endpoint, creating them if
+     *         needed
+     */
+    CommandMetrics& get(mctp_eid_t eid, uint8_t type, uint8_t command)
+    {
+        return metrics[MetricsKey{eid, type, command}];
+    }
+
+    /** @brief Count a request queued to be sent */
+    void recordQueued(mctp_eid_t eid, uint8_t type, uint8_t command)
+    {
+        auto& entry = get(eid, type, command);
+        entry.queueDepth++;
+        entry.maxQueueDepth = std::max(entry.maxQueueDepth, entry.queueDepth);
+    }
+
+    /** @brief Count a request leaving the queue, to be sent or cancelled */
+    void recordDequeued(mctp_eid_t eid, uint8_t type, uint8_t command)
+    {
+        auto& entry = get(eid, type, command);
+        if (entry.queueDepth)
+        {
+            entry.queueDepth--;
+        }
+    }
+
+    /** @brief Count a request sent */
+    void recordSent(mctp_eid_t eid, uint8_t type, uint8_t command)
+    {
+        get(eid, type, command).requests++;
+    }
+
+    /** @brief Count a response and record its latency
+     *
+     *  @param[in] latency - time from the first send of the request
+     *  @param[in] retries - number of times the request was retried
+     *  @param[in] completionCode - completion code of the response, if it
+     *                              has one
+     */
+    void recordResponse(mctp_eid_t eid, uint8_t type, uint8_t command,
+                        std::chrono::microseconds latency, uint64_t retries,
+                        std::optional<uint8_t> completionCode)
+    {
+        auto& entry = get(eid, type, command);
+        entry.responses++;
+        entry.retries += retries;
+        entry.latency.record(latency);
+        if (completionCode && *completionCode != PLDM_SUCCESS)
+        {
+            entry.errorResponses++;
+        }
+    }
+
+    /** @brief Count a request whose instance ID expired without a response
+     */
+    void recordTimeout(mctp_eid_t eid, uint8_t type, uint8_t command,
+                       uint64_t retries)
+    {
+        auto& entry = get(eid, type, command);
+        entry.timeouts++;
+        entry.retries += retries;
+    }
+
+    /** @brief Count a request which failed to be sent */
+    void recordSendFailure(mctp_eid_t eid, uint8_t type, uint8_t command)
+    {
+        get(eid, type, command).sendFailures++;
+    }
+
+    /** @brief Count a request unregistered by the caller
+     *
+     *  @param[in] retries - number of times the request was retried, if it
+     *                       was sent
+     */
+    void recordCancelled(mctp_eid_t eid, uint8_t type, uint8_t command,
+                         uint64_t retries)
+    {
+        auto& entry = get(eid, type, command);
+        entry.cancelled++;
+        entry.retries += retries;
+    }
+
+    /** @brief Get the metrics of all the commands sent */
+    const Metrics& getAll() const
+    {
+        return metrics;
+    }
+
+    /** @brief Reset all the metrics, the queue depths are kept */
+    void reset()
+    {
+        for (auto& [key, entry] : metrics)
+        {
+            auto queueDepth = entry.queueDepth;
+            entry = CommandMetrics{};
+            entry.queueDepth = queueDepth;
+            entry.maxQueueDepth = queueDepth;
+        }
+    }
+
+  private:
+    Metrics metrics;
+};
+
+} // namespace requester
+
+} // namespace pldm
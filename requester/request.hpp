@@ -4,13 +4,12 @@
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "timing_wheel.hpp"
 
 #include <libpldm/base.h>
 #include <sys/socket.h>
 
 #include <phosphor-logging/lg2.hpp>
-#include <sdbusplus/timer.hpp>
-#include <sdeventplus/event.hpp>
 
 #include <chrono>
 #include <functional>
@@ -41,15 +40,14 @@ class RequestRetryTimer
 
     /** @brief Constructor
      *
-     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] wheel - timing wheel of the requester handler
      *  @param[in] numRetries - number of request retries
      *  @param[in] timeout - time to wait between each retry in milliseconds
      */
-    explicit RequestRetryTimer(sdeventplus::Event& event, uint8_t numRetries,
+    explicit RequestRetryTimer(TimingWheel& wheel, uint8_t numRetries,
                                std::chrono::milliseconds timeout) :
-
-        event(event), numRetries(numRetries), timeout(timeout),
-        timer(event.get(), std::bind_front(&RequestRetryTimer::callback, this))
+        numRetries(numRetries), timeout(timeout),
+        timer(wheel, [this] { callback(); })
     {}
 
     /** @brief Starts the request flow and arms the timer for request retries
@@ -85,20 +83,21 @@ class RequestRetryTimer
     /** @brief Stops the timer and no further request retries happen */
     void stop()
     {
-        auto rc = timer.stop();
-        if (rc)
-        {
-            error("Failed to stop the request timer, response code '{RC}'",
-                  "RC", rc);
-        }
+        timer.stop();
+    }
+
+    /** @brief Get the number of times the request has been retried */
+    uint8_t getRetryCount() const
+    {
+        return retryCount;
     }
 
   protected:
-    sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
-    uint8_t numRetries;        //!< number of request retries
+    uint8_t numRetries;    //!< number of request retries
+    uint8_t retryCount{0}; //!< number of retries sent so far
     std::chrono::milliseconds
-        timeout;            //!< time to wait between each retry in milliseconds
-    sdbusplus::Timer timer; //!< manages starting timers and handling timeouts
+        timeout;      //!< time to wait between each retry in milliseconds
+    WheelTimer timer; //!< manages starting timers and handling timeouts
 
     /** @brief Sends the PLDM request message
      *
@@ -111,6 +110,7 @@ class RequestRetryTimer
     {
         if (numRetries--)
         {
+            retryCount++;
             send();
         }
         else
@@ -144,17 +144,17 @@ class Request final : public RequestRetryTimer
      *  @param[in] pldm_transport - PLDM transport object
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      *  @param[in] currrentSendbuffSize - the current send buffer size
-     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] wheel - timing wheel of the requester handler
      *  @param[in] requestMsg - PLDM request message
      *  @param[in] numRetries - number of request retries
      *  @param[in] timeout - time to wait between each retry in milliseconds
      *  @param[in] verbose - verbose tracing flag
      */
     explicit Request(PldmTransport* pldmTransport, mctp_eid_t eid,
-                     sdeventplus::Event& event, pldm::Request&& requestMsg,
+                     TimingWheel& wheel, pldm::Request&& requestMsg,
                      uint8_t numRetries, std::chrono::milliseconds timeout,
                      bool verbose) :
-        RequestRetryTimer(event, numRetries, timeout),
+        RequestRetryTimer(wheel, numRetries, timeout),
         pldmTransport(pldmTransport), eid(eid),
         requestMsg(std::move(requestMsg)), verbose(verbose)
     {}
@@ -176,7 +176,7 @@ class Request final : public RequestRetryTimer
             pldm::utils::printBuffer(pldm::utils::Tx, requestMsg);
         }
         pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
-            requestMsg, true);
+            requestMsg, true, eid);
         const struct pldm_msg_hdr* hdr =
             (struct pldm_msg_hdr*)(requestMsg.data());
         if (!hdr->request)
@@ -6,6 +6,7 @@
 #include "test/test_instance_id.hpp"
 
 #include <libpldm/base.h>
+#include <libpldm/platform.h>
 #include <libpldm/transport.h>
 
 #include <sdbusplus/async.hpp>
@@ -294,3 +295,319 @@ TEST_F(HandlerTest, asyncRequestResponseByCoroutine)
 
     stdexec::sync_wait(scope.on_empty());
 }
+
+TEST_F(HandlerTest, multipleOutstandingRequestsScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(2), 2,
+        milliseconds(100));
+    EXPECT_EQ(reqHandler.getEndpointWindowSize(eid), REQUEST_WINDOW_SIZE);
+    EXPECT_EQ(reqHandler.setEndpointWindowSize(eid, 0),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(reqHandler.setEndpointWindowSize(eid, maxRequestWindowSize + 1),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(reqHandler.setEndpointWindowSize(eid, 2), PLDM_SUCCESS);
+    EXPECT_EQ(reqHandler.getEndpointWindowSize(eid), 2);
+
+    pldm::Request request{};
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    pldm::Request requestNxt{};
+    auto instanceIdNxt = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdNxt, 0, 0, std::move(requestNxt),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // Both requests are in flight, so the response of the second request is
+    // matched before the first request completes
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceIdNxt, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(validResponse, true);
+    EXPECT_EQ(callbackCount, 1);
+
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+}
+
+TEST_F(HandlerTest, requestClassScheduling)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(2), 2,
+        milliseconds(100));
+    std::vector<uint8_t> commands;
+    auto responseHandler = [&commands](uint8_t command) {
+        return [&commands, command](mctp_eid_t, const pldm_msg*, size_t) {
+            commands.push_back(command);
+        };
+    };
+
+    // The first bulk request is sent immediately, the rest are queued
+    auto bulkId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(eid, bulkId, 0, 1, pldm::Request{},
+                                         responseHandler(1),
+                                         RequestClass::Bulk);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    auto bulkIdNxt = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(eid, bulkIdNxt, 0, 1, pldm::Request{},
+                                    responseHandler(1), RequestClass::Bulk);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    auto controlId = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(eid, controlId, 0, 2, pldm::Request{},
+                                    responseHandler(2), RequestClass::Control);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    auto stats = reqHandler.getRequestClassStats(eid, RequestClass::Bulk);
+    EXPECT_EQ(stats.enqueued, 2);
+    EXPECT_EQ(stats.dequeued, 1);
+    EXPECT_EQ(stats.queueDepth, 1);
+    EXPECT_EQ(stats.maxQueueDepth, 1);
+    stats = reqHandler.getRequestClassStats(eid, RequestClass::Control);
+    EXPECT_EQ(stats.queueDepth, 1);
+
+    // The control request overtakes the queued bulk request
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, bulkId, 0, 1, responsePtr, response.size());
+    reqHandler.handleResponse(eid, controlId, 0, 2, responsePtr,
+                              response.size());
+    reqHandler.handleResponse(eid, bulkIdNxt, 0, 1, responsePtr,
+                              response.size());
+    EXPECT_EQ(commands, std::vector<uint8_t>({1, 2, 1}));
+
+    stats = reqHandler.getRequestClassStats(eid, RequestClass::Bulk);
+    EXPECT_EQ(stats.dequeued, 2);
+    EXPECT_EQ(stats.queueDepth, 0);
+}
+
+TEST_F(HandlerTest, adaptiveRetryTimeout)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), milliseconds(20), milliseconds(400));
+    auto rttStats = reqHandler.getEndpointRttStats(eid);
+    EXPECT_EQ(rttStats.retryTimeout, milliseconds(100));
+    EXPECT_EQ(rttStats.samples, 0);
+
+    // A fast response shrinks the retry interval down to the floor
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(validResponse, true);
+
+    rttStats = reqHandler.getEndpointRttStats(eid);
+    EXPECT_EQ(rttStats.samples, 1);
+    EXPECT_LT(rttStats.rtt, milliseconds(20));
+    EXPECT_EQ(rttStats.retryTimeout, milliseconds(20));
+
+    // A request without response is retried and backs the interval off
+    instanceId = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    waitEventExpiry(milliseconds(1500));
+    EXPECT_EQ(nullResponse, true);
+
+    rttStats = reqHandler.getEndpointRttStats(eid);
+    EXPECT_EQ(rttStats.samples, 1);
+    EXPECT_EQ(rttStats.retries, 2);
+    EXPECT_EQ(rttStats.timeouts, 1);
+    EXPECT_EQ(rttStats.retryTimeout, milliseconds(40));
+}
+
+TEST_F(HandlerTest, retryTimeoutFitsInstanceIdExpiry)
+{
+    // The request and its 2 retries have 1 s before the instance ID expires
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(2000), milliseconds(300), milliseconds(4800));
+    auto rttStats = reqHandler.getEndpointRttStats(eid);
+    EXPECT_EQ(rttStats.retryTimeout,
+              duration_cast<microseconds>(seconds(1)) / 3);
+}
+
+TEST_F(HandlerTest, idempotentRequestsCoalesced)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(2), 2,
+        milliseconds(100));
+    auto getRequest = [](uint8_t instanceId, uint8_t sensorId) {
+        pldm::Request request(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+        auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+        requestMsg->hdr.request = PLDM_REQUEST;
+        requestMsg->hdr.instance_id = instanceId;
+        requestMsg->hdr.type = PLDM_PLATFORM;
+        requestMsg->hdr.command = PLDM_GET_SENSOR_READING;
+        requestMsg->payload[0] = sensorId;
+        return request;
+    };
+
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+        getRequest(instanceId, 1),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+        RequestClass::SensorPolling, true);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // Identical request attaches to the pending one, another sensor does not
+    auto instanceIdDup = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdDup, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+        getRequest(instanceIdDup, 1),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+        RequestClass::SensorPolling, true);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    auto instanceIdOther = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdOther, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+        getRequest(instanceIdOther, 2),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+        RequestClass::SensorPolling, true);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(reqHandler.getCoalescedRequestCount(eid), 1);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, instanceIdOther, PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, false);
+}
+
+/** @brief Request which fails to be sent while sendFailure is set */
+class FailingRequest : public RequestRetryTimer
+{
+  public:
+    FailingRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+                   TimingWheel& wheel, pldm::Request&& /*requestMsg*/,
+                   uint8_t numRetries, milliseconds responseTimeOut,
+                   bool /*verbose*/) :
+        RequestRetryTimer(wheel, numRetries, responseTimeOut)
+    {}
+
+    int send() const override
+    {
+        return sendFailure ? PLDM_ERROR : PLDM_SUCCESS;
+    }
+
+    static inline bool sendFailure = false;
+};
+
+TEST_F(HandlerTest, coalescedRequestsSendFailure)
+{
+    Handler<FailingRequest> reqHandler(pldmTransport, event, instanceIdDb,
+                                       false, seconds(2), 2, milliseconds(100));
+    EXPECT_EQ(reqHandler.setEndpointWindowSize(eid, 1), PLDM_SUCCESS);
+    auto getRequest = [](uint8_t instanceId) {
+        pldm::Request request(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+        auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+        requestMsg->hdr.request = PLDM_REQUEST;
+        requestMsg->hdr.instance_id = instanceId;
+        requestMsg->hdr.type = PLDM_PLATFORM;
+        requestMsg->hdr.command = PLDM_GET_SENSOR_READING;
+        requestMsg->payload[0] = 1;
+        return request;
+    };
+
+    // The first request holds the window, the identical requests queued
+    // behind it are coalesced
+    pldm::Request request{};
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    for (int idx = 0; idx < 2; ++idx)
+    {
+        auto instanceIdDup = instanceIdDb.next(eid);
+        rc = reqHandler.registerRequest(
+            eid, instanceIdDup, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+            getRequest(instanceIdDup),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+            RequestClass::SensorPolling, true);
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+    EXPECT_EQ(reqHandler.getCoalescedRequestCount(eid), 1);
+
+    // The window frees up and the coalesced request fails to be sent
+    FailingRequest::sendFailure = true;
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    FailingRequest::sendFailure = false;
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_EQ(nullResponse, false);
+
+    // Both waiters get an empty response like on timeout
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, true);
+}
+
+TEST_F(HandlerTest, requestMetrics)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+
+    // The second request waits in the queue while the first one is pending
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+        pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    auto instanceIdQueued = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdQueued, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+        pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    auto& metrics =
+        reqHandler.getMetrics().get(eid, PLDM_PLATFORM, PLDM_GET_SENSOR_READING);
+    EXPECT_EQ(metrics.requests, 1);
+    EXPECT_EQ(metrics.queueDepth, 1);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    responsePtr->payload[0] = PLDM_ERROR_INVALID_DATA;
+    reqHandler.handleResponse(eid, instanceId, PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              response.size());
+    EXPECT_EQ(metrics.requests, 2);
+    EXPECT_EQ(metrics.responses, 1);
+    EXPECT_EQ(metrics.errorResponses, 1);
+    EXPECT_EQ(metrics.queueDepth, 0);
+    EXPECT_EQ(metrics.maxQueueDepth, 1);
+    EXPECT_EQ(metrics.latency.count, 1);
+
+    // The queued request gets no response
+    waitEventExpiry(milliseconds(1500));
+    EXPECT_EQ(nullResponse, true);
+    EXPECT_EQ(metrics.timeouts, 1);
+    EXPECT_EQ(metrics.retries, 2);
+    EXPECT_EQ(metrics.latency.count, 1);
+}
@@ -0,0 +1,30 @@
+#include "requester/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+TEST(RequesterMetrics, resetKeepsQueueDepth)
+{
+    RequesterMetrics metrics;
+    metrics.recordQueued(8, 2, 0x11);
+    metrics.recordQueued(8, 2, 0x11);
+    metrics.recordDequeued(8, 2, 0x11);
+    metrics.recordSent(8, 2, 0x11);
+    metrics.recordResponse(8, 2, 0x11, microseconds(150), 1, PLDM_SUCCESS);
+
+    const auto& entry = metrics.get(8, 2, 0x11);
+    EXPECT_EQ(entry.requests, 1);
+    EXPECT_EQ(entry.responses, 1);
+    EXPECT_EQ(entry.errorResponses, 0);
+    EXPECT_EQ(entry.retries, 1);
+    EXPECT_EQ(entry.maxQueueDepth, 2);
+
+    metrics.reset();
+    EXPECT_EQ(entry.requests, 0);
+    EXPECT_EQ(entry.latency.count, 0);
+    EXPECT_EQ(entry.queueDepth, 1);
+    EXPECT_EQ(entry.maxQueueDepth, 1);
+    EXPECT_EQ(metrics.getAll().size(), 1);
+}
@@ -18,10 +18,10 @@ class MockRequest : public RequestRetryTimer
 {
   public:
     MockRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
-                sdeventplus::Event& event, pldm::Request&& /*requestMsg*/,
+                TimingWheel& wheel, pldm::Request&& /*requestMsg*/,
                 uint8_t numRetries, std::chrono::milliseconds responseTimeOut,
                 bool /*verbose*/) :
-        RequestRetryTimer(event, numRetries, responseTimeOut)
+        RequestRetryTimer(wheel, numRetries, responseTimeOut)
     {}
 
     MOCK_METHOD(int, send, (), (const, override));
@@ -1,5 +1,6 @@
 #include "common/transport.hpp"
 #include "mock_request.hpp"
+#include "requester/timing_wheel.hpp"
 
 #include <libpldm/base.h>
 
@@ -19,7 +20,8 @@ using ::testing::Return;
 class RequestIntfTest : public testing::Test
 {
   protected:
-    RequestIntfTest() : event(sdeventplus::Event::get_default()) {}
+    RequestIntfTest() : event(sdeventplus::Event::get_default()), wheel(event)
+    {}
 
     /** @brief This function runs the sd_event_run in a loop till all the events
      *         in the testcase are dispatched and exits when there are no events
@@ -44,12 +46,13 @@ class RequestIntfTest : public testing::Test
     mctp_eid_t eid = 0;
     PldmTransport* pldmTransport = nullptr;
     sdeventplus::Event event;
+    TimingWheel wheel;
 };
 
 TEST_F(RequestIntfTest, 0Retries100msTimeout)
 {
     std::vector<uint8_t> requestMsg;
-    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 0,
+    MockRequest request(pldmTransport, eid, wheel, std::move(requestMsg), 0,
                         milliseconds(100), false);
     EXPECT_CALL(request, send())
         .Times(Exactly(1))
@@ -61,7 +64,7 @@ TEST_F(RequestIntfTest, 0Retries100msTimeout)
 TEST_F(RequestIntfTest, 2Retries100msTimeout)
 {
     std::vector<uint8_t> requestMsg;
-    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 2,
+    MockRequest request(pldmTransport, eid, wheel, std::move(requestMsg), 2,
                         milliseconds(100), false);
     // send() is called a total of 3 times, the original plus two retries
     EXPECT_CALL(request, send()).Times(3).WillRepeatedly(Return(PLDM_SUCCESS));
@@ -73,7 +76,7 @@ TEST_F(RequestIntfTest, 2Retries100msTimeout)
 TEST_F(RequestIntfTest, 9Retries100msTimeoutRequestStoppedAfter1sec)
 {
     std::vector<uint8_t> requestMsg;
-    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 9,
+    MockRequest request(pldmTransport, eid, wheel, std::move(requestMsg), 9,
                         milliseconds(100), false);
     // send() will be called a total of 10 times, the original plus 9 retries.
     // In a ideal scenario send() would have been called 10 times in 1 sec (when
@@ -97,7 +100,7 @@ TEST_F(RequestIntfTest, 9Retries100msTimeoutRequestStoppedAfter1sec)
 TEST_F(RequestIntfTest, 2Retries100msTimeoutsendReturnsError)
 {
     std::vector<uint8_t> requestMsg;
-    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 2,
+    MockRequest request(pldmTransport, eid, wheel, std::move(requestMsg), 2,
                         milliseconds(100), false);
     EXPECT_CALL(request, send()).Times(Exactly(1)).WillOnce(Return(PLDM_ERROR));
     auto rc = request.start();
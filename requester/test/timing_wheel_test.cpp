@@ -0,0 +1,162 @@
+#include "requester/timing_wheel.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+class TimingWheelTest : public testing::Test
+{
+  protected:
+    TimingWheelTest() :
+        event(sdeventplus::Event::get_default()), wheel(event, milliseconds(1))
+    {}
+
+    /** @brief This function runs the sd_event_run in a loop till all the events
+     *         in the testcase are dispatched and exits when there are no events
+     *         for the timeout time.
+     *
+     *  @param[in] timeout - maximum time to wait for an event
+     */
+    void waitEventExpiry(milliseconds timeout)
+    {
+        while (1)
+        {
+            auto sleepTime = duration_cast<microseconds>(timeout);
+            // Returns 0 on timeout
+            if (!sd_event_run(event.get(), sleepTime.count()))
+            {
+                break;
+            }
+        }
+    }
+
+    sdeventplus::Event event;
+    TimingWheel wheel;
+};
+
+TEST_F(TimingWheelTest, oneShotTimersExpireInOrder)
+{
+    std::vector<int> order;
+    WheelTimer late(wheel, [&] { order.push_back(3); });
+    WheelTimer early(wheel, [&] { order.push_back(1); });
+    // Lands in the second level of the wheel and has to be cascaded down
+    WheelTimer cascaded(wheel, [&] { order.push_back(2); });
+
+    auto start = steady_clock::now();
+    late.start(milliseconds(200));
+    early.start(milliseconds(10));
+    cascaded.start(milliseconds(100));
+    EXPECT_EQ(wheel.size(), 3u);
+
+    waitEventExpiry(milliseconds(300));
+    EXPECT_GE(steady_clock::now() - start, milliseconds(200));
+    EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(wheel.size(), 0u);
+    EXPECT_FALSE(late.isRunning());
+}
+
+TEST_F(TimingWheelTest, stoppedTimerDoesNotExpire)
+{
+    int expired = 0;
+    WheelTimer timer(wheel, [&] { expired++; });
+    timer.start(milliseconds(50));
+    EXPECT_TRUE(timer.isRunning());
+    timer.stop();
+    EXPECT_FALSE(timer.isRunning());
+    EXPECT_EQ(wheel.size(), 0u);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 0);
+
+    auto destroyed = std::make_unique<WheelTimer>(wheel, [&] { expired++; });
+    destroyed->start(milliseconds(50));
+    destroyed.reset();
+    EXPECT_EQ(wheel.size(), 0u);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 0);
+}
+
+TEST_F(TimingWheelTest, periodicTimerStoppedFromCallback)
+{
+    int expired = 0;
+    WheelTimer timer(wheel, [&] {
+        if (++expired == 3)
+        {
+            timer.stop();
+        }
+    });
+    timer.start(milliseconds(20), true);
+
+    waitEventExpiry(milliseconds(200));
+    EXPECT_EQ(expired, 3);
+    EXPECT_FALSE(timer.isRunning());
+}
+
+TEST_F(TimingWheelTest, timerDestroyedFromCallback)
+{
+    int expired = 0;
+    std::unique_ptr<WheelTimer> timer;
+    timer = std::make_unique<WheelTimer>(wheel, [&] {
+        expired++;
+        timer.reset();
+    });
+    timer->start(milliseconds(20), true);
+
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(expired, 1);
+    EXPECT_FALSE(timer);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(TimingWheelTest, restartPostponesExpiry)
+{
+    int expired = 0;
+    WheelTimer timer(wheel, [&] { expired++; });
+    auto start = steady_clock::now();
+    timer.start(milliseconds(20));
+    timer.start(milliseconds(150));
+    EXPECT_EQ(wheel.size(), 1u);
+
+    waitEventExpiry(milliseconds(300));
+    EXPECT_EQ(expired, 1);
+    EXPECT_GE(steady_clock::now() - start, milliseconds(150));
+}
+
+TEST(TimingWheel, timeUntilPastExpiryIsZero)
+{
+    auto now =
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch());
+    auto tick = milliseconds(1);
+    auto past = static_cast<uint64_t>(now / tick) - 5;
+    EXPECT_EQ(TimingWheel::timeUntil(past, tick, now), microseconds(0));
+
+    // A tick boundary passed since the expiry was computed
+    EXPECT_EQ(TimingWheel::timeUntil(10, tick, microseconds(10001)),
+              microseconds(0));
+    EXPECT_EQ(TimingWheel::timeUntil(10, tick, nanoseconds(9999500)),
+              microseconds(1));
+    EXPECT_EQ(TimingWheel::timeUntil(10, tick, milliseconds(8)),
+              milliseconds(2));
+}
+
+TEST_F(TimingWheelTest, expiryPastWhenArmedFires)
+{
+    // With a 1us tick the expiry of a 0 interval timer is in the past by the
+    // time the wheel arms its timer
+    TimingWheel fineWheel(event, microseconds(1));
+    int expired = 0;
+    WheelTimer timer(fineWheel, [&] { expired++; });
+    for (int i = 0; i < 50; ++i)
+    {
+        timer.start(microseconds(0));
+        waitEventExpiry(milliseconds(50));
+        EXPECT_EQ(expired, i + 1);
+    }
+}
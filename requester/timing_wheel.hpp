@@ -0,0 +1,433 @@
+#pragma once
+
+#include "common/loop_watchdog.hpp"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace pldm
+{
+namespace requester
+{
+
+class TimingWheel;
+
+/** @class WheelTimer
+ *
+ *  A one-shot or periodic timer armed on a TimingWheel. The timer is an
+ *  intrusive node of the wheel's slot lists, so arming and cancelling it are
+ *  O(1) and neither allocates memory nor touches an sd-event source.
+ */
+class WheelTimer
+{
+  public:
+    using Callback = std::function<void()>;
+
+    WheelTimer() = delete;
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+    WheelTimer& operator=(WheelTimer&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] wheel - the timing wheel the timer is armed on
+     *  @param[in] callback - function invoked when the timer expires
+     */
+    explicit WheelTimer(TimingWheel& wheel, Callback&& callback) :
+        wheel(&wheel),
+        callback(std::make_shared<const Callback>(std::move(callback)))
+    {}
+
+    /** @brief Move constructor, only an unarmed timer can be moved */
+    WheelTimer(WheelTimer&& other) noexcept :
+        wheel(other.wheel), callback(std::move(other.callback))
+    {
+        assert(!other.armed);
+    }
+
+    ~WheelTimer()
+    {
+        stop();
+    }
+
+    /** @brief Arm the timer, re-arming it if it is already running
+     *
+     *  @param[in] interval - time until the timer expires
+     *  @param[in] repeat - re-arm the timer with the same interval every time
+     *                      it expires
+     */
+    inline void start(std::chrono::microseconds interval, bool repeat = false);
+
+    /** @brief Disarm the timer */
+    inline void stop();
+
+    /** @brief Check whether the timer is armed */
+    bool isRunning() const
+    {
+        return armed;
+    }
+
+  private:
+    friend class TimingWheel;
+
+    TimingWheel* wheel;         //!< the wheel the timer is armed on
+    /** @brief Function invoked on expiry, shared with the expiry in progress
+     *         so that the timer can be destroyed by its own callback
+     */
+    std::shared_ptr<const Callback> callback;
+    WheelTimer** slot{nullptr}; //!< head of the slot list holding the timer
+    WheelTimer* prev{nullptr};  //!< previous timer in the slot list
+    WheelTimer* next{nullptr};  //!< next timer in the slot list
+    uint64_t expiry{0};         //!< absolute expiry time in ticks
+    uint64_t period{0};         //!< re-arm interval in ticks, 0 if one-shot
+    bool armed{false};          //!< timer is linked into a slot list
+};
+
+/** @class TimingWheel
+ *
+ *  A hierarchical timing wheel, as described by Varghese and Lauck, driven by
+ *  a single sd-event time source. Level 0 has one slot per tick and every
+ *  higher level covers the full span of the level below with each slot. Timers
+ *  in a higher level are cascaded down whenever the level below wraps around.
+ *  The time source is a one-shot armed for the first slot which may hold an
+ *  expiring timer, so the wheel causes no wakeups while it is idle.
+ */
+class TimingWheel
+{
+  public:
+    static constexpr size_t slotBits = 6;
+    static constexpr size_t slotsPerLevel = 1 << slotBits;
+    static constexpr size_t numLevels = 4;
+
+    TimingWheel() = delete;
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel(TimingWheel&&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+    TimingWheel& operator=(TimingWheel&&) = delete;
+    ~TimingWheel() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] tick - resolution of the wheel
+     */
+    explicit TimingWheel(
+        sdeventplus::Event& event,
+        std::chrono::microseconds tick = std::chrono::milliseconds(10)) :
+        tick(tick),
+        timer(event.get(), [this] { advance(); }), currentTick(now())
+    {}
+
+    /** @brief Get the number of armed timers */
+    size_t size() const
+    {
+        return armedTimers;
+    }
+
+    /** @brief Get the resolution of the wheel */
+    std::chrono::microseconds resolution() const
+    {
+        return tick;
+    }
+
+    /** @brief Get the time until a tick
+     *
+     *  The tick of a timer may already be past when the wheel is armed, a
+     *  tick boundary passed since the expiry was computed or the loop
+     *  stalled, so the time is computed signed.
+     *
+     *  @param[in] expiry - the tick
+     *  @param[in] tick - resolution of the wheel
+     *  @param[in] now - the current time since the epoch of steady_clock
+     *
+     *  @return the time until the tick, rounded up, 0 if it is past
+     */
+    static std::chrono::microseconds timeUntil(uint64_t expiry,
+                                               std::chrono::microseconds tick,
+                                               std::chrono::nanoseconds now)
+    {
+        auto wait = std::chrono::nanoseconds(static_cast<int64_t>(expiry) *
+                                             tick) -
+                    now;
+        return std::max(std::chrono::ceil<std::chrono::microseconds>(wait),
+                        std::chrono::microseconds(0));
+    }
+
+  private:
+    friend class WheelTimer;
+
+    /** @brief Arm a timer
+     *
+     *  @param[in] entry - the timer
+     *  @param[in] interval - time until the timer expires
+     *  @param[in] repeat - re-arm the timer after it expires
+     */
+    void arm(WheelTimer& entry, std::chrono::microseconds interval, bool repeat)
+    {
+        if (entry.armed)
+        {
+            cancel(entry);
+        }
+
+        if (!armedTimers)
+        {
+            currentTick = now();
+        }
+
+        /* Round up, so that a timer never expires before its interval */
+        auto deadline = std::chrono::steady_clock::now().time_since_epoch() +
+                        interval;
+        entry.expiry = std::max<uint64_t>(toTicks(deadline), currentTick + 1);
+        entry.period = repeat ? std::max<uint64_t>(toTicks(interval), 1) : 0;
+        insert(entry);
+        armedTimers++;
+        schedule(entry.expiry);
+    }
+
+    /** @brief Disarm a timer
+     *
+     *  @param[in] entry - the timer
+     */
+    void cancel(WheelTimer& entry)
+    {
+        if (!entry.armed)
+        {
+            return;
+        }
+
+        unlink(entry);
+        if (!--armedTimers)
+        {
+            timer.stop();
+            wakeTick = noWakeup;
+        }
+    }
+
+    /** @brief Arm the time source if a timer expires before the next wakeup
+     *
+     *  @param[in] expiry - expiry time of the timer in ticks
+     */
+    void schedule(uint64_t expiry)
+    {
+        if (expiry >= wakeTick)
+        {
+            return;
+        }
+
+        wakeTick = expiry;
+        timer.start(timeUntil(
+            expiry, tick, std::chrono::steady_clock::now().time_since_epoch()));
+    }
+
+    /** @brief Get a lower bound of the earliest expiry time of all timers
+     *
+     *  For level 0 this is the first non-empty slot, for the higher levels it
+     *  is the tick at which the first non-empty slot is cascaded down.
+     */
+    uint64_t nextExpiry() const
+    {
+        uint64_t next = noWakeup;
+        for (size_t level = 0; level < numLevels; ++level)
+        {
+            auto base = currentTick >> (slotBits * level);
+            for (uint64_t i = 1; i <= slotsPerLevel; ++i)
+            {
+                if (slots[level][(base + i) & (slotsPerLevel - 1)])
+                {
+                    next = std::min(next, (base + i) << (slotBits * level));
+                    break;
+                }
+            }
+        }
+        return next;
+    }
+
+    /** @brief Get the current time in ticks */
+    uint64_t now() const
+    {
+        return std::chrono::steady_clock::now().time_since_epoch() / tick;
+    }
+
+    /** @brief Convert a duration to ticks, rounding up
+     *
+     *  @param[in] duration - the duration
+     */
+    uint64_t toTicks(std::chrono::steady_clock::duration duration) const
+    {
+        auto usec = std::chrono::ceil<std::chrono::microseconds>(duration);
+        return (usec + tick - std::chrono::microseconds(1)) / tick;
+    }
+
+    /** @brief Link a timer into the slot matching its expiry time
+     *
+     *  @param[in] entry - the timer
+     */
+    void insert(WheelTimer& entry)
+    {
+        uint64_t expiry = std::max(entry.expiry, currentTick);
+        uint64_t delta = expiry - currentTick;
+
+        size_t level = 0;
+        while (level < numLevels - 1 &&
+               delta >= (uint64_t{1} << (slotBits * (level + 1))))
+        {
+            level++;
+        }
+
+        uint64_t maxDelta = (uint64_t{1} << (slotBits * numLevels)) - 1;
+        if (delta > maxDelta)
+        {
+            expiry = currentTick + maxDelta;
+        }
+
+        auto& head =
+            slots[level][(expiry >> (slotBits * level)) & (slotsPerLevel - 1)];
+        entry.slot = &head;
+        entry.prev = nullptr;
+        entry.next = head;
+        if (head)
+        {
+            head->prev = &entry;
+        }
+        head = &entry;
+        entry.armed = true;
+    }
+
+    /** @brief Unlink a timer from its slot list
+     *
+     *  @param[in] entry - the timer
+     */
+    void unlink(WheelTimer& entry)
+    {
+        if (entry.prev)
+        {
+            entry.prev->next = entry.next;
+        }
+        else
+        {
+            *entry.slot = entry.next;
+        }
+        if (entry.next)
+        {
+            entry.next->prev = entry.prev;
+        }
+        entry.slot = nullptr;
+        entry.prev = nullptr;
+        entry.next = nullptr;
+        entry.armed = false;
+    }
+
+    /** @brief Move the timers of one slot of a higher level down the wheel
+     *
+     *  @param[in] level - the level to cascade from
+     *
+     *  @return the slot index which was cascaded
+     */
+    size_t cascade(size_t level)
+    {
+        auto idx = (currentTick >> (slotBits * level)) & (slotsPerLevel - 1);
+        auto* entry = slots[level][idx];
+        slots[level][idx] = nullptr;
+        while (entry)
+        {
+            auto* next = entry->next;
+            insert(*entry);
+            entry = next;
+        }
+        return idx;
+    }
+
+    /** @brief Callback of the time source, expires all due timers */
+    void advance()
+    {
+        watchdog::LoopWatchdog::Scope scope(
+            {.kind = watchdog::SourceKind::Timer, .name = "TimingWheel"});
+        auto target = now();
+        wakeTick = noWakeup;
+        while (currentTick < target && armedTimers)
+        {
+            currentTick++;
+            auto idx = currentTick & (slotsPerLevel - 1);
+            for (size_t level = 1; !idx && level < numLevels; ++level)
+            {
+                idx = cascade(level);
+            }
+
+            auto& head = slots[0][currentTick & (slotsPerLevel - 1)];
+            while (head)
+            {
+                auto& entry = *head;
+                unlink(entry);
+                if (entry.period)
+                {
+                    entry.expiry = currentTick + entry.period;
+                    insert(entry);
+                }
+                else
+                {
+                    armedTimers--;
+                }
+
+                /* The callback may disarm or destroy the timer, the local
+                 * reference keeps the callback alive while it runs */
+                auto callback = entry.callback;
+                (*callback)();
+            }
+        }
+        currentTick = std::max(currentTick, target);
+
+        if (armedTimers)
+        {
+            schedule(nextExpiry());
+        }
+        else
+        {
+            timer.stop();
+            wakeTick = noWakeup;
+        }
+    }
+
+    static constexpr uint64_t noWakeup = std::numeric_limits<uint64_t>::max();
+
+    /** @brief Resolution of the wheel */
+    std::chrono::microseconds tick;
+
+    /** @brief The single sd-event time source driving the wheel */
+    sdbusplus::Timer timer;
+
+    /** @brief The time up to which the timers have been expired, in ticks */
+    uint64_t currentTick;
+
+    /** @brief Number of armed timers */
+    size_t armedTimers{0};
+
+    /** @brief The tick the time source is armed for */
+    uint64_t wakeTick{noWakeup};
+
+    /** @brief Heads of the slot lists of each level */
+    std::array<std::array<WheelTimer*, slotsPerLevel>, numLevels> slots{};
+};
+
+inline void WheelTimer::start(std::chrono::microseconds interval, bool repeat)
+{
+    wheel->arm(*this, interval, repeat);
+}
+
+inline void WheelTimer::stop()
+{
+    wheel->cancel(*this);
+}
+
+} // namespace requester
+
+} // namespace pldm
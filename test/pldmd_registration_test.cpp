@@ -2,7 +2,10 @@
 
 #include <libpldm/base.h>
 
+#include <algorithm>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -30,6 +33,37 @@ class TestHandler : public CmdHandler
     }
 };
 
+class TestAsyncHandler : public CmdHandler
+{
+  public:
+    TestAsyncHandler()
+    {
+        asyncHandlers.emplace(
+            testCmd,
+            [](uint8_t /*tid*/, const pldm_msg* request,
+               size_t /*payloadLength*/) -> exec::task<Response> {
+                co_return ccOnlyResponse(request, PLDM_SUCCESS);
+            });
+    }
+};
+
+class ThrowingHandler : public CmdHandler
+{
+  public:
+    ThrowingHandler()
+    {
+        handlers.emplace(testCmd,
+                         [](uint8_t /*tid*/, const pldm_msg* /*request*/,
+                            size_t /*payloadLength*/) -> Response {
+            throw std::runtime_error("handler failure");
+        });
+        handlers.emplace(0xFE, [](uint8_t /*tid*/, const pldm_msg* /*request*/,
+                                  size_t /*payloadLength*/) -> Response {
+            throw std::out_of_range("unknown command");
+        });
+    }
+};
+
 TEST(CcOnlyResponse, testEncode)
 {
     std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
@@ -48,15 +82,137 @@ TEST(Registration, testSuccess)
     auto result = invoker.handle(tid, testType, testCmd, nullptr, 0);
     ASSERT_EQ(result[0], 100);
     ASSERT_EQ(result[1], 200);
+
+    auto stats = invoker.getHandlerStats(testType, testCmd);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_FALSE(stats->async);
+    EXPECT_EQ(stats->calls, 1);
+    EXPECT_LE(stats->maxTime, stats->totalTime);
+
+    size_t commands = 0;
+    invoker.forEachHandlerStats(
+        [&commands](Type type, Command command, const HandlerStats& usage) {
+            EXPECT_EQ(type, testType);
+            EXPECT_EQ(command, testCmd);
+            EXPECT_EQ(usage.calls, 1);
+            commands++;
+        });
+    EXPECT_EQ(commands, 1);
+
+    invoker.resetHandlerStats();
+    stats = invoker.getHandlerStats(testType, testCmd);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->calls, 0);
+    EXPECT_EQ(stats->maxTime.count(), 0);
+}
+
+TEST(Registration, testAsync)
+{
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+    encode_get_types_req(0, reinterpret_cast<pldm_msg*>(requestMsg.data()));
+
+    Invoker invoker{};
+    invoker.registerHandler(testType, std::make_unique<TestAsyncHandler>());
+    std::optional<Response> sent;
+    auto result = invoker.dispatch(
+        tid, testType, testCmd, requestMsg,
+        [&sent](pldm_tid_t, Response&& response) {
+            sent = std::move(response);
+        });
+
+    // The response of an asynchronous handler goes to the callback
+    EXPECT_FALSE(result.has_value());
+    ASSERT_TRUE(sent.has_value());
+    std::vector<uint8_t> expectMsg = {0, 0, 4, PLDM_SUCCESS};
+    EXPECT_EQ(*sent, expectMsg);
+
+    auto stats = invoker.getHandlerStats(testType, testCmd);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_TRUE(stats->async);
+    EXPECT_EQ(stats->calls, 1);
+    EXPECT_FALSE(invoker.getHandlerStats(testType, 0xFE).has_value());
 }
 
 TEST(Registration, testFailure)
 {
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    encode_get_types_req(0, request);
+    std::vector<uint8_t> expectMsg = {0, 0, 4,
+                                      PLDM_ERROR_UNSUPPORTED_PLDM_CMD};
+
     Invoker invoker{};
-    ASSERT_THROW(invoker.handle(tid, testType, testCmd, nullptr, 0),
-                 std::out_of_range);
+    auto result = invoker.handle(tid, testType, testCmd, request, 0);
+    EXPECT_EQ(result, expectMsg);
     invoker.registerHandler(testType, std::make_unique<TestHandler>());
     uint8_t badCmd = 0xFE;
-    ASSERT_THROW(invoker.handle(tid, testType, badCmd, nullptr, 0),
-                 std::out_of_range);
+    result = invoker.handle(tid, testType, badCmd, request, 0);
+    EXPECT_EQ(result, expectMsg);
+}
+
+TEST(ResponsePool, buffersAreReused)
+{
+    auto& responsePool = ResponsePool::getInstance();
+    auto response = CmdHandler::newResponse(PLDM_GET_TID_RESP_BYTES);
+    EXPECT_EQ(response.size(), sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES);
+    EXPECT_TRUE(std::ranges::all_of(response, [](auto b) { return !b; }));
+    response[0] = 0xFF;
+    auto data = response.data();
+
+    auto freeBuffers = responsePool.size();
+    responsePool.release(std::move(response));
+    EXPECT_EQ(responsePool.size(), freeBuffers + 1);
+
+    // The released buffer is handed out again, zero filled
+    auto reused = CmdHandler::newResponse(1);
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_EQ(reused, std::vector<uint8_t>(sizeof(pldm_msg_hdr) + 1, 0));
+    EXPECT_EQ(responsePool.size(), freeBuffers);
+
+    // Large buffers are not kept
+    Response large(ResponsePool::maxBufferCapacity + 1);
+    responsePool.release(std::move(large));
+    EXPECT_EQ(responsePool.size(), freeBuffers);
+}
+
+TEST(Registration, testHandlerException)
+{
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    encode_get_types_req(0, request);
+
+    Invoker invoker{};
+    invoker.registerHandler(testType, std::make_unique<ThrowingHandler>());
+    auto result = invoker.handle(tid, testType, testCmd, request, 0);
+    std::vector<uint8_t> expectMsg = {0, 0, 4, PLDM_ERROR};
+    EXPECT_EQ(result, expectMsg);
+
+    result = invoker.handle(tid, testType, 0xFE, request, 0);
+    expectMsg = {0, 0, 4, PLDM_ERROR_UNSUPPORTED_PLDM_CMD};
+    EXPECT_EQ(result, expectMsg);
+
+    auto stats = invoker.getHandlerStats(testType, testCmd);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->calls, 1);
+}
+
+TEST(ResponsePool, poolPerThread)
+{
+    auto& responsePool = ResponsePool::getInstance();
+    auto freeBuffers = responsePool.size();
+
+    // A handler run on a worker thread does not touch the pool of the event
+    // loop, the buffer is released to it once the response is sent
+    Response response;
+    const ResponsePool* workerPool = nullptr;
+    std::thread worker([&response, &workerPool] {
+        workerPool = &ResponsePool::getInstance();
+        response = CmdHandler::newResponse(PLDM_GET_TID_RESP_BYTES);
+    });
+    worker.join();
+    EXPECT_NE(workerPool, &responsePool);
+    EXPECT_EQ(responsePool.size(), freeBuffers);
+
+    responsePool.release(std::move(response));
+    EXPECT_EQ(responsePool.size(), freeBuffers + 1);
 }
@@ -0,0 +1,172 @@
+#include "pldmd/rx_drain.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/* Compares the receive path of pldmd handling one message per wakeup of the
+ * event loop and copying it, with draining all the pending messages and
+ * handing out a view of the receive buffer. The transport is a datagram
+ * socket pair receiving into a heap buffer per message like libpldm does.
+ */
+
+constexpr size_t totalMsgs = 200000;
+constexpr size_t burstMsgs = 64;
+
+class SocketTransport
+{
+  public:
+    SocketTransport()
+    {
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds))
+        {
+            throw std::runtime_error("socketpair failed");
+        }
+    }
+
+    ~SocketTransport()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    int getEventSource() const
+    {
+        return fds[0];
+    }
+
+    void send(std::span<const uint8_t> msg)
+    {
+        if (::send(fds[1], msg.data(), msg.size(), 0) < 0)
+        {
+            throw std::runtime_error("send failed");
+        }
+    }
+
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx, size_t& len)
+    {
+        auto length = recv(fds[0], nullptr, 0, MSG_PEEK | MSG_TRUNC);
+        if (length <= 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+        rx = malloc(length);
+        len = recv(fds[0], rx, length, 0);
+        tid = 9;
+        return PLDM_REQUESTER_SUCCESS;
+    }
+
+    bool hasPendingMsg() const
+    {
+        pollfd readiness{fds[0], POLLIN, 0};
+        return poll(&readiness, 1, 0) > 0 && (readiness.revents & POLLIN);
+    }
+
+  private:
+    int fds[2];
+};
+
+/* The work common to both paths, decode the header and build a response */
+static size_t processMsg(std::span<const uint8_t> msg)
+{
+    pldm_header_info hdrFields{};
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(msg.data());
+    if (PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
+    {
+        return 0;
+    }
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 1);
+    return response.size() + hdrFields.command;
+}
+
+static double run(const char* name,
+                  const std::function<size_t(SocketTransport&)>& onReadable)
+{
+    SocketTransport transport;
+    int epollFd = epoll_create1(0);
+    epoll_event readable{};
+    readable.events = EPOLLIN;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, transport.getEventSource(), &readable);
+
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + 4);
+    auto request = reinterpret_cast<pldm_msg*>(msg.data());
+    pldm_header_info header{};
+    header.msg_type = PLDM_REQUEST;
+    header.instance = 1;
+    header.pldm_type = PLDM_PLATFORM;
+    header.command = PLDM_GET_SENSOR_READING;
+    pack_pldm_header(&header, &request->hdr);
+
+    size_t received = 0;
+    size_t wakeups = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (received < totalMsgs)
+    {
+        for (size_t i = 0; i < burstMsgs; ++i)
+        {
+            transport.send(msg);
+        }
+        for (size_t pending = burstMsgs; pending;)
+        {
+            epoll_event event{};
+            if (epoll_wait(epollFd, &event, 1, -1) != 1)
+            {
+                continue;
+            }
+            wakeups++;
+            auto count = onReadable(transport);
+            pending -= count;
+            received += count;
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    close(epollFd);
+
+    auto rate = received / elapsed.count();
+    printf("%-12s %10.0f msgs/s %8.2f msgs/wakeup\n", name, rate,
+           static_cast<double>(received) / wakeups);
+    return rate;
+}
+
+int main()
+{
+    auto single = run("one-by-one", [](SocketTransport& transport) -> size_t {
+        pldm_tid_t tid = 0;
+        void* rx = nullptr;
+        size_t len = 0;
+        if (transport.recvMsg(tid, rx, len) != PLDM_REQUESTER_SUCCESS)
+        {
+            return 0;
+        }
+        std::vector<uint8_t> msg(static_cast<uint8_t*>(rx),
+                                 static_cast<uint8_t*>(rx) + len);
+        free(rx);
+        processMsg(msg);
+        return 1;
+    });
+
+    auto drained = run("drain", [](SocketTransport& transport) -> size_t {
+        size_t count = 0;
+        pldm::drainRxMsgs(transport, pldm::maxRxMsgsPerWakeup,
+                          [&count](pldm_tid_t, std::span<const uint8_t> msg) {
+                              processMsg(msg);
+                              count++;
+                          });
+        return count;
+    });
+
+    printf("speedup      %10.2fx\n", drained / single);
+    return 0;
+}
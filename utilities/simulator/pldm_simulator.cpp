@@ -0,0 +1,68 @@
+#include "simulator.hpp"
+
+#include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <atomic>
+#include <csignal>
+#include <exception>
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+static std::atomic<bool> stop = false;
+
+static void onSignal(int)
+{
+    stop = true;
+}
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"Simulate PLDM termini for pldmd built with the loopback "
+                 "transport"};
+    std::string configFile{};
+    app.add_option("-c,--config", configFile,
+                   "JSON description of the simulated termini")
+        ->required();
+    std::string basePath{LOOPBACK_SOCKET_PATH};
+    app.add_option("-p,--path", basePath, "Socket path of pldmd")
+        ->capture_default_str();
+    CLI11_PARSE(app, argc, argv);
+
+    std::ifstream jsonFile(configFile);
+    auto data = nlohmann::json::parse(jsonFile, nullptr, false);
+    if (data.is_discarded())
+    {
+        error("Failed to parse simulator config file '{PATH}'", "PATH",
+              configFile);
+        return -1;
+    }
+
+    try
+    {
+        auto config = pldm::simulator::parseConfig(data);
+        pldm::simulator::Simulator simulator(config, basePath);
+        info("Simulating {COUNT} termini on '{PATH}'", "COUNT",
+             simulator.size(), "PATH", basePath);
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        simulator.run(stop);
+
+        const auto& stats = simulator.getStats();
+        info(
+            "Received {REQUESTS} requests, dropped {DROPPED}, answered {READINGS} sensor readings, delivered {DELIVERED} of {QUEUED} sensor events",
+            "REQUESTS", stats.requests.load(), "DROPPED", stats.dropped.load(),
+            "READINGS", stats.sensorReadings.load(), "DELIVERED",
+            stats.eventsDelivered.load(), "QUEUED", stats.eventsQueued.load());
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to simulate the termini, error - {ERROR}", "ERROR", e);
+        return -1;
+    }
+
+    return 0;
+}
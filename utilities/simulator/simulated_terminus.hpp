@@ -0,0 +1,1141 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/entity.h>
+#include <libpldm/platform.h>
+#include <libpldm/utils.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace simulator
+{
+
+/** @struct SensorConfig
+ *
+ *  A numeric sensor of a simulated terminus. Its raw reading sweeps from the
+ *  lowest to the highest reading, one step per GetSensorReading.
+ */
+struct SensorConfig
+{
+    uint16_t sensorId = 0;                 //!< sensor ID
+    uint16_t entityType = PLDM_ENTITY_PROC; //!< entity type of the sensor
+    uint16_t entityInstance = 1;           //!< entity instance number
+    uint16_t containerId = 1;              //!< container ID of the entity
+    uint8_t baseUnit = PLDM_SENSOR_UNIT_DEGRESS_C; //!< base unit
+    int8_t unitModifier = 0;                       //!< unit modifier
+    uint8_t dataSize = PLDM_SENSOR_DATA_SIZE_UINT16; //!< sensor data size
+    int64_t minReading = 0;   //!< lowest raw reading
+    int64_t maxReading = 100; //!< highest raw reading
+    float updateInterval = 1; //!< update interval, in seconds
+    uint8_t eventMessageEnable =
+        PLDM_NO_EVENT_GENERATION; //!< sensorEventMessageEnable reported
+};
+
+/** @struct FaultConfig
+ *
+ *  The faults injected by a simulated terminus
+ */
+struct FaultConfig
+{
+    std::chrono::microseconds latency{0}; //!< delay of every response
+    std::chrono::microseconds jitter{0}; //!< random extra delay, up to this
+    double lossRate = 0;                 //!< ratio of requests dropped
+    double stormRate = 0; //!< sensor events generated per second
+    std::chrono::milliseconds stormDuration{0}; //!< 0 to never stop
+};
+
+/** @struct TerminusConfig
+ *
+ *  A simulated terminus
+ */
+struct TerminusConfig
+{
+    uint8_t eid = 0;                    //!< MCTP EID
+    pldm_tid_t tid = PLDM_TID_UNASSIGNED; //!< TID before any SetTID
+    std::string name;                   //!< terminus name
+    uint16_t maxBufferSize = 256;       //!< event message buffer size
+    uint16_t pdrTransferSize = 0; //!< largest GetPDR part, 0 for no limit
+    std::vector<SensorConfig> sensors; //!< numeric sensors
+    FaultConfig faults;                //!< injected faults
+};
+
+/** @struct SimulatorConfig
+ *
+ *  The simulated termini and the seed of the random faults
+ */
+struct SimulatorConfig
+{
+    uint32_t seed = 1;
+    std::vector<TerminusConfig> termini;
+};
+
+/** @brief Get the raw reading range of a sensor data size
+ *
+ *  @return the lowest and the highest reading
+ */
+inline std::pair<int64_t, int64_t> sensorDataRange(uint8_t dataSize)
+{
+    switch (dataSize)
+    {
+        case PLDM_SENSOR_DATA_SIZE_UINT8:
+            return {0, std::numeric_limits<uint8_t>::max()};
+        case PLDM_SENSOR_DATA_SIZE_SINT8:
+            return {std::numeric_limits<int8_t>::min(),
+                    std::numeric_limits<int8_t>::max()};
+        case PLDM_SENSOR_DATA_SIZE_UINT16:
+            return {0, std::numeric_limits<uint16_t>::max()};
+        case PLDM_SENSOR_DATA_SIZE_SINT16:
+            return {std::numeric_limits<int16_t>::min(),
+                    std::numeric_limits<int16_t>::max()};
+        case PLDM_SENSOR_DATA_SIZE_UINT32:
+            return {0, std::numeric_limits<uint32_t>::max()};
+        case PLDM_SENSOR_DATA_SIZE_SINT32:
+            return {std::numeric_limits<int32_t>::min(),
+                    std::numeric_limits<int32_t>::max()};
+        default:
+            throw std::invalid_argument("Invalid sensor data size " +
+                                        std::to_string(dataSize));
+    }
+}
+
+/** @brief Get the number of bytes of a sensor data size */
+inline size_t sensorDataBytes(uint8_t dataSize)
+{
+    return static_cast<size_t>(1) << (dataSize / 2);
+}
+
+/** @brief Parse the JSON description of the simulated termini
+ *
+ *  @code
+ *  {
+ *      "seed": 1,
+ *      "termini": [{
+ *          "eid": 10, "count": 50, "tid": 0, "name": "SIM",
+ *          "maxBufferSize": 256, "pdrTransferSize": 0,
+ *          "latency_us": 500, "jitter_us": 200, "loss_percent": 0.1,
+ *          "eventStorm": {"rate": 100, "duration_ms": 0},
+ *          "sensors": [{
+ *              "count": 200, "sensorId": 1, "entityType": 135,
+ *              "entityInstance": 1, "containerId": 1, "baseUnit": 2,
+ *              "unitModifier": 0, "dataSize": "uint16", "min": 0,
+ *              "max": 100, "updateInterval": 1.0,
+ *              "eventMessageEnable": "noEventGeneration"
+ *          }]
+ *      }]
+ *  }
+ *  @endcode
+ *
+ *  The eventMessageEnable of a sensor is one of noEventGeneration,
+ *  eventsDisabled, eventsEnabled, opEventsOnlyEnabled and
+ *  stateEventsOnlyEnabled, reported in its GetSensorReading responses.
+ *
+ *  An entry with a count describes that many identical termini on
+ *  consecutive EIDs, or that many sensors with consecutive sensor IDs. The
+ *  name of a terminus is suffixed with its EID when the entry has a count,
+ *  so that every terminus is named differently.
+ *
+ *  @param[in] json - the description
+ *
+ *  @return the configuration of the simulator
+ *
+ *  @throw std::invalid_argument or nlohmann::json::exception if the
+ *         description is invalid
+ */
+inline SimulatorConfig parseConfig(const nlohmann::json& json)
+{
+    static const std::map<std::string, uint8_t> dataSizes{
+        {"uint8", PLDM_SENSOR_DATA_SIZE_UINT8},
+        {"sint8", PLDM_SENSOR_DATA_SIZE_SINT8},
+        {"uint16", PLDM_SENSOR_DATA_SIZE_UINT16},
+        {"sint16", PLDM_SENSOR_DATA_SIZE_SINT16},
+        {"uint32", PLDM_SENSOR_DATA_SIZE_UINT32},
+        {"sint32", PLDM_SENSOR_DATA_SIZE_SINT32}};
+    static const std::map<std::string, uint8_t> eventMessageEnables{
+        {"noEventGeneration", PLDM_NO_EVENT_GENERATION},
+        {"eventsDisabled", PLDM_EVENTS_DISABLED},
+        {"eventsEnabled", PLDM_EVENTS_ENABLED},
+        {"opEventsOnlyEnabled", PLDM_OP_EVENTS_ONLY_ENABLED},
+        {"stateEventsOnlyEnabled", PLDM_STATE_EVENTS_ONLY_ENABLED}};
+
+    SimulatorConfig config;
+    config.seed = json.value("seed", 1u);
+
+    std::vector<bool> usedEids(std::numeric_limits<uint8_t>::max() + 1);
+    for (const auto& entry : json.at("termini"))
+    {
+        auto firstEid = entry.at("eid").get<unsigned>();
+        auto count = entry.value("count", 0u);
+        auto name = entry.value("name", std::string("SIM"));
+        auto lastEid = firstEid + std::max(count, 1u) - 1;
+        // EID 0 and 255 are reserved
+        if (!firstEid || lastEid >= std::numeric_limits<uint8_t>::max())
+        {
+            throw std::invalid_argument("Invalid EID range from EID " +
+                                        std::to_string(firstEid));
+        }
+
+        TerminusConfig terminus;
+        terminus.tid = entry.value("tid", PLDM_TID_UNASSIGNED);
+        terminus.maxBufferSize = entry.value("maxBufferSize", 256);
+        terminus.pdrTransferSize = entry.value("pdrTransferSize", 0);
+        terminus.faults.latency =
+            std::chrono::microseconds(entry.value("latency_us", 0));
+        terminus.faults.jitter =
+            std::chrono::microseconds(entry.value("jitter_us", 0));
+        terminus.faults.lossRate =
+            std::clamp(entry.value("loss_percent", 0.0), 0.0, 100.0) / 100;
+        if (entry.contains("eventStorm"))
+        {
+            const auto& storm = entry.at("eventStorm");
+            terminus.faults.stormRate = std::max(storm.value("rate", 0.0), 0.0);
+            terminus.faults.stormDuration =
+                std::chrono::milliseconds(storm.value("duration_ms", 0));
+        }
+
+        uint32_t sensorId = 1;
+        for (const auto& group : entry.value("sensors", nlohmann::json::array()))
+        {
+            SensorConfig sensor;
+            sensorId = group.value("sensorId", sensorId);
+            sensor.entityType = group.value("entityType", sensor.entityType);
+            sensor.entityInstance =
+                group.value("entityInstance", sensor.entityInstance);
+            sensor.containerId = group.value("containerId", sensor.containerId);
+            sensor.baseUnit = group.value("baseUnit", sensor.baseUnit);
+            sensor.unitModifier =
+                group.value("unitModifier", sensor.unitModifier);
+            sensor.updateInterval =
+                group.value("updateInterval", sensor.updateInterval);
+
+            auto dataSize = group.value("dataSize", std::string("uint16"));
+            if (!dataSizes.contains(dataSize))
+            {
+                throw std::invalid_argument("Invalid sensor data size " +
+                                            dataSize);
+            }
+            sensor.dataSize = dataSizes.at(dataSize);
+            auto eventMessageEnable = group.value(
+                "eventMessageEnable", std::string("noEventGeneration"));
+            if (!eventMessageEnables.contains(eventMessageEnable))
+            {
+                throw std::invalid_argument("Invalid event message enable " +
+                                            eventMessageEnable);
+            }
+            sensor.eventMessageEnable =
+                eventMessageEnables.at(eventMessageEnable);
+            auto [lowest, highest] = sensorDataRange(sensor.dataSize);
+            sensor.minReading = group.value("min", int64_t(0));
+            sensor.maxReading = group.value("max", int64_t(100));
+            if (sensor.minReading > sensor.maxReading ||
+                sensor.minReading < lowest || sensor.maxReading > highest)
+            {
+                throw std::invalid_argument(
+                    "Invalid reading range for sensor data size " + dataSize);
+            }
+
+            for (auto idx = group.value("count", 1u); idx; --idx, ++sensorId)
+            {
+                if (sensorId > std::numeric_limits<uint16_t>::max())
+                {
+                    throw std::invalid_argument("Too many sensors");
+                }
+                sensor.sensorId = static_cast<uint16_t>(sensorId);
+                terminus.sensors.push_back(sensor);
+            }
+        }
+
+        for (auto eid = firstEid; eid <= lastEid; ++eid)
+        {
+            if (usedEids[eid])
+            {
+                throw std::invalid_argument("Duplicate EID " +
+                                            std::to_string(eid));
+            }
+            usedEids[eid] = true;
+            terminus.eid = static_cast<uint8_t>(eid);
+            terminus.name = count ? name + "_" + std::to_string(eid) : name;
+            config.termini.push_back(terminus);
+        }
+    }
+
+    return config;
+}
+
+/** @brief Append a value to a message in little endian byte order */
+template <typename T>
+void appendLE(std::vector<uint8_t>& msg, T value)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    auto bits = static_cast<Unsigned>(value);
+    for (size_t idx = 0; idx < sizeof(T); ++idx)
+    {
+        msg.push_back(static_cast<uint8_t>(bits >> (8 * idx)));
+    }
+}
+
+/** @brief Read a little endian value from a message payload */
+template <typename T>
+T extractLE(std::span<const uint8_t> payload, size_t offset)
+{
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t idx = 0; idx < sizeof(T); ++idx)
+    {
+        bits |= static_cast<decltype(bits)>(payload[offset + idx]) << (8 * idx);
+    }
+    return static_cast<T>(bits);
+}
+
+/** @class SimulatedTerminus
+ *
+ *  A PLDM terminus answering the base and platform commands platform-mc
+ *  sends, with a PDR repository generated from its configuration: an entity
+ *  auxiliary names PDR with the terminus name and a numeric sensor PDR per
+ *  sensor. The sensor events it generates are delivered through
+ *  PollForPlatformEventMessage, announced by a pldmMessagePollEvent.
+ *
+ *  The terminus only builds messages, the transport and the injected faults
+ *  are up to its user.
+ */
+class SimulatedTerminus
+{
+  public:
+    /** @brief Largest number of sensor events waiting to be polled, further
+     *         events are dropped
+     */
+    static constexpr size_t maxQueuedEvents = 1024;
+
+    explicit SimulatedTerminus(TerminusConfig config) :
+        config(std::move(config)), tid(this->config.tid)
+    {
+        generatePdrs();
+        for (size_t idx = 0; idx < this->config.sensors.size(); ++idx)
+        {
+            sensors.emplace(this->config.sensors[idx].sensorId,
+                            SensorState{idx});
+        }
+    }
+
+    /** @brief Get the configuration of the terminus */
+    const TerminusConfig& getConfig() const
+    {
+        return config;
+    }
+
+    /** @brief Get the current TID of the terminus */
+    pldm_tid_t getTid() const
+    {
+        return tid;
+    }
+
+    /** @brief Get the PDRs of the terminus, in record handle order */
+    const std::vector<std::vector<uint8_t>>& getPdrs() const
+    {
+        return pdrs;
+    }
+
+    /** @brief Check if an event receiver has enabled the events */
+    bool isEventReceiverSet() const
+    {
+        return eventMessageGlobalEnable != PLDM_EVENT_MESSAGE_GLOBAL_DISABLE;
+    }
+
+    /** @brief Get the number of sensor events waiting to be polled */
+    size_t getQueuedEvents() const
+    {
+        return events.size();
+    }
+
+    /** @brief Number of GetSensorReading commands answered */
+    uint64_t sensorReadings = 0;
+
+    /** @brief Number of sensor events acknowledged by the event receiver */
+    uint64_t eventsDelivered = 0;
+
+    /** @brief Number of sensor events dropped as too many were queued */
+    uint64_t eventsDropped = 0;
+
+    /** @brief Handle a PLDM message received by the terminus
+     *
+     *  @param[in] msg - the message
+     *
+     *  @return the response, empty if the message is not a request
+     */
+    std::vector<uint8_t> handleRequest(std::span<const uint8_t> msg)
+    {
+        if (msg.size() < sizeof(pldm_msg_hdr))
+        {
+            return {};
+        }
+        auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+        if (!request->hdr.request)
+        {
+            return {};
+        }
+        auto payload = msg.subspan(sizeof(pldm_msg_hdr));
+
+        if (request->hdr.type == PLDM_BASE)
+        {
+            switch (request->hdr.command)
+            {
+                case PLDM_GET_TID:
+                    return getTID(request);
+                case PLDM_SET_TID:
+                    return setTID(request, payload);
+                case PLDM_GET_PLDM_TYPES:
+                    return getPLDMTypes(request);
+                case PLDM_GET_PLDM_COMMANDS:
+                    return getPLDMCommands(request, payload);
+                case PLDM_GET_PLDM_VERSION:
+                    return getPLDMVersion(request, payload);
+            }
+        }
+        else if (request->hdr.type == PLDM_PLATFORM)
+        {
+            switch (request->hdr.command)
+            {
+                case PLDM_GET_PDR_REPOSITORY_INFO:
+                    return getPDRRepositoryInfo(request);
+                case PLDM_GET_PDR:
+                    return getPDR(request, payload);
+                case PLDM_GET_SENSOR_READING:
+                    return getSensorReading(request, payload);
+                case PLDM_EVENT_MESSAGE_BUFFER_SIZE:
+                    return eventMessageBufferSize(request, payload);
+                case PLDM_EVENT_MESSAGE_SUPPORTED:
+                    return eventMessageSupported(request, payload);
+                case PLDM_SET_EVENT_RECEIVER:
+                    return setEventReceiver(request, payload);
+                case PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE:
+                    return pollForPlatformEventMessage(request, payload);
+            }
+        }
+
+        return ccOnlyResponse(request, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+    }
+
+    /** @brief Generate a sensor event, for the next sensor in turn
+     *
+     *  The events toggle the sensor between the normal and the upper warning
+     *  state.
+     *
+     *  @return false if the event was dropped
+     */
+    bool queueSensorEvent()
+    {
+        if (config.sensors.empty())
+        {
+            return false;
+        }
+        if (events.size() >= maxQueuedEvents)
+        {
+            eventsDropped++;
+            return false;
+        }
+
+        const auto& sensor = config.sensors[nextEventSensor];
+        nextEventSensor = (nextEventSensor + 1) % config.sensors.size();
+        auto& state = sensors.at(sensor.sensorId);
+        auto previousState = state.eventState;
+        state.eventState = previousState == PLDM_SENSOR_NORMAL
+                               ? PLDM_SENSOR_UPPERWARNING
+                               : PLDM_SENSOR_NORMAL;
+
+        // sensorEvent data of the numericSensorState class, DSP0248 Table 19
+        // and Table 21
+        Event event{nextEventId, {}};
+        appendLE(event.data, sensor.sensorId);
+        event.data.push_back(PLDM_NUMERIC_SENSOR_STATE);
+        event.data.push_back(state.eventState);
+        event.data.push_back(previousState);
+        event.data.push_back(sensor.dataSize);
+        appendReading(event.data, sensor, state.reading);
+        events.push_back(std::move(event));
+
+        // Event IDs 0x0000 and 0xFFFF are reserved
+        nextEventId = nextEventId % 0xFFFE + 1;
+        return true;
+    }
+
+    /** @brief Check if the event receiver has to be told with a
+     *         pldmMessagePollEvent that events are waiting to be polled
+     */
+    bool needsPollEvent() const
+    {
+        return isEventReceiverSet() && !events.empty() && !pollEventAnnounced;
+    }
+
+    /** @brief Announce the pldmMessagePollEvent again, as the event receiver
+     *         did not poll the events it announced
+     */
+    void resetPollEvent()
+    {
+        pollEventAnnounced = false;
+    }
+
+    /** @brief Build the PlatformEventMessage request announcing the queued
+     *         events with a pldmMessagePollEvent
+     *
+     *  @param[in] instanceId - instance ID of the request
+     */
+    std::vector<uint8_t> pollEventRequest(uint8_t instanceId)
+    {
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr));
+        pldm_header_info header{};
+        header.msg_type = PLDM_REQUEST;
+        header.instance = instanceId;
+        header.pldm_type = PLDM_PLATFORM;
+        header.command = PLDM_PLATFORM_EVENT_MESSAGE;
+        pack_pldm_header(&header, reinterpret_cast<pldm_msg_hdr*>(msg.data()));
+
+        // formatVersion, TID, eventClass and the pldmMessagePollEvent data,
+        // DSP0248 Table 11 and Table 24
+        msg.push_back(1);
+        msg.push_back(tid);
+        msg.push_back(PLDM_MESSAGE_POLL_EVENT);
+        msg.push_back(1);
+        appendLE(msg, events.empty() ? uint16_t(1) : events.front().id);
+        appendLE(msg, uint32_t(0));
+        pollEventAnnounced = true;
+        return msg;
+    }
+
+    /** @brief Number of PollForPlatformEventMessage commands answered */
+    uint64_t eventPolls = 0;
+
+  private:
+    /** @struct SensorState
+     *
+     *  The changing state of a sensor
+     */
+    struct SensorState
+    {
+        size_t index;    //!< index of the sensor in the configuration
+        uint64_t step = 0; //!< number of readings taken
+        int64_t reading = 0; //!< last reading
+        uint8_t eventState = PLDM_SENSOR_NORMAL; //!< last event state
+    };
+
+    /** @struct Event
+     *
+     *  A sensor event waiting to be polled
+     */
+    struct Event
+    {
+        uint16_t id;               //!< event ID
+        std::vector<uint8_t> data; //!< sensorEvent class data
+    };
+
+    /** @brief Build the header of the response to a request */
+    static std::vector<uint8_t> newResponse(const pldm_msg* request,
+                                            size_t payloadLength)
+    {
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + payloadLength);
+        pldm_header_info header{};
+        header.msg_type = PLDM_RESPONSE;
+        header.instance = request->hdr.instance_id;
+        header.pldm_type = request->hdr.type;
+        header.command = request->hdr.command;
+        pack_pldm_header(&header,
+                         reinterpret_cast<pldm_msg_hdr*>(response.data()));
+        return response;
+    }
+
+    static std::vector<uint8_t> ccOnlyResponse(const pldm_msg* request,
+                                               uint8_t completionCode)
+    {
+        auto response = newResponse(request, 0);
+        response.push_back(completionCode);
+        return response;
+    }
+
+    /** @brief Append a raw reading in the data size of a sensor */
+    static void appendReading(std::vector<uint8_t>& msg,
+                              const SensorConfig& sensor, int64_t reading)
+    {
+        switch (sensorDataBytes(sensor.dataSize))
+        {
+            case 1:
+                msg.push_back(static_cast<uint8_t>(reading));
+                break;
+            case 2:
+                appendLE(msg, static_cast<uint16_t>(reading));
+                break;
+            default:
+                appendLE(msg, static_cast<uint32_t>(reading));
+                break;
+        }
+    }
+
+    /** @brief Append a value in a PDR range field format, the sensor data
+     *         size values match the integer range field formats
+     */
+    static void appendRangeField(std::vector<uint8_t>& pdr, uint8_t format,
+                                 int64_t value)
+    {
+        SensorConfig sensor;
+        sensor.dataSize = format;
+        appendReading(pdr, sensor, value);
+    }
+
+    /** @brief Append the common PDR header and return the offset of its
+     *         dataLength field
+     */
+    static size_t appendPdrHeader(std::vector<uint8_t>& pdr,
+                                  uint32_t recordHandle, uint8_t type)
+    {
+        appendLE(pdr, recordHandle);
+        pdr.push_back(1); // PDRHeaderVersion
+        pdr.push_back(type);
+        appendLE(pdr, uint16_t(0)); // recordChangeNumber
+        appendLE(pdr, uint16_t(0)); // dataLength, set once known
+        return pdr.size() - sizeof(uint16_t);
+    }
+
+    static void setPdrDataLength(std::vector<uint8_t>& pdr, size_t offset)
+    {
+        auto length = static_cast<uint16_t>(pdr.size() - sizeof(pldm_pdr_hdr));
+        pdr[offset] = static_cast<uint8_t>(length);
+        pdr[offset + 1] = static_cast<uint8_t>(length >> 8);
+    }
+
+    /** @brief Generate the PDR repository of the terminus */
+    void generatePdrs()
+    {
+        uint32_t recordHandle = 1;
+
+        // Entity auxiliary names PDR of the overall system entity, which
+        // names the terminus, DSP0248 Table 95
+        std::vector<uint8_t> names;
+        auto lengthOffset = appendPdrHeader(names, recordHandle++,
+                                            PLDM_ENTITY_AUXILIARY_NAMES_PDR);
+        appendLE(names, uint16_t(PLDM_ENTITY_SYSTEM_CHASSIS));
+        appendLE(names, uint16_t(1)); // entityInstanceNumber
+        appendLE(names, uint16_t(PLDM_PLATFORM_ENTITY_SYSTEM_CONTAINER_ID));
+        names.push_back(0); // sharedNameCount
+        names.push_back(1); // nameStringCount
+        names.insert(names.end(), {'e', 'n', 0});
+        // entityName is a NUL terminated UTF-16BE string
+        for (auto c : config.name)
+        {
+            names.push_back(0);
+            names.push_back(static_cast<uint8_t>(c));
+        }
+        names.insert(names.end(), {0, 0});
+        setPdrDataLength(names, lengthOffset);
+        pdrs.push_back(std::move(names));
+
+        // Numeric sensor PDRs, DSP0248 Table 78
+        for (const auto& sensor : config.sensors)
+        {
+            std::vector<uint8_t> pdr;
+            lengthOffset =
+                appendPdrHeader(pdr, recordHandle++, PLDM_NUMERIC_SENSOR_PDR);
+            appendLE(pdr, uint16_t(0)); // PLDMTerminusHandle
+            appendLE(pdr, sensor.sensorId);
+            appendLE(pdr, sensor.entityType);
+            appendLE(pdr, sensor.entityInstance);
+            appendLE(pdr, sensor.containerId);
+            pdr.push_back(PLDM_NO_INIT);         // sensorInit
+            pdr.push_back(false);                // sensorAuxiliaryNamesPDR
+            pdr.push_back(sensor.baseUnit);      // baseUnit
+            pdr.push_back(static_cast<uint8_t>(sensor.unitModifier));
+            pdr.push_back(0);                    // rateUnit
+            pdr.push_back(0);                    // baseOEMUnitHandle
+            pdr.push_back(0);                    // auxUnit
+            pdr.push_back(0);                    // auxUnitModifier
+            pdr.push_back(0);                    // auxRateUnit
+            pdr.push_back(0);                    // rel
+            pdr.push_back(0);                    // auxOEMUnitHandle
+            pdr.push_back(true);                 // isLinear
+            pdr.push_back(sensor.dataSize);      // sensorDataSize
+            appendFloat(pdr, 1);                 // resolution
+            appendFloat(pdr, 0);                 // offset
+            appendLE(pdr, uint16_t(0));          // accuracy
+            pdr.push_back(0);                    // plusTolerance
+            pdr.push_back(0);                    // minusTolerance
+            appendReading(pdr, sensor, 0);       // hysteresis
+            pdr.push_back(0);                    // supportedThresholds
+            pdr.push_back(0); // thresholdAndHysteresisVolatility
+            appendFloat(pdr, 0);                     // stateTransitionInterval
+            appendFloat(pdr, sensor.updateInterval); // updateInterval
+            appendReading(pdr, sensor, sensor.maxReading); // maxReadable
+            appendReading(pdr, sensor, sensor.minReading); // minReadable
+            pdr.push_back(sensor.dataSize); // rangeFieldFormat
+            pdr.push_back(0);               // rangeFieldSupport
+            // nominalValue, normalMax, normalMin, warningHigh, warningLow,
+            // criticalHigh, criticalLow, fatalHigh and fatalLow
+            for (size_t idx = 0; idx < 9; ++idx)
+            {
+                appendRangeField(pdr, sensor.dataSize, 0);
+            }
+            setPdrDataLength(pdr, lengthOffset);
+            pdrs.push_back(std::move(pdr));
+        }
+
+        for (const auto& pdr : pdrs)
+        {
+            repositorySize += pdr.size();
+            largestRecordSize =
+                std::max<uint32_t>(largestRecordSize, pdr.size());
+        }
+    }
+
+    static void appendFloat(std::vector<uint8_t>& msg, float value)
+    {
+        appendLE(msg, std::bit_cast<uint32_t>(value));
+    }
+
+    std::vector<uint8_t> getTID(const pldm_msg* request) const
+    {
+        auto response = newResponse(request, PLDM_GET_TID_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_get_tid_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                      tid, responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> setTID(const pldm_msg* request,
+                                std::span<const uint8_t> payload)
+    {
+        if (payload.size() < sizeof(pldm_tid_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+        // TID 0 and 255 are reserved
+        if (payload[0] == PLDM_TID_UNASSIGNED || payload[0] == 0xFF)
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+        }
+        tid = payload[0];
+        return ccOnlyResponse(request, PLDM_SUCCESS);
+    }
+
+    std::vector<uint8_t> getPLDMTypes(const pldm_msg* request) const
+    {
+        std::array<bitfield8_t, 8> types{};
+        types[0].byte = 1 << PLDM_BASE | 1 << PLDM_PLATFORM;
+
+        auto response = newResponse(request, PLDM_GET_TYPES_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                        types.data(), responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> getPLDMCommands(const pldm_msg* request,
+                                         std::span<const uint8_t> payload) const
+    {
+        uint8_t type = 0;
+        ver32_t version{};
+        auto rc = decode_get_commands_req(request, payload.size(), &type,
+                                          &version);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+
+        std::vector<uint8_t> commands;
+        if (type == PLDM_BASE)
+        {
+            commands = {PLDM_SET_TID, PLDM_GET_TID, PLDM_GET_PLDM_VERSION,
+                        PLDM_GET_PLDM_TYPES, PLDM_GET_PLDM_COMMANDS};
+        }
+        else if (type == PLDM_PLATFORM)
+        {
+            commands = {PLDM_SET_EVENT_RECEIVER,
+                        PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE,
+                        PLDM_EVENT_MESSAGE_SUPPORTED,
+                        PLDM_EVENT_MESSAGE_BUFFER_SIZE,
+                        PLDM_GET_SENSOR_READING,
+                        PLDM_GET_PDR_REPOSITORY_INFO,
+                        PLDM_GET_PDR};
+        }
+        else
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_PLDM_TYPE);
+        }
+
+        std::array<bitfield8_t, 32> cmds{};
+        for (auto cmd : commands)
+        {
+            cmds[cmd / 8].byte |= 1 << (cmd % 8);
+        }
+
+        auto response = newResponse(request, PLDM_GET_COMMANDS_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        rc = encode_get_commands_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                      cmds.data(), responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> getPLDMVersion(const pldm_msg* request,
+                                        std::span<const uint8_t> payload) const
+    {
+        uint32_t transferHandle = 0;
+        uint8_t transferFlag = 0;
+        uint8_t type = 0;
+        auto rc = decode_get_version_req(request, payload.size(),
+                                         &transferHandle, &transferFlag, &type);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+
+        ver32_t version{};
+        if (type == PLDM_BASE)
+        {
+            version = {0x00, 0xf0, 0xf0, 0xf1};
+        }
+        else if (type == PLDM_PLATFORM)
+        {
+            version = {0x00, 0xf0, 0xf2, 0xf1};
+        }
+        else
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_PLDM_TYPE);
+        }
+
+        auto response = newResponse(request, PLDM_GET_VERSION_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        rc = encode_get_version_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
+                                     PLDM_START_AND_END, &version,
+                                     sizeof(pldm_version), responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> getPDRRepositoryInfo(const pldm_msg* request) const
+    {
+        // The repository is never updated
+        std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{};
+        auto response =
+            newResponse(request, PLDM_GET_PDR_REPOSITORY_INFO_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_get_pdr_repository_info_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, PLDM_AVAILABLE,
+            updateTime.data(), updateTime.data(),
+            static_cast<uint32_t>(pdrs.size()), repositorySize,
+            largestRecordSize, 0, responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> getPDR(const pldm_msg* request,
+                                std::span<const uint8_t> payload) const
+    {
+        uint32_t recordHandle = 0;
+        uint32_t dataTransferHandle = 0;
+        uint8_t transferOpFlag = 0;
+        uint16_t requestCount = 0;
+        uint16_t recordChangeNumber = 0;
+        auto rc = decode_get_pdr_req(request, payload.size(), &recordHandle,
+                                     &dataTransferHandle, &transferOpFlag,
+                                     &requestCount, &recordChangeNumber);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+
+        // Record handle 0 is the first record, handles are 1 based
+        auto index = recordHandle ? recordHandle - 1 : 0;
+        if (index >= pdrs.size())
+        {
+            return ccOnlyResponse(request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+        }
+        const auto& pdr = pdrs[index];
+
+        // The data transfer handle of a part is its offset in the record
+        uint32_t offset =
+            transferOpFlag == PLDM_GET_FIRSTPART ? 0 : dataTransferHandle;
+        if (offset >= pdr.size())
+        {
+            return ccOnlyResponse(request,
+                                  PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+        }
+
+        size_t count = std::min<size_t>(requestCount, pdr.size() - offset);
+        if (config.pdrTransferSize)
+        {
+            count = std::min<size_t>(count, config.pdrTransferSize);
+        }
+        bool start = offset == 0;
+        bool end = offset + count == pdr.size();
+        uint8_t transferFlag = start ? (end ? PLDM_START_AND_END : PLDM_START)
+                                     : (end ? PLDM_END : PLDM_MIDDLE);
+        uint32_t nextRecordHandle =
+            index + 1 < pdrs.size() ? static_cast<uint32_t>(index + 2) : 0;
+        uint32_t nextDataTransferHandle =
+            end ? 0 : static_cast<uint32_t>(offset + count);
+        // The transferCRC of the last part of a multipart transfer covers
+        // the whole record
+        uint8_t transferCrc =
+            end && !start ? crc8(pdr.data(), pdr.size()) : 0;
+
+        auto response = newResponse(request, PLDM_GET_PDR_MIN_RESP_BYTES +
+                                                 count + (end && !start));
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        rc = encode_get_pdr_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                 nextRecordHandle, nextDataTransferHandle,
+                                 transferFlag, static_cast<uint16_t>(count),
+                                 pdr.data() + offset, transferCrc, responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> getSensorReading(const pldm_msg* request,
+                                          std::span<const uint8_t> payload)
+    {
+        // sensorID and rearmEventState
+        if (payload.size() < sizeof(uint16_t) + sizeof(uint8_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+        auto it = sensors.find(extractLE<uint16_t>(payload, 0));
+        if (it == sensors.end())
+        {
+            return ccOnlyResponse(request, PLDM_PLATFORM_INVALID_SENSOR_ID);
+        }
+
+        auto& state = it->second;
+        const auto& sensor = config.sensors[state.index];
+        auto span = static_cast<uint64_t>(sensor.maxReading -
+                                          sensor.minReading) + 1;
+        state.reading = sensor.minReading +
+                        static_cast<int64_t>(state.step++ % span);
+        sensorReadings++;
+
+        union_sensor_data_size presentReading{};
+        switch (sensor.dataSize)
+        {
+            case PLDM_SENSOR_DATA_SIZE_UINT8:
+                presentReading.value_u8 = static_cast<uint8_t>(state.reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+                presentReading.value_s8 = static_cast<int8_t>(state.reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT16:
+                presentReading.value_u16 =
+                    static_cast<uint16_t>(state.reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+                presentReading.value_s16 = static_cast<int16_t>(state.reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT32:
+                presentReading.value_u32 =
+                    static_cast<uint32_t>(state.reading);
+                break;
+            default:
+                presentReading.value_s32 = static_cast<int32_t>(state.reading);
+                break;
+        }
+
+        // The reading takes one byte of the minimum response
+        auto payloadLength = PLDM_GET_SENSOR_READING_MIN_RESP_BYTES +
+                             sensorDataBytes(sensor.dataSize) - 1;
+        auto response = newResponse(request, payloadLength);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_get_sensor_reading_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, sensor.dataSize,
+            PLDM_SENSOR_ENABLED, sensor.eventMessageEnable, state.eventState,
+            state.eventState, state.eventState,
+            reinterpret_cast<const uint8_t*>(&presentReading), responsePtr,
+            payloadLength);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> eventMessageBufferSize(
+        const pldm_msg* request, std::span<const uint8_t> payload) const
+    {
+        if (payload.size() < sizeof(uint16_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+        auto response =
+            newResponse(request, PLDM_EVENT_MESSAGE_BUFFER_SIZE_RESP_BYTES);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_event_message_buffer_size_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, config.maxBufferSize,
+            responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    std::vector<uint8_t> eventMessageSupported(
+        const pldm_msg* request, std::span<const uint8_t> payload) const
+    {
+        if (payload.size() < sizeof(uint8_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+
+        // DSP0248 Table 15
+        auto response = newResponse(request, 0);
+        response.push_back(PLDM_SUCCESS);
+        response.push_back(eventMessageGlobalEnable);
+        response.push_back(1 << PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_ASYNC |
+                           1 << PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_POLLING);
+        response.push_back(2); // numberEventClassReturned
+        response.push_back(PLDM_SENSOR_EVENT);
+        response.push_back(PLDM_MESSAGE_POLL_EVENT);
+        return response;
+    }
+
+    std::vector<uint8_t> setEventReceiver(const pldm_msg* request,
+                                          std::span<const uint8_t> payload)
+    {
+        // eventMessageGlobalEnable, transportProtocolType and
+        // eventReceiverAddressInfo, the heartbeat timer is not simulated
+        if (payload.size() < 3 * sizeof(uint8_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+        if (payload[0] > PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_ASYNC_KEEP_ALIVE)
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+        }
+        eventMessageGlobalEnable = payload[0];
+        return ccOnlyResponse(request, PLDM_SUCCESS);
+    }
+
+    std::vector<uint8_t> pollForPlatformEventMessage(
+        const pldm_msg* request, std::span<const uint8_t> payload)
+    {
+        // formatVersion, transferOperationFlag, dataTransferHandle and
+        // eventIDToAcknowledge
+        if (payload.size() < 2 * sizeof(uint8_t) + sizeof(uint32_t) +
+                                 sizeof(uint16_t))
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        }
+        auto transferOperationFlag = payload[1];
+        auto eventIdToAcknowledge = extractLE<uint16_t>(payload, 6);
+        eventPolls++;
+
+        if (transferOperationFlag == PLDM_ACKNOWLEDGEMENT_ONLY)
+        {
+            if (!events.empty() && events.front().id == eventIdToAcknowledge)
+            {
+                events.pop_front();
+                eventsDelivered++;
+            }
+            if (events.empty())
+            {
+                pollEventAnnounced = false;
+            }
+            // An acknowledgement of an event with more events queued asks
+            // the event receiver to poll again
+            return pollResponse(request, events.empty()
+                                             ? PLDM_PLATFORM_EVENT_ID_NONE
+                                             : PLDM_PLATFORM_EVENT_ID_ACK);
+        }
+
+        if (transferOperationFlag != PLDM_GET_FIRSTPART)
+        {
+            // Every event fits in a single part
+            return ccOnlyResponse(request,
+                                  PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+        }
+        if (events.empty())
+        {
+            pollEventAnnounced = false;
+            return pollResponse(request, PLDM_PLATFORM_EVENT_ID_NONE);
+        }
+        return pollResponse(request, events.front().id, &events.front());
+    }
+
+    /** @brief Build a PollForPlatformEventMessage response
+     *
+     *  @param[in] request - the request
+     *  @param[in] eventId - event ID of the response
+     *  @param[in] event - the event sent, nullptr for a response without
+     *                     event data
+     */
+    std::vector<uint8_t> pollResponse(const pldm_msg* request, uint16_t eventId,
+                                      Event* event = nullptr) const
+    {
+        // nextDataTransferHandle, transferFlag, eventClass, eventDataSize,
+        // eventData and eventDataIntegrityChecksum follow an event ID
+        size_t payloadLength =
+            PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_MIN_RESP_BYTES;
+        uint32_t checksum = 0;
+        if (event)
+        {
+            payloadLength += sizeof(uint32_t) + 2 * sizeof(uint8_t) +
+                             sizeof(uint32_t) + event->data.size() +
+                             sizeof(uint32_t);
+            checksum = crc32(event->data.data(), event->data.size());
+        }
+
+        auto response = newResponse(request, payloadLength);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto rc = encode_poll_for_platform_event_message_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, tid, eventId, 0,
+            PLDM_PLATFORM_TRANSFER_START_AND_END, PLDM_SENSOR_EVENT,
+            event ? static_cast<uint32_t>(event->data.size()) : 0,
+            event ? event->data.data() : nullptr, checksum, responsePtr,
+            payloadLength);
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
+        return response;
+    }
+
+    TerminusConfig config;
+    pldm_tid_t tid;
+    std::vector<std::vector<uint8_t>> pdrs;
+    uint32_t repositorySize = 0;
+    uint32_t largestRecordSize = 0;
+    std::map<uint16_t, SensorState> sensors;
+    uint8_t eventMessageGlobalEnable = PLDM_EVENT_MESSAGE_GLOBAL_DISABLE;
+    std::deque<Event> events;
+    uint16_t nextEventId = 1;
+    size_t nextEventSensor = 0;
+    bool pollEventAnnounced = false;
+};
+
+} // namespace simulator
+} // namespace pldm
@@ -0,0 +1,432 @@
+#pragma once
+
+#include "common/loopback.hpp"
+#include "simulated_terminus.hpp"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace simulator
+{
+
+/** @struct SimulatorStats
+ *
+ *  Counters of a simulator, readable from other threads while it runs
+ */
+struct SimulatorStats
+{
+    std::atomic<uint64_t> requests = 0;  //!< requests received
+    std::atomic<uint64_t> responses = 0; //!< responses sent
+    std::atomic<uint64_t> dropped = 0;   //!< requests dropped as lost
+    std::atomic<uint64_t> sensorReadings = 0; //!< GetSensorReading answered
+    std::atomic<uint64_t> eventsQueued = 0;    //!< sensor events generated
+    std::atomic<uint64_t> eventsDelivered = 0; //!< sensor events acknowledged
+    std::atomic<uint64_t> pollEvents = 0;      //!< pldmMessagePollEvents sent
+    std::atomic<size_t> configured = 0; //!< termini with an event receiver
+};
+
+/** @class Simulator
+ *
+ *  Serves simulated termini over the loopback transport, see
+ *  common/loopback.hpp, delaying and dropping messages as configured. The
+ *  termini either share one end of a socketpair(), whose other end is the
+ *  loopback transport of an in-process pldmd, or each terminus binds the
+ *  socket path of its EID to be reached by a pldmd using the loopback
+ *  transport.
+ *
+ *  run() serves the termini until stopped, it is meant to be the body of the
+ *  main loop of a program or of a thread.
+ */
+class Simulator
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    Simulator() = delete;
+    Simulator(const Simulator&) = delete;
+    Simulator& operator=(const Simulator&) = delete;
+    Simulator(Simulator&&) = delete;
+    Simulator& operator=(Simulator&&) = delete;
+
+    /** @brief Serve the termini on a connected socket
+     *
+     *  @param[in] config - the termini
+     *  @param[in] fd - one end of a socketpair(), owned by the simulator
+     */
+    Simulator(const SimulatorConfig& config, int fd) : rng(config.seed)
+    {
+        endpoints.push_back({fd, {}, {}});
+        addTermini(config, [](const TerminusConfig&) { return 0; });
+    }
+
+    /** @brief Serve each terminus on the socket path of its EID
+     *
+     *  @param[in] config - the termini
+     *  @param[in] basePath - socket path of pldmd
+     *
+     *  @throw std::system_error if a socket cannot be bound
+     */
+    Simulator(const SimulatorConfig& config, const std::string& basePath) :
+        rng(config.seed)
+    {
+        auto peer = loopback::endpointAddress(basePath);
+        try
+        {
+            addTermini(config, [this, &basePath,
+                                &peer](const TerminusConfig& terminus) {
+                auto address =
+                    loopback::endpointAddress(basePath, terminus.eid);
+                int fd = address ? loopback::bindSocket(address)
+                                 : -ENAMETOOLONG;
+                if (fd < 0)
+                {
+                    throw std::system_error(
+                        -fd, std::generic_category(),
+                        "Failed to bind the socket of EID " +
+                            std::to_string(terminus.eid));
+                }
+                endpoints.push_back({fd, peer, address.addr.sun_path});
+                return endpoints.size() - 1;
+            });
+        }
+        catch (...)
+        {
+            closeEndpoints();
+            throw;
+        }
+    }
+
+    ~Simulator()
+    {
+        closeEndpoints();
+    }
+
+    /** @brief Get the counters of the simulator */
+    const SimulatorStats& getStats() const
+    {
+        return stats;
+    }
+
+    /** @brief Get the number of simulated termini */
+    size_t size() const
+    {
+        return termini.size();
+    }
+
+    /** @brief Serve the termini until stopped
+     *
+     *  @param[in] stop - set by another thread or a signal handler to stop
+     */
+    void run(const std::atomic<bool>& stop)
+    {
+        std::vector<pollfd> pfds;
+        for (const auto& endpoint : endpoints)
+        {
+            pfds.push_back({endpoint.fd, POLLIN, 0});
+        }
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            auto now = Clock::now();
+            generateEvents(now);
+            auto blocked = !flush(now);
+
+            // Wake up for the next message or event due, and at least every
+            // 100ms to check if stopped
+            auto wakeup = now + std::chrono::milliseconds(blocked ? 1 : 100);
+            if (!pending.empty())
+            {
+                wakeup = std::min(wakeup, pending.top().due);
+            }
+            for (const auto& terminus : termini)
+            {
+                if (terminus.stormActive)
+                {
+                    wakeup = std::min(wakeup, terminus.nextEvent);
+                }
+            }
+            auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::max(wakeup - now, Clock::duration::zero()));
+            timespec ts{static_cast<time_t>(timeout.count() / 1000000000),
+                        static_cast<long>(timeout.count() % 1000000000)};
+
+            if (ppoll(pfds.data(), pfds.size(), &ts, nullptr) <= 0)
+            {
+                continue;
+            }
+            for (size_t idx = 0; idx < pfds.size(); ++idx)
+            {
+                if (pfds[idx].revents & POLLIN)
+                {
+                    receive(idx);
+                }
+            }
+        }
+    }
+
+  private:
+    /** @struct Endpoint
+     *
+     *  A socket of the simulator
+     */
+    struct Endpoint
+    {
+        int fd;                 //!< the socket
+        loopback::Address peer; //!< pldmd, empty for a connected socket
+        std::string path;       //!< path the socket is bound to, if any
+    };
+
+    /** @struct Terminus
+     *
+     *  A simulated terminus and the state of its fault injection
+     */
+    struct Terminus
+    {
+        std::unique_ptr<SimulatedTerminus> terminus;
+        size_t endpoint = 0;
+        bool configured = false;  //!< an event receiver was set
+        bool stormActive = false; //!< sensor events are being generated
+        Clock::time_point nextEvent{}; //!< time of the next sensor event
+        Clock::time_point stormEnd{};  //!< end of the event storm, if any
+        Clock::time_point announced{}; //!< time of the last poll event
+        uint64_t pollsAtAnnounce = 0;  //!< event polls at that time
+        uint8_t instanceId = 0;        //!< of the next request
+    };
+
+    /** @struct Pending
+     *
+     *  A message waiting for its injected latency to elapse
+     */
+    struct Pending
+    {
+        Clock::time_point due;
+        uint64_t sequence; //!< keeps messages due at once in order
+        size_t endpoint;
+        loopback::Address dest;
+        uint8_t eid;
+        std::vector<uint8_t> msg;
+
+        bool operator>(const Pending& other) const
+        {
+            return std::tie(due, sequence) >
+                   std::tie(other.due, other.sequence);
+        }
+    };
+
+    /** @brief Close the sockets and remove the socket paths bound */
+    void closeEndpoints()
+    {
+        for (const auto& endpoint : endpoints)
+        {
+            close(endpoint.fd);
+            if (!endpoint.path.empty())
+            {
+                unlink(endpoint.path.c_str());
+            }
+        }
+        endpoints.clear();
+    }
+
+    void addTermini(
+        const SimulatorConfig& config,
+        const std::function<size_t(const TerminusConfig&)>& bindEndpoint)
+    {
+        for (const auto& terminusConfig : config.termini)
+        {
+            Terminus terminus;
+            terminus.endpoint = bindEndpoint(terminusConfig);
+            terminus.terminus =
+                std::make_unique<SimulatedTerminus>(terminusConfig);
+            byEid[terminusConfig.eid] = termini.size();
+            termini.push_back(std::move(terminus));
+        }
+    }
+
+    /** @brief Receive and answer the messages pending on a socket */
+    void receive(size_t endpointIdx)
+    {
+        const auto& endpoint = endpoints[endpointIdx];
+        uint8_t eid = 0;
+        loopback::Address src;
+        while (true)
+        {
+            auto rc = loopback::recvMessage(endpoint.fd, eid, rxBuffer, &src);
+            if (rc == PLDM_REQUESTER_TRANSPORT_BUSY ||
+                rc == PLDM_REQUESTER_RECV_FAIL)
+            {
+                break;
+            }
+            auto it = byEid.find(eid);
+            if (rc != PLDM_REQUESTER_SUCCESS || it == byEid.end())
+            {
+                continue;
+            }
+
+            auto& terminus = termini[it->second];
+            auto& sim = *terminus.terminus;
+            const auto& faults = sim.getConfig().faults;
+            auto request = reinterpret_cast<const pldm_msg_hdr*>(
+                rxBuffer.data());
+            if (!request->request)
+            {
+                // Responses to the poll events need no answer
+                continue;
+            }
+            stats.requests++;
+            if (faults.lossRate > 0 && loss(rng) < faults.lossRate)
+            {
+                stats.dropped++;
+                continue;
+            }
+
+            auto readings = sim.sensorReadings;
+            auto delivered = sim.eventsDelivered;
+            auto response = sim.handleRequest(rxBuffer);
+            stats.sensorReadings += sim.sensorReadings - readings;
+            stats.eventsDelivered += sim.eventsDelivered - delivered;
+            if (!terminus.configured && sim.isEventReceiverSet())
+            {
+                terminus.configured = true;
+                stats.configured++;
+                startStorm(terminus, Clock::now());
+            }
+            if (response.empty())
+            {
+                continue;
+            }
+
+            auto delay = faults.latency;
+            if (faults.jitter.count() > 0)
+            {
+                std::uniform_int_distribution<int64_t> jitter(
+                    0, faults.jitter.count());
+                delay += std::chrono::microseconds(jitter(rng));
+            }
+            pending.push({Clock::now() + delay, sequence++, endpointIdx,
+                          src ? src : endpoint.peer, eid, std::move(response)});
+        }
+    }
+
+    /** @brief Send the messages whose latency elapsed
+     *
+     *  @return false if the socket is full, the remaining messages are sent
+     *          once it drains
+     */
+    bool flush(Clock::time_point now)
+    {
+        while (!pending.empty() && pending.top().due <= now)
+        {
+            const auto& msg = pending.top();
+            auto rc = loopback::sendMessage(endpoints[msg.endpoint].fd,
+                                            msg.dest, msg.eid, msg.msg.data(),
+                                            msg.msg.size());
+            if (rc != PLDM_REQUESTER_SUCCESS &&
+                (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return false;
+            }
+            auto hdr = reinterpret_cast<const pldm_msg_hdr*>(msg.msg.data());
+            if (rc == PLDM_REQUESTER_SUCCESS && !hdr->request)
+            {
+                stats.responses++;
+            }
+            pending.pop();
+        }
+        return true;
+    }
+
+    void startStorm(Terminus& terminus, Clock::time_point now)
+    {
+        const auto& faults = terminus.terminus->getConfig().faults;
+        if (faults.stormRate <= 0)
+        {
+            return;
+        }
+        terminus.stormActive = true;
+        terminus.nextEvent = now;
+        terminus.stormEnd = faults.stormDuration.count()
+                                ? now + faults.stormDuration
+                                : Clock::time_point::max();
+    }
+
+    /** @brief Generate the sensor events due and tell the event receiver
+     *         about them
+     */
+    void generateEvents(Clock::time_point now)
+    {
+        for (auto& terminus : termini)
+        {
+            auto& sim = *terminus.terminus;
+            if (terminus.stormActive)
+            {
+                auto interval = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(
+                        1 / sim.getConfig().faults.stormRate));
+                while (terminus.nextEvent <= now &&
+                       terminus.nextEvent < terminus.stormEnd)
+                {
+                    if (sim.queueSensorEvent())
+                    {
+                        stats.eventsQueued++;
+                    }
+                    terminus.nextEvent += interval;
+                }
+                terminus.stormActive = terminus.nextEvent < terminus.stormEnd;
+            }
+
+            // Announce the events again if the event receiver did not poll
+            // them, e.g. as the announcement was lost
+            if (sim.getQueuedEvents() &&
+                sim.eventPolls == terminus.pollsAtAnnounce &&
+                now - terminus.announced > std::chrono::seconds(1))
+            {
+                sim.resetPollEvent();
+            }
+            if (sim.needsPollEvent())
+            {
+                pending.push({now, sequence++, terminus.endpoint,
+                              endpoints[terminus.endpoint].peer,
+                              sim.getConfig().eid,
+                              sim.pollEventRequest(terminus.instanceId)});
+                terminus.instanceId = (terminus.instanceId + 1) %
+                                      (PLDM_INSTANCE_MAX + 1);
+                terminus.announced = now;
+                terminus.pollsAtAnnounce = sim.eventPolls;
+                stats.pollEvents++;
+            }
+        }
+    }
+
+    std::vector<Endpoint> endpoints;
+    std::vector<Terminus> termini;
+    std::unordered_map<uint8_t, size_t> byEid;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+    uint64_t sequence = 0;
+    std::vector<uint8_t> rxBuffer;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> loss{0, 1};
+    SimulatorStats stats;
+};
+
+} // namespace simulator
+} // namespace pldm